@@ -0,0 +1,611 @@
+// bloom_filter.h
+//
+// The bloom filter is a probabilistic set that can tell that a value was
+// definitely never added to it. It may report that a value was added when
+// it was not but it never reports that an added value is missing.
+//
+// This is a split block bloom filter. The bits are divided into blocks of
+// eight 32 bit words, one block is selected by the hash code and then a
+// single bit is set in each of its words. A query only touches one 32 byte
+// block so a negative answer costs a single cache line, and the eight words
+// are tested at once using SSE2 or AVX2 when they are available.
+//
+// Double hashing is used to pick the bits: the block is selected by the mixed
+// hash code and the bits by a second hash that is derived from it.
+//
+// Values cannot be removed from the filter. Clearing or resizing the filter
+// is the only way to reset it.
+//
+// The allocator is a policy like it is for DynamicArray. The blocks are
+// allocated as words so a container can share its own policy with the
+// filter, and values are hashed using the hasher. Containers with their own
+// hash function add and query hash codes directly.
+//
+#ifndef NGE_CNTR_BLOOM_FILTER_H
+#define NGE_CNTR_BLOOM_FILTER_H
+
+#include <assert.h>
+#include <utility>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+#include "engine/intdef.h"
+#include "engine/memory/memory_utils.h"
+#include "engine/memory/static_allocator.h"
+#include "engine/utility/hash_utils.h"
+#include "engine/utility/hasher.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, template <typename> class A = mem::StaticAllocator>
+class BloomFilter : private A<uint32>
+{
+  public:
+    // CONSTANTS
+    /**
+     * The number of words in each block.
+     */
+    static constexpr uint32 WORDS_PER_BLOCK = 8;
+
+    // STRUCTURES
+    /**
+     * Defines a block of bits.
+     */
+    struct Block
+    {
+        uint32 words[WORDS_PER_BLOCK];
+    };
+
+  private:
+    // CONSTANTS
+    /**
+     * The number of bits that are reserved for each value.
+     */
+    static constexpr uint32 BITS_PER_VALUE = 12;
+
+    /**
+     * The number of bits in each block.
+     */
+    static constexpr uint32 BITS_PER_BLOCK = WORDS_PER_BLOCK * 32;
+
+    /**
+     * The value that is used to derive the second hash.
+     */
+    static constexpr uint32 SEED = 0x9e3779b9;
+
+    /**
+     * The number of extra words that are allocated so that the blocks can
+     * start on a cache line.
+     */
+    static constexpr uint32 PAD_WORDS =
+        mem::MemoryUtils::CACHE_LINE_SIZE / sizeof( uint32 ) - 1;
+
+    static_assert( mem::MemoryUtils::CACHE_LINE_SIZE % sizeof( Block ) == 0,
+                   "a block must not straddle two cache lines" );
+
+    /**
+     * The odd constants that each select a bit in one of the words.
+     */
+    static constexpr uint32 SALTS[WORDS_PER_BLOCK] = {
+        0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+        0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31
+    };
+
+    // MEMBERS
+    /**
+     * The words that were allocated for the blocks.
+     */
+    uint32* _words;
+
+    /**
+     * The blocks, which start on a cache line.
+     */
+    Block* _blocks;
+
+    /**
+     * The number of blocks.
+     *
+     * This is always zero or a power of two.
+     */
+    uint32 _blockCount;
+
+    /**
+     * The number of values that have been added.
+     */
+    uint32 _count;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the allocator policy.
+     */
+    A<uint32>& policy();
+
+    /**
+     * Allocates enough blocks for the given number of values.
+     */
+    void allocate( uint32 capacity );
+
+    /**
+     * Allocates the current number of blocks starting on a cache line.
+     */
+    void allocateBlocks();
+
+    /**
+     * Releases the blocks.
+     */
+    void release();
+
+    /**
+     * Gets the block for the given mixed hash code.
+     */
+    Block& getBlock( uint32 mixed ) const;
+
+    /**
+     * Computes the bit that is used in each word for the given mixed hash
+     * code.
+     */
+    static void makeMasks( uint32 mixed, uint32* masks );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new filter without any blocks.
+     *
+     * A filter without any blocks reports that every value may be contained.
+     */
+    BloomFilter();
+
+    /**
+     * Constructs a new filter sized for the given number of values.
+     */
+    BloomFilter( uint32 capacity );
+
+    /**
+     * Constructs a new filter without any blocks that uses the given
+     * allocator.
+     */
+    BloomFilter( const A<uint32>& allocator );
+
+    /**
+     * Constructs a new filter using the given allocator and sized for the
+     * given number of values.
+     */
+    BloomFilter( const A<uint32>& allocator, uint32 capacity );
+
+    /**
+     * Constructs a copy of the given filter.
+     */
+    BloomFilter( const BloomFilter<T, A>& filter );
+
+    /**
+     * Moves the filter to a new instance.
+     */
+    BloomFilter( BloomFilter<T, A>&& filter );
+
+    /**
+     * Destructs the filter.
+     */
+    ~BloomFilter();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given filter.
+     */
+    BloomFilter<T, A>& operator=( const BloomFilter<T, A>& filter );
+
+    /**
+     * Moves the filter data to this instance.
+     */
+    BloomFilter<T, A>& operator=( BloomFilter<T, A>&& filter );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds the value to the filter.
+     */
+    void add( const T& value );
+
+    /**
+     * Adds a value with the given hash code to the filter.
+     *
+     * This does nothing if the filter does not have any blocks.
+     */
+    void addHash( uint32 hashCode );
+
+    /**
+     * Checks if the value may have been added to the filter.
+     */
+    bool mayContain( const T& value ) const;
+
+    /**
+     * Checks if a value with the given hash code may have been added to the
+     * filter.
+     */
+    bool mayContainHash( uint32 hashCode ) const;
+
+    /**
+     * Clears the filter and resizes it for the given number of values.
+     */
+    void resize( uint32 capacity );
+
+    /**
+     * Clears all of the bits.
+     */
+    void clear();
+
+    /**
+     * Gets the number of values that have been added.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of blocks.
+     */
+    uint32 blockCount() const;
+
+    /**
+     * Checks if the filter has any blocks.
+     */
+    bool isEnabled() const;
+};
+
+// CONSTANTS
+template <typename T, template <typename> class A>
+constexpr uint32 BloomFilter<T, A>::WORDS_PER_BLOCK;
+
+template <typename T, template <typename> class A>
+constexpr uint32 BloomFilter<T, A>::BITS_PER_VALUE;
+
+template <typename T, template <typename> class A>
+constexpr uint32 BloomFilter<T, A>::BITS_PER_BLOCK;
+
+template <typename T, template <typename> class A>
+constexpr uint32 BloomFilter<T, A>::SEED;
+
+template <typename T, template <typename> class A>
+constexpr uint32 BloomFilter<T, A>::PAD_WORDS;
+
+template <typename T, template <typename> class A>
+constexpr uint32 BloomFilter<T, A>::SALTS[WORDS_PER_BLOCK];
+
+// CONSTRUCTORS
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::BloomFilter()
+    : A<uint32>(), _words( nullptr ), _blocks( nullptr ), _blockCount( 0 ),
+      _count( 0 )
+{
+}
+
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::BloomFilter( uint32 capacity )
+    : A<uint32>(), _words( nullptr ), _blocks( nullptr ), _blockCount( 0 ),
+      _count( 0 )
+{
+    allocate( capacity );
+}
+
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::BloomFilter( const A<uint32>& allocator )
+    : A<uint32>( allocator ), _words( nullptr ), _blocks( nullptr ),
+      _blockCount( 0 ), _count( 0 )
+{
+}
+
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::BloomFilter( const A<uint32>& allocator, uint32 capacity )
+    : A<uint32>( allocator ), _words( nullptr ), _blocks( nullptr ),
+      _blockCount( 0 ), _count( 0 )
+{
+    allocate( capacity );
+}
+
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::BloomFilter( const BloomFilter<T, A>& filter )
+    : A<uint32>( filter ), _words( nullptr ), _blocks( nullptr ),
+      _blockCount( filter._blockCount ), _count( filter._count )
+{
+    if ( _blockCount > 0 )
+    {
+        allocateBlocks();
+        mem::MemoryUtils::copy( _blocks, filter._blocks, _blockCount );
+    }
+}
+
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::BloomFilter( BloomFilter<T, A>&& filter )
+    : A<uint32>( filter ), _words( filter._words ), _blocks( filter._blocks ),
+      _blockCount( filter._blockCount ), _count( filter._count )
+{
+    filter._words = nullptr;
+    filter._blocks = nullptr;
+    filter._blockCount = 0;
+    filter._count = 0;
+}
+
+template <typename T, template <typename> class A>
+inline
+BloomFilter<T, A>::~BloomFilter()
+{
+    release();
+    _count = 0;
+}
+
+// OPERATORS
+template <typename T, template <typename> class A>
+BloomFilter<T, A>& BloomFilter<T, A>::operator=(
+    const BloomFilter<T, A>& filter )
+{
+    if ( this == &filter )
+    {
+        return *this;
+    }
+
+    release();
+
+    A<uint32>::operator=( filter );
+    _blockCount = filter._blockCount;
+    _count = filter._count;
+
+    if ( _blockCount > 0 )
+    {
+        allocateBlocks();
+        mem::MemoryUtils::copy( _blocks, filter._blocks, _blockCount );
+    }
+
+    return *this;
+}
+
+template <typename T, template <typename> class A>
+BloomFilter<T, A>& BloomFilter<T, A>::operator=( BloomFilter<T, A>&& filter )
+{
+    if ( this == &filter )
+    {
+        return *this;
+    }
+
+    release();
+
+    A<uint32>::operator=( filter );
+    _words = filter._words;
+    _blocks = filter._blocks;
+    _blockCount = filter._blockCount;
+    _count = filter._count;
+
+    filter._words = nullptr;
+    filter._blocks = nullptr;
+    filter._blockCount = 0;
+    filter._count = 0;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T, template <typename> class A>
+inline
+void BloomFilter<T, A>::add( const T& value )
+{
+    addHash( util::Hasher<T>::hash( value ) );
+}
+
+template <typename T, template <typename> class A>
+void BloomFilter<T, A>::addHash( uint32 hashCode )
+{
+    if ( _blockCount <= 0 )
+    {
+        return;
+    }
+
+    const uint32 mixed = util::HashUtils::mix( hashCode );
+    uint32 masks[WORDS_PER_BLOCK];
+    uint32 i;
+
+    makeMasks( mixed, masks );
+
+    Block& block = getBlock( mixed );
+    for ( i = 0; i < WORDS_PER_BLOCK; ++i )
+    {
+        block.words[i] |= masks[i];
+    }
+
+    ++_count;
+}
+
+template <typename T, template <typename> class A>
+inline
+bool BloomFilter<T, A>::mayContain( const T& value ) const
+{
+    return mayContainHash( util::Hasher<T>::hash( value ) );
+}
+
+template <typename T, template <typename> class A>
+inline
+bool BloomFilter<T, A>::mayContainHash( uint32 hashCode ) const
+{
+    if ( _blockCount <= 0 )
+    {
+        return true;
+    }
+
+    const uint32 mixed = util::HashUtils::mix( hashCode );
+    const Block& block = getBlock( mixed );
+
+#if defined( __AVX2__ )
+    const __m256i key = _mm256_set1_epi32(
+        static_cast<int32>( util::HashUtils::mix( mixed ^ SEED ) ) );
+    const __m256i salts =
+        _mm256_loadu_si256( reinterpret_cast<const __m256i*>( SALTS ) );
+    const __m256i shifts =
+        _mm256_srli_epi32( _mm256_mullo_epi32( key, salts ), 27 );
+    const __m256i masks =
+        _mm256_sllv_epi32( _mm256_set1_epi32( 1 ), shifts );
+    const __m256i words =
+        _mm256_loadu_si256( reinterpret_cast<const __m256i*>( block.words ) );
+
+    // set when every bit of the masks is also set in the words
+    return _mm256_testc_si256( words, masks ) != 0;
+#elif defined( __SSE2__ )
+    uint32 masks[WORDS_PER_BLOCK];
+    makeMasks( mixed, masks );
+
+    const __m128i* words = reinterpret_cast<const __m128i*>( block.words );
+    const __m128i* bits = reinterpret_cast<const __m128i*>( masks );
+    const __m128i low = _mm_loadu_si128( bits );
+    const __m128i high = _mm_loadu_si128( bits + 1 );
+
+    const __m128i lowHits =
+        _mm_cmpeq_epi32( _mm_and_si128( _mm_loadu_si128( words ), low ), low );
+    const __m128i highHits = _mm_cmpeq_epi32(
+        _mm_and_si128( _mm_loadu_si128( words + 1 ), high ), high );
+
+    return _mm_movemask_epi8( _mm_and_si128( lowHits, highHits ) ) == 0xffff;
+#else
+    uint32 masks[WORDS_PER_BLOCK];
+    uint32 i;
+
+    makeMasks( mixed, masks );
+
+    for ( i = 0; i < WORDS_PER_BLOCK; ++i )
+    {
+        if ( ( block.words[i] & masks[i] ) != masks[i] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+#endif
+}
+
+template <typename T, template <typename> class A>
+void BloomFilter<T, A>::resize( uint32 capacity )
+{
+    release();
+    allocate( capacity );
+}
+
+template <typename T, template <typename> class A>
+void BloomFilter<T, A>::clear()
+{
+    uint32 i;
+    for ( i = 0; i < _blockCount; ++i )
+    {
+        mem::MemoryUtils::set( _blocks[i].words, static_cast<uint32>( 0 ),
+                               WORDS_PER_BLOCK );
+    }
+
+    _count = 0;
+}
+
+template <typename T, template <typename> class A>
+inline
+uint32 BloomFilter<T, A>::size() const
+{
+    return _count;
+}
+
+template <typename T, template <typename> class A>
+inline
+uint32 BloomFilter<T, A>::blockCount() const
+{
+    return _blockCount;
+}
+
+template <typename T, template <typename> class A>
+inline
+bool BloomFilter<T, A>::isEnabled() const
+{
+    return _blockCount > 0;
+}
+
+// HELPER FUNCTIONS
+template <typename T, template <typename> class A>
+inline
+A<uint32>& BloomFilter<T, A>::policy()
+{
+    return *this;
+}
+
+template <typename T, template <typename> class A>
+void BloomFilter<T, A>::allocate( uint32 capacity )
+{
+    const uint32 bits = capacity * BITS_PER_VALUE;
+
+    _blockCount = 1;
+    while ( _blockCount * BITS_PER_BLOCK < bits )
+    {
+        _blockCount <<= 1;
+    }
+
+    allocateBlocks();
+    clear();
+}
+
+template <typename T, template <typename> class A>
+void BloomFilter<T, A>::allocateBlocks()
+{
+    uintptr_t address;
+
+    _words = policy().get( _blockCount * WORDS_PER_BLOCK + PAD_WORDS );
+
+    // skip the words in front of the first cache line boundary
+    address = reinterpret_cast<uintptr_t>( _words );
+    address = ( address + mem::MemoryUtils::CACHE_LINE_SIZE - 1 ) &
+              ~static_cast<uintptr_t>( mem::MemoryUtils::CACHE_LINE_SIZE - 1 );
+    _blocks = reinterpret_cast<Block*>( address );
+
+    assert( mem::MemoryUtils::isAligned( _blocks,
+                                         mem::MemoryUtils::CACHE_LINE_SIZE ) );
+}
+
+template <typename T, template <typename> class A>
+void BloomFilter<T, A>::release()
+{
+    if ( _words != nullptr )
+    {
+        policy().release( _words, _blockCount * WORDS_PER_BLOCK + PAD_WORDS );
+        _words = nullptr;
+        _blocks = nullptr;
+    }
+
+    _blockCount = 0;
+}
+
+template <typename T, template <typename> class A>
+inline
+typename BloomFilter<T, A>::Block& BloomFilter<T, A>::getBlock(
+    uint32 mixed ) const
+{
+    return _blocks[mixed & ( _blockCount - 1 )];
+}
+
+template <typename T, template <typename> class A>
+inline
+void BloomFilter<T, A>::makeMasks( uint32 mixed, uint32* masks )
+{
+    const uint32 key = util::HashUtils::mix( mixed ^ SEED );
+    uint32 i;
+
+    for ( i = 0; i < WORDS_PER_BLOCK; ++i )
+    {
+        masks[i] = static_cast<uint32>( 1 ) << ( ( key * SALTS[i] ) >> 27 );
+    }
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif // NGE_CNTR_BLOOM_FILTER_H
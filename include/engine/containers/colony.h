@@ -0,0 +1,1062 @@
+// colony.h
+//
+// The colony is an unordered container that stores its items in fixed-size
+// blocks. Items never move once they are inserted so pointers to them remain
+// valid until they are removed, and the blocks keep the items close together
+// in mem which makes iterating over all of them cache friendly.
+//
+// Removed slots are reused by later insertions. Each block has a skip field
+// that is used during iteration to jump over runs of removed slots in
+// constant time. The skip field is a jump-counting skip field: a value of
+// zero marks a slot in use, and the first and last slot of every run of free
+// slots store the length of the run. The values of the slots inside of a run
+// are unspecified but never zero.
+//
+// The start of each run of free slots is kept on a stack so that insertion is
+// O(1). Entries are validated lazily when popped so merging runs during
+// removal does not have to search the stack.
+//
+#ifndef NGE_CNTR_COLONY_H
+#define NGE_CNTR_COLONY_H
+
+#include <assert.h>
+#include <utility>
+
+#include "engine/containers/dynamic_array.h"
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/memory_utils.h"
+#include "engine/port.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T>
+class Colony
+{
+  private:
+    // STRUCTURES
+    /**
+     * Defines a block of items.
+     */
+    struct Block
+    {
+        /**
+         * The items.
+         */
+        T* values;
+
+        /**
+         * The skip field.
+         */
+        uint32* skip;
+
+        /**
+         * The number of slots that are in use.
+         */
+        uint32 count;
+    };
+
+    /**
+     * Defines the location of a slot.
+     */
+    struct Slot
+    {
+        uint32 block;
+        uint32 index;
+    };
+
+    // CLASSES
+    /**
+     * Defines an iterator for the colony.
+     */
+    template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+    class ColonyIterator
+    {
+        friend class Colony<T>;
+
+        // MEMBERS
+        /**
+         * The colony that is being iterated.
+         */
+        CPTR _iterColony;
+
+        /**
+         * The current block.
+         */
+        uint32 _iterBlock;
+
+        /**
+         * The current slot in the block.
+         */
+        uint32 _iterIndex;
+
+      public:
+        // CONSTRUCTORS
+        /**
+         * Constructs a new iterator.
+         */
+        ColonyIterator();
+
+        /**
+         * Constructs an iterator for a colony at the given slot.
+         */
+        ColonyIterator( CPTR colony, uint32 block, uint32 index );
+
+        /**
+         * Constructs a copy of the given iterator.
+         */
+        ColonyIterator( const ColonyIterator& iter );
+
+        /**
+         * Destructs the iterator.
+         */
+        ~ColonyIterator();
+
+        // OPERATORS
+        /**
+         * Assigns this as a copy of the other iterator.
+         */
+        ColonyIterator& operator=( const ColonyIterator& iter );
+
+        /**
+         * Moves to the next item.
+         */
+        ColonyIterator& operator++();
+
+        /**
+         * Moves to the next item.
+         */
+        ColonyIterator& operator++( int32 );
+
+        /**
+         * Moves to the previous item.
+         */
+        ColonyIterator& operator--();
+
+        /**
+         * Moves to the previous item.
+         */
+        ColonyIterator& operator--( int32 );
+
+        /**
+         * Gets the element at the current position.
+         */
+        CTREF operator*() const;
+
+        /**
+         * Gets the element at the current position.
+         */
+        TREF operator*();
+
+        /**
+         * Gets the element at the current position.
+         */
+        TPTR operator->() const;
+
+        /**
+         * Gets the element at the current position.
+         */
+        TPTR operator->();
+
+        /**
+         * Checks if the other iterator is at the same position.
+         */
+        bool operator==( const ColonyIterator& iter ) const;
+
+        /**
+         * Checks if the other iterator is not at the same position.
+         */
+        bool operator!=( const ColonyIterator& iter ) const;
+    };
+
+    // CONSTANTS
+    /**
+     * The default number of items in a block.
+     */
+    static constexpr uint32 DEFAULT_BLOCK_SIZE = 64;
+
+    // MEMBERS
+    /**
+     * The item allocator.
+     */
+    mem::AllocatorGuard<T> _valueAlloc;
+
+    /**
+     * The skip field allocator.
+     */
+    mem::AllocatorGuard<uint32> _skipAlloc;
+
+    /**
+     * The blocks.
+     */
+    DynamicArray<Block> _blocks;
+
+    /**
+     * The starts of the runs of free slots.
+     *
+     * This may contain stale entries which are discarded when popped.
+     */
+    DynamicArray<Slot> _freeRuns;
+
+    /**
+     * The number of items in each block.
+     */
+    uint32 _blockSize;
+
+    /**
+     * The number of items in the colony.
+     */
+    uint32 _size;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets a free slot, allocating a new block if necessary.
+     */
+    Slot acquire();
+
+    /**
+     * Marks the free slot as in use.
+     *
+     * Behavior is undefined when:
+     * the slot is not the start of a run of free slots
+     */
+    void occupy( const Slot& slot );
+
+    /**
+     * Marks the slot as free and merges it with the neighbouring runs.
+     */
+    void vacate( const Slot& slot );
+
+    /**
+     * Allocates a new block that is entirely free.
+     */
+    void addBlock();
+
+    /**
+     * Rebuilds the free run stack from the skip fields.
+     */
+    void rebuildFreeRuns();
+
+    /**
+     * Releases all of the blocks.
+     */
+    void releaseBlocks();
+
+    /**
+     * Copies the blocks of the given colony.
+     */
+    void copyBlocks( const Colony<T>& colony );
+
+    /**
+     * Checks if the slot is the start of a run of free slots.
+     */
+    bool isRunStart( const Slot& slot ) const;
+
+    /**
+     * Moves the position forward to the next slot in use if it is not
+     * already on one.
+     */
+    void advance( uint32& block, uint32& index ) const;
+
+    /**
+     * Moves the position backward to the previous slot in use.
+     */
+    void retreat( uint32& block, uint32& index ) const;
+
+    /**
+     * Finds the slot that holds the given pointer.
+     *
+     * Behavior is undefined when:
+     * the pointer is not held by the colony
+     */
+    Slot find( const T* pointer ) const;
+
+  public:
+    // TYPES
+    /**
+     * Defines an iterator for the colony.
+     */
+    typedef ColonyIterator<Colony<T>*, T&, const T&, T*> Iterator;
+
+    /**
+     * Defines a constant iterator for the colony.
+     */
+    typedef ColonyIterator<const Colony<T>*, const T&, const T&, const T*>
+        ConstIterator;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new colony.
+     */
+    Colony();
+
+    /**
+     * Constructs a new colony with the given number of items per block.
+     */
+    Colony( uint32 blockSize );
+
+    /**
+     * Constructs a new colony using the given allocators.
+     */
+    Colony( mem::IAllocator<T>* valueAlloc,
+            mem::IAllocator<uint32>* skipAlloc );
+
+    /**
+     * Constructs a new colony using the given allocators and number of items
+     * per block.
+     */
+    Colony( mem::IAllocator<T>* valueAlloc,
+            mem::IAllocator<uint32>* skipAlloc, uint32 blockSize );
+
+    /**
+     * Constructs a copy of the given colony.
+     *
+     * The items in the copy are located in the same slots as the original.
+     */
+    Colony( const Colony<T>& colony );
+
+    /**
+     * Moves the colony to a new instance.
+     *
+     * Pointers to the items remain valid.
+     */
+    Colony( Colony<T>&& colony );
+
+    /**
+     * Destructs the colony.
+     */
+    ~Colony();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given colony.
+     */
+    Colony<T>& operator=( const Colony<T>& colony );
+
+    /**
+     * Moves the colony data to this instance.
+     */
+    Colony<T>& operator=( Colony<T>&& colony );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds a copy of the value to the colony and gets its address.
+     */
+    T* insert( const T& value );
+
+    /**
+     * Moves the value into the colony and gets its address.
+     */
+    T* insert( T&& value );
+
+    /**
+     * Removes the item at the iterator position and gets an iterator to the
+     * next item.
+     *
+     * Behavior is undefined when:
+     * the iterator is not valid for this colony
+     */
+    Iterator remove( const Iterator& iter );
+
+    /**
+     * Removes the item with the given address.
+     *
+     * This is O(b) where b is the number of blocks.
+     *
+     * Behavior is undefined when:
+     * the pointer is not held by the colony
+     */
+    void remove( const T* pointer );
+
+    /**
+     * Removes all of the items and releases all of the blocks.
+     */
+    void clear();
+
+    /**
+     * Gets an iterator at the first item.
+     */
+    Iterator begin();
+
+    /**
+     * Gets a constant iterator at the first item.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator at the end of the colony.
+     */
+    Iterator end();
+
+    /**
+     * Gets a constant iterator at the end of the colony.
+     */
+    ConstIterator cend() const;
+
+    /**
+     * Gets the number of items in the colony.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of items the colony can hold without allocating.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the number of items in each block.
+     */
+    uint32 blockSize() const;
+
+    /**
+     * Checks if the colony is empty.
+     */
+    bool isEmpty() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 Colony<T>::DEFAULT_BLOCK_SIZE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+Colony<T>::Colony()
+    : _valueAlloc(), _skipAlloc(), _blocks(), _freeRuns(),
+      _blockSize( DEFAULT_BLOCK_SIZE ), _size( 0 )
+{
+}
+
+template <typename T>
+inline
+Colony<T>::Colony( uint32 blockSize )
+    : _valueAlloc(), _skipAlloc(), _blocks(), _freeRuns(),
+      _blockSize( blockSize ), _size( 0 )
+{
+    assert( _blockSize > 0 );
+}
+
+template <typename T>
+inline
+Colony<T>::Colony( mem::IAllocator<T>* valueAlloc,
+                   mem::IAllocator<uint32>* skipAlloc )
+    : _valueAlloc( valueAlloc ), _skipAlloc( skipAlloc ), _blocks(),
+      _freeRuns(), _blockSize( DEFAULT_BLOCK_SIZE ), _size( 0 )
+{
+}
+
+template <typename T>
+inline
+Colony<T>::Colony( mem::IAllocator<T>* valueAlloc,
+                   mem::IAllocator<uint32>* skipAlloc, uint32 blockSize )
+    : _valueAlloc( valueAlloc ), _skipAlloc( skipAlloc ), _blocks(),
+      _freeRuns(), _blockSize( blockSize ), _size( 0 )
+{
+    assert( _blockSize > 0 );
+}
+
+template <typename T>
+inline
+Colony<T>::Colony( const Colony<T>& colony )
+    : _valueAlloc( colony._valueAlloc ), _skipAlloc( colony._skipAlloc ),
+      _blocks(), _freeRuns( colony._freeRuns ),
+      _blockSize( colony._blockSize ), _size( colony._size )
+{
+    copyBlocks( colony );
+}
+
+template <typename T>
+inline
+Colony<T>::Colony( Colony<T>&& colony )
+    : _valueAlloc( colony._valueAlloc ), _skipAlloc( colony._skipAlloc ),
+      _blocks( std::move( colony._blocks ) ),
+      _freeRuns( std::move( colony._freeRuns ) ),
+      _blockSize( colony._blockSize ), _size( colony._size )
+{
+    colony._size = 0;
+}
+
+template <typename T>
+inline
+Colony<T>::~Colony()
+{
+    releaseBlocks();
+    _size = 0;
+}
+
+// OPERATORS
+template <typename T>
+Colony<T>& Colony<T>::operator=( const Colony<T>& colony )
+{
+    releaseBlocks();
+
+    _valueAlloc = colony._valueAlloc;
+    _skipAlloc = colony._skipAlloc;
+    _freeRuns = colony._freeRuns;
+    _blockSize = colony._blockSize;
+    _size = colony._size;
+
+    copyBlocks( colony );
+
+    return *this;
+}
+
+template <typename T>
+Colony<T>& Colony<T>::operator=( Colony<T>&& colony )
+{
+    releaseBlocks();
+
+    _valueAlloc = colony._valueAlloc;
+    _skipAlloc = colony._skipAlloc;
+    _blocks = std::move( colony._blocks );
+    _freeRuns = std::move( colony._freeRuns );
+    _blockSize = colony._blockSize;
+    _size = colony._size;
+
+    colony._size = 0;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* Colony<T>::insert( const T& value )
+{
+    const Slot slot = acquire();
+    occupy( slot );
+
+    T* pointer = &_blocks[slot.block].values[slot.index];
+    *pointer = value;
+    return pointer;
+}
+
+template <typename T>
+inline
+T* Colony<T>::insert( T&& value )
+{
+    const Slot slot = acquire();
+    occupy( slot );
+
+    T* pointer = &_blocks[slot.block].values[slot.index];
+    *pointer = std::move( value );
+    return pointer;
+}
+
+template <typename T>
+typename Colony<T>::Iterator Colony<T>::remove( const Iterator& iter )
+{
+    assert( iter._iterColony == this );
+
+    Slot slot;
+    slot.block = iter._iterBlock;
+    slot.index = iter._iterIndex;
+
+    // read the run after the slot before vacating merges it with the slot
+    const uint32 right = slot.index + 1 < _blockSize ?
+                         _blocks[slot.block].skip[slot.index + 1] : 0;
+    vacate( slot );
+
+    // the slot is now part of a run so start after the end of that run
+    Iterator next( this, slot.block, slot.index + right + 1 );
+    advance( next._iterBlock, next._iterIndex );
+    return next;
+}
+
+template <typename T>
+inline
+void Colony<T>::remove( const T* pointer )
+{
+    vacate( find( pointer ) );
+}
+
+template <typename T>
+inline
+void Colony<T>::clear()
+{
+    releaseBlocks();
+    _blocks.clear();
+    _freeRuns.clear();
+    _size = 0;
+}
+
+template <typename T>
+inline
+typename Colony<T>::Iterator Colony<T>::begin()
+{
+    Iterator iter( this, 0, 0 );
+    advance( iter._iterBlock, iter._iterIndex );
+    return iter;
+}
+
+template <typename T>
+inline
+typename Colony<T>::ConstIterator Colony<T>::cbegin() const
+{
+    ConstIterator iter( this, 0, 0 );
+    advance( iter._iterBlock, iter._iterIndex );
+    return iter;
+}
+
+template <typename T>
+inline
+typename Colony<T>::Iterator Colony<T>::end()
+{
+    return Iterator( this, _blocks.size(), 0 );
+}
+
+template <typename T>
+inline
+typename Colony<T>::ConstIterator Colony<T>::cend() const
+{
+    return ConstIterator( this, _blocks.size(), 0 );
+}
+
+template <typename T>
+inline
+uint32 Colony<T>::size() const
+{
+    return _size;
+}
+
+template <typename T>
+inline
+uint32 Colony<T>::capacity() const
+{
+    return _blocks.size() * _blockSize;
+}
+
+template <typename T>
+inline
+uint32 Colony<T>::blockSize() const
+{
+    return _blockSize;
+}
+
+template <typename T>
+inline
+bool Colony<T>::isEmpty() const
+{
+    return _size <= 0;
+}
+
+// HELPER FUNCTIONS
+template <typename T>
+typename Colony<T>::Slot Colony<T>::acquire()
+{
+    Slot slot;
+    while ( !_freeRuns.isEmpty() )
+    {
+        slot = _freeRuns.pop();
+        if ( isRunStart( slot ) )
+        {
+            return slot;
+        }
+    }
+
+    addBlock();
+    return _freeRuns.pop();
+}
+
+template <typename T>
+void Colony<T>::occupy( const Slot& slot )
+{
+    Block& block = _blocks[slot.block];
+    uint32* skip = block.skip;
+    const uint32 length = skip[slot.index];
+
+    assert( isRunStart( slot ) );
+
+    skip[slot.index] = 0;
+
+    // the rest of the run starts at the next slot
+    if ( length > 1 )
+    {
+        skip[slot.index + 1] = length - 1;
+        skip[slot.index + length - 1] = length - 1;
+
+        Slot next;
+        next.block = slot.block;
+        next.index = slot.index + 1;
+        _freeRuns.push( next );
+    }
+
+    ++block.count;
+    ++_size;
+}
+
+template <typename T>
+void Colony<T>::vacate( const Slot& slot )
+{
+    Block& block = _blocks[slot.block];
+    uint32* skip = block.skip;
+    const uint32 i = slot.index;
+
+    assert( skip[i] == 0 );
+
+    // release any resources held by the item
+    block.values[i] = T();
+
+    // the length of the runs that end just before and start just after
+    const uint32 left = i > 0 ? skip[i - 1] : 0;
+    const uint32 right = i + 1 < _blockSize ? skip[i + 1] : 0;
+
+    if ( left == 0 && right == 0 )
+    {
+        skip[i] = 1;
+        _freeRuns.push( slot );
+    }
+    else if ( right == 0 )
+    {
+        skip[i - left] = left + 1;
+        skip[i] = left + 1;
+    }
+    else if ( left == 0 )
+    {
+        skip[i] = right + 1;
+        skip[i + right] = right + 1;
+        _freeRuns.push( slot );
+    }
+    else
+    {
+        skip[i - left] = left + right + 1;
+        skip[i + right] = left + right + 1;
+        skip[i] = 1;
+    }
+
+    --block.count;
+    --_size;
+
+    // merged runs leave stale entries behind so rebuild before they pile up
+    if ( _freeRuns.size() > 2 * ( capacity() - _size ) + _blockSize )
+    {
+        rebuildFreeRuns();
+    }
+}
+
+template <typename T>
+void Colony<T>::addBlock()
+{
+    Block block;
+    block.values = _valueAlloc.get( _blockSize );
+    block.skip = _skipAlloc.get( _blockSize );
+    block.count = 0;
+
+    // the entire block is a single run of free slots
+    mem::MemoryUtils::set( block.skip, static_cast<uint32>( 1 ), _blockSize );
+    block.skip[0] = _blockSize;
+    block.skip[_blockSize - 1] = _blockSize;
+
+    Slot slot;
+    slot.block = _blocks.size();
+    slot.index = 0;
+
+    _blocks.push( block );
+    _freeRuns.push( slot );
+}
+
+template <typename T>
+void Colony<T>::rebuildFreeRuns()
+{
+    _freeRuns.clear();
+
+    Slot slot;
+    for ( slot.block = 0; slot.block < _blocks.size(); ++slot.block )
+    {
+        const uint32* skip = _blocks[slot.block].skip;
+        for ( slot.index = 0; slot.index < _blockSize; ++slot.index )
+        {
+            if ( skip[slot.index] != 0 )
+            {
+                _freeRuns.push( slot );
+                slot.index += skip[slot.index] - 1;
+            }
+        }
+    }
+}
+
+template <typename T>
+void Colony<T>::releaseBlocks()
+{
+    uint32 i;
+    for ( i = 0; i < _blocks.size(); ++i )
+    {
+        _valueAlloc.release( _blocks[i].values, _blockSize );
+        _skipAlloc.release( _blocks[i].skip, _blockSize );
+    }
+}
+
+template <typename T>
+void Colony<T>::copyBlocks( const Colony<T>& colony )
+{
+    _blocks.clear();
+
+    uint32 i;
+    Block block;
+    for ( i = 0; i < colony._blocks.size(); ++i )
+    {
+        const Block& other = colony._blocks[i];
+
+        block.values = _valueAlloc.get( _blockSize );
+        block.skip = _skipAlloc.get( _blockSize );
+        block.count = other.count;
+
+        mem::MemoryUtils::copy( block.values, other.values, _blockSize );
+        mem::MemoryUtils::copy( block.skip, other.skip, _blockSize );
+
+        _blocks.push( block );
+    }
+}
+
+template <typename T>
+inline
+bool Colony<T>::isRunStart( const Slot& slot ) const
+{
+    const uint32* skip = _blocks[slot.block].skip;
+    return skip[slot.index] != 0 &&
+           ( slot.index == 0 || skip[slot.index - 1] == 0 );
+}
+
+template <typename T>
+void Colony<T>::advance( uint32& block, uint32& index ) const
+{
+    while ( block < _blocks.size() )
+    {
+        if ( _blocks[block].count > 0 && index < _blockSize )
+        {
+            // this is zero for a slot in use so it only jumps over a run
+            index += _blocks[block].skip[index];
+            if ( index < _blockSize )
+            {
+                return;
+            }
+        }
+
+        ++block;
+        index = 0;
+    }
+
+    index = 0;
+}
+
+template <typename T>
+void Colony<T>::retreat( uint32& block, uint32& index ) const
+{
+    uint32 length;
+    while ( true )
+    {
+        if ( index == 0 )
+        {
+            assert( block > 0 );
+
+            --block;
+            index = _blockSize;
+
+            if ( _blocks[block].count <= 0 )
+            {
+                index = 0;
+                continue;
+            }
+        }
+
+        --index;
+
+        // the last slot of a run holds its length
+        length = _blocks[block].skip[index];
+        if ( length == 0 )
+        {
+            return;
+        }
+
+        if ( length > index )
+        {
+            index = 0;
+            continue;
+        }
+
+        index -= length;
+        return;
+    }
+}
+
+template <typename T>
+typename Colony<T>::Slot Colony<T>::find( const T* pointer ) const
+{
+    Slot slot;
+    for ( slot.block = 0; slot.block < _blocks.size(); ++slot.block )
+    {
+        const T* values = _blocks[slot.block].values;
+        if ( pointer >= values && pointer < values + _blockSize )
+        {
+            slot.index = static_cast<uint32>( pointer - values );
+            return slot;
+        }
+    }
+
+    assert( false );
+    return slot;
+}
+
+// ITERATOR CONSTRUCTORS
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::ColonyIterator()
+    : _iterColony( nullptr ), _iterBlock( 0 ), _iterIndex( 0 )
+{
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::ColonyIterator(
+    CPTR colony, uint32 block, uint32 index )
+    : _iterColony( colony ), _iterBlock( block ), _iterIndex( index )
+{
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::ColonyIterator(
+    const ColonyIterator& iter )
+    : _iterColony( iter._iterColony ), _iterBlock( iter._iterBlock ),
+      _iterIndex( iter._iterIndex )
+{
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::~ColonyIterator()
+{
+    _iterColony = nullptr;
+    _iterBlock = static_cast<uint32>( -1 );
+    _iterIndex = static_cast<uint32>( -1 );
+}
+
+// ITERATOR OPERATORS
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>&
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator=(
+    const ColonyIterator& iter )
+{
+    _iterColony = iter._iterColony;
+    _iterBlock = iter._iterBlock;
+    _iterIndex = iter._iterIndex;
+
+    return *this;
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>&
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator++()
+{
+    ++_iterIndex;
+    _iterColony->advance( _iterBlock, _iterIndex );
+
+    return *this;
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>&
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator++( int32 )
+{
+    ++_iterIndex;
+    _iterColony->advance( _iterBlock, _iterIndex );
+
+    return *this;
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>&
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator--()
+{
+    _iterColony->retreat( _iterBlock, _iterIndex );
+
+    return *this;
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>&
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator--( int32 )
+{
+    _iterColony->retreat( _iterBlock, _iterIndex );
+
+    return *this;
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+CTREF
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator*() const
+{
+    return _iterColony->_blocks[_iterBlock].values[_iterIndex];
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+TREF Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator*()
+{
+    return _iterColony->_blocks[_iterBlock].values[_iterIndex];
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+TPTR
+Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator->() const
+{
+    return &_iterColony->_blocks[_iterBlock].values[_iterIndex];
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+TPTR Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator->()
+{
+    return &_iterColony->_blocks[_iterBlock].values[_iterIndex];
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+bool Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator==(
+    const ColonyIterator& iter ) const
+{
+    return _iterColony == iter._iterColony &&
+           _iterBlock == iter._iterBlock && _iterIndex == iter._iterIndex;
+}
+
+template <typename T>
+template <typename CPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+bool Colony<T>::ColonyIterator<CPTR, TREF, CTREF, TPTR>::operator!=(
+    const ColonyIterator& iter ) const
+{
+    return _iterColony != iter._iterColony ||
+           _iterBlock != iter._iterBlock || _iterIndex != iter._iterIndex;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif // NGE_CNTR_COLONY_H
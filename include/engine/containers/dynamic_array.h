@@ -7,6 +7,10 @@
 // may actually mean the 5th position in the mem block and the last item
 // may actually be in the 4th position in mem.
 //
+// The allocator is a policy so that the common case of the static allocator
+// adds no space and no virtual calls to the array. Arrays that use an
+// allocator chosen at runtime take the allocator guard as their policy.
+//
 #ifndef NGE_CNTR_DYNAMIC_ARRAY_H
 #define NGE_CNTR_DYNAMIC_ARRAY_H
 
@@ -18,6 +22,7 @@
 #include "engine/memory/allocator_guard.h"
 #include "engine/memory/iallocator.h"
 #include "engine/memory/memory_utils.h"
+#include "engine/memory/static_allocator.h"
 #include "engine/port.h"
 
 namespace nge
@@ -26,8 +31,8 @@ namespace nge
 namespace cntr
 {
 
-template <typename T>
-class DynamicArray
+template <typename T, template <typename> class A = mem::StaticAllocator>
+class DynamicArray : private A<T>
 {
   private:
     // CLASSES
@@ -134,11 +139,6 @@ class DynamicArray
     static constexpr uint32 MIN_CAPACITY = 32;
 
     // MEMBERS
-    /**
-     * The allocator.
-     */
-    mem::AllocatorGuard<T> _allocator;
-
     /**
      * The array of values.
      */
@@ -160,8 +160,16 @@ class DynamicArray
     uint32 _capacity;
 
     // HELPER FUNCTIONS
+    /**
+     * Gets the allocator policy.
+     */
+    A<T>& policy();
+
     /**
      * Doubles the capacity of the array.
+     *
+     * The array grows in place when the allocator supports it and is
+     * resized otherwise.
      */
     void grow();
 
@@ -207,13 +215,13 @@ class DynamicArray
     /**
      * Defines an iterator for the array.
      */
-    typedef ArrayIterator<DynamicArray<T>*, T&, const T&, T*> Iterator;
+    typedef ArrayIterator<DynamicArray<T, A>*, T&, const T&, T*> Iterator;
 
     /**
      * Defines a constant iterator for the array.
      */
-    typedef ArrayIterator<const DynamicArray<T>*, const T&, const T&, const T*>
-        ConstIterator;
+    typedef ArrayIterator<const DynamicArray<T, A>*, const T&, const T&,
+                          const T*> ConstIterator;
 
     // CONSTRUCTORS
     /**
@@ -224,7 +232,7 @@ class DynamicArray
     /**
      * Constructs a new DynamicArray using the given allocator.
      */
-    DynamicArray( mem::IAllocator<T>* allocator );
+    DynamicArray( const A<T>& allocator );
 
     /**
      * Constructs a new DynamicArray using the given initial capacity.
@@ -239,17 +247,17 @@ class DynamicArray
      * Constructs a new DynamicArray using the given allocator and initial
      * capacity.
      */
-    DynamicArray( mem::IAllocator<T>* allocator, uint32 capacity );
+    DynamicArray( const A<T>& allocator, uint32 capacity );
 
     /**
      * Constructs a copy of the given array.
      */
-    DynamicArray( const DynamicArray<T>& array );
+    DynamicArray( const DynamicArray<T, A>& array );
 
     /**
      * Moves the array data to a new instance.
      */
-    DynamicArray( DynamicArray<T>&& array );
+    DynamicArray( DynamicArray<T, A>&& array );
 
     /**
      * Destructs the array.
@@ -260,14 +268,14 @@ class DynamicArray
     /**
      * Makes this array a copy of another.
      */
-    DynamicArray<T>& operator=( const DynamicArray<T>& array );
+    DynamicArray<T, A>& operator=( const DynamicArray<T, A>& array );
 
     /**
      * Moves the data from the other array to this one.
      *
      * Deletes this array in the process.
      */
-    DynamicArray<T>& operator=( DynamicArray<T>&& array );
+    DynamicArray<T, A>& operator=( DynamicArray<T, A>&& array );
 
     /**
      * Gets the value at the given index.
@@ -383,6 +391,16 @@ class DynamicArray
      */
     bool has( const T& value ) const;
 
+    /**
+     * Gets the number of items from the index that are next to each other
+     * in memory, which ends at the last item or where the array wraps
+     * around.
+     *
+     * Behavior is undefined when:
+     * - index is out of bounds
+     */
+    uint32 contiguousSize( uint32 index ) const;
+
     /**
      * Gets the size of the array.
      */
@@ -395,32 +413,32 @@ class DynamicArray
 };
 
 // CONSTANTS
-template <typename T>
-constexpr uint32 DynamicArray<T>::MIN_CAPACITY;
+template <typename T, template <typename> class A>
+constexpr uint32 DynamicArray<T, A>::MIN_CAPACITY;
 
 // CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-DynamicArray<T>::DynamicArray()
-    : _allocator(), _values( nullptr ), _first( 0 ), _size( 0 ),
+DynamicArray<T, A>::DynamicArray()
+    : A<T>(), _values( nullptr ), _first( 0 ), _size( 0 ),
       _capacity( MIN_CAPACITY )
 {
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-DynamicArray<T>::DynamicArray( mem::IAllocator<T>* allocator )
-    : _allocator( allocator ), _values( nullptr ), _first( 0 ),
+DynamicArray<T, A>::DynamicArray( const A<T>& allocator )
+    : A<T>( allocator ), _values( nullptr ), _first( 0 ),
       _size( 0 ), _capacity( MIN_CAPACITY )
 {
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-DynamicArray<T>::DynamicArray( uint32 capacity )
-    : _allocator(), _values( nullptr ), _first( 0 ), _size( 0 ),
+DynamicArray<T, A>::DynamicArray( uint32 capacity )
+    : A<T>(), _values( nullptr ), _first( 0 ), _size( 0 ),
       _capacity( MIN_CAPACITY )
 {
     while ( _capacity < capacity )
@@ -428,13 +446,13 @@ DynamicArray<T>::DynamicArray( uint32 capacity )
         _capacity <<= 1;
     }
 
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-DynamicArray<T>::DynamicArray( mem::IAllocator<T>* allocator, uint32 capacity )
-    : _allocator( allocator ), _values( nullptr ), _first( 0 ),
+DynamicArray<T, A>::DynamicArray( const A<T>& allocator, uint32 capacity )
+    : A<T>( allocator ), _values( nullptr ), _first( 0 ),
       _size( 0 ), _capacity( MIN_CAPACITY )
 {
     while ( _capacity < capacity )
@@ -442,86 +460,83 @@ DynamicArray<T>::DynamicArray( mem::IAllocator<T>* allocator, uint32 capacity )
         _capacity <<= 1;
     }
 
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
 }
 
-template <typename T>
-DynamicArray<T>::DynamicArray( const DynamicArray<T>& array )
-    : _allocator( array._allocator ), _values( nullptr ),
+template <typename T, template <typename> class A>
+DynamicArray<T, A>::DynamicArray( const DynamicArray<T, A>& array )
+    : A<T>( array ), _values( nullptr ),
       _first( array._first ), _size( array._size ),
       _capacity( array._capacity )
 {
     using namespace mem;
 
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
     MemoryUtils::copy( _values, array._values, _capacity );
 }
 
-template <typename T>
-DynamicArray<T>::DynamicArray( DynamicArray<T>&& array )
-    : _allocator( array._allocator ), _values( array._values ),
+template <typename T, template <typename> class A>
+DynamicArray<T, A>::DynamicArray( DynamicArray<T, A>&& array )
+    : A<T>( array ), _values( array._values ),
       _first( array._first ), _size( array._size ),
       _capacity( array._capacity )
 {
-    array._allocator = nullptr;
     array._values = nullptr;
     array._first = 0;
     array._size = 0;
     array._capacity = 0;
 }
 
-template <typename T>
-DynamicArray<T>::~DynamicArray()
+template <typename T, template <typename> class A>
+DynamicArray<T, A>::~DynamicArray()
 {
     if ( _values != nullptr )
     {
-        _allocator.release( _values, _capacity );
+        policy().release( _values, _capacity );
         _values = nullptr;
     }
-
-    _allocator = nullptr;
 }
 
 // OPERATORS
-template <typename T>
-DynamicArray<T>& DynamicArray<T>::operator=(
-    const cntr::DynamicArray<T>& array )
+template <typename T, template <typename> class A>
+DynamicArray<T, A>& DynamicArray<T, A>::operator=(
+    const cntr::DynamicArray<T, A>& array )
 {
     using namespace mem;
 
     if ( _values != nullptr )
     {
-        _allocator.release( _values, _capacity );
+        policy().release( _values, _capacity );
         _values = nullptr;
     }
 
-    _allocator = array._allocator;
+    A<T>::operator=( array );
     _first = array._first;
     _size = array._size;
     _capacity = array._capacity;
 
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
     MemoryUtils::copy( _values, array._values, _capacity );
 
     return *this;
 }
 
-template <typename T>
-DynamicArray<T>& DynamicArray<T>::operator=( cntr::DynamicArray<T>&& array )
+template <typename T, template <typename> class A>
+DynamicArray<T, A>& DynamicArray<T, A>::operator=(
+    cntr::DynamicArray<T, A>&& array )
 {
     if ( _values != nullptr )
     {
-        _allocator.release( _values, _capacity );
+        policy().release( _values, _capacity );
         _values = nullptr;
     }
 
-    _allocator = array._allocator;
+    A<T>::operator=( array );
     _values = array._values;
     _first = array._first;
     _size = array._size;
     _capacity = array._capacity;
 
-    array._allocator = nullptr;
     array._values = nullptr;
     array._first = 0;
     array._size = 0;
@@ -530,26 +545,26 @@ DynamicArray<T>& DynamicArray<T>::operator=( cntr::DynamicArray<T>&& array )
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-const T& DynamicArray<T>::operator[]( uint32 index ) const
+const T& DynamicArray<T, A>::operator[]( uint32 index ) const
 {
     assert( index < _size );
     return _values[wrap( index )];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T& DynamicArray<T>::operator[]( uint32 index )
+T& DynamicArray<T, A>::operator[]( uint32 index )
 {
     assert( index < _size );
     return _values[wrap( index )];
 }
 
 // MEMBER FUNCTIONS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T& DynamicArray<T>::at( uint32 index ) const
+T& DynamicArray<T, A>::at( uint32 index ) const
 {
     if ( index >= _size )
     {
@@ -559,9 +574,9 @@ T& DynamicArray<T>::at( uint32 index ) const
     return _values[wrap( index )];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::push( const T& value )
+void DynamicArray<T, A>::push( const T& value )
 {
     if ( shouldGrow() )
     {
@@ -572,9 +587,9 @@ void DynamicArray<T>::push( const T& value )
     ( *this )[_size - 1] = value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::push( T&& value )
+void DynamicArray<T, A>::push( T&& value )
 {
     if ( shouldGrow() )
     {
@@ -585,9 +600,9 @@ void DynamicArray<T>::push( T&& value )
     ( *this )[_size - 1] = std::move( value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::pushFront( const T& value )
+void DynamicArray<T, A>::pushFront( const T& value )
 {
     if ( shouldGrow() )
     {
@@ -599,8 +614,8 @@ void DynamicArray<T>::pushFront( const T& value )
     ( *this )[0] = value;
 }
 
-template <typename T>
-void DynamicArray<T>::pushFront( T&& value )
+template <typename T, template <typename> class A>
+void DynamicArray<T, A>::pushFront( T&& value )
 {
     if ( shouldGrow() )
     {
@@ -612,8 +627,8 @@ void DynamicArray<T>::pushFront( T&& value )
     ( *this )[0] = std::move( value );
 }
 
-template <typename T>
-void DynamicArray<T>::insertAt( uint32 index, const T& value )
+template <typename T, template <typename> class A>
+void DynamicArray<T, A>::insertAt( uint32 index, const T& value )
 {
     if ( index > _size )
     {
@@ -630,8 +645,8 @@ void DynamicArray<T>::insertAt( uint32 index, const T& value )
     ( *this )[index] = value;
 }
 
-template <typename T>
-void DynamicArray<T>::insertAt( uint32 index, T&& value )
+template <typename T, template <typename> class A>
+void DynamicArray<T, A>::insertAt( uint32 index, T&& value )
 {
     if ( index > _size )
     {
@@ -648,8 +663,8 @@ void DynamicArray<T>::insertAt( uint32 index, T&& value )
     ( *this )[index] = std::move( value );
 }
 
-template <typename T>
-T DynamicArray<T>::pop()
+template <typename T, template <typename> class A>
+T DynamicArray<T, A>::pop()
 {
     assert( _size > 0 );
 
@@ -663,8 +678,8 @@ T DynamicArray<T>::pop()
     return elem;
 }
 
-template <typename T>
-T DynamicArray<T>::popFront()
+template <typename T, template <typename> class A>
+T DynamicArray<T, A>::popFront()
 {
     assert( _size > 0 );
 
@@ -679,8 +694,8 @@ T DynamicArray<T>::popFront()
     return elem;
 }
 
-template <typename T>
-T DynamicArray<T>::removeAt( uint32 index )
+template <typename T, template <typename> class A>
+T DynamicArray<T, A>::removeAt( uint32 index )
 {
     assert( _size > 0 );
 
@@ -701,9 +716,9 @@ T DynamicArray<T>::removeAt( uint32 index )
     return elem;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool DynamicArray<T>::remove( const T& value )
+bool DynamicArray<T, A>::remove( const T& value )
 {
     uint32 index = indexOf( value );
     if ( index == static_cast<uint32>( -1 ) )
@@ -715,39 +730,39 @@ bool DynamicArray<T>::remove( const T& value )
     return true;
 }
 
-template <typename T>
-void DynamicArray<T>::clear()
+template <typename T, template <typename> class A>
+void DynamicArray<T, A>::clear()
 {
     _size = 0;
     _first = 0;
 }
 
-template <typename T>
-typename DynamicArray<T>::Iterator DynamicArray<T>::begin()
+template <typename T, template <typename> class A>
+typename DynamicArray<T, A>::Iterator DynamicArray<T, A>::begin()
 {
     return Iterator( this, 0 );
 }
 
-template <typename T>
-typename DynamicArray<T>::ConstIterator DynamicArray<T>::cbegin() const
+template <typename T, template <typename> class A>
+typename DynamicArray<T, A>::ConstIterator DynamicArray<T, A>::cbegin() const
 {
     return ConstIterator( this, 0 );
 }
 
-template <typename T>
-typename DynamicArray<T>::Iterator DynamicArray<T>::end()
+template <typename T, template <typename> class A>
+typename DynamicArray<T, A>::Iterator DynamicArray<T, A>::end()
 {
     return Iterator( this, _size );
 }
 
-template <typename T>
-typename DynamicArray<T>::ConstIterator DynamicArray<T>::cend() const
+template <typename T, template <typename> class A>
+typename DynamicArray<T, A>::ConstIterator DynamicArray<T, A>::cend() const
 {
     return ConstIterator( this, _size );
 }
 
-template <typename T>
-uint32 DynamicArray<T>::indexOf( const T& value ) const
+template <typename T, template <typename> class A>
+uint32 DynamicArray<T, A>::indexOf( const T& value ) const
  {
     uint32 i;
     bool found;
@@ -762,8 +777,8 @@ uint32 DynamicArray<T>::indexOf( const T& value ) const
     return found ? --i : static_cast<uint32>( -1 );
 }
 
-template <typename T>
-bool DynamicArray<T>::has( const T& value ) const
+template <typename T, template <typename> class A>
+bool DynamicArray<T, A>::has( const T& value ) const
 {
     uint32 i;
     bool found;
@@ -778,39 +793,67 @@ bool DynamicArray<T>::has( const T& value ) const
     return found;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
+inline
+uint32 DynamicArray<T, A>::contiguousSize( uint32 index ) const
+{
+    assert( index < _size );
+    return std::min( _size - index, _capacity - wrap( index ) );
+}
+
+template <typename T, template <typename> class A>
 inline
-uint32 DynamicArray<T>::size() const
+uint32 DynamicArray<T, A>::size() const
 {
     return _size;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool DynamicArray<T>::isEmpty() const
+bool DynamicArray<T, A>::isEmpty() const
 {
     return _size <= 0;
 }
 
 // HELPER FUNCTIONS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::grow()
+A<T>& DynamicArray<T, A>::policy()
 {
-    resize(_capacity << 1);
+    return *this;
+}
 
+template <typename T, template <typename> class A>
+inline
+void DynamicArray<T, A>::grow()
+{
+    uint32 oldCapacity = _capacity;
+    uint32 i;
 
+    if ( !policy().grow( _values, _capacity, _capacity << 1 ) )
+    {
+        resize( _capacity << 1 );
+        return;
+    }
+
+    // the array is full so only the items that wrapped around to the front
+    // have to move to keep their order
+    _capacity <<= 1;
+    for ( i = 0; i < _first; ++i )
+    {
+        _values[oldCapacity + i] = std::move( _values[i] );
+    }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::shrink()
+void DynamicArray<T, A>::shrink()
 {
     resize(_capacity >> 1);
 }
 
-template <typename T>
-void DynamicArray<T>::resize( uint32 newCapacity )
+template <typename T, template <typename> class A>
+void DynamicArray<T, A>::resize( uint32 newCapacity )
 {
     assert( _values != nullptr );
     uint32 oldCapacity = _capacity;
@@ -818,7 +861,7 @@ void DynamicArray<T>::resize( uint32 newCapacity )
     T* oldValues = _values;
 
     _capacity = newCapacity;
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
     _first = 0;
 
     uint32 i;
@@ -827,12 +870,12 @@ void DynamicArray<T>::resize( uint32 newCapacity )
         _values[i] = std::move( oldValues[( oldFirst + i ) % oldCapacity] );
     }
 
-    _allocator.release( oldValues, oldCapacity );
+    policy().release( oldValues, oldCapacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::shiftForward( uint32 start )
+void DynamicArray<T, A>::shiftForward( uint32 start )
 {
     assert( start >= 0 && start <= _size );
     uint32 i;
@@ -842,9 +885,9 @@ void DynamicArray<T>::shiftForward( uint32 start )
     }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void DynamicArray<T>::shiftBackward( uint32 start )
+void DynamicArray<T, A>::shiftBackward( uint32 start )
 {
     assert( start >= 0 && start < _size );
     uint32 i;
@@ -854,68 +897,68 @@ void DynamicArray<T>::shiftBackward( uint32 start )
     }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 DynamicArray<T>::wrap( uint32 index ) const
+uint32 DynamicArray<T, A>::wrap( uint32 index ) const
 {
     return ( _first + index ) & ( _capacity - 1 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool DynamicArray<T>::shouldGrow() const
+bool DynamicArray<T, A>::shouldGrow() const
 {
     return _size >= _capacity;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool DynamicArray<T>::shouldShrink() const
+bool DynamicArray<T, A>::shouldShrink() const
 {
     return _size <= ( _capacity >> 2 ) && _capacity > MIN_CAPACITY;
 }
 
 // ITERATOR CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator()
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator()
     : _iterArray( nullptr ), _iterIndex( 0 )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
     APTR array, uint32 index ) : _iterArray( array ), _iterIndex( index )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
     const ArrayIterator& iter )
     : _iterArray( iter._iterArray ), _iterIndex( iter._iterIndex )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::~ArrayIterator()
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::~ArrayIterator()
 {
     _iterArray = nullptr;
     _iterIndex = static_cast<uint32>( -1 );
 }
 
 // ITERATOR OPERATORS
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator=(
+vc_typename DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator=(
     const ArrayIterator& iter )
 {
     _iterArray = iter._iterArray;
@@ -924,98 +967,98 @@ DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator=(
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++()
+vc_typename DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++()
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++( int32 )
+vc_typename DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++( int32 )
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--()
+vc_typename DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--()
 {
     _iterIndex = ( _iterIndex > 0 ) ? _iterIndex - 1 : _iterArray->_size;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--( int32 )
+vc_typename DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--( int32 )
 {
     _iterIndex = ( _iterIndex > 0 ) ? _iterIndex - 1 : _iterArray->_size;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
 CTREF
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*() const
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*() const
 {
     return ( *_iterArray )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TREF DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*()
+TREF DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*()
 {
     return ( *_iterArray )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
 TPTR
-DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->() const
+DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->() const
 {
     return &( *_iterArray )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TPTR DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->()
+TPTR DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->()
 {
     return &( *_iterArray )[_iterIndex];
 }
 
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-bool DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator==(
+bool DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator==(
     const ArrayIterator& iter ) const
 {
     return _iterArray == iter._iterArray && _iterIndex == iter._iterIndex;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-bool DynamicArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator!=(
+bool DynamicArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator!=(
     const ArrayIterator& iter ) const
 {
     return _iterArray != iter._iterArray || _iterIndex != iter._iterIndex;
@@ -8,6 +8,10 @@
 // in that it guarantees that items are contiguous in mem and
 // start at the beginning of the array.
 //
+// Like DynamicArray the allocator is a policy. The static allocator adds
+// nothing to the array while the allocator guard supports allocators that
+// are chosen at runtime.
+//
 #ifndef NGE_CNTR_FIXED_ARRAY_H
 #define NGE_CNTR_FIXED_ARRAY_H
 
@@ -17,6 +21,7 @@
 #include "engine/intdef.h"
 #include "engine/memory/allocator_guard.h"
 #include "engine/memory/memory_utils.h"
+#include "engine/memory/static_allocator.h"
 
 namespace nge
 {
@@ -24,8 +29,8 @@ namespace nge
 namespace cntr
 {
 
-template <typename T>
-class FixedArray
+template <typename T, template <typename> class A = mem::StaticAllocator>
+class FixedArray : private A<T>
 {
   private:
     // CLASSES
@@ -132,11 +137,6 @@ class FixedArray
     static constexpr uint32 DEFAULT_CAPACITY = 32;
 
     // MEMBERS
-    /**
-     * The allocator.
-     */
-    mem::AllocatorGuard<T> _allocator;
-
     /**
      * The underlying array.
      */
@@ -160,6 +160,11 @@ class FixedArray
     bool _isDataExternal;
 
     // HELPER FUNCTIONS
+    /**
+     * Gets the allocator policy.
+     */
+    A<T>& policy();
+
     /**
      * Shifts the given number of items forward one spot starting at the
      * given index
@@ -183,12 +188,12 @@ class FixedArray
     /**
      * Defines an iterator for the array.
      */
-    typedef ArrayIterator<FixedArray<T>*, T&, const T&, T*> Iterator;
+    typedef ArrayIterator<FixedArray<T, A>*, T&, const T&, T*> Iterator;
 
     /**
      * Defines a constant iterator for the array.
      */
-    typedef ArrayIterator<const FixedArray<T>*, const T&, const T&, const T*>
+    typedef ArrayIterator<const FixedArray<T, A>*, const T&, const T&, const T*>
         ConstIterator;
 
     // GLOBAL METHODS
@@ -205,7 +210,7 @@ class FixedArray
      * If it is moved to a new instance the new instance will reference the
      * wrapped data.
      */
-    static FixedArray<T> wrap( T* data, uint32 size );
+    static FixedArray<T, A> wrap( T* data, uint32 size );
 
     /**
      * Wraps a pre-allocated array.
@@ -220,7 +225,7 @@ class FixedArray
      * If it is moved to a new instance the new instance will reference the
      * wrapped data.
      */
-    static FixedArray<T> wrap( T* data, uint32 size, uint32 capacity );
+    static FixedArray<T, A> wrap( T* data, uint32 size, uint32 capacity );
 
     // CONSTRUCTORS
     /**
@@ -237,22 +242,22 @@ class FixedArray
      * Constructs a new array with a capacity of 32 created using the
      * given allocator.
      */
-    FixedArray( mem::IAllocator<T>* allocator );
+    FixedArray( const A<T>& allocator );
 
     /**
      * Constructs a new array using the given allocator and capacity.
      */
-    FixedArray( mem::IAllocator<T>* allocator, uint32 capacity );
+    FixedArray( const A<T>& allocator, uint32 capacity );
 
     /**
      * Constructs a copy of the given array.
      */
-    FixedArray( const FixedArray<T>& array );
+    FixedArray( const FixedArray<T, A>& array );
 
     /**
      * Constructs an array by moving the resources to a new instance.
      */
-    FixedArray( FixedArray<T>&& array );
+    FixedArray( FixedArray<T, A>&& array );
 
     /**
      * Destructs the fixed array.
@@ -263,12 +268,12 @@ class FixedArray
     /**
      * Assigns this as a copy of the other array.
      */
-    FixedArray<T>& operator=( const FixedArray<T>& array );
+    FixedArray<T, A>& operator=( const FixedArray<T, A>& array );
 
     /**
      * Moves the array to this instance.
      */
-    FixedArray<T>& operator=( FixedArray<T>&& array );
+    FixedArray<T, A>& operator=( FixedArray<T, A>&& array );
 
     /**
      * Gets the value at the given index.
@@ -451,76 +456,76 @@ class FixedArray
 };
 
 // CONSTANTS
-template <typename T>
-constexpr uint32 FixedArray<T>::DEFAULT_CAPACITY;
+template <typename T, template <typename> class A>
+constexpr uint32 FixedArray<T, A>::DEFAULT_CAPACITY;
 
 // GLOBAL METHODS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T> FixedArray<T>::wrap( T* data, uint32 size )
+FixedArray<T, A> FixedArray<T, A>::wrap( T* data, uint32 size )
 {
-    return FixedArray<T>::wrap( data, size, size );
+    return FixedArray<T, A>::wrap( data, size, size );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T> FixedArray<T>::wrap( T* data, uint32 size, uint32 capacity )
+FixedArray<T, A> FixedArray<T, A>::wrap( T* data, uint32 size, uint32 capacity )
 {
-    return FixedArray<T>( data, size, capacity );
+    return FixedArray<T, A>( data, size, capacity );
 }
 
 // CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray() : FixedArray( nullptr, DEFAULT_CAPACITY )
+FixedArray<T, A>::FixedArray() : FixedArray( A<T>(), DEFAULT_CAPACITY )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray( uint32 capacity ) : FixedArray( nullptr, capacity )
+FixedArray<T, A>::FixedArray( uint32 capacity ) : FixedArray( A<T>(), capacity )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray( mem::IAllocator<T>* allocator )
+FixedArray<T, A>::FixedArray( const A<T>& allocator )
     : FixedArray( allocator, DEFAULT_CAPACITY )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray( mem::IAllocator<T>* allocator, uint32 capacity )
-    : _allocator( allocator ), _values( nullptr ), _size( 0 ),
+FixedArray<T, A>::FixedArray( const A<T>& allocator, uint32 capacity )
+    : A<T>( allocator ), _values( nullptr ), _size( 0 ),
       _capacity( capacity ), _isDataExternal( false )
 {
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray( T* data, uint32 size, uint32 capacity )
-    : _allocator( nullptr ), _values( data ), _size( size ),
+FixedArray<T, A>::FixedArray( T* data, uint32 size, uint32 capacity )
+    : A<T>(), _values( data ), _size( size ),
       _capacity( capacity ), _isDataExternal( true )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray( const FixedArray<T>& array )
-    : _allocator( array._allocator ), _values( nullptr ),
+FixedArray<T, A>::FixedArray( const FixedArray<T, A>& array )
+    : A<T>( array ), _values( nullptr ),
       _size( array._size ), _capacity( array._capacity ),
       _isDataExternal( false )
 {
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
     mem::MemoryUtils::copy( _values, array._values, _size );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::FixedArray( FixedArray<T>&& array )
-    : _allocator( array._allocator ), _values( array._values ),
+FixedArray<T, A>::FixedArray( FixedArray<T, A>&& array )
+    : A<T>( array ), _values( array._values ),
       _size( array._size ), _capacity( array._capacity ),
       _isDataExternal( array._isDataExternal )
 
@@ -531,49 +536,49 @@ FixedArray<T>::FixedArray( FixedArray<T>&& array )
     array._isDataExternal = false;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-FixedArray<T>::~FixedArray()
+FixedArray<T, A>::~FixedArray()
 {
     if ( !_isDataExternal && _values != nullptr )
     {
-        _allocator.release( _values, _capacity );
+        policy().release( _values, _capacity );
     }
 
     _values = nullptr;
 }
 
 // OPERATORS
-template <typename T>
-FixedArray<T>& FixedArray<T>::operator=( const FixedArray& array )
+template <typename T, template <typename> class A>
+FixedArray<T, A>& FixedArray<T, A>::operator=( const FixedArray& array )
 {
     if ( !_isDataExternal && _values != nullptr )
     {
-        _allocator.release( _values, _capacity );
+        policy().release( _values, _capacity );
         _values = nullptr;
     }
 
-    _allocator = array._allocator;
+    A<T>::operator=( array );
     _size = array._size;
     _capacity = array._capacity;
     _isDataExternal = false;
 
-    _values = _allocator.get( _capacity );
+    _values = policy().get( _capacity );
     mem::MemoryUtils::copy( _values, array._values, _capacity );
 
     return *this;
 }
 
-template <typename T>
-FixedArray<T>& FixedArray<T>::operator=( FixedArray<T>&& array )
+template <typename T, template <typename> class A>
+FixedArray<T, A>& FixedArray<T, A>::operator=( FixedArray<T, A>&& array )
 {
     if ( !_isDataExternal && _values != nullptr )
     {
-        _allocator.release( _values, _capacity );
+        policy().release( _values, _capacity );
         _values = nullptr;
     }
 
-    _allocator = array._allocator;
+    A<T>::operator=( array );
     _values = array._values;
     _size = array._size;
     _capacity = array._capacity;
@@ -586,26 +591,26 @@ FixedArray<T>& FixedArray<T>::operator=( FixedArray<T>&& array )
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-const T& FixedArray<T>::operator[]( uint32 index ) const
+const T& FixedArray<T, A>::operator[]( uint32 index ) const
 {
     assert( index < _size );
     return _values[index];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T& FixedArray<T>::operator[]( uint32 index )
+T& FixedArray<T, A>::operator[]( uint32 index )
 {
     assert( index < _size );
     return _values[index];
 }
 
 // MEMBER FUNCTIONS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T& FixedArray<T>::at( uint32 index ) const
+T& FixedArray<T, A>::at( uint32 index ) const
 {
     if ( index >= _size )
     {
@@ -615,25 +620,25 @@ T& FixedArray<T>::at( uint32 index ) const
     return _values[index];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::push( const T& value )
+void FixedArray<T, A>::push( const T& value )
 {
     assert( _size < _capacity );
     _values[_size++] = value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::push( T&& value )
+void FixedArray<T, A>::push( T&& value )
 {
     assert( _size < _capacity );
     _values[_size++] = std::move( value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::pushFront( const T& value )
+void FixedArray<T, A>::pushFront( const T& value )
 {
     assert( _size < _capacity );
     shiftForward( 0 );
@@ -641,9 +646,9 @@ void FixedArray<T>::pushFront( const T& value )
     ++_size;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::pushFront( T&& value )
+void FixedArray<T, A>::pushFront( T&& value )
 {
     assert( _size < _capacity );
     shiftForward( 0 );
@@ -651,9 +656,9 @@ void FixedArray<T>::pushFront( T&& value )
     ++_size;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::insertAt( uint32 index, const T& value )
+void FixedArray<T, A>::insertAt( uint32 index, const T& value )
 {
     assert( _size < _capacity );
     if ( index > _size )
@@ -666,9 +671,9 @@ void FixedArray<T>::insertAt( uint32 index, const T& value )
     _values[index] = value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::insertAt( uint32 index, T&& value )
+void FixedArray<T, A>::insertAt( uint32 index, T&& value )
 {
     assert( _size < _capacity );
     if ( index > _size )
@@ -681,18 +686,18 @@ void FixedArray<T>::insertAt( uint32 index, T&& value )
     _values[index] = value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T FixedArray<T>::pop()
+T FixedArray<T, A>::pop()
 {
     assert( _size > 0 );
     T elem = std::move( _values[--_size] );
     return elem;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T FixedArray<T>::popFront()
+T FixedArray<T, A>::popFront()
 {
     assert( _size > 0 );
     T elem = std::move( _values[0] );
@@ -702,9 +707,9 @@ T FixedArray<T>::popFront()
     return elem;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T FixedArray<T>::removeAt( uint32 index )
+T FixedArray<T, A>::removeAt( uint32 index )
 {
     assert( _size > 0 );
 
@@ -720,9 +725,9 @@ T FixedArray<T>::removeAt( uint32 index )
     return elem;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool FixedArray<T>::remove( const T& value )
+bool FixedArray<T, A>::remove( const T& value )
 {
     uint32 index = indexOf( value );
     if ( index == static_cast<uint32>( -1 ) )
@@ -734,43 +739,43 @@ bool FixedArray<T>::remove( const T& value )
     return true;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::clear()
+void FixedArray<T, A>::clear()
 {
     _size = 0;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename FixedArray<T>::Iterator FixedArray<T>::begin()
+typename FixedArray<T, A>::Iterator FixedArray<T, A>::begin()
 {
     return Iterator( this, 0 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename FixedArray<T>::ConstIterator FixedArray<T>::cbegin() const
+typename FixedArray<T, A>::ConstIterator FixedArray<T, A>::cbegin() const
 {
     return ConstIterator( this, 0 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename FixedArray<T>::Iterator FixedArray<T>::end()
+typename FixedArray<T, A>::Iterator FixedArray<T, A>::end()
 {
     return Iterator( this, _size );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename FixedArray<T>::ConstIterator FixedArray<T>::cend() const
+typename FixedArray<T, A>::ConstIterator FixedArray<T, A>::cend() const
 {
     return ConstIterator( this, _size );
 }
 
-template <typename T>
-uint32 FixedArray<T>::indexOf( const T& value ) const
+template <typename T, template <typename> class A>
+uint32 FixedArray<T, A>::indexOf( const T& value ) const
 {
     uint32 i;
     bool found;
@@ -785,8 +790,8 @@ uint32 FixedArray<T>::indexOf( const T& value ) const
     return found ? --i : static_cast<uint32>( -1 );
 }
 
-template <typename T>
-bool FixedArray<T>::has( const T& value ) const
+template <typename T, template <typename> class A>
+bool FixedArray<T, A>::has( const T& value ) const
 {
     uint32 i;
     bool found;
@@ -801,45 +806,52 @@ bool FixedArray<T>::has( const T& value ) const
     return found;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T* FixedArray<T>::data() const
+T* FixedArray<T, A>::data() const
 {
     return _values;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 FixedArray<T>::size() const
+uint32 FixedArray<T, A>::size() const
 {
     return _size;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 FixedArray<T>::capacity() const
+uint32 FixedArray<T, A>::capacity() const
 {
     return _capacity;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool FixedArray<T>::isEmpty() const
+bool FixedArray<T, A>::isEmpty() const
 {
     return _size <= 0;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool FixedArray<T>::isFull() const
+bool FixedArray<T, A>::isFull() const
 {
     return _size >= _capacity;
 }
 
 // HELPER FUNCTIONS
-template <typename T>
+template <typename T, template <typename> class A>
+inline
+A<T>& FixedArray<T, A>::policy()
+{
+    return *this;
+}
+
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::shiftForward( uint32 start )
+void FixedArray<T, A>::shiftForward( uint32 start )
 {
     assert( start >= 0 && start <= _size );
     uint32 i;
@@ -849,9 +861,9 @@ void FixedArray<T>::shiftForward( uint32 start )
     }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void FixedArray<T>::shiftBackward( uint32 start )
+void FixedArray<T, A>::shiftBackward( uint32 start )
 {
     assert( start >= 0 && start < _size );
     uint32 i;
@@ -862,46 +874,46 @@ void FixedArray<T>::shiftBackward( uint32 start )
 }
 
 // ITERATOR CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator()
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator()
     : _iterArray( nullptr ), _iterIndex( 0 )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
     APTR array, uint32 index ) : _iterArray( array ), _iterIndex( index )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::ArrayIterator(
     const ArrayIterator& iter )
     : _iterArray( iter._iterArray ), _iterIndex( iter._iterIndex )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::~ArrayIterator()
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::~ArrayIterator()
 {
     _iterArray = nullptr;
     _iterIndex = static_cast<uint32>( -1 );
 }
 
 // ITERATOR OPERATORS
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator=(
+vc_typename FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator=(
     const ArrayIterator& iter )
 {
     _iterArray = iter._iterArray;
@@ -910,98 +922,98 @@ FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator=(
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++()
+vc_typename FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++()
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++( int32 )
+vc_typename FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator++( int32 )
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--()
+vc_typename FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--()
 {
     _iterIndex = ( _iterIndex > 0 ) ? _iterIndex - 1 : _iterArray->_size;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--( int32 )
+vc_typename FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>&
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator--( int32 )
 {
     _iterIndex = ( _iterIndex > 0 ) ? _iterIndex - 1 : _iterArray->_size;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
 CTREF
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*() const
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*() const
 {
     return ( *_iterArray )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TREF FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*()
+TREF FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator*()
 {
     return ( *_iterArray )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
 TPTR
-FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->() const
+FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->() const
 {
     return &( *_iterArray )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TPTR FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->()
+TPTR FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator->()
 {
     return &( *_iterArray )[_iterIndex];
 }
 
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-bool FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator==(
+bool FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator==(
     const ArrayIterator& iter ) const
 {
     return _iterArray == iter._iterArray && _iterIndex == iter._iterIndex;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename APTR, typename TREF, typename CTREF, typename TPTR>
 inline
-bool FixedArray<T>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator!=(
+bool FixedArray<T, A>::ArrayIterator<APTR, TREF, CTREF, TPTR>::operator!=(
     const ArrayIterator& iter ) const
 {
     return _iterArray != iter._iterArray || _iterIndex != iter._iterIndex;
@@ -11,6 +11,8 @@
 // This is implemented as a doubly linked circular list meaning that each
 // item knows the index of the next and previous item.
 //
+// The node allocator is a policy like it is for DynamicArray.
+//
 // todo: implement a version of this class which utilizes a lookup table
 // todo: to optimize for random access. call this class array list
 #ifndef NGE_CNTR_LIST_H
@@ -24,6 +26,7 @@
 #include "engine/memory/allocator_guard.h"
 #include "engine/memory/iallocator.h"
 #include "engine/memory/memory_utils.h"
+#include "engine/memory/static_allocator.h"
 #include "engine/port.h"
 
 namespace nge
@@ -32,20 +35,29 @@ namespace nge
 namespace cntr
 {
 
+/**
+ * Defines a node in a list.
+ *
+ * The node does not depend on the allocator policy of the list so the same
+ * node allocator can be used by lists with any policy.
+ */
 template <typename T>
-class List
+struct ListNode
+{
+    uint32 next;
+    uint32 prev;
+    T value;
+};
+
+template <typename T, template <typename> class A = mem::StaticAllocator>
+class List : private A<ListNode<T>>
 {
   public:
-    // STRUCTURES
+    // TYPES
     /**
      * Defines a node in the list.
      */
-    struct Node
-    {
-        uint32 next;
-        uint32 prev;
-        T value;
-    };
+    typedef ListNode<T> Node;
 
   private:
     // CLASSES
@@ -163,11 +175,6 @@ class List
     static constexpr uint32 MIN_CAPACITY = 32;
 
     // MEMBERS
-    /**
-     * The node allocator.
-     */
-    mem::AllocatorGuard<Node> _alloc;
-
     /**
      * The internal list representation.
      * <p>
@@ -207,6 +214,11 @@ class List
     uint32 _capacity;
 
     // HELPER FUNCTIONS
+    /**
+     * Gets the allocator policy.
+     */
+    A<Node>& policy();
+
     /**
      * Removes a free node from the front of the free list and gets
      * its index.
@@ -276,12 +288,12 @@ class List
     /**
      * Defines an iterator for the list.
      */
-    typedef ListIterator<List<T>*, T&, const T&, T*> Iterator;
+    typedef ListIterator<List<T, A>*, T&, const T&, T*> Iterator;
 
     /**
      * Defines a constant iterator for the list.
      */
-    typedef ListIterator<const List<T>*, const T&, const T&, const T*>
+    typedef ListIterator<const List<T, A>*, const T&, const T&, const T*>
         ConstIterator;
 
     // CONSTRUCTORS
@@ -298,22 +310,22 @@ class List
     /**
      * Constructs a new list using the given allocator.
      */
-    List( mem::IAllocator<Node>* alloc );
+    List( const A<Node>& alloc );
 
     /**
      * Constructs a new list using the given allocator and capacity.
      */
-    List( mem::IAllocator<Node>* alloc, uint32 capacity );
+    List( const A<Node>& alloc, uint32 capacity );
 
     /**
      * Constructs a copy of the given list.
      */
-    List( const List<T>& list );
+    List( const List<T, A>& list );
 
     /**
      * Moves the data in the given list to a new instance.
      */
-    List( List<T>&& list );
+    List( List<T, A>&& list );
 
     /**
      * Destructs the list.
@@ -324,12 +336,12 @@ class List
     /**
      * Assigns this as a copy of the other list.
      */
-    List<T>& operator=( const List<T>& list );
+    List<T, A>& operator=( const List<T, A>& list );
 
     /**
      * Moves the data from the other list to this instance.
      */
-    List<T>& operator=( List<T>&& list );
+    List<T, A>& operator=( List<T, A>&& list );
 
     /**
      * Gets the value at the given index.
@@ -451,22 +463,23 @@ class List
 };
 
 // CONSTANTS
-template <typename T>
-constexpr uint32 List<T>::MIN_CAPACITY;
+template <typename T, template <typename> class A>
+constexpr uint32 List<T, A>::MIN_CAPACITY;
 
 // CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::List() : _alloc(), _nodes( nullptr ), _first( 0 ), _count( 0 ),
-                  _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
+List<T, A>::List()
+    : A<Node>(), _nodes( nullptr ), _first( 0 ), _count( 0 ),
+      _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
 {
-    _nodes = _alloc.get( _capacity );
+    _nodes = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::List( uint32 capacity )
-    : _alloc(), _nodes( nullptr ), _first( 0 ), _count( 0 ),
+List<T, A>::List( uint32 capacity )
+    : A<Node>(), _nodes( nullptr ), _first( 0 ), _count( 0 ),
       _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
 {
     while ( _capacity < capacity )
@@ -474,22 +487,22 @@ List<T>::List( uint32 capacity )
         _capacity <<= 1;
     }
 
-    _nodes = _alloc.get( _capacity );
+    _nodes = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::List( mem::IAllocator<Node>* alloc )
-    : _alloc( alloc ), _nodes( nullptr ), _first( 0 ), _count( 0 ),
+List<T, A>::List( const A<Node>& alloc )
+    : A<Node>( alloc ), _nodes( nullptr ), _first( 0 ), _count( 0 ),
       _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
 {
-    _nodes = _alloc.get( _capacity );
+    _nodes = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::List( mem::IAllocator<Node>* alloc, uint32 capacity )
-    : _alloc( alloc ), _nodes( nullptr ), _first( 0 ), _count( 0 ),
+List<T, A>::List( const A<Node>& alloc, uint32 capacity )
+    : A<Node>( alloc ), _nodes( nullptr ), _first( 0 ), _count( 0 ),
       _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
 {
     while ( _capacity < capacity )
@@ -497,25 +510,25 @@ List<T>::List( mem::IAllocator<Node>* alloc, uint32 capacity )
         _capacity <<= 1;
     }
 
-    _nodes = _alloc.get( _capacity );
+    _nodes = policy().get( _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::List( const List<T>& list )
-    : _alloc( list._alloc ), _nodes( nullptr ),
+List<T, A>::List( const List<T, A>& list )
+    : A<Node>( list ), _nodes( nullptr ),
       _first( list._first ), _count( list._count ),
       _firstFree( list._firstFree ), _freeCount( list._freeCount ),
       _capacity( list._capacity )
 {
-    _nodes = _alloc.get( _capacity );
+    _nodes = policy().get( _capacity );
     mem::MemoryUtils::copy( _nodes, list._nodes, _capacity );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::List( cntr::List<T>&& list )
-    : _alloc( std::move( list._alloc ) ), _nodes( list._nodes ),
+List<T, A>::List( cntr::List<T, A>&& list )
+    : A<Node>( list ), _nodes( list._nodes ),
       _first( list._first ), _count( list._count ),
       _firstFree( list._firstFree ), _freeCount( list._freeCount ),
       _capacity( list._capacity )
@@ -528,13 +541,13 @@ List<T>::List( cntr::List<T>&& list )
     list._capacity = 0;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>::~List()
+List<T, A>::~List()
 {
     if ( _nodes != nullptr )
     {
-        _alloc.release( _nodes, _capacity );
+        policy().release( _nodes, _capacity );
     }
     _nodes = nullptr;
     _first = 0;
@@ -545,43 +558,43 @@ List<T>::~List()
 }
 
 // OPERATORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>& List<T>::operator=( const List<T>& list )
+List<T, A>& List<T, A>::operator=( const List<T, A>& list )
 {
     uint32 i;
 
     if ( _nodes != nullptr )
     {
-        _alloc.release( _nodes, _capacity );
+        policy().release( _nodes, _capacity );
         _nodes = nullptr;
     }
 
     // create minimally size internal array
-    _alloc = list._alloc;
+    A<Node>::operator=( list );
     _first = list._first;
     _count = list._count;
     _firstFree = list._firstFree;
     _freeCount = list._freeCount;
     _capacity = list._capacity;
 
-    _nodes = _alloc.get( _capacity );
+    _nodes = policy().get( _capacity );
     mem::MemoryUtils::copy( _nodes, list._nodes, _capacity );
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-List<T>& List<T>::operator=( cntr::List<T>&& list )
+List<T, A>& List<T, A>::operator=( cntr::List<T, A>&& list )
 {
     if ( _nodes != nullptr )
     {
-        _alloc.release( _nodes, _capacity );
+        policy().release( _nodes, _capacity );
         _nodes = nullptr;
     }
 
-    _alloc = std::move( list._alloc );
+    A<Node>::operator=( list );
     _nodes = list._nodes;
     _first = list._first;
     _count = list._count;
@@ -599,26 +612,26 @@ List<T>& List<T>::operator=( cntr::List<T>&& list )
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-const T& List<T>::operator[]( uint32 index ) const
+const T& List<T, A>::operator[]( uint32 index ) const
 {
     assert( index < _count );
     return getNodeAt( index ).value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T& List<T>::operator[]( uint32 index )
+T& List<T, A>::operator[]( uint32 index )
 {
     assert( index < _count );
     return getNodeAt( index ).value;
 }
 
 // MEMBER FUNCTIONS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T& List<T>::at( uint32 index ) const
+T& List<T, A>::at( uint32 index ) const
 {
     if ( index >= _count )
     {
@@ -628,70 +641,70 @@ T& List<T>::at( uint32 index ) const
     return getNodeAt( index ).value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::push( const T& value )
+void List<T, A>::push( const T& value )
 {
     insertAt( _count, value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::push( T&& value )
+void List<T, A>::push( T&& value )
 {
     insertAt( _count, value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::pushFront( const T& value )
+void List<T, A>::pushFront( const T& value )
 {
     insertAt( 0, value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::pushFront( T&& value )
+void List<T, A>::pushFront( T&& value )
 {
     insertAt( 0, value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::insertAt( uint32 index, const T& value )
+void List<T, A>::insertAt( uint32 index, const T& value )
 {
     Node node;
     node.value = value;
     insertAtPos( index, node );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::insertAt( uint32 index, T&& value )
+void List<T, A>::insertAt( uint32 index, T&& value )
 {
     Node node;
     node.value = std::move( value );
     insertAtPos( index, node );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T List<T>::pop()
+T List<T, A>::pop()
 {
     assert( _count > 0 );
     return removeAt( _count - 1 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-T List<T>::popFront()
+T List<T, A>::popFront()
 {
     assert( _count > 0 );
     return removeAt( 0 );
 }
 
-template <typename T>
-T List<T>::removeAt( uint32 index )
+template <typename T, template <typename> class A>
+T List<T, A>::removeAt( uint32 index )
 {
     assert( _count > 0 );
     assert( index < _count );
@@ -718,9 +731,9 @@ T List<T>::removeAt( uint32 index )
     return node.value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool List<T>::remove( const T& value )
+bool List<T, A>::remove( const T& value )
 {
     uint32 index = indexOf( value );
     if ( index == static_cast<uint32>( -1 ) )
@@ -732,9 +745,9 @@ bool List<T>::remove( const T& value )
     return true;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::clear()
+void List<T, A>::clear()
 {
     _first = 0;
     _count = 0;
@@ -742,38 +755,38 @@ void List<T>::clear()
     _freeCount = 0;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename List<T>::Iterator List<T>::begin()
+typename List<T, A>::Iterator List<T, A>::begin()
 {
 
     return Iterator( this, _first, 0 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename List<T>::ConstIterator List<T>::cbegin() const
+typename List<T, A>::ConstIterator List<T, A>::cbegin() const
 {
 
     return ConstIterator( this, _first, 0 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename List<T>::Iterator List<T>::end()
+typename List<T, A>::Iterator List<T, A>::end()
 {
     return Iterator( this, _first, _count );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename List<T>::ConstIterator List<T>::cend() const
+typename List<T, A>::ConstIterator List<T, A>::cend() const
 {
     return ConstIterator( this, _first, _count );
 }
 
-template <typename T>
-uint32 List<T>::indexOf( const T& value ) const
+template <typename T, template <typename> class A>
+uint32 List<T, A>::indexOf( const T& value ) const
 {
     if ( _count <= 0 )
     {
@@ -796,8 +809,8 @@ uint32 List<T>::indexOf( const T& value ) const
     return ret;
 }
 
-template <typename T>
-bool List<T>::has( const T& value ) const
+template <typename T, template <typename> class A>
+bool List<T, A>::has( const T& value ) const
 {
     if ( _count <= 0 )
     {
@@ -817,23 +830,30 @@ bool List<T>::has( const T& value ) const
     return found;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 List<T>::size() const
+uint32 List<T, A>::size() const
 {
     return _count;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool List<T>::isEmpty() const
+bool List<T, A>::isEmpty() const
 {
     return _count <= 0;
 }
 
 // HELPER FUNCTIONS
-template <typename T>
-uint32 List<T>::popFreeNodeAndGetPos()
+template <typename T, template <typename> class A>
+inline
+A<ListNode<T>>& List<T, A>::policy()
+{
+    return *this;
+}
+
+template <typename T, template <typename> class A>
+uint32 List<T, A>::popFreeNodeAndGetPos()
 {
     assert( _freeCount > 0 );
 
@@ -853,8 +873,8 @@ uint32 List<T>::popFreeNodeAndGetPos()
     return pos;
 }
 
-template <typename T>
-void List<T>::insertAtPos( uint32 index, Node& node )
+template <typename T, template <typename> class A>
+void List<T, A>::insertAtPos( uint32 index, Node& node )
 {
     assert( index <= _count );
 
@@ -898,8 +918,8 @@ void List<T>::insertAtPos( uint32 index, Node& node )
     ++_count;
 }
 
-template <typename T>
-void List<T>::pushFree( uint32 index )
+template <typename T, template <typename> class A>
+void List<T, A>::pushFree( uint32 index )
 {
     if ( !hasFree() )
     {
@@ -916,24 +936,24 @@ void List<T>::pushFree( uint32 index )
     ++_freeCount;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::grow()
+void List<T, A>::grow()
 {
     resize( _capacity << 1 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void List<T>::shrink()
+void List<T, A>::shrink()
 {
     resize( _capacity >> 1 );
 }
 
-template <typename T>
-void List<T>::resize( uint32 size )
+template <typename T, template <typename> class A>
+void List<T, A>::resize( uint32 size )
 {
-    Node* newList = _alloc.get( size );
+    Node* newList = policy().get( size );
 
     // copy only the items that are in use to the new array
     uint32 i;
@@ -959,21 +979,21 @@ void List<T>::resize( uint32 size )
     _firstFree = 0;
     _freeCount = 0;
 
-    _alloc.release( _nodes, _capacity );
+    policy().release( _nodes, _capacity );
     _capacity = size;
     _nodes = newList;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename List<T>::Node& List<T>::getNodeAt( uint32 index ) const
+typename List<T, A>::Node& List<T, A>::getNodeAt( uint32 index ) const
 {
     return _nodes[getNodePos( index )];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 List<T>::getNodePos( uint32 index ) const
+uint32 List<T, A>::getNodePos( uint32 index ) const
 {
     assert( index < _count );
     uint32 cur;
@@ -997,59 +1017,59 @@ uint32 List<T>::getNodePos( uint32 index ) const
     return cur;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool List<T>::shouldGrow() const
+bool List<T, A>::shouldGrow() const
 {
     return _count >= _capacity;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool List<T>::shouldShrink() const
+bool List<T, A>::shouldShrink() const
 {
     return _count <= ( _capacity / 4 ) && _capacity > MIN_CAPACITY;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool List<T>::hasFree() const
+bool List<T, A>::hasFree() const
 {
     return _freeCount > 0;
 }
 
 // ITERATOR CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::ListIterator()
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::ListIterator()
     : _iterList( nullptr ), _iterIndex( 0 ), _iterPos( 0 )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::ListIterator(
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::ListIterator(
     LPTR list, uint32 index, uint32 pos )
     : _iterList( list ), _iterIndex( index ), _iterPos( pos )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::ListIterator(
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::ListIterator(
     const ListIterator& iter )
     : _iterList( iter._iterList ), _iterIndex( iter._iterIndex ),
       _iterPos( iter._iterPos )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::~ListIterator()
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::~ListIterator()
 {
     _iterList = nullptr;
     _iterIndex = static_cast<uint32>( -1 );
@@ -1057,11 +1077,11 @@ List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::~ListIterator()
 }
 
 // ITERATOR OPERATORS
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>&
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator=(
+vc_typename List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>&
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator=(
     const ListIterator& iter )
 {
     _iterList = iter._iterList;
@@ -1071,11 +1091,11 @@ List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator=(
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>&
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator++()
+vc_typename List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>&
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator++()
 {
     _iterIndex = _iterList->_nodes[_iterIndex].next;
     ++_iterPos;
@@ -1083,11 +1103,11 @@ List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator++()
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>&
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator++( int32 )
+vc_typename List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>&
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator++( int32 )
 {
     _iterIndex = _iterList->_nodes[_iterIndex].next;
     ++_iterPos;
@@ -1095,11 +1115,11 @@ List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator++( int32 )
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>&
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator--()
+vc_typename List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>&
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator--()
 {
     _iterIndex = _iterList->_nodes[_iterIndex].prev;
     _iterPos = _iterPos > 0 ? _iterPos - 1 : _iterList->_count;
@@ -1107,11 +1127,11 @@ List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator--()
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-vc_typename List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>&
-List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator--( int32 )
+vc_typename List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>&
+List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator--( int32 )
 {
     _iterIndex = _iterList->_nodes[_iterIndex].prev;
     _iterPos = _iterPos > 0 ? _iterPos - 1 : static_cast<uint32>( -1 );
@@ -1119,51 +1139,51 @@ List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator--( int32 )
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-CTREF List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator*() const
+CTREF List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator*() const
 {
     return _iterList->_nodes[_iterIndex].value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TREF List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator*()
+TREF List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator*()
 {
     return _iterList->_nodes[_iterIndex].value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TPTR List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator->() const
+TPTR List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator->() const
 {
     return &( _iterList->_nodes[_iterIndex].value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-TPTR List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator->()
+TPTR List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator->()
 {
     return &( _iterList->_nodes[_iterIndex].value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-bool List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator==(
+bool List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator==(
     const ListIterator& iter ) const
 {
     return _iterList == iter._iterList && _iterPos == iter._iterPos;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
 inline
-bool List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator!=(
+bool List<T, A>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator!=(
     const ListIterator& iter ) const
 {
     return _iterList != iter._iterList || _iterPos != iter._iterPos;
@@ -0,0 +1,795 @@
+// lru_cache.h
+//
+// The lru cache is a container that maps keys to values and evicts the least
+// recently used entries once the total weight of its entries exceeds its
+// capacity. By default every entry weighs one so the capacity is a number of
+// entries, a weigher can be provided to measure entries in bytes instead.
+//
+// The entries are stored in a pool of list nodes which form a doubly linked
+// circular list ordered from the most to the least recently used entry. A map
+// from each key to the index of its node makes get, put, and evict O(1).
+// Both the node pool and the map are allocated through the given allocators.
+//
+// The pool grows by adding fixed size chunks of nodes rather than by
+// reallocating, so nodes never move and the values returned by get stay
+// valid until their entries are removed or evicted.
+//
+#ifndef NGE_CNTR_LRU_CACHE_H
+#define NGE_CNTR_LRU_CACHE_H
+
+#include <assert.h>
+#include <functional>
+#include <utility>
+
+#include "engine/containers/dynamic_array.h"
+#include "engine/containers/list.h"
+#include "engine/containers/map.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename K, typename V>
+class LruCache
+{
+  public:
+    // STRUCTURES
+    /**
+     * Defines an entry in the cache.
+     */
+    struct Entry
+    {
+        K key;
+        V value;
+        uint32 weight;
+    };
+
+    // TYPES
+    /**
+     * Defines a node in the node pool.
+     */
+    typedef typename List<Entry>::Node Node;
+
+    /**
+     * Defines a pair in the key lookup.
+     */
+    typedef typename Map<K, uint32>::Pair Pair;
+
+    /**
+     * Defines a function that measures the weight of an entry.
+     */
+    typedef std::function<uint32( const K&, const V& )> Weigher;
+
+    /**
+     * Defines a function that is called before an entry is evicted.
+     */
+    typedef std::function<void( const K&, V& )> EvictionCallback;
+
+  private:
+    // CONSTANTS
+    /**
+     * The number of nodes in each chunk of the pool.
+     *
+     * This must be a power of two so that indices split into a chunk and a
+     * position with a shift and a mask.
+     */
+    static constexpr uint32 CHUNK_SIZE = 32;
+
+    /**
+     * The number of bits of a node index that select its position in a
+     * chunk.
+     */
+    static constexpr uint32 CHUNK_SHIFT = 5;
+
+    static_assert( CHUNK_SIZE == 1u << CHUNK_SHIFT,
+                   "the chunk shift must match the chunk size" );
+
+    /**
+     * The value used to mark the end of the free list.
+     */
+    static constexpr uint32 NODE_NONE = static_cast<uint32>( -1 );
+
+    // MEMBERS
+    /**
+     * The node allocator.
+     */
+    mem::AllocatorGuard<Node> _alloc;
+
+    /**
+     * The chunks of the node pool.
+     */
+    DynamicArray<Node*> _chunks;
+
+    /**
+     * The index of the node for each key.
+     */
+    Map<K, uint32, mem::AllocatorGuard> _lookup;
+
+    /**
+     * The index of the most recently used node.
+     */
+    uint32 _first;
+
+    /**
+     * The number of entries.
+     */
+    uint32 _count;
+
+    /**
+     * The index of the first free node.
+     */
+    uint32 _firstFree;
+
+    /**
+     * The maximum total weight of the entries.
+     */
+    uint32 _capacity;
+
+    /**
+     * The total weight of the entries.
+     */
+    uint32 _weight;
+
+    /**
+     * The function that measures the entries.
+     */
+    Weigher _weigher;
+
+    /**
+     * The function that is called before an entry is evicted.
+     */
+    EvictionCallback _onEvict;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the node at the given index.
+     */
+    Node& getNodeAt( uint32 index ) const;
+
+    /**
+     * Gets a free node, growing the pool if necessary.
+     */
+    uint32 acquireNode();
+
+    /**
+     * Resets the node and returns it to the free list.
+     */
+    void releaseNode( uint32 index );
+
+    /**
+     * Links the node as the most recently used entry.
+     */
+    void link( uint32 index );
+
+    /**
+     * Unlinks the node from the entries.
+     */
+    void unlink( uint32 index );
+
+    /**
+     * Adds a chunk to the node pool.
+     */
+    void grow();
+
+    /**
+     * Copies the chunks of the given cache.
+     */
+    void copyChunks( const LruCache<K, V>& cache );
+
+    /**
+     * Releases every chunk of the node pool.
+     */
+    void releaseChunks();
+
+    /**
+     * Links the nodes in the given range into the free list.
+     */
+    void pushFree( uint32 start, uint32 end );
+
+    /**
+     * Evicts entries until the weight is within the capacity.
+     */
+    void trim();
+
+    /**
+     * Measures the given entry.
+     */
+    uint32 weigh( const K& key, const V& value ) const;
+
+    /**
+     * Stores the value for the key and marks it as most recently used.
+     */
+    template <typename U>
+    void store( const K& key, U&& value );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new cache with the given capacity in entries.
+     */
+    LruCache( uint32 capacity );
+
+    /**
+     * Constructs a new cache with the given capacity in units of the weigher.
+     */
+    LruCache( uint32 capacity, const Weigher& weigher );
+
+    /**
+     * Constructs a new cache using the given allocators and capacity in
+     * entries.
+     */
+    LruCache( mem::IAllocator<Node>* nodeAlloc,
+              mem::IAllocator<Pair>* pairAlloc,
+              mem::IAllocator<uint32>* binAlloc, uint32 capacity );
+
+    /**
+     * Constructs a new cache using the given allocators and capacity in
+     * units of the weigher.
+     */
+    LruCache( mem::IAllocator<Node>* nodeAlloc,
+              mem::IAllocator<Pair>* pairAlloc,
+              mem::IAllocator<uint32>* binAlloc, uint32 capacity,
+              const Weigher& weigher );
+
+    /**
+     * Constructs a copy of the given cache.
+     */
+    LruCache( const LruCache<K, V>& cache );
+
+    /**
+     * Moves the data in the given cache to a new instance.
+     */
+    LruCache( LruCache<K, V>&& cache );
+
+    /**
+     * Destructs the cache.
+     *
+     * This does not call the eviction callback.
+     */
+    ~LruCache();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the other cache.
+     */
+    LruCache<K, V>& operator=( const LruCache<K, V>& cache );
+
+    /**
+     * Moves the data from the other cache to this instance.
+     */
+    LruCache<K, V>& operator=( LruCache<K, V>&& cache );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the value for the key and marks it as most recently used.
+     *
+     * Returns nullptr if there is no entry for the key. The pointer is valid
+     * until the entry is removed or evicted.
+     */
+    V* get( const K& key );
+
+    /**
+     * Adds or replaces the entry for the key and marks it as most recently
+     * used.
+     *
+     * Entries are evicted until the weight is within the capacity which
+     * includes the new entry if it is heavier than the capacity.
+     */
+    void put( const K& key, const V& value );
+
+    /**
+     * Moves the value into the entry for the key and marks it as most
+     * recently used.
+     */
+    void put( const K& key, V&& value );
+
+    /**
+     * Removes the entry for the key and returns if it was found.
+     *
+     * This does not call the eviction callback.
+     */
+    bool remove( const K& key );
+
+    /**
+     * Evicts the least recently used entry and returns if there was one.
+     */
+    bool evict();
+
+    /**
+     * Removes all of the entries without calling the eviction callback.
+     */
+    void clear();
+
+    /**
+     * Checks if there is an entry for the key without marking it as used.
+     */
+    bool has( const K& key ) const;
+
+    /**
+     * Sets the function that is called before an entry is evicted.
+     */
+    void setEvictionCallback( const EvictionCallback& onEvict );
+
+    /**
+     * Sets the capacity, evicting entries if necessary.
+     */
+    void setCapacity( uint32 capacity );
+
+    /**
+     * Gets the capacity.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the total weight of the entries.
+     */
+    uint32 weight() const;
+
+    /**
+     * Gets the number of entries.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the cache is empty.
+     */
+    bool isEmpty() const;
+};
+
+// CONSTANTS
+template <typename K, typename V>
+constexpr uint32 LruCache<K, V>::CHUNK_SIZE;
+
+template <typename K, typename V>
+constexpr uint32 LruCache<K, V>::CHUNK_SHIFT;
+
+template <typename K, typename V>
+constexpr uint32 LruCache<K, V>::NODE_NONE;
+
+// CONSTRUCTORS
+template <typename K, typename V>
+inline
+LruCache<K, V>::LruCache( uint32 capacity )
+    : _alloc(), _chunks(), _lookup(), _first( 0 ), _count( 0 ),
+      _firstFree( NODE_NONE ), _capacity( capacity ), _weight( 0 ),
+      _weigher(), _onEvict()
+{
+    grow();
+}
+
+template <typename K, typename V>
+inline
+LruCache<K, V>::LruCache( uint32 capacity, const Weigher& weigher )
+    : _alloc(), _chunks(), _lookup(), _first( 0 ), _count( 0 ),
+      _firstFree( NODE_NONE ), _capacity( capacity ), _weight( 0 ),
+      _weigher( weigher ), _onEvict()
+{
+    grow();
+}
+
+template <typename K, typename V>
+inline
+LruCache<K, V>::LruCache( mem::IAllocator<Node>* nodeAlloc,
+                          mem::IAllocator<Pair>* pairAlloc,
+                          mem::IAllocator<uint32>* binAlloc,
+                          uint32 capacity )
+    : _alloc( nodeAlloc ), _chunks(), _lookup( pairAlloc, binAlloc ),
+      _first( 0 ), _count( 0 ), _firstFree( NODE_NONE ),
+      _capacity( capacity ), _weight( 0 ), _weigher(), _onEvict()
+{
+    grow();
+}
+
+template <typename K, typename V>
+inline
+LruCache<K, V>::LruCache( mem::IAllocator<Node>* nodeAlloc,
+                          mem::IAllocator<Pair>* pairAlloc,
+                          mem::IAllocator<uint32>* binAlloc,
+                          uint32 capacity, const Weigher& weigher )
+    : _alloc( nodeAlloc ), _chunks(), _lookup( pairAlloc, binAlloc ),
+      _first( 0 ), _count( 0 ), _firstFree( NODE_NONE ),
+      _capacity( capacity ), _weight( 0 ), _weigher( weigher ),
+      _onEvict()
+{
+    grow();
+}
+
+template <typename K, typename V>
+inline
+LruCache<K, V>::LruCache( const LruCache<K, V>& cache )
+    : _alloc( cache._alloc ), _chunks(), _lookup( cache._lookup ),
+      _first( cache._first ), _count( cache._count ),
+      _firstFree( cache._firstFree ), _capacity( cache._capacity ),
+      _weight( cache._weight ), _weigher( cache._weigher ),
+      _onEvict( cache._onEvict )
+{
+    copyChunks( cache );
+}
+
+template <typename K, typename V>
+inline
+LruCache<K, V>::LruCache( LruCache<K, V>&& cache )
+    : _alloc( cache._alloc ), _chunks( std::move( cache._chunks ) ),
+      _lookup( std::move( cache._lookup ) ),
+      _first( cache._first ), _count( cache._count ),
+      _firstFree( cache._firstFree ), _capacity( cache._capacity ),
+      _weight( cache._weight ), _weigher( std::move( cache._weigher ) ),
+      _onEvict( std::move( cache._onEvict ) )
+{
+    cache._count = 0;
+    cache._firstFree = NODE_NONE;
+    cache._weight = 0;
+}
+
+template <typename K, typename V>
+inline
+LruCache<K, V>::~LruCache()
+{
+    releaseChunks();
+
+    _count = 0;
+    _weight = 0;
+}
+
+// OPERATORS
+template <typename K, typename V>
+LruCache<K, V>& LruCache<K, V>::operator=( const LruCache<K, V>& cache )
+{
+    if ( this == &cache )
+    {
+        return *this;
+    }
+
+    releaseChunks();
+
+    _alloc = cache._alloc;
+    _lookup = cache._lookup;
+    _first = cache._first;
+    _count = cache._count;
+    _firstFree = cache._firstFree;
+    _capacity = cache._capacity;
+    _weight = cache._weight;
+    _weigher = cache._weigher;
+    _onEvict = cache._onEvict;
+
+    copyChunks( cache );
+
+    return *this;
+}
+
+template <typename K, typename V>
+LruCache<K, V>& LruCache<K, V>::operator=( LruCache<K, V>&& cache )
+{
+    if ( this == &cache )
+    {
+        return *this;
+    }
+
+    releaseChunks();
+
+    _alloc = cache._alloc;
+    _chunks = std::move( cache._chunks );
+    _lookup = std::move( cache._lookup );
+    _first = cache._first;
+    _count = cache._count;
+    _firstFree = cache._firstFree;
+    _capacity = cache._capacity;
+    _weight = cache._weight;
+    _weigher = std::move( cache._weigher );
+    _onEvict = std::move( cache._onEvict );
+
+    cache._count = 0;
+    cache._firstFree = NODE_NONE;
+    cache._weight = 0;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename K, typename V>
+V* LruCache<K, V>::get( const K& key )
+{
+    const uint32* found = _lookup.find( key );
+    if ( found == nullptr )
+    {
+        return nullptr;
+    }
+
+    const uint32 index = *found;
+    if ( index != _first )
+    {
+        unlink( index );
+        link( index );
+    }
+
+    return &getNodeAt( index ).value.value;
+}
+
+template <typename K, typename V>
+inline
+void LruCache<K, V>::put( const K& key, const V& value )
+{
+    store( key, value );
+}
+
+template <typename K, typename V>
+inline
+void LruCache<K, V>::put( const K& key, V&& value )
+{
+    store( key, std::move( value ) );
+}
+
+template <typename K, typename V>
+bool LruCache<K, V>::remove( const K& key )
+{
+    uint32 index;
+    if ( !_lookup.remove( key, &index ) )
+    {
+        return false;
+    }
+
+    _weight -= getNodeAt( index ).value.weight;
+    unlink( index );
+    releaseNode( index );
+
+    return true;
+}
+
+template <typename K, typename V>
+bool LruCache<K, V>::evict()
+{
+    if ( _count <= 0 )
+    {
+        return false;
+    }
+
+    const uint32 index = getNodeAt( _first ).prev;
+    Entry& entry = getNodeAt( index ).value;
+
+    if ( _onEvict )
+    {
+        _onEvict( entry.key, entry.value );
+    }
+
+    _lookup.remove( entry.key );
+    _weight -= entry.weight;
+    unlink( index );
+    releaseNode( index );
+
+    return true;
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::clear()
+{
+    releaseChunks();
+
+    _lookup.clear();
+    _first = 0;
+    _count = 0;
+    _firstFree = NODE_NONE;
+    _weight = 0;
+
+    grow();
+}
+
+template <typename K, typename V>
+inline
+bool LruCache<K, V>::has( const K& key ) const
+{
+    return _lookup.has( key );
+}
+
+template <typename K, typename V>
+inline
+void LruCache<K, V>::setEvictionCallback( const EvictionCallback& onEvict )
+{
+    _onEvict = onEvict;
+}
+
+template <typename K, typename V>
+inline
+void LruCache<K, V>::setCapacity( uint32 capacity )
+{
+    _capacity = capacity;
+    trim();
+}
+
+template <typename K, typename V>
+inline
+uint32 LruCache<K, V>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename K, typename V>
+inline
+uint32 LruCache<K, V>::weight() const
+{
+    return _weight;
+}
+
+template <typename K, typename V>
+inline
+uint32 LruCache<K, V>::size() const
+{
+    return _count;
+}
+
+template <typename K, typename V>
+inline
+bool LruCache<K, V>::isEmpty() const
+{
+    return _count <= 0;
+}
+
+// HELPER FUNCTIONS
+template <typename K, typename V>
+inline
+typename LruCache<K, V>::Node& LruCache<K, V>::getNodeAt(
+    uint32 index ) const
+{
+    return _chunks[index >> CHUNK_SHIFT][index & ( CHUNK_SIZE - 1 )];
+}
+
+template <typename K, typename V>
+template <typename U>
+void LruCache<K, V>::store( const K& key, U&& value )
+{
+    const uint32* found = _lookup.find( key );
+    uint32 index;
+    if ( found != nullptr )
+    {
+        index = *found;
+        _weight -= getNodeAt( index ).value.weight;
+        unlink( index );
+    }
+    else
+    {
+        index = acquireNode();
+        getNodeAt( index ).value.key = key;
+        _lookup[key] = index;
+    }
+
+    Entry& entry = getNodeAt( index ).value;
+    entry.value = std::forward<U>( value );
+    entry.weight = weigh( key, entry.value );
+
+    _weight += entry.weight;
+    link( index );
+
+    trim();
+}
+
+template <typename K, typename V>
+uint32 LruCache<K, V>::acquireNode()
+{
+    if ( _firstFree == NODE_NONE )
+    {
+        grow();
+    }
+
+    const uint32 index = _firstFree;
+    _firstFree = getNodeAt( index ).next;
+    return index;
+}
+
+template <typename K, typename V>
+inline
+void LruCache<K, V>::releaseNode( uint32 index )
+{
+    // release any resources held by the entry
+    getNodeAt( index ).value = Entry();
+    getNodeAt( index ).next = _firstFree;
+    _firstFree = index;
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::link( uint32 index )
+{
+    Node& node = getNodeAt( index );
+    if ( _count <= 0 )
+    {
+        node.next = index;
+        node.prev = index;
+    }
+    else
+    {
+        Node& first = getNodeAt( _first );
+        node.next = _first;
+        node.prev = first.prev;
+        getNodeAt( first.prev ).next = index;
+        first.prev = index;
+    }
+
+    _first = index;
+    ++_count;
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::unlink( uint32 index )
+{
+    Node& node = getNodeAt( index );
+
+    getNodeAt( node.prev ).next = node.next;
+    getNodeAt( node.next ).prev = node.prev;
+
+    if ( _first == index )
+    {
+        _first = node.next;
+    }
+
+    --_count;
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::grow()
+{
+    const uint32 start = _chunks.size() << CHUNK_SHIFT;
+
+    // existing chunks never move so values handed out by get stay valid
+    _chunks.push( _alloc.get( CHUNK_SIZE ) );
+    pushFree( start, start + CHUNK_SIZE );
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::copyChunks( const LruCache<K, V>& cache )
+{
+    uint32 i;
+    for ( i = 0; i < cache._chunks.size(); ++i )
+    {
+        _chunks.push( _alloc.get( CHUNK_SIZE ) );
+        mem::MemoryUtils::copy( _chunks[i], cache._chunks[i], CHUNK_SIZE );
+    }
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::releaseChunks()
+{
+    uint32 i;
+    for ( i = 0; i < _chunks.size(); ++i )
+    {
+        _alloc.release( _chunks[i], CHUNK_SIZE );
+    }
+
+    _chunks.clear();
+}
+
+template <typename K, typename V>
+void LruCache<K, V>::pushFree( uint32 start, uint32 end )
+{
+    uint32 i;
+    for ( i = end; i > start; --i )
+    {
+        getNodeAt( i - 1 ).next = _firstFree;
+        _firstFree = i - 1;
+    }
+}
+
+template <typename K, typename V>
+inline
+void LruCache<K, V>::trim()
+{
+    while ( _weight > _capacity && evict() )
+    {
+        // do nothing
+    }
+}
+
+template <typename K, typename V>
+inline
+uint32 LruCache<K, V>::weigh( const K& key, const V& value ) const
+{
+    return _weigher ? _weigher( key, value ) : 1;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif // NGE_CNTR_LRU_CACHE_H
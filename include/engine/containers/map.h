@@ -12,12 +12,17 @@
 // to the nature of a map there is only a constant iterator defined for this
 // class.
 //
+// The allocator is a policy like it is for DynamicArray. The same policy
+// allocates both the pairs and the bins.
+//
 #ifndef NGE_CNTR_MAP_H
 #define NGE_CNTR_MAP_H
 
 #include <functional>
+#include <utility>
 #include <engine/utility/hasher.h>
 
+#include "engine/containers/bloom_filter.h"
 #include "engine/containers/dynamic_array.h"
 
 namespace nge
@@ -29,15 +34,29 @@ namespace cntr
 // TODO: consider using progressive bin copy afte resize if necessary
 // TODO: cache hashes in separate array if necessary
 // TODO: define non-constant iterator without *() operator
+/**
+ * Defines a key-value pair in a map.
+ *
+ * The pair does not depend on the allocator policy of the map so the same
+ * pair allocator can be used by maps with any policy.
+ */
 template <typename K, typename V>
-class Map
+struct MapPair
+{
+    K key;
+    V value;
+};
+
+template <typename K, typename V,
+          template <typename> class A = mem::StaticAllocator>
+class Map : private A<uint32>
 {
   public:
-    // STRUCTURES
+    // TYPES
     /**
      * Defines a key-value pair.
      */
-    struct Pair;
+    typedef MapPair<K, V> Pair;
 
   private:
     // CONSTANTS
@@ -51,6 +70,15 @@ class Map
      */
     static constexpr uint32 BIN_EMPTY = static_cast<uint32>( -1 );
 
+    /**
+     * Defines a bin whose mapping was removed.
+     *
+     * The bin cannot be marked as empty since that would break the probe
+     * sequence of any key that was placed after it. Removed bins are
+     * reclaimed when the bins are resized.
+     */
+    static constexpr uint32 BIN_REMOVED = static_cast<uint32>( -2 );
+
     /**
      * The threshold percentage at which the map grows.
      */
@@ -62,15 +90,10 @@ class Map
     static constexpr uint32 SHRINK_THRESHOLD = 30;
 
     // MEMBERS
-    /**
-     * The bin allocator.
-     */
-    mem::AllocatorGuard<uint32> _binAlloc;
-
     /**
      * The key-value pairs.
      */
-    DynamicArray<Pair> _pairs;
+    DynamicArray<Pair, A> _pairs;
 
     /**
      * The hash function.
@@ -87,12 +110,44 @@ class Map
      */
     uint32 _binsInUse;
 
+    /**
+     * The number of bins whose mapping was removed.
+     */
+    uint32 _binsRemoved;
+
     /**
      * The total number of bins.
      */
     uint32 _binCount;
 
+    /**
+     * The filter that rejects most keys that are not in the map or null if
+     * the filter is not enabled.
+     *
+     * The filter is only created when it is enabled so that unfiltered
+     * maps do not carry it. Its blocks are allocated by the bin allocator
+     * policy.
+     */
+    BloomFilter<K, A>* _filter;
+
     // HELPER FUNCTIONS
+    /**
+     * Gets the bin allocator policy.
+     */
+    A<uint32>& policy();
+
+    /**
+     * Adds the hash code to the filter if it is enabled.
+     */
+    void filterHash( uint32 hashCode );
+
+    /**
+     * Checks if a key with the hash code may be in the map.
+     *
+     * This is always true when the filter is not enabled.
+     */
+    bool mayContainHash( uint32 hashCode ) const;
+
     /**
      * Creates a new pair.
      */
@@ -111,6 +166,18 @@ class Map
      */
     uint32 findBinForKey( const K& key ) const;
 
+    /**
+     * Gets the index of a bin that should hold the given key using its
+     * precomputed hash code.
+     */
+    uint32 findBinForKey( const K& key, uint32 hashCode ) const;
+
+    /**
+     * Removes the mapping in the bin at the given index and returns its
+     * value.
+     */
+    V removeBin( uint32 binIndex );
+
     /**
      * Computes the hash for the given key.
      */
@@ -134,6 +201,14 @@ class Map
      */
     bool isBinEmpty( uint32 binIndex ) const;
 
+    /**
+     * Checks if the mapping in the bin at the given index was removed.
+     *
+     * Behavior is undefined when:
+     * binIndex is invalid.
+     */
+    bool isBinRemoved( uint32 binIndex ) const;
+
     /**
      * Checks if the bin at the given indx contains the given key.
      *
@@ -153,6 +228,9 @@ class Map
 
     /**
      * Grows the bin array to twice the current capacity.
+     *
+     * When most of the load is removed bins the bins are rehashed at the
+     * current capacity instead.
      */
     void grow();
 
@@ -162,7 +240,9 @@ class Map
     void shrink();
 
     /**
-     * Resizes the bin array to the specified size.
+     * Resizes the bin array to the specified size and rehashes the keys.
+     *
+     * The bin array is reused when the size does not change.
      */
     void resize( uint32 newSize );
 
@@ -183,7 +263,7 @@ class Map
         /**
          * The set of values that are being iterated.
          */
-        const DynamicArray<Pair>* _iterValues;
+        const DynamicArray<Pair, A>* _iterValues;
 
         /**
          * The current position in the set.
@@ -200,7 +280,7 @@ class Map
         /**
          * Constructs an iterator for the map with the given index.
          */
-        ConstIterator( const Map<K, V>* map, uint32 index );
+        ConstIterator( const Map<K, V, A>* map, uint32 index );
 
         /**
          * Constructs a copy of the given iterator.
@@ -262,13 +342,6 @@ class Map
         bool operator!=( const ConstIterator& iter ) const;
     };
 
-    // STRUCTURES
-    struct Pair
-    {
-        K key;
-        V value;
-    };
-
     // CONSTRUCTORS
     /**
      * Constructs a new map.
@@ -294,36 +367,36 @@ class Map
     /**
      * Constructs a new map that uses the given allocators.
      */
-    Map( mem::IAllocator<Pair>* pairAlloc, mem::IAllocator<uint32>* intAlloc );
+    Map( const A<Pair>& pairAlloc, const A<uint32>& intAlloc );
 
     /**
      * Constructs a new map using the given allocators and initial capacity.
      */
-    Map( mem::IAllocator<Pair>* pairAlloc, mem::IAllocator<uint32>* intAlloc,
+    Map( const A<Pair>& pairAlloc, const A<uint32>& intAlloc,
         uint32 capacity );
 
     /**
      * Constructs a new map using the given allocators and hash function.
      */
-    Map( mem::IAllocator<Pair>* pairAlloc, mem::IAllocator<uint32>* intAlloc,
+    Map( const A<Pair>& pairAlloc, const A<uint32>& intAlloc,
         const std::function<uint32( const K& )>& hashFunc );
 
     /**
      * Constructs a new map using the given allocators, initial capacity, and
      * hash function.
      */
-    Map( mem::IAllocator<Pair>* pairAlloc, mem::IAllocator<uint32>* intAlloc,
+    Map( const A<Pair>& pairAlloc, const A<uint32>& intAlloc,
         uint32 capacity, const std::function<uint32( const K& )>& hashFunc );
 
     /**
      * Constructs a copy of the given map.
      */
-    Map( const Map<K, V>& map );
+    Map( const Map<K, V, A>& map );
 
     /**
      * Moves the map to a new instance.
      */
-    Map( Map<K, V>&& map );
+    Map( Map<K, V, A>&& map );
 
     /**
      * Destructs the map.
@@ -334,12 +407,12 @@ class Map
     /**
      * Assigns this as a copy of the given map.
      */
-    Map<K, V>& operator=( const Map<K, V>& map );
+    Map<K, V, A>& operator=( const Map<K, V, A>& map );
 
     /**
      * Moves the map data to this instance.
      */
-    Map<K, V>& operator=( Map<K, V>&& map );
+    Map<K, V, A>& operator=( Map<K, V, A>&& map );
 
     /**
      * Gets the value that is associated with the given key.
@@ -370,21 +443,62 @@ class Map
     /**
      * Removes the mapping for the specified key and returns the value.
      *
+     * The last pair is moved into the position of the removed pair so the
+     * iteration order is not preserved.
+     *
      * Behavior is undefined when:
      * There isn't a mapping for the key.
      */
     V remove( const K& key );
 
+    /**
+     * Removes the mapping for the specified key if there is one and returns
+     * if it was removed.
+     *
+     * The value is moved into the output when it is not null. This probes
+     * the bins once, unlike checking has before calling remove.
+     */
+    bool remove( const K& key, V* value );
+
     /**
      * Checks if the map contains a mapping for the given key.
      */
     bool has( const K& key ) const;
 
+    /**
+     * Gets the value mapped to the key or null if there is no mapping.
+     *
+     * This does not add a mapping or resize the bins. The pointer is
+     * invalidated when the map is modified.
+     */
+    const V* find( const K& key ) const;
+
+    /**
+     * Gets the value mapped to the key or null if there is no mapping.
+     *
+     * This does not add a mapping or resize the bins. The pointer is
+     * invalidated when the map is modified.
+     */
+    V* find( const K& key );
+
     /**
      * Removes all mappings.
      */
     void clear();
 
+    /**
+     * Enables a bloom filter in front of the bins.
+     *
+     * Checking for a key that is not in the map then rarely has to probe the
+     * bins. The filter is rebuilt whenever the bins are resized.
+     */
+    void enableFilter();
+
+    /**
+     * Checks if the bloom filter is enabled.
+     */
+    bool isFiltered() const;
+
     /**
      * Gets an iterator for the mappings.
      */
@@ -407,249 +521,293 @@ class Map
 };
 
 // CONSTANTS
-template <typename K, typename V>
-constexpr uint32 Map<K, V>::MIN_BINS;
+template <typename K, typename V, template <typename> class A>
+constexpr uint32 Map<K, V, A>::MIN_BINS;
 
-template <typename K, typename V>
-constexpr uint32 Map<K, V>::BIN_EMPTY;
+template <typename K, typename V, template <typename> class A>
+constexpr uint32 Map<K, V, A>::BIN_EMPTY;
 
-template <typename K, typename V>
-constexpr uint32 Map<K, V>::GROW_THRESHOLD;
+template <typename K, typename V, template <typename> class A>
+constexpr uint32 Map<K, V, A>::BIN_REMOVED;
 
-template <typename K, typename V>
-constexpr uint32 Map<K, V>::SHRINK_THRESHOLD;
+template <typename K, typename V, template <typename> class A>
+constexpr uint32 Map<K, V, A>::GROW_THRESHOLD;
+
+template <typename K, typename V, template <typename> class A>
+constexpr uint32 Map<K, V, A>::SHRINK_THRESHOLD;
 
 // CONSTRUCTORS
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map() : _binAlloc(), _pairs(), _hashFunc( &util::Hasher<K>::hash ),
-                   _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Map<K, V, A>::Map()
+    : A<uint32>(), _pairs(), _hashFunc( &util::Hasher<K>::hash ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( uint32 capacity )
-    : _binAlloc(), _pairs( capacity ), _hashFunc( &util::Hasher<K>::hash ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Map<K, V, A>::Map( uint32 capacity )
+    : A<uint32>(), _pairs( capacity ), _hashFunc( &util::Hasher<K>::hash ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( const std::function<uint32( const K& )>& hashFunc )
-    : _binAlloc(), _pairs(), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Map<K, V, A>::Map( const std::function<uint32( const K& )>& hashFunc )
+    : A<uint32>(), _pairs(), _hashFunc( hashFunc ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( uint32 capacity,
-                const std::function<uint32( const K& )>& hashFunc )
-    : _binAlloc(), _pairs( capacity ), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Map<K, V, A>::Map( uint32 capacity,
+                   const std::function<uint32( const K& )>& hashFunc )
+    : A<uint32>(), _pairs( capacity ), _hashFunc( hashFunc ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( mem::IAllocator<Pair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc )
-    : _binAlloc( intAlloc ), _pairs( pairAlloc ),
+Map<K, V, A>::Map( const A<Pair>& pairAlloc,
+                   const A<uint32>& intAlloc )
+    : A<uint32>( intAlloc ), _pairs( pairAlloc ),
       _hashFunc( &util::Hasher<K>::hash ), _bins( nullptr ), _binsInUse( 0 ),
-      _binCount( MIN_BINS )
+      _binsRemoved( 0 ), _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( mem::IAllocator<Pair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc, uint32 capacity )
-    : _binAlloc( intAlloc ), _pairs( pairAlloc, capacity ),
+Map<K, V, A>::Map( const A<Pair>& pairAlloc,
+                   const A<uint32>& intAlloc, uint32 capacity )
+    : A<uint32>( intAlloc ), _pairs( pairAlloc, capacity ),
       _hashFunc( &util::Hasher<K>::hash ), _bins( nullptr ), _binsInUse( 0 ),
-      _binCount( MIN_BINS )
+      _binsRemoved( 0 ), _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( mem::IAllocator<Pair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc,
-                const std::function<uint32( const K& )>& hashFunc )
-    : _binAlloc( intAlloc ), _pairs( pairAlloc ), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Map<K, V, A>::Map( const A<Pair>& pairAlloc,
+                   const A<uint32>& intAlloc,
+                   const std::function<uint32( const K& )>& hashFunc )
+    : A<uint32>( intAlloc ), _pairs( pairAlloc ), _hashFunc( hashFunc ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( mem::IAllocator<Pair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc, uint32 capacity,
-                const std::function<uint32( const K& )>& hashFunc )
-    : _binAlloc( intAlloc ), _pairs( pairAlloc, capacity ),
+Map<K, V, A>::Map( const A<Pair>& pairAlloc,
+                   const A<uint32>& intAlloc, uint32 capacity,
+                   const std::function<uint32( const K& )>& hashFunc )
+    : A<uint32>( intAlloc ), _pairs( pairAlloc, capacity ),
       _hashFunc( hashFunc ), _bins( nullptr ), _binsInUse( 0 ),
-      _binCount( MIN_BINS )
+      _binsRemoved( 0 ), _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( const Map<K, V>& map )
-    : _binAlloc( map._binAlloc ), _pairs( map._pairs ),
+Map<K, V, A>::Map( const Map<K, V, A>& map )
+    : A<uint32>( map ), _pairs( map._pairs ),
       _hashFunc( map._hashFunc ), _bins( nullptr ),
-      _binsInUse( map._binsInUse ), _binCount( map._binCount )
+      _binsInUse( map._binsInUse ), _binsRemoved( map._binsRemoved ),
+      _binCount( map._binCount ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    if ( map._filter != nullptr )
+    {
+        _filter = new BloomFilter<K, A>( *map._filter );
+    }
+
+    _bins = policy().get( _binCount );
     mem::MemoryUtils::copy( _bins, map._bins, _binCount );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::Map( Map<K, V>&& map )
-    : _binAlloc( std::move( map._binAlloc ) ),
+Map<K, V, A>::Map( Map<K, V, A>&& map )
+    : A<uint32>( map ),
       _pairs( std::move( map._pairs ) ),
       _hashFunc( std::move( map._hashFunc ) ), _bins( map._bins ),
-      _binsInUse( map._binsInUse ), _binCount( map._binCount )
+      _binsInUse( map._binsInUse ), _binsRemoved( map._binsRemoved ),
+      _binCount( map._binCount ), _filter( map._filter )
 {
+    map._filter = nullptr;
     map._bins = nullptr;
     map._binsInUse = 0;
+    map._binsRemoved = 0;
     map._binCount = 0;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::~Map()
+Map<K, V, A>::~Map()
 {
     if ( _bins != nullptr )
     {
-        _binAlloc.release( _bins, _binCount );
+        policy().release( _bins, _binCount );
         _bins = nullptr;
     }
     _binsInUse = 0;
+    _binsRemoved = 0;
     _binCount = 0;
+
+    delete _filter;
+    _filter = nullptr;
 }
 
 // OPERATORS
-template <typename K, typename V>
-Map<K, V>& Map<K, V>::operator=( const Map<K, V>& map )
+template <typename K, typename V, template <typename> class A>
+Map<K, V, A>& Map<K, V, A>::operator=( const Map<K, V, A>& map )
 {
     if ( _bins != nullptr )
     {
-        _binAlloc.release( _bins, _binCount );
+        policy().release( _bins, _binCount );
     }
 
-    _binAlloc = map._binAlloc;
+    A<uint32>::operator=( map );
     _pairs = map._pairs;
     _hashFunc = map._hashFunc;
     _binCount = map._binCount;
     _binsInUse = map._binsInUse;
-    _bins = _binAlloc.get( _binCount );
+    _binsRemoved = map._binsRemoved;
+
+    delete _filter;
+    _filter = nullptr;
+    if ( map._filter != nullptr )
+    {
+        _filter = new BloomFilter<K, A>( *map._filter );
+    }
+    _bins = policy().get( _binCount );
     mem::MemoryUtils::copy( _bins, map._bins, _binCount );
 
     return *this;
 }
 
-template <typename K, typename V>
-Map<K, V>& Map<K, V>::operator=( Map<K, V>&& map )
+template <typename K, typename V, template <typename> class A>
+Map<K, V, A>& Map<K, V, A>::operator=( Map<K, V, A>&& map )
 {
     if ( _bins != nullptr )
     {
-        _binAlloc.release( _bins, _binCount );
+        policy().release( _bins, _binCount );
     }
 
-    _binAlloc = std::move( map._binAlloc );
+    A<uint32>::operator=( map );
     _pairs = std::move( map._pairs );
     _hashFunc = std::move( map._hashFunc );
     _bins = map._bins;
     _binCount = map._binCount;
     _binsInUse = map._binsInUse;
+    _binsRemoved = map._binsRemoved;
+    delete _filter;
+    _filter = map._filter;
+    map._filter = nullptr;
 
     map._bins = nullptr;
     map._binCount = 0;
     map._binsInUse = 0;
+    map._binsRemoved = 0;
 
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-const V& Map<K, V>::operator[]( const K& key ) const
+const V& Map<K, V, A>::operator[]( const K& key ) const
 {
     uint32 binIndex = findBinForKey( key );
     assert( !isBinEmpty( binIndex ) );
     return _pairs[_bins[binIndex]].value;
 }
 
-template <typename K, typename V>
-V& Map<K, V>::operator[]( const K& key )
+template <typename K, typename V, template <typename> class A>
+V& Map<K, V, A>::operator[]( const K& key )
 {
     if ( shouldGrow() )
     {
         grow();
     }
 
-    uint32 binIndex = findBinForKey( key );
+    const uint32 hashCode = hash( key );
+    uint32 binIndex = findBinForKey( key, hashCode );
 
     if ( isBinEmpty( binIndex ) )
     {
         ++_binsInUse;
         _bins[binIndex] = _pairs.size();
 
-        V value;
+        V value = V();
         _pairs.push( makePair( key, value ) );
+        filterHash( hashCode );
     }
 
     return _pairs[_bins[binIndex]].value;
 }
 
 // MEMBER FUNCTIONS
-template <typename K, typename V>
-void Map<K, V>::put( const K& key, const V& value )
+template <typename K, typename V, template <typename> class A>
+void Map<K, V, A>::put( const K& key, const V& value )
 {
-    uint32 binIndex = findBinForKey( key );
+    if ( shouldGrow() )
+    {
+        grow();
+    }
+
+    const uint32 hashCode = hash( key );
+    uint32 binIndex = findBinForKey( key, hashCode );
 
     if ( isBinEmpty( binIndex ) )
     {
         ++_binsInUse;
         _bins[binIndex] = _pairs.size();
         _pairs.push( makePair( key, value ) );
+        filterHash( hashCode );
     }
     else
     {
@@ -657,16 +815,23 @@ void Map<K, V>::put( const K& key, const V& value )
     }
 }
 
-template <typename K, typename V>
-void Map<K, V>::put( const K& key, V&& value )
+template <typename K, typename V, template <typename> class A>
+void Map<K, V, A>::put( const K& key, V&& value )
 {
-    uint32 binIndex = findBinForKey( key );
+    if ( shouldGrow() )
+    {
+        grow();
+    }
+
+    const uint32 hashCode = hash( key );
+    uint32 binIndex = findBinForKey( key, hashCode );
 
     if ( isBinEmpty( binIndex ) )
     {
         ++_binsInUse;
         _bins[binIndex] = _pairs.size();
         _pairs.push( makePair( key, std::move( value ) ) );
+        filterHash( hashCode );
     }
     else
     {
@@ -674,99 +839,223 @@ void Map<K, V>::put( const K& key, V&& value )
     }
 }
 
-template <typename K, typename V>
-V Map<K, V>::remove( const K& key )
+template <typename K, typename V, template <typename> class A>
+V Map<K, V, A>::remove( const K& key )
 {
     if ( shouldShrink() )
     {
         shrink();
     }
 
-    uint32 binIndex = findBinForKey( key );
-    uint32 i;
-
+    const uint32 binIndex = findBinForKey( key );
     assert( !isBinEmpty( binIndex ) );
 
-    --_binsInUse;
-    V value( _pairs.removeAt( _bins[binIndex] ).value );
+    return removeBin( binIndex );
+}
+
+template <typename K, typename V, template <typename> class A>
+bool Map<K, V, A>::remove( const K& key, V* value )
+{
+    const uint32 hashCode = hash( key );
+    if ( !mayContainHash( hashCode ) )
+    {
+        return false;
+    }
+
+    if ( shouldShrink() )
+    {
+        shrink();
+    }
+
+    const uint32 binIndex = findBinForKey( key, hashCode );
+    if ( isBinEmpty( binIndex ) )
+    {
+        return false;
+    }
 
-    // correct bin indices
-    for ( i = 0; i < _binCount; ++i )
+    if ( value != nullptr )
+    {
+        *value = removeBin( binIndex );
+    }
+    else
     {
-        if ( !isBinEmpty( i ) && _bins[i] > _bins[binIndex] )
-        {
-            --( _bins[i] );
-        }
+        removeBin( binIndex );
     }
 
-    _bins[binIndex] = BIN_EMPTY;
+    return true;
+}
+
+template <typename K, typename V, template <typename> class A>
+V Map<K, V, A>::removeBin( uint32 binIndex )
+{
+    uint32 pairIndex;
+    uint32 lastIndex;
+
+    // move the last pair into the hole so only its bin has to be corrected
+    pairIndex = _bins[binIndex];
+    lastIndex = _pairs.size() - 1;
+    if ( pairIndex != lastIndex )
+    {
+        _bins[findBinForKey( _pairs[lastIndex].key )] = pairIndex;
+        std::swap( _pairs[pairIndex], _pairs[lastIndex] );
+    }
+
+    --_binsInUse;
+    V value( _pairs.pop().value );
+
+    ++_binsRemoved;
+    _bins[binIndex] = BIN_REMOVED;
 
     return value;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::has( const K& key ) const
+bool Map<K, V, A>::has( const K& key ) const
 {
-    return !isBinEmpty( findBinForKey( key ) );
+    const uint32 hashCode = hash( key );
+    return mayContainHash( hashCode ) &&
+           !isBinEmpty( findBinForKey( key, hashCode ) );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
+inline
+const V* Map<K, V, A>::find( const K& key ) const
+{
+    const uint32 hashCode = hash( key );
+    if ( !mayContainHash( hashCode ) )
+    {
+        return nullptr;
+    }
+
+    const uint32 binIndex = findBinForKey( key, hashCode );
+    return isBinEmpty( binIndex ) ? nullptr : &_pairs[_bins[binIndex]].value;
+}
+
+template <typename K, typename V, template <typename> class A>
+inline
+V* Map<K, V, A>::find( const K& key )
+{
+    const uint32 hashCode = hash( key );
+    if ( !mayContainHash( hashCode ) )
+    {
+        return nullptr;
+    }
+
+    const uint32 binIndex = findBinForKey( key, hashCode );
+    return isBinEmpty( binIndex ) ? nullptr : &_pairs[_bins[binIndex]].value;
+}
+
+template <typename K, typename V, template <typename> class A>
 inline
-void Map<K, V>::clear()
+void Map<K, V, A>::clear()
 {
     clearBins();
     _pairs.clear();
     _binsInUse = 0;
+    _binsRemoved = 0;
+
+    if ( _filter != nullptr )
+    {
+        _filter->clear();
+    }
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
+void Map<K, V, A>::enableFilter()
+{
+    if ( _filter == nullptr )
+    {
+        _filter = new BloomFilter<K, A>( policy() );
+    }
+
+    _filter->resize( _binCount );
+
+    uint32 i;
+    for ( i = 0; i < _pairs.size(); ++i )
+    {
+        _filter->addHash( hash( _pairs[i].key ) );
+    }
+}
+
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator Map<K, V>::cbegin() const
+bool Map<K, V, A>::isFiltered() const
+{
+    return _filter != nullptr;
+}
+
+template <typename K, typename V, template <typename> class A>
+inline
+typename Map<K, V, A>::ConstIterator Map<K, V, A>::cbegin() const
 {
     return ConstIterator( this, 0 );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator Map<K, V>::cend() const
+typename Map<K, V, A>::ConstIterator Map<K, V, A>::cend() const
 {
     return ConstIterator( this, _pairs.size() );
 }
 
-//template <typename K, typename V>
+//template <typename K, typename V, template <typename> class A>
 //inline
-//typename Map<K, V>::ConstKeyIterator Map<K, V>::cKeysBegin() const
+//typename Map<K, V, A>::ConstKeyIterator Map<K, V, A>::cKeysBegin() const
 //{
 //    return ConstKeyIterator( this, 0 );
 //}
 //
-//template <typename K, typename V>
+//template <typename K, typename V, template <typename> class A>
 //inline
-//typename Map<K, V>::ConstKeyIterator Map<K, V>::cKeysEnd() const
+//typename Map<K, V, A>::ConstKeyIterator Map<K, V, A>::cKeysEnd() const
 //{
 //    return ConstKeyIterator( this, _pairs.size() );
 //}
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-uint32 Map<K, V>::size() const
+uint32 Map<K, V, A>::size() const
 {
     return _pairs.size();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::isEmpty() const
+bool Map<K, V, A>::isEmpty() const
 {
     return _pairs.isEmpty();
 }
 
 // HELPER FUNCTIONS
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::Pair
-Map<K, V>::makePair( const K& key, const V& value ) const
+A<uint32>& Map<K, V, A>::policy()
+{
+    return *this;
+}
+
+template <typename K, typename V, template <typename> class A>
+inline
+void Map<K, V, A>::filterHash( uint32 hashCode )
+{
+    if ( _filter != nullptr )
+    {
+        _filter->addHash( hashCode );
+    }
+}
+
+template <typename K, typename V, template <typename> class A>
+inline
+bool Map<K, V, A>::mayContainHash( uint32 hashCode ) const
+{
+    return _filter == nullptr || _filter->mayContainHash( hashCode );
+}
+
+template <typename K, typename V, template <typename> class A>
+inline
+typename Map<K, V, A>::Pair
+Map<K, V, A>::makePair( const K& key, const V& value ) const
 {
     Pair pair;
     pair.key = key;
@@ -774,10 +1063,10 @@ Map<K, V>::makePair( const K& key, const V& value ) const
     return pair;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::Pair
-Map<K, V>::makePair( const K& key, V&& value ) const
+typename Map<K, V, A>::Pair
+Map<K, V, A>::makePair( const K& key, V&& value ) const
 {
     Pair pair;
     pair.key = key;
@@ -785,11 +1074,17 @@ Map<K, V>::makePair( const K& key, V&& value ) const
     return pair;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-uint32 Map<K, V>::findBinForKey( const K& key ) const
+uint32 Map<K, V, A>::findBinForKey( const K& key ) const
+{
+    return findBinForKey( key, hash( key ) );
+}
+
+template <typename K, typename V, template <typename> class A>
+inline
+uint32 Map<K, V, A>::findBinForKey( const K& key, uint32 hashCode ) const
 {
-    const uint32 hashCode = hash( key );
     uint32 i;
     uint32 probes;
     for ( i = wrap( hashCode ), probes = 0;
@@ -802,132 +1097,163 @@ uint32 Map<K, V>::findBinForKey( const K& key ) const
     return i;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-uint32 Map<K, V>::hash( const K& key ) const
+uint32 Map<K, V, A>::hash( const K& key ) const
 {
     return _hashFunc( key );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-uint32 Map<K, V>::probe( uint32 probes ) const
+uint32 Map<K, V, A>::probe( uint32 probes ) const
 {
     return probes;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-uint32 Map<K, V>::wrap( uint32 index ) const
+uint32 Map<K, V, A>::wrap( uint32 index ) const
 {
     return index & ( _binCount - 1 );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::isBinEmpty( uint32 binIndex ) const
+bool Map<K, V, A>::isBinEmpty( uint32 binIndex ) const
 {
     assert( binIndex < _binCount );
     return _bins[binIndex] == BIN_EMPTY;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
+inline
+bool Map<K, V, A>::isBinRemoved( uint32 binIndex ) const
+{
+    assert( binIndex < _binCount );
+    return _bins[binIndex] == BIN_REMOVED;
+}
+
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::doesBinContain( uint32 binIndex, const K& key ) const
+bool Map<K, V, A>::doesBinContain( uint32 binIndex, const K& key ) const
 {
     return binIndex < _binCount && !isBinEmpty( binIndex ) &&
-       _pairs[_bins[binIndex]].key == key;
+       !isBinRemoved( binIndex ) && _pairs[_bins[binIndex]].key == key;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::shouldShrink() const
+bool Map<K, V, A>::shouldShrink() const
 {
     return ( ( _binsInUse * 100 ) / _binCount ) <= SHRINK_THRESHOLD &&
            _binCount > MIN_BINS;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::shouldGrow() const
+bool Map<K, V, A>::shouldGrow() const
 {
-    return ( ( _binsInUse * 100 ) / _binCount ) >= GROW_THRESHOLD;
+    return ( ( ( _binsInUse + _binsRemoved ) * 100 ) / _binCount ) >=
+           GROW_THRESHOLD;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-void Map<K, V>::grow()
+void Map<K, V, A>::grow()
 {
-    resize( _binCount << 1 );
+    // doubling would leave the map small enough to shrink right back, so
+    // the removed bins are reclaimed without changing the size
+    if ( ( _binsInUse * 100 ) / ( _binCount << 1 ) <= SHRINK_THRESHOLD )
+    {
+        resize( _binCount );
+    }
+    else
+    {
+        resize( _binCount << 1 );
+    }
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-void Map<K, V>::shrink()
+void Map<K, V, A>::shrink()
 {
     resize( _binCount >> 1 );
 }
 
-template <typename K, typename V>
-void Map<K, V>::resize( uint32 newSize )
+template <typename K, typename V, template <typename> class A>
+void Map<K, V, A>::resize( uint32 newSize )
 {
     assert( _bins != nullptr );
-    _binAlloc.release( _bins, _binCount );
-    _bins = _binAlloc.get( newSize );
-    _binCount = newSize;
+    if ( newSize != _binCount )
+    {
+        policy().release( _bins, _binCount );
+        _bins = policy().get( newSize );
+        _binCount = newSize;
+    }
+
+    _binsRemoved = 0;
     clearBins();
 
+    if ( _filter != nullptr )
+    {
+        _filter->resize( _binCount );
+    }
+
     uint32 i;
     uint32 pos;
+    uint32 hashCode;
     for ( i = 0; i < _pairs.size(); ++i )
     {
-        pos = findBinForKey( _pairs[i].key );
+        hashCode = hash( _pairs[i].key );
+        pos = findBinForKey( _pairs[i].key, hashCode );
         _bins[pos] = i;
+        filterHash( hashCode );
     }
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-void Map<K, V>::clearBins()
+void Map<K, V, A>::clearBins()
 {
     mem::MemoryUtils::set( _bins, BIN_EMPTY, _binCount );
 }
 
 // VALUE ITERATOR CONSTRUCTORS
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::ConstIterator::ConstIterator()
+Map<K, V, A>::ConstIterator::ConstIterator()
     : _iterValues( nullptr ), _iterIndex( 0 )
 {
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::ConstIterator::ConstIterator( const Map<K, V>* map,
+Map<K, V, A>::ConstIterator::ConstIterator( const Map<K, V, A>* map,
                                                    uint32 index )
     : _iterValues( &( map->_pairs ) ), _iterIndex( index )
 {
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::ConstIterator::ConstIterator(
+Map<K, V, A>::ConstIterator::ConstIterator(
     const ConstIterator& iter )
     : _iterValues( iter._iterValues ), _iterIndex( iter._iterIndex )
 {
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-Map<K, V>::ConstIterator::~ConstIterator()
+Map<K, V, A>::ConstIterator::~ConstIterator()
 {
 }
 
 // VALUE ITERATOR OPERATORS
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator&
-Map<K, V>::ConstIterator::operator=( const ConstIterator& iter )
+typename Map<K, V, A>::ConstIterator&
+Map<K, V, A>::ConstIterator::operator=( const ConstIterator& iter )
 {
     _iterValues = iter._iterValues;
     _iterIndex = iter._iterIndex;
@@ -935,67 +1261,69 @@ Map<K, V>::ConstIterator::operator=( const ConstIterator& iter )
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator&
-Map<K, V>::ConstIterator::operator++()
+typename Map<K, V, A>::ConstIterator&
+Map<K, V, A>::ConstIterator::operator++()
 {
     ++_iterIndex;
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator&
-Map<K, V>::ConstIterator::operator++( int32 )
+typename Map<K, V, A>::ConstIterator&
+Map<K, V, A>::ConstIterator::operator++( int32 )
 {
     ++_iterIndex;
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator&
-Map<K, V>::ConstIterator::operator--()
+typename Map<K, V, A>::ConstIterator&
+Map<K, V, A>::ConstIterator::operator--()
 {
     --_iterIndex;
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-typename Map<K, V>::ConstIterator&
-Map<K, V>::ConstIterator::operator--( int32 )
+typename Map<K, V, A>::ConstIterator&
+Map<K, V, A>::ConstIterator::operator--( int32 )
 {
     --_iterIndex;
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-const typename Map<K, V>::Pair& Map<K, V>::ConstIterator::operator*() const
+const typename Map<K, V, A>::Pair&
+Map<K, V, A>::ConstIterator::operator*() const
 {
     return ( *_iterValues )[_iterIndex];
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-const typename Map<K, V>::Pair* Map<K, V>::ConstIterator::operator->() const
+const typename Map<K, V, A>::Pair*
+Map<K, V, A>::ConstIterator::operator->() const
 {
     return &( *_iterValues )[_iterIndex];
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::ConstIterator::operator==(
+bool Map<K, V, A>::ConstIterator::operator==(
     const ConstIterator& iter ) const
 {
     return _iterValues == iter._iterValues && _iterIndex == iter._iterIndex;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, template <typename> class A>
 inline
-bool Map<K, V>::ConstIterator::operator!=(
+bool Map<K, V, A>::ConstIterator::operator!=(
     const ConstIterator& iter ) const
 {
     return _iterValues != iter._iterValues || _iterIndex != iter._iterIndex;
@@ -0,0 +1,699 @@
+// priority_queue.h
+//
+// The priority queue is a binary (or d-ary) heap stored in a dynamic array.
+// The value at the top of the queue is the one that has priority over every
+// other value according to the comparison, i.e. compare( top, other ) is
+// true. Using std::less therefore yields a min-queue which is what timers
+// and path finding open sets usually want.
+//
+// The arity of the heap is configurable. A 4-ary heap is shallower than a
+// binary heap and the children of a node are adjacent in mem so each pop
+// touches fewer cache lines which pays off for large queues.
+//
+// Position tracking can optionally be enabled. This keeps a map from each
+// value to its index in the heap which allows values to be updated (e.g.
+// decrease-key) or removed in O(log n) time. While tracking is enabled every
+// value in the queue must be unique. Values must be equality comparable.
+// The map is only created when tracking is enabled so untracked queues do
+// not pay for it, and it can be given its own allocators like the heap.
+//
+#ifndef NGE_CNTR_PRIORITY_QUEUE_H
+#define NGE_CNTR_PRIORITY_QUEUE_H
+
+#include <assert.h>
+#include <functional>
+#include <utility>
+
+#include "engine/containers/dynamic_array.h"
+#include "engine/containers/map.h"
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, typename Compare = std::less<T>, uint32 ARITY = 2>
+class PriorityQueue
+{
+    static_assert( ARITY >= 2, "A heap must have an arity of at least two." );
+
+  public:
+    // TYPES
+    /**
+     * Defines the map from each value to its index in the heap.
+     *
+     * The map uses the allocator guard for the same reason the heap does.
+     */
+    typedef Map<T, uint32, mem::AllocatorGuard> Positions;
+
+    /**
+     * Defines a pair in the positions map.
+     */
+    typedef typename Positions::Pair Pair;
+
+  private:
+    // MEMBERS
+    /**
+     * The heap.
+     *
+     * The heap uses the allocator guard since the allocator of the queue is
+     * chosen at runtime.
+     */
+    DynamicArray<T, mem::AllocatorGuard> _heap;
+
+    /**
+     * The comparison that determines priority.
+     */
+    Compare _compare;
+
+    /**
+     * The index of each value in the heap or null if tracking is not
+     * enabled.
+     */
+    Positions* _positions;
+
+    // HELPER FUNCTIONS
+    /**
+     * Moves the value at the given index up until its parent has priority.
+     */
+    void siftUp( uint32 index );
+
+    /**
+     * Moves the value at the given index down until it has priority over all
+     * of its children.
+     */
+    void siftDown( uint32 index );
+
+    /**
+     * Restores the heap property for the value at the given index after it
+     * has been replaced.
+     */
+    void restore( uint32 index );
+
+    /**
+     * Moves the value into the heap at the given index and records its
+     * position if tracking is enabled.
+     */
+    void place( uint32 index, T&& value );
+
+    /**
+     * Restores the heap property for the entire array in linear time.
+     */
+    void build();
+
+    /**
+     * Records the positions of every value in the heap.
+     */
+    void trackAll();
+
+    /**
+     * Gets the index of the parent of the given index.
+     */
+    static uint32 parent( uint32 index );
+
+    /**
+     * Gets the index of the first child of the given index.
+     */
+    static uint32 firstChild( uint32 index );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new priority queue.
+     */
+    PriorityQueue();
+
+    /**
+     * Constructs a new priority queue with the given initial capacity.
+     */
+    PriorityQueue( uint32 capacity );
+
+    /**
+     * Constructs a new priority queue that uses the given comparison.
+     */
+    PriorityQueue( const Compare& compare );
+
+    /**
+     * Constructs a new priority queue using the given allocator.
+     */
+    PriorityQueue( mem::IAllocator<T>* alloc );
+
+    /**
+     * Constructs a new priority queue using the given allocator, initial
+     * capacity and comparison.
+     */
+    PriorityQueue( mem::IAllocator<T>* alloc, uint32 capacity,
+                   const Compare& compare );
+
+    /**
+     * Constructs a copy of the given queue.
+     */
+    PriorityQueue( const PriorityQueue<T, Compare, ARITY>& queue );
+
+    /**
+     * Moves the queue to a new instance.
+     */
+    PriorityQueue( PriorityQueue<T, Compare, ARITY>&& queue );
+
+    /**
+     * Destructs the queue.
+     */
+    ~PriorityQueue();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given queue.
+     */
+    PriorityQueue<T, Compare, ARITY>& operator=(
+        const PriorityQueue<T, Compare, ARITY>& queue );
+
+    /**
+     * Moves the queue data to this instance.
+     */
+    PriorityQueue<T, Compare, ARITY>& operator=(
+        PriorityQueue<T, Compare, ARITY>&& queue );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Enables position tracking using the given hash function.
+     *
+     * The hash function must spread the values across the bins of the
+     * positions map or lookups degrade to linear time.
+     *
+     * The positions of the values already in the queue are recorded.
+     */
+    void enableTracking( const std::function<uint32( const T& )>& hashFunc );
+
+    /**
+     * Enables position tracking using the given hash function and the
+     * given allocators for the positions map.
+     *
+     * The positions of the values already in the queue are recorded.
+     */
+    void enableTracking( const std::function<uint32( const T& )>& hashFunc,
+                         mem::IAllocator<Pair>* pairAlloc,
+                         mem::IAllocator<uint32>* binAlloc );
+
+    /**
+     * Adds a copy of the value to the queue.
+     */
+    void push( const T& value );
+
+    /**
+     * Moves the value into the queue.
+     */
+    void push( T&& value );
+
+    /**
+     * Replaces the contents of the queue with the given values.
+     *
+     * This builds the heap in O(n) rather than the O(n log n) that pushing
+     * each value would take.
+     */
+    void heapify( const T* values, uint32 count );
+
+    /**
+     * Removes the value at the top of the queue.
+     *
+     * Behavior is undefined when:
+     * the queue is empty
+     */
+    T pop();
+
+    /**
+     * Gets the value at the top of the queue.
+     *
+     * Behavior is undefined when:
+     * the queue is empty
+     */
+    const T& top() const;
+
+    /**
+     * Replaces a value in the queue and moves it to its new position.
+     *
+     * This is used to decrease (or increase) the key of a value. Returns
+     * false if the value was not in the queue.
+     *
+     * Behavior is undefined when:
+     * tracking is not enabled
+     */
+    bool update( const T& value, const T& newValue );
+
+    /**
+     * Removes the given value from the queue and returns if it was found.
+     *
+     * Behavior is undefined when:
+     * tracking is not enabled
+     */
+    bool remove( const T& value );
+
+    /**
+     * Checks if the value is in the queue.
+     *
+     * This is O(1) when tracking is enabled and O(n) otherwise.
+     */
+    bool has( const T& value ) const;
+
+    /**
+     * Removes all values from the queue.
+     */
+    void clear();
+
+    /**
+     * Checks if positions are being tracked.
+     */
+    bool isTracking() const;
+
+    /**
+     * Gets the number of values in the queue.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the queue is empty.
+     */
+    bool isEmpty() const;
+};
+
+// CONSTRUCTORS
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue()
+    : _heap(), _compare(), _positions( nullptr )
+{
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue( uint32 capacity )
+    : _heap( capacity ), _compare(), _positions( nullptr )
+{
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue( const Compare& compare )
+    : _heap(), _compare( compare ), _positions( nullptr )
+{
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue( mem::IAllocator<T>* alloc )
+    : _heap( alloc ), _compare(), _positions( nullptr )
+{
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue( mem::IAllocator<T>* alloc,
+                                                 uint32 capacity,
+                                                 const Compare& compare )
+    : _heap( alloc, capacity ), _compare( compare ), _positions( nullptr )
+{
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue(
+    const PriorityQueue<T, Compare, ARITY>& queue )
+    : _heap( queue._heap ), _compare( queue._compare ), _positions( nullptr )
+{
+    if ( queue._positions != nullptr )
+    {
+        _positions = new Positions( *queue._positions );
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::PriorityQueue(
+    PriorityQueue<T, Compare, ARITY>&& queue )
+    : _heap( std::move( queue._heap ) ),
+      _compare( std::move( queue._compare ) ),
+      _positions( queue._positions )
+{
+    queue._positions = nullptr;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>::~PriorityQueue()
+{
+    delete _positions;
+}
+
+// OPERATORS
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>& PriorityQueue<T, Compare, ARITY>::operator=(
+    const PriorityQueue<T, Compare, ARITY>& queue )
+{
+    if ( this == &queue )
+    {
+        return *this;
+    }
+
+    _heap = queue._heap;
+    _compare = queue._compare;
+
+    delete _positions;
+    _positions = nullptr;
+    if ( queue._positions != nullptr )
+    {
+        _positions = new Positions( *queue._positions );
+    }
+
+    return *this;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+PriorityQueue<T, Compare, ARITY>& PriorityQueue<T, Compare, ARITY>::operator=(
+    PriorityQueue<T, Compare, ARITY>&& queue )
+{
+    if ( this == &queue )
+    {
+        return *this;
+    }
+
+    _heap = std::move( queue._heap );
+    _compare = std::move( queue._compare );
+
+    delete _positions;
+    _positions = queue._positions;
+    queue._positions = nullptr;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::enableTracking(
+    const std::function<uint32( const T& )>& hashFunc )
+{
+    enableTracking( hashFunc, nullptr, nullptr );
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::enableTracking(
+    const std::function<uint32( const T& )>& hashFunc,
+    mem::IAllocator<Pair>* pairAlloc,
+    mem::IAllocator<uint32>* binAlloc )
+{
+    delete _positions;
+    _positions = new Positions( pairAlloc, binAlloc, _heap.size(),
+                                hashFunc );
+    trackAll();
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+void PriorityQueue<T, Compare, ARITY>::push( const T& value )
+{
+    push( T( value ) );
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::push( T&& value )
+{
+    assert( _positions == nullptr || !_positions->has( value ) );
+
+    _heap.push( std::move( value ) );
+    if ( _positions != nullptr )
+    {
+        ( *_positions )[_heap[_heap.size() - 1]] = _heap.size() - 1;
+    }
+
+    siftUp( _heap.size() - 1 );
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::heapify( const T* values,
+                                                uint32 count )
+{
+    assert( values != nullptr || count == 0 );
+
+    _heap.clear();
+
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        _heap.push( values[i] );
+    }
+
+    // record the positions once the heap is built rather than on every move
+    Positions* positions = _positions;
+    _positions = nullptr;
+    build();
+    _positions = positions;
+
+    if ( _positions != nullptr )
+    {
+        _positions->clear();
+        trackAll();
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+T PriorityQueue<T, Compare, ARITY>::pop()
+{
+    assert( !_heap.isEmpty() );
+
+    T value = std::move( _heap[0] );
+    T last = _heap.pop();
+
+    if ( _positions != nullptr )
+    {
+        _positions->remove( value );
+    }
+
+    if ( !_heap.isEmpty() )
+    {
+        place( 0, std::move( last ) );
+        siftDown( 0 );
+    }
+
+    return value;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+const T& PriorityQueue<T, Compare, ARITY>::top() const
+{
+    assert( !_heap.isEmpty() );
+    return _heap[0];
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+bool PriorityQueue<T, Compare, ARITY>::update( const T& value,
+                                               const T& newValue )
+{
+    assert( _positions != nullptr );
+
+    if ( !_positions->has( value ) )
+    {
+        return false;
+    }
+
+    const uint32 index = _positions->remove( value );
+    assert( !_positions->has( newValue ) );
+
+    place( index, T( newValue ) );
+    restore( index );
+
+    return true;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+bool PriorityQueue<T, Compare, ARITY>::remove( const T& value )
+{
+    assert( _positions != nullptr );
+
+    if ( !_positions->has( value ) )
+    {
+        return false;
+    }
+
+    const uint32 index = _positions->remove( value );
+    T last = _heap.pop();
+
+    if ( index < _heap.size() )
+    {
+        place( index, std::move( last ) );
+        restore( index );
+    }
+
+    return true;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+bool PriorityQueue<T, Compare, ARITY>::has( const T& value ) const
+{
+    return _positions != nullptr ? _positions->has( value )
+                                 : _heap.has( value );
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+void PriorityQueue<T, Compare, ARITY>::clear()
+{
+    _heap.clear();
+    if ( _positions != nullptr )
+    {
+        _positions->clear();
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+bool PriorityQueue<T, Compare, ARITY>::isTracking() const
+{
+    return _positions != nullptr;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+uint32 PriorityQueue<T, Compare, ARITY>::size() const
+{
+    return _heap.size();
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+bool PriorityQueue<T, Compare, ARITY>::isEmpty() const
+{
+    return _heap.isEmpty();
+}
+
+// HELPER FUNCTIONS
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::siftUp( uint32 index )
+{
+    if ( index == 0 )
+    {
+        return;
+    }
+
+    // move the parents down into the hole rather than swapping
+    T value = std::move( _heap[index] );
+    uint32 up;
+    while ( index > 0 && _compare( value, _heap[up = parent( index )] ) )
+    {
+        place( index, std::move( _heap[up] ) );
+        index = up;
+    }
+
+    place( index, std::move( value ) );
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::siftDown( uint32 index )
+{
+    const uint32 count = _heap.size();
+    T value = std::move( _heap[index] );
+
+    uint32 child;
+    uint32 last;
+    uint32 best;
+    uint32 i;
+    while ( ( child = firstChild( index ) ) < count )
+    {
+        // find the child with the highest priority
+        last = std::min( child + ARITY, count );
+        for ( i = child + 1, best = child; i < last; ++i )
+        {
+            if ( _compare( _heap[i], _heap[best] ) )
+            {
+                best = i;
+            }
+        }
+
+        if ( !_compare( _heap[best], value ) )
+        {
+            break;
+        }
+
+        place( index, std::move( _heap[best] ) );
+        index = best;
+    }
+
+    place( index, std::move( value ) );
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+void PriorityQueue<T, Compare, ARITY>::restore( uint32 index )
+{
+    if ( index > 0 && _compare( _heap[index], _heap[parent( index )] ) )
+    {
+        siftUp( index );
+    }
+    else
+    {
+        siftDown( index );
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+void PriorityQueue<T, Compare, ARITY>::place( uint32 index, T&& value )
+{
+    _heap[index] = std::move( value );
+    if ( _positions != nullptr )
+    {
+        ( *_positions )[_heap[index]] = index;
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::build()
+{
+    if ( _heap.size() < 2 )
+    {
+        return;
+    }
+
+    // sift down every node that has children starting from the last one
+    uint32 i;
+    for ( i = parent( _heap.size() - 1 ) + 1; i > 0; --i )
+    {
+        siftDown( i - 1 );
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+void PriorityQueue<T, Compare, ARITY>::trackAll()
+{
+    uint32 i;
+    for ( i = 0; i < _heap.size(); ++i )
+    {
+        assert( !_positions->has( _heap[i] ) );
+        ( *_positions )[_heap[i]] = i;
+    }
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+uint32 PriorityQueue<T, Compare, ARITY>::parent( uint32 index )
+{
+    return ( index - 1 ) / ARITY;
+}
+
+template <typename T, typename Compare, uint32 ARITY>
+inline
+uint32 PriorityQueue<T, Compare, ARITY>::firstChild( uint32 index )
+{
+    return index * ARITY + 1;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif // NGE_CNTR_PRIORITY_QUEUE_H
@@ -0,0 +1,908 @@
+// segmented_array.h
+//
+// The segmented array is a double ended array that stores its items in fixed
+// size blocks. Growing only ever allocates a new block so items are never
+// moved and pointers to them remain valid until they are removed.
+//
+// Indexing goes through a table of blocks. The block size is a power of two
+// so finding the block and the slot of an index is a shift and a mask. Items
+// may be pushed or popped at either end in O(1) time.
+//
+// One empty block is kept as a spare so that pushing and popping repeatedly
+// across a block boundary does not allocate and release each time.
+//
+#ifndef NGE_CNTR_SEGMENTED_ARRAY_H
+#define NGE_CNTR_SEGMENTED_ARRAY_H
+
+#include <assert.h>
+#include <stdexcept>
+#include <utility>
+
+#include "engine/containers/dynamic_array.h"
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+#include "engine/port.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T>
+class SegmentedArray
+{
+  private:
+    // CLASSES
+    /**
+     * Defines an iterator for the array.
+     */
+    template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+    class SegmentedIterator
+    {
+        // MEMBERS
+        /**
+         * The array that is being iterated.
+         */
+        APTR _iterArray;
+
+        /**
+         * The current index in the array.
+         */
+        uint32 _iterIndex;
+
+      public:
+        // CONSTRUCTORS
+        /**
+         * Constructs a new iterator.
+         */
+        SegmentedIterator();
+
+        /**
+         * Constructs an iterator for an array starting at the given index.
+         */
+        SegmentedIterator( APTR array, uint32 index );
+
+        /**
+         * Constructs a copy of the given iterator.
+         */
+        SegmentedIterator( const SegmentedIterator& iter );
+
+        /**
+         * Destructs the iterator.
+         */
+        ~SegmentedIterator();
+
+        // OPERATORS
+        /**
+         * Assigns this as a copy of the other iterator.
+         */
+        SegmentedIterator& operator=( const SegmentedIterator& iter );
+
+        /**
+         * Moves to the next item.
+         */
+        SegmentedIterator& operator++();
+
+        /**
+         * Moves to the next item.
+         */
+        SegmentedIterator& operator++( int32 );
+
+        /**
+         * Moves to the previous item.
+         */
+        SegmentedIterator& operator--();
+
+        /**
+         * Moves to the previous item.
+         */
+        SegmentedIterator& operator--( int32 );
+
+        /**
+         * Gets the element at the current position.
+         */
+        CTREF operator*() const;
+
+        /**
+         * Gets the element at the current position.
+         */
+        TREF operator*();
+
+        /**
+         * Gets the element at the current position.
+         */
+        TPTR operator->() const;
+
+        /**
+         * Gets the element at the current position.
+         */
+        TPTR operator->();
+
+        /**
+         * Checks if the other iterator is at the same position.
+         */
+        bool operator==( const SegmentedIterator& iter ) const;
+
+        /**
+         * Checks if the other iterator is not at the same position.
+         */
+        bool operator!=( const SegmentedIterator& iter ) const;
+    };
+
+    // CONSTANTS
+    /**
+     * The default number of items in a block.
+     */
+    static constexpr uint32 DEFAULT_BLOCK_SIZE = 64;
+
+    // MEMBERS
+    /**
+     * The block allocator.
+     */
+    mem::AllocatorGuard<T> _allocator;
+
+    /**
+     * The block table.
+     */
+    DynamicArray<T*> _blocks;
+
+    /**
+     * An empty block that is kept for reuse.
+     */
+    T* _spare;
+
+    /**
+     * The slot of the first item in the first block.
+     */
+    uint32 _first;
+
+    /**
+     * The number of items in the array.
+     */
+    uint32 _size;
+
+    /**
+     * The number of items in each block.
+     */
+    uint32 _blockSize;
+
+    /**
+     * The number of bits to shift an index by to get its block.
+     */
+    uint32 _blockShift;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets an empty block.
+     */
+    T* acquireBlock();
+
+    /**
+     * Releases the block, keeping it as the spare if there isn't one.
+     */
+    void releaseBlock( T* block );
+
+    /**
+     * Releases all of the blocks including the spare.
+     */
+    void releaseBlocks();
+
+    /**
+     * Copies the items of the given array to the end of this one.
+     */
+    void copyItems( const SegmentedArray<T>& array );
+
+    /**
+     * Rounds the block size up to a power of two and sets the block shift.
+     */
+    void initBlockSize( uint32 blockSize );
+
+    /**
+     * Gets the item at the given position relative to the first block.
+     */
+    T& getAt( uint32 position ) const;
+
+  public:
+    // TYPES
+    /**
+     * Defines an iterator for the array.
+     */
+    typedef SegmentedIterator<SegmentedArray<T>*, T&, const T&, T*> Iterator;
+
+    /**
+     * Defines a constant iterator for the array.
+     */
+    typedef SegmentedIterator<const SegmentedArray<T>*, const T&, const T&,
+                              const T*> ConstIterator;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new segmented array.
+     */
+    SegmentedArray();
+
+    /**
+     * Constructs a new segmented array using the given allocator.
+     */
+    SegmentedArray( mem::IAllocator<T>* allocator );
+
+    /**
+     * Constructs a new segmented array with the given number of items per
+     * block.
+     *
+     * The block size is rounded up to the next power of two.
+     */
+    SegmentedArray( uint32 blockSize );
+
+    /**
+     * Constructs a new segmented array using the given allocator and number
+     * of items per block.
+     */
+    SegmentedArray( mem::IAllocator<T>* allocator, uint32 blockSize );
+
+    /**
+     * Constructs a copy of the given array.
+     */
+    SegmentedArray( const SegmentedArray<T>& array );
+
+    /**
+     * Moves the array data to a new instance.
+     *
+     * Pointers to the items remain valid.
+     */
+    SegmentedArray( SegmentedArray<T>&& array );
+
+    /**
+     * Destructs the array.
+     */
+    ~SegmentedArray();
+
+    // OPERATORS
+    /**
+     * Makes this array a copy of another.
+     */
+    SegmentedArray<T>& operator=( const SegmentedArray<T>& array );
+
+    /**
+     * Moves the data from the other array to this one.
+     */
+    SegmentedArray<T>& operator=( SegmentedArray<T>&& array );
+
+    /**
+     * Gets the value at the given index.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    const T& operator[]( uint32 index ) const;
+
+    /**
+     * Gets the value at the given index.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    T& operator[]( uint32 index );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the value at the given index.
+     *
+     * Throws a runtime_error when:
+     * index is out of bounds
+     */
+    T& at( uint32 index ) const;
+
+    /**
+     * Adds the value to the end of the array.
+     */
+    void push( const T& value );
+
+    /**
+     * Moves the value to the end of the array.
+     */
+    void push( T&& value );
+
+    /**
+     * Adds the value to the front of the array.
+     */
+    void pushFront( const T& value );
+
+    /**
+     * Moves the value to the front of the array.
+     */
+    void pushFront( T&& value );
+
+    /**
+     * Removes the value at the back of the array.
+     */
+    T pop();
+
+    /**
+     * Removes the value at the front of the array.
+     */
+    T popFront();
+
+    /**
+     * Removes all items from the array and releases the blocks.
+     */
+    void clear();
+
+    /**
+     * Gets an iterator at the start of the array.
+     */
+    Iterator begin();
+
+    /**
+     * Gets a constant iterator at the start of the array.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator at the end of the array.
+     */
+    Iterator end();
+
+    /**
+     * Gets a constant iterator at the end of the array.
+     */
+    ConstIterator cend() const;
+
+    /**
+     * Gets the size of the array.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of items in each block.
+     */
+    uint32 blockSize() const;
+
+    /**
+     * Gets the number of blocks in use.
+     */
+    uint32 blockCount() const;
+
+    /**
+     * Checks if the array is empty.
+     */
+    bool isEmpty() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 SegmentedArray<T>::DEFAULT_BLOCK_SIZE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+SegmentedArray<T>::SegmentedArray()
+    : _allocator(), _blocks(), _spare( nullptr ), _first( 0 ), _size( 0 ),
+      _blockSize( 0 ), _blockShift( 0 )
+{
+    initBlockSize( DEFAULT_BLOCK_SIZE );
+}
+
+template <typename T>
+inline
+SegmentedArray<T>::SegmentedArray( mem::IAllocator<T>* allocator )
+    : _allocator( allocator ), _blocks(), _spare( nullptr ), _first( 0 ),
+      _size( 0 ), _blockSize( 0 ), _blockShift( 0 )
+{
+    initBlockSize( DEFAULT_BLOCK_SIZE );
+}
+
+template <typename T>
+inline
+SegmentedArray<T>::SegmentedArray( uint32 blockSize )
+    : _allocator(), _blocks(), _spare( nullptr ), _first( 0 ), _size( 0 ),
+      _blockSize( 0 ), _blockShift( 0 )
+{
+    initBlockSize( blockSize );
+}
+
+template <typename T>
+inline
+SegmentedArray<T>::SegmentedArray( mem::IAllocator<T>* allocator,
+                                   uint32 blockSize )
+    : _allocator( allocator ), _blocks(), _spare( nullptr ), _first( 0 ),
+      _size( 0 ), _blockSize( 0 ), _blockShift( 0 )
+{
+    initBlockSize( blockSize );
+}
+
+template <typename T>
+inline
+SegmentedArray<T>::SegmentedArray( const SegmentedArray<T>& array )
+    : _allocator( array._allocator ), _blocks(), _spare( nullptr ),
+      _first( 0 ), _size( 0 ), _blockSize( array._blockSize ),
+      _blockShift( array._blockShift )
+{
+    copyItems( array );
+}
+
+template <typename T>
+inline
+SegmentedArray<T>::SegmentedArray( SegmentedArray<T>&& array )
+    : _allocator( array._allocator ), _blocks( std::move( array._blocks ) ),
+      _spare( array._spare ), _first( array._first ), _size( array._size ),
+      _blockSize( array._blockSize ), _blockShift( array._blockShift )
+{
+    array._spare = nullptr;
+    array._first = 0;
+    array._size = 0;
+}
+
+template <typename T>
+inline
+SegmentedArray<T>::~SegmentedArray()
+{
+    releaseBlocks();
+    _first = 0;
+    _size = 0;
+}
+
+// OPERATORS
+template <typename T>
+SegmentedArray<T>& SegmentedArray<T>::operator=(
+    const SegmentedArray<T>& array )
+{
+    releaseBlocks();
+    _blocks.clear();
+
+    _allocator = array._allocator;
+    _first = 0;
+    _size = 0;
+    _blockSize = array._blockSize;
+    _blockShift = array._blockShift;
+
+    copyItems( array );
+
+    return *this;
+}
+
+template <typename T>
+SegmentedArray<T>& SegmentedArray<T>::operator=( SegmentedArray<T>&& array )
+{
+    releaseBlocks();
+
+    _allocator = array._allocator;
+    _blocks = std::move( array._blocks );
+    _spare = array._spare;
+    _first = array._first;
+    _size = array._size;
+    _blockSize = array._blockSize;
+    _blockShift = array._blockShift;
+
+    array._spare = nullptr;
+    array._first = 0;
+    array._size = 0;
+
+    return *this;
+}
+
+template <typename T>
+inline
+const T& SegmentedArray<T>::operator[]( uint32 index ) const
+{
+    assert( index < _size );
+    return getAt( _first + index );
+}
+
+template <typename T>
+inline
+T& SegmentedArray<T>::operator[]( uint32 index )
+{
+    assert( index < _size );
+    return getAt( _first + index );
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T& SegmentedArray<T>::at( uint32 index ) const
+{
+    if ( index >= _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    return getAt( _first + index );
+}
+
+template <typename T>
+inline
+void SegmentedArray<T>::push( const T& value )
+{
+    if ( _first + _size >= _blocks.size() << _blockShift )
+    {
+        _blocks.push( acquireBlock() );
+    }
+
+    getAt( _first + _size ) = value;
+    ++_size;
+}
+
+template <typename T>
+inline
+void SegmentedArray<T>::push( T&& value )
+{
+    if ( _first + _size >= _blocks.size() << _blockShift )
+    {
+        _blocks.push( acquireBlock() );
+    }
+
+    getAt( _first + _size ) = std::move( value );
+    ++_size;
+}
+
+template <typename T>
+inline
+void SegmentedArray<T>::pushFront( const T& value )
+{
+    if ( _first <= 0 )
+    {
+        _blocks.pushFront( acquireBlock() );
+        _first = _blockSize;
+    }
+
+    --_first;
+    getAt( _first ) = value;
+    ++_size;
+}
+
+template <typename T>
+inline
+void SegmentedArray<T>::pushFront( T&& value )
+{
+    if ( _first <= 0 )
+    {
+        _blocks.pushFront( acquireBlock() );
+        _first = _blockSize;
+    }
+
+    --_first;
+    getAt( _first ) = std::move( value );
+    ++_size;
+}
+
+template <typename T>
+T SegmentedArray<T>::pop()
+{
+    assert( _size > 0 );
+
+    --_size;
+    T elem = std::move( getAt( _first + _size ) );
+
+    // release the last block once it is empty
+    if ( ( ( _first + _size ) & ( _blockSize - 1 ) ) == 0 )
+    {
+        releaseBlock( _blocks.pop() );
+        if ( _blocks.isEmpty() )
+        {
+            _first = 0;
+        }
+    }
+
+    return elem;
+}
+
+template <typename T>
+T SegmentedArray<T>::popFront()
+{
+    assert( _size > 0 );
+
+    T elem = std::move( getAt( _first ) );
+    ++_first;
+    --_size;
+
+    // release the first block once it is empty
+    if ( _first >= _blockSize || _size <= 0 )
+    {
+        releaseBlock( _blocks.popFront() );
+        _first = 0;
+    }
+
+    return elem;
+}
+
+template <typename T>
+void SegmentedArray<T>::clear()
+{
+    releaseBlocks();
+    _blocks.clear();
+    _first = 0;
+    _size = 0;
+}
+
+template <typename T>
+inline
+typename SegmentedArray<T>::Iterator SegmentedArray<T>::begin()
+{
+    return Iterator( this, 0 );
+}
+
+template <typename T>
+inline
+typename SegmentedArray<T>::ConstIterator SegmentedArray<T>::cbegin() const
+{
+    return ConstIterator( this, 0 );
+}
+
+template <typename T>
+inline
+typename SegmentedArray<T>::Iterator SegmentedArray<T>::end()
+{
+    return Iterator( this, _size );
+}
+
+template <typename T>
+inline
+typename SegmentedArray<T>::ConstIterator SegmentedArray<T>::cend() const
+{
+    return ConstIterator( this, _size );
+}
+
+template <typename T>
+inline
+uint32 SegmentedArray<T>::size() const
+{
+    return _size;
+}
+
+template <typename T>
+inline
+uint32 SegmentedArray<T>::blockSize() const
+{
+    return _blockSize;
+}
+
+template <typename T>
+inline
+uint32 SegmentedArray<T>::blockCount() const
+{
+    return _blocks.size();
+}
+
+template <typename T>
+inline
+bool SegmentedArray<T>::isEmpty() const
+{
+    return _size <= 0;
+}
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+T* SegmentedArray<T>::acquireBlock()
+{
+    if ( _spare != nullptr )
+    {
+        T* block = _spare;
+        _spare = nullptr;
+        return block;
+    }
+
+    return _allocator.get( _blockSize );
+}
+
+template <typename T>
+inline
+void SegmentedArray<T>::releaseBlock( T* block )
+{
+    if ( _spare == nullptr )
+    {
+        _spare = block;
+    }
+    else
+    {
+        _allocator.release( block, _blockSize );
+    }
+}
+
+template <typename T>
+void SegmentedArray<T>::releaseBlocks()
+{
+    uint32 i;
+    for ( i = 0; i < _blocks.size(); ++i )
+    {
+        _allocator.release( _blocks[i], _blockSize );
+    }
+
+    if ( _spare != nullptr )
+    {
+        _allocator.release( _spare, _blockSize );
+        _spare = nullptr;
+    }
+}
+
+template <typename T>
+void SegmentedArray<T>::copyItems( const SegmentedArray<T>& array )
+{
+    uint32 i;
+    for ( i = 0; i < array._size; ++i )
+    {
+        push( array[i] );
+    }
+}
+
+template <typename T>
+void SegmentedArray<T>::initBlockSize( uint32 blockSize )
+{
+    assert( blockSize > 0 );
+
+    _blockSize = 1;
+    _blockShift = 0;
+    while ( _blockSize < blockSize )
+    {
+        _blockSize <<= 1;
+        ++_blockShift;
+    }
+}
+
+template <typename T>
+inline
+T& SegmentedArray<T>::getAt( uint32 position ) const
+{
+    return _blocks[position >> _blockShift][position & ( _blockSize - 1 )];
+}
+
+// ITERATOR CONSTRUCTORS
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    SegmentedIterator()
+    : _iterArray( nullptr ), _iterIndex( 0 )
+{
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    SegmentedIterator( APTR array, uint32 index )
+    : _iterArray( array ), _iterIndex( index )
+{
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    SegmentedIterator( const SegmentedIterator& iter )
+    : _iterArray( iter._iterArray ), _iterIndex( iter._iterIndex )
+{
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    ~SegmentedIterator()
+{
+    _iterArray = nullptr;
+    _iterIndex = static_cast<uint32>( -1 );
+}
+
+// ITERATOR OPERATORS
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>&
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::operator=(
+    const SegmentedIterator& iter )
+{
+    _iterArray = iter._iterArray;
+    _iterIndex = iter._iterIndex;
+
+    return *this;
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>&
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::operator++()
+{
+    ++_iterIndex;
+
+    return *this;
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>&
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::operator++(
+    int32 )
+{
+    ++_iterIndex;
+
+    return *this;
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>&
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::operator--()
+{
+    _iterIndex = ( _iterIndex > 0 ) ? _iterIndex - 1 : _iterArray->_size;
+
+    return *this;
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+vc_typename SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>&
+SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::operator--(
+    int32 )
+{
+    _iterIndex = ( _iterIndex > 0 ) ? _iterIndex - 1 : _iterArray->_size;
+
+    return *this;
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+CTREF SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    operator*() const
+{
+    return ( *_iterArray )[_iterIndex];
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+TREF SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    operator*()
+{
+    return ( *_iterArray )[_iterIndex];
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+TPTR SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    operator->() const
+{
+    return &( *_iterArray )[_iterIndex];
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+TPTR SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    operator->()
+{
+    return &( *_iterArray )[_iterIndex];
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+bool SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    operator==( const SegmentedIterator& iter ) const
+{
+    return _iterArray == iter._iterArray && _iterIndex == iter._iterIndex;
+}
+
+template <typename T>
+template <typename APTR, typename TREF, typename CTREF, typename TPTR>
+inline
+bool SegmentedArray<T>::SegmentedIterator<APTR, TREF, CTREF, TPTR>::
+    operator!=( const SegmentedIterator& iter ) const
+{
+    return _iterArray != iter._iterArray || _iterIndex != iter._iterIndex;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif // NGE_CNTR_SEGMENTED_ARRAY_H
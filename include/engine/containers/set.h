@@ -6,8 +6,10 @@
 #include <engine/utility/hasher.h>
 
 #include "engine/intdef.h"
+#include "engine/containers/bloom_filter.h"
 #include "engine/containers/dynamic_array.h"
 #include "engine/memory/allocator_guard.h"
+#include "engine/memory/static_allocator.h"
 
 namespace nge
 {
@@ -18,8 +20,8 @@ namespace cntr
 // TODO: consider using progressive bin copy after resize if necessary
 // TODO: cache hashes in separate array if necessary
 // TODO: define non-constant iterator without *() operator
-template <typename T>
-class Set
+template <typename T, template <typename> class A = mem::StaticAllocator>
+class Set : private A<uint32>
 {
   private:
     // CONSTANTS
@@ -33,6 +35,15 @@ class Set
      */
     static constexpr uint32 BIN_EMPTY = static_cast<uint32>( -1 );
 
+    /**
+     * Defines a bin whose value was removed.
+     *
+     * The bin cannot be marked as empty since that would break the probe
+     * sequence of any value that was placed after it. Removed bins are
+     * reclaimed when the bins are resized.
+     */
+    static constexpr uint32 BIN_REMOVED = static_cast<uint32>( -2 );
+
     /**
      * The threshold percentage at which the map grows.
      */
@@ -44,15 +55,10 @@ class Set
     static constexpr uint32 SHRINK_THRESHOLD = 30;
 
     // MEMBERS
-    /**
-     * The bin allocator.
-     */
-    mem::AllocatorGuard<uint32> _binAlloc;
-
     /**
      * The values in the array.
      */
-    DynamicArray<T> _values;
+    DynamicArray<T, A> _values;
 
     /**
      * The hash function.
@@ -69,12 +75,44 @@ class Set
      */
     uint32 _binsInUse;
 
+    /**
+     * The number of bins whose value was removed.
+     */
+    uint32 _binsRemoved;
+
     /**
      * The total number of bins.
      */
     uint32 _binCount;
 
+    /**
+     * The filter that rejects most values that are not in the set or null if
+     * the filter is not enabled.
+     *
+     * The filter is only created when it is enabled so that unfiltered
+     * sets do not carry it. Its blocks are allocated by the bin allocator
+     * policy.
+     */
+    BloomFilter<T, A>* _filter;
+
     // HELPER FUNCTIONS
+    /**
+     * Gets the bin allocator policy.
+     */
+    A<uint32>& policy();
+
+    /**
+     * Adds the hash code to the filter if it is enabled.
+     */
+    void filterHash( uint32 hashCode );
+
+    /**
+     * Checks if a value with the hash code may be in the set.
+     *
+     * This is always true when the filter is not enabled.
+     */
+    bool mayContainHash( uint32 hashCode ) const;
+
     /**
      * Gets the index of a bin that should hold the given value.
      *
@@ -83,6 +121,12 @@ class Set
      */
     uint32 findBinForValue( const T& value ) const;
 
+    /**
+     * Gets the index of a bin that should hold the given value using its
+     * precomputed hash code.
+     */
+    uint32 findBinForValue( const T& value, uint32 hashCode ) const;
+
     /**
      * Computes the hash for the given value.
      */
@@ -106,6 +150,14 @@ class Set
      */
     bool isBinEmpty( uint32 binIndex ) const;
 
+    /**
+     * Checks if the value in the bin at the given index was removed.
+     *
+     * Behavior is undefined when:
+     * binIndex is invalid.
+     */
+    bool isBinRemoved( uint32 binIndex ) const;
+
     /**
      * Checks if the bin at the given index contains the given value.
      *
@@ -125,6 +177,9 @@ class Set
 
     /**
      * Grows the bin array to twice the current capacity.
+     *
+     * When most of the load is removed bins the bins are rehashed at the
+     * current capacity instead.
      */
     void grow();
 
@@ -134,14 +189,16 @@ class Set
     void shrink();
 
     /**
-     * Resizes the bin array to the specified size.
+     * Resizes the bin array to the specified size and rehashes the values.
+     *
+     * The bin array is reused when the size does not change.
      */
     void resize( uint32 newSize );
 
     /**
      * Resets all of the bins back to empty.
      *
-     * This does not reset _binsInUse.
+     * This does not reset _binsInUse or _binsRemoved.
      */
     void clearBins();
 
@@ -157,7 +214,7 @@ class Set
         /**
          * The set values that are being iterated.
          */
-        const DynamicArray<T>* _iterValues;
+        const DynamicArray<T, A>* _iterValues;
 
         /**
          * The current position in the set.
@@ -174,7 +231,7 @@ class Set
         /**
          * Constructs an iterator for the set with the given index.
          */
-        ConstIterator( const Set<T>* set, uint32 index );
+        ConstIterator( const Set<T, A>* set, uint32 index );
 
         /**
          * Constructs a copy of the given iterator.
@@ -261,36 +318,36 @@ class Set
     /**
      * Constructs a new set that uses the given allocators.
      */
-    Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc );
+    Set( const A<T>& valueAlloc, const A<uint32>& intAlloc );
 
     /**
      * Constructs a new set using the given allocators and initial capacity.
      */
-    Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
+    Set( const A<T>& valueAlloc, const A<uint32>& intAlloc,
          uint32 capacity );
 
     /**
      * Constructs a new set using the given allocators and hash function.
      */
-    Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
+    Set( const A<T>& valueAlloc, const A<uint32>& intAlloc,
          const std::function<uint32( const T& )>& hashFunc );
 
     /**
      * Constructs a new set using the given allocators, initial capacity, and
      * hash function.
      */
-    Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
+    Set( const A<T>& valueAlloc, const A<uint32>& intAlloc,
          uint32 capacity, const std::function<uint32( const T& )>& hashFunc );
 
     /**
      * Constructs a copy of the given set.
      */
-    Set( const Set<T>& set );
+    Set( const Set<T, A>& set );
 
     /**
      * Moves the set to a new instance.
      */
-    Set( Set<T>&& set );
+    Set( Set<T, A>&& set );
 
     /**
      * Destructs the set.
@@ -301,12 +358,12 @@ class Set
     /**
      * Assigns this as a copy of the given set.
      */
-    Set<T>& operator=( const Set<T>& set );
+    Set<T, A>& operator=( const Set<T, A>& set );
 
     /**
      * Moves the set data to this instance.
      */
-    Set<T>& operator=( Set<T>&& set );
+    Set<T, A>& operator=( Set<T, A>&& set );
 
     /**
      * Gets the item in the set at the given index.
@@ -346,6 +403,19 @@ class Set
      */
     void clear();
 
+    /**
+     * Enables a bloom filter in front of the bins.
+     *
+     * Checking for a value that is not in the set then rarely has to probe
+     * the bins. The filter is rebuilt whenever the bins are resized.
+     */
+    void enableFilter();
+
+    /**
+     * Checks if the bloom filter is enabled.
+     */
+    bool isFiltered() const;
+
     /**
      * Gets an iterator for the set.
      */
@@ -368,253 +438,297 @@ class Set
 };
 
 // CONSTANTS
-template <typename T>
-constexpr uint32 Set<T>::MIN_BINS;
+template <typename T, template <typename> class A>
+constexpr uint32 Set<T, A>::MIN_BINS;
 
-template <typename T>
-constexpr uint32 Set<T>::BIN_EMPTY;
+template <typename T, template <typename> class A>
+constexpr uint32 Set<T, A>::BIN_EMPTY;
 
-template <typename T>
-constexpr uint32 Set<T>::GROW_THRESHOLD;
+template <typename T, template <typename> class A>
+constexpr uint32 Set<T, A>::BIN_REMOVED;
 
-template <typename T>
-constexpr uint32 Set<T>::SHRINK_THRESHOLD;
+template <typename T, template <typename> class A>
+constexpr uint32 Set<T, A>::GROW_THRESHOLD;
+
+template <typename T, template <typename> class A>
+constexpr uint32 Set<T, A>::SHRINK_THRESHOLD;
 
 // CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set() : _binAlloc(), _values(), _hashFunc( &util::Hasher<T>::hash ),
-                _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, A>::Set()
+    : A<uint32>(), _values(), _hashFunc( &util::Hasher<T>::hash ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( uint32 capacity )
-    : _binAlloc(), _values( capacity ), _hashFunc( &util::Hasher<T>::hash ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, A>::Set( uint32 capacity )
+    : A<uint32>(), _values( capacity ), _hashFunc( &util::Hasher<T>::hash ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( const std::function<uint32( const T& )>& hashFunc )
-    : _binAlloc(), _values(), _hashFunc( hashFunc ), _bins( nullptr ),
-      _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, A>::Set( const std::function<uint32( const T& )>& hashFunc )
+    : A<uint32>(), _values(), _hashFunc( hashFunc ), _bins( nullptr ),
+      _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( uint32 capacity,
-             const std::function<uint32( const T& )>& hashFunc )
-    : _binAlloc(), _values( capacity ), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, A>::Set( uint32 capacity,
+                const std::function<uint32( const T& )>& hashFunc )
+    : A<uint32>(), _values( capacity ), _hashFunc( hashFunc ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc,
-             mem::IAllocator<uint32>* intAlloc )
-    : _binAlloc( intAlloc ), _values( valueAlloc ),
+Set<T, A>::Set( const A<T>& valueAlloc,
+                const A<uint32>& intAlloc )
+    : A<uint32>( intAlloc ), _values( valueAlloc ),
       _hashFunc( &util::Hasher<T>::hash ),  _bins( nullptr ),
-      _binsInUse( 0 ), _binCount( MIN_BINS )
+      _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc,
-             mem::IAllocator<uint32>* intAlloc, uint32 capacity )
-    : _binAlloc( intAlloc ), _values( valueAlloc, capacity ),
+Set<T, A>::Set( const A<T>& valueAlloc,
+                const A<uint32>& intAlloc, uint32 capacity )
+    : A<uint32>( intAlloc ), _values( valueAlloc, capacity ),
       _hashFunc( &util::Hasher<T>::hash ), _bins( nullptr ),
-      _binsInUse( 0 ), _binCount( MIN_BINS )
+      _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
-             const std::function<uint32( const T& )>& hashFunc )
-    : _binAlloc( intAlloc ), _values( valueAlloc ), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, A>::Set( const A<T>& valueAlloc, const A<uint32>& intAlloc,
+                const std::function<uint32( const T& )>& hashFunc )
+    : A<uint32>( intAlloc ), _values( valueAlloc ), _hashFunc( hashFunc ),
+      _bins( nullptr ), _binsInUse( 0 ), _binsRemoved( 0 ),
+      _binCount( MIN_BINS ),
+      _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
-             uint32 capacity,
-             const std::function<uint32( const T& )>& hashFunc )
-    : _binAlloc( intAlloc ), _values( valueAlloc, capacity ),
+Set<T, A>::Set( const A<T>& valueAlloc, const A<uint32>& intAlloc,
+                uint32 capacity,
+                const std::function<uint32( const T& )>& hashFunc )
+    : A<uint32>( intAlloc ), _values( valueAlloc, capacity ),
       _hashFunc( hashFunc ), _bins( nullptr ), _binsInUse( 0 ),
-      _binCount( MIN_BINS )
+      _binsRemoved( 0 ), _binCount( MIN_BINS ), _filter( nullptr )
 {
     while ( _binCount < capacity )
     {
         _binCount <<= 1;
     }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     clearBins();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( const Set<T>& set )
-    : _binAlloc( set._binAlloc ), _values( set._values ),
+Set<T, A>::Set( const Set<T, A>& set )
+    : A<uint32>( set ), _values( set._values ),
       _hashFunc( set._hashFunc ), _bins( nullptr ),
-      _binsInUse( set._binsInUse ), _binCount( set._binCount )
+      _binsInUse( set._binsInUse ), _binsRemoved( set._binsRemoved ),
+      _binCount( set._binCount ),
+      _filter( nullptr )
 {
-    _bins = _binAlloc.get( _binCount );
+    if ( set._filter != nullptr )
+    {
+        _filter = new BloomFilter<T, A>( *set._filter );
+    }
+
+    _bins = policy().get( _binCount );
     mem::MemoryUtils::copy( _bins, set._bins, _binCount );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::Set( Set<T>&& set )
-    : _binAlloc( std::move( set._binAlloc ) ),
+Set<T, A>::Set( Set<T, A>&& set )
+    : A<uint32>( set ),
       _values( std::move( set._values ) ),
       _hashFunc( std::move( set._hashFunc ) ), _bins( set._bins ),
-      _binsInUse( set._binsInUse ), _binCount( set._binCount )
+      _binsInUse( set._binsInUse ), _binsRemoved( set._binsRemoved ),
+      _binCount( set._binCount ),
+      _filter( set._filter )
 {
+    set._filter = nullptr;
     set._bins = nullptr;
     set._binsInUse = 0;
+    set._binsRemoved = 0;
     set._binCount = 0;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::~Set()
+Set<T, A>::~Set()
 {
     if ( _bins != nullptr )
     {
-        _binAlloc.release( _bins, _binCount );
+        policy().release( _bins, _binCount );
         _bins = nullptr;
     }
     _binsInUse = 0;
+    _binsRemoved = 0;
     _binCount = 0;
+
+    delete _filter;
+    _filter = nullptr;
 }
 
 // OPERATORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>& Set<T>::operator=( const Set<T>& set )
+Set<T, A>& Set<T, A>::operator=( const Set<T, A>& set )
 {
     if ( _bins != nullptr )
     {
-        _binAlloc.release( _bins, _binCount );
+        policy().release( _bins, _binCount );
     }
 
-    _binAlloc = set._binAlloc;
+    A<uint32>::operator=( set );
     _values = set._values;
     _hashFunc = set._hashFunc;
     _binCount = set._binCount;
     _binsInUse = set._binsInUse;
+    _binsRemoved = set._binsRemoved;
+
+    delete _filter;
+    _filter = nullptr;
+    if ( set._filter != nullptr )
+    {
+        _filter = new BloomFilter<T, A>( *set._filter );
+    }
 
-    _bins = _binAlloc.get( _binCount );
+    _bins = policy().get( _binCount );
     mem::MemoryUtils::copy( _bins, set._bins, _binCount );
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>& Set<T>::operator=( Set<T>&& set )
+Set<T, A>& Set<T, A>::operator=( Set<T, A>&& set )
 {
     if ( _bins != nullptr )
     {
-        _binAlloc.release( _bins, _binCount );
+        policy().release( _bins, _binCount );
     }
 
-    _binAlloc = std::move( set._binAlloc );
+    A<uint32>::operator=( set );
     _values = std::move( set._values );
     _hashFunc = std::move( set._hashFunc );
     _bins = set._bins;
     _binCount = set._binCount;
     _binsInUse = set._binsInUse;
+    _binsRemoved = set._binsRemoved;
+    delete _filter;
+    _filter = set._filter;
+    set._filter = nullptr;
 
     set._bins = nullptr;
     set._binsInUse = 0;
+    set._binsRemoved = 0;
     set._binCount = 0;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-const T& Set<T>::operator[]( uint32 index ) const
+const T& Set<T, A>::operator[]( uint32 index ) const
 {
     assert( index < size() );
     return _values[index];
 }
 
-template <typename T>
-void Set<T>::add( const T& value )
+template <typename T, template <typename> class A>
+void Set<T, A>::add( const T& value )
 {
     if ( shouldGrow() )
     {
         grow();
     }
 
-    uint32 binIndex = findBinForValue( value );
+    const uint32 hashCode = hash( value );
+    uint32 binIndex = findBinForValue( value, hashCode );
     if ( isBinEmpty( binIndex ) )
     {
         ++_binsInUse;
         _bins[binIndex] = _values.size();
         _values.push( std::move( value ) );
+        filterHash( hashCode );
     }
 }
 
-template <typename T>
-void Set<T>::add( T&& value )
+template <typename T, template <typename> class A>
+void Set<T, A>::add( T&& value )
 {
     if ( shouldGrow() )
     {
         grow();
     }
 
-    uint32 binIndex = findBinForValue( value );
+    const uint32 hashCode = hash( value );
+    uint32 binIndex = findBinForValue( value, hashCode );
     if ( isBinEmpty( binIndex ) )
     {
         ++_binsInUse;
         _bins[binIndex] = _values.size();
         _values.push( std::move( value ) );
+        filterHash( hashCode );
     }
 }
 
-template <typename T>
-void Set<T>::remove( const T& value )
+template <typename T, template <typename> class A>
+void Set<T, A>::remove( const T& value )
 {
     if ( shouldShrink() )
     {
@@ -631,71 +745,139 @@ void Set<T>::remove( const T& value )
         // correct bin indices
         for ( i = 0; i < _binCount; ++i )
         {
-            if ( !isBinEmpty( i ) && _bins[i] > _bins[binIndex] )
+            if ( !isBinEmpty( i ) && !isBinRemoved( i ) &&
+                 _bins[i] > _bins[binIndex] )
             {
                 --( _bins[i] );
             }
         }
 
-        _bins[binIndex] = BIN_EMPTY;
+        ++_binsRemoved;
+        _bins[binIndex] = BIN_REMOVED;
     }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::has( const T& value ) const
+bool Set<T, A>::has( const T& value ) const
 {
-    const uint32 binIndex = findBinForValue( value );
+    const uint32 hashCode = hash( value );
+    if ( !mayContainHash( hashCode ) )
+    {
+        return false;
+    }
+
+    const uint32 binIndex = findBinForValue( value, hashCode );
     return binIndex != -1 && doesBinContain( binIndex, value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void Set<T>::clear()
+void Set<T, A>::clear()
 {
     _values.clear();
     mem::MemoryUtils::set( _bins, BIN_EMPTY, _binCount );
     _binsInUse = 0;
+    _binsRemoved = 0;
+
+    if ( _filter != nullptr )
+    {
+        _filter->clear();
+    }
+}
+
+template <typename T, template <typename> class A>
+void Set<T, A>::enableFilter()
+{
+    if ( _filter == nullptr )
+    {
+        _filter = new BloomFilter<T, A>( policy() );
+    }
+
+    _filter->resize( _binCount );
+
+    uint32 i;
+    for ( i = 0; i < _values.size(); ++i )
+    {
+        _filter->addHash( hash( _values[i] ) );
+    }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator Set<T>::cbegin() const
+bool Set<T, A>::isFiltered() const
+{
+    return _filter != nullptr;
+}
+
+template <typename T, template <typename> class A>
+inline
+typename Set<T, A>::ConstIterator Set<T, A>::cbegin() const
 {
     return ConstIterator( this, 0 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator Set<T>::cend() const
+typename Set<T, A>::ConstIterator Set<T, A>::cend() const
 {
     return ConstIterator( this, _values.size() );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 Set<T>::size() const
+uint32 Set<T, A>::size() const
 {
     return _values.size();
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::isEmpty() const
+bool Set<T, A>::isEmpty() const
 {
     return _values.isEmpty();
 }
 
 // HELPER FUNCTIONS
-template <typename T>
-uint32 Set<T>::findBinForValue( const T& value ) const
+template <typename T, template <typename> class A>
+inline
+A<uint32>& Set<T, A>::policy()
+{
+    return *this;
+}
+
+template <typename T, template <typename> class A>
+inline
+void Set<T, A>::filterHash( uint32 hashCode )
+{
+    if ( _filter != nullptr )
+    {
+        _filter->addHash( hashCode );
+    }
+}
+
+template <typename T, template <typename> class A>
+inline
+bool Set<T, A>::mayContainHash( uint32 hashCode ) const
+{
+    return _filter == nullptr || _filter->mayContainHash( hashCode );
+}
+
+template <typename T, template <typename> class A>
+inline
+uint32 Set<T, A>::findBinForValue( const T& value ) const
+{
+    return findBinForValue( value, hash( value ) );
+}
+
+template <typename T, template <typename> class A>
+uint32 Set<T, A>::findBinForValue( const T& value, uint32 hashCode ) const
 {
-    const uint32 hashCode = hash( value );
     uint32 i;
     uint32 probes;
     for ( i = wrap( hashCode ), probes = 0;
           !isBinEmpty( i ) && !doesBinContain( i, value );
-          i = probe( ++probes ) )
+          i = wrap( i + probe( ++probes ) ) )
     {
         // do nothing
     }
@@ -703,131 +885,162 @@ uint32 Set<T>::findBinForValue( const T& value ) const
     return i;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 Set<T>::hash( const T& value ) const
+uint32 Set<T, A>::hash( const T& value ) const
 {
     return _hashFunc( value );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 Set<T>::probe( uint32 probes ) const
+uint32 Set<T, A>::probe( uint32 probes ) const
 {
     return probes;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-uint32 Set<T>::wrap( uint32 index ) const
+uint32 Set<T, A>::wrap( uint32 index ) const
 {
     return index & ( _binCount - 1 );
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::isBinEmpty( uint32 binIndex ) const
+bool Set<T, A>::isBinEmpty( uint32 binIndex ) const
 {
     assert( binIndex < _binCount );
     return _bins[binIndex] == BIN_EMPTY;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::doesBinContain( uint32 binIndex, const T& value ) const
+bool Set<T, A>::isBinRemoved( uint32 binIndex ) const
+{
+    assert( binIndex < _binCount );
+    return _bins[binIndex] == BIN_REMOVED;
+}
+
+template <typename T, template <typename> class A>
+inline
+bool Set<T, A>::doesBinContain( uint32 binIndex, const T& value ) const
 {
     return binIndex < _binCount && !isBinEmpty( binIndex ) &&
-        _values[_bins[binIndex]] == value;
+        !isBinRemoved( binIndex ) && _values[_bins[binIndex]] == value;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::shouldShrink() const
+bool Set<T, A>::shouldShrink() const
 {
     return ( ( _binsInUse * 100 ) / _binCount ) <= SHRINK_THRESHOLD &&
         _binCount > MIN_BINS;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::shouldGrow() const
+bool Set<T, A>::shouldGrow() const
 {
-    return ( ( _binsInUse * 100 ) / _binCount ) >= GROW_THRESHOLD;
+    return ( ( ( _binsInUse + _binsRemoved ) * 100 ) / _binCount ) >=
+        GROW_THRESHOLD;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void Set<T>::grow()
+void Set<T, A>::grow()
 {
-    resize( _binCount << 1 );
+    // doubling would leave the set small enough to shrink right back, so
+    // the removed bins are reclaimed without changing the size
+    if ( ( _binsInUse * 100 ) / ( _binCount << 1 ) <= SHRINK_THRESHOLD )
+    {
+        resize( _binCount );
+    }
+    else
+    {
+        resize( _binCount << 1 );
+    }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void Set<T>::shrink()
+void Set<T, A>::shrink()
 {
     resize( _binCount >> 1 );
 }
 
-template <typename T>
-void Set<T>::resize( uint32 newSize )
+template <typename T, template <typename> class A>
+void Set<T, A>::resize( uint32 newSize )
 {
     assert( _bins != nullptr );
-    _binAlloc.release( _bins, _binCount );
-    _bins = _binAlloc.get( newSize );
-    _binCount = newSize;
+    if ( newSize != _binCount )
+    {
+        policy().release( _bins, _binCount );
+        _bins = policy().get( newSize );
+        _binCount = newSize;
+    }
+
+    _binsRemoved = 0;
     clearBins();
 
+    if ( _filter != nullptr )
+    {
+        _filter->resize( _binCount );
+    }
+
     uint32 i;
     uint32 pos;
+    uint32 hashCode;
     for ( i = 0; i < _values.size(); ++i )
     {
-        pos = findBinForValue( _values[i] );
+        hashCode = hash( _values[i] );
+        pos = findBinForValue( _values[i], hashCode );
         _bins[pos] = i;
+        filterHash( hashCode );
     }
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-void Set<T>::clearBins()
+void Set<T, A>::clearBins()
 {
     mem::MemoryUtils::set( _bins, BIN_EMPTY, _binCount );
 }
 
 // ITERATOR CONSTRUCTORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::ConstIterator::ConstIterator()
+Set<T, A>::ConstIterator::ConstIterator()
     : _iterValues( nullptr ), _iterIndex( 0 )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::ConstIterator::ConstIterator( const Set<T>* set, uint32 index )
+Set<T, A>::ConstIterator::ConstIterator( const Set<T, A>* set, uint32 index )
     : _iterValues( &set->_values ), _iterIndex( index )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::ConstIterator::ConstIterator( const ConstIterator& iter )
+Set<T, A>::ConstIterator::ConstIterator( const ConstIterator& iter )
     : _iterValues( iter._iterValues ), _iterIndex( iter._iterIndex )
 {
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-Set<T>::ConstIterator::~ConstIterator()
+Set<T, A>::ConstIterator::~ConstIterator()
 {
     _iterValues = nullptr;
     _iterIndex = static_cast<uint32>( -1 );
 }
 
 // ITERATOR OPERATORS
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator=(
+typename Set<T, A>::ConstIterator& Set<T, A>::ConstIterator::operator=(
     const ConstIterator& iter )
 {
     _iterValues = iter._iterValues;
@@ -836,66 +1049,66 @@ typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator=(
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator++()
+typename Set<T, A>::ConstIterator& Set<T, A>::ConstIterator::operator++()
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator++( int32 )
+typename Set<T, A>::ConstIterator& Set<T, A>::ConstIterator::operator++( int32 )
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator--()
+typename Set<T, A>::ConstIterator& Set<T, A>::ConstIterator::operator--()
 {
     _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues->size();
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator--( int32 )
+typename Set<T, A>::ConstIterator& Set<T, A>::ConstIterator::operator--( int32 )
 {
     _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues->size();
 
     return *this;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-const T& Set<T>::ConstIterator::operator*() const
+const T& Set<T, A>::ConstIterator::operator*() const
 {
     return ( *_iterValues )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-const T* Set<T>::ConstIterator::operator->() const
+const T* Set<T, A>::ConstIterator::operator->() const
 {
     return &( *_iterValues )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::ConstIterator::operator==( const ConstIterator& iter ) const
+bool Set<T, A>::ConstIterator::operator==( const ConstIterator& iter ) const
 {
     return _iterValues == iter._iterValues && _iterIndex == iter._iterIndex;
 }
 
-template <typename T>
+template <typename T, template <typename> class A>
 inline
-bool Set<T>::ConstIterator::operator!=( const ConstIterator& iter ) const
+bool Set<T, A>::ConstIterator::operator!=( const ConstIterator& iter ) const
 {
     return _iterValues != iter._iterValues || _iterIndex != iter._iterIndex;
 }
@@ -0,0 +1,689 @@
+// static_map.h
+//
+// The static map is a read-only map from strings to values whose table is
+// built entirely at compile time. It is meant for small fixed key sets that
+// are looked up often such as config keys, shader attribute names, and
+// event types.
+//
+// The table is a two level perfect hash. A seed is searched for that spreads
+// the keys over the buckets so that no bucket holds more than four keys, then
+// a second seed is searched for each bucket that places its keys into its
+// four slots without collisions. A lookup is one string hash followed by one
+// string compare against the only entry that can hold the key.
+//
+// The seed search happens while the map is constant evaluated so a key set
+// that cannot be placed fails to compile instead of failing at runtime. The
+// search cost grows with the square of the number of keys so the map is
+// intended for sets of up to a few hundred keys.
+//
+// Usage:
+//     constexpr StaticMap<uint32, 2>::Entry ATTRIBUTES[] = {
+//         { "position", 0 },
+//         { "normal",   1 }
+//     };
+//
+//     constexpr StaticMap<uint32, 2> ATTRIBUTE_MAP( ATTRIBUTES );
+//
+// The entries must be a constexpr array so the key strings are available
+// while the map is built.
+//
+#ifndef NGE_CNTR_STATIC_MAP_H
+#define NGE_CNTR_STATIC_MAP_H
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "engine/intdef.h"
+#include "engine/utility/hash_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename V, uint32 N>
+class StaticMap
+{
+    static_assert( N > 0, "A static map must have at least one entry." );
+    static_assert( N < 0xffff, "A static map must have less than 65535 "
+                               "entries." );
+
+  public:
+    // STRUCTURES
+    /**
+     * Defines a key and the value that is mapped to it.
+     */
+    struct Entry
+    {
+        const char* key;
+        V value;
+    };
+
+  private:
+    // STRUCTURES
+    /**
+     * Defines a compile time list of indices.
+     */
+    template <uint32... INDICES>
+    struct Indices
+    {
+        typedef Indices<INDICES..., ( sizeof...( INDICES ) + INDICES )...>
+            Doubled;
+        typedef Indices<INDICES..., sizeof...( INDICES )> Next;
+    };
+
+    /**
+     * Makes the list of indices from zero up to the count.
+     *
+     * The list is built by doubling so that large tables do not exceed the
+     * template recursion limit.
+     */
+    template <uint32 COUNT, bool EMPTY = COUNT == 0>
+    struct MakeIndices
+    {
+        typedef typename MakeIndices<COUNT / 2>::Type::Doubled Half;
+        typedef typename std::conditional<COUNT % 2 == 1,
+                                          typename Half::Next,
+                                          Half>::type Type;
+    };
+
+    template <uint32 COUNT>
+    struct MakeIndices<COUNT, true>
+    {
+        typedef Indices<> Type;
+    };
+
+    /**
+     * Rounds the count up to the next power of two.
+     */
+    template <uint32 COUNT, uint32 POWER = 1, bool DONE = POWER >= COUNT>
+    struct PowerOfTwo
+    {
+        static constexpr uint32 VALUE =
+            PowerOfTwo<COUNT, POWER * 2>::VALUE;
+    };
+
+    template <uint32 COUNT, uint32 POWER>
+    struct PowerOfTwo<COUNT, POWER, true>
+    {
+        static constexpr uint32 VALUE = POWER;
+    };
+
+    // CONSTANTS
+    /**
+     * The number of bits of the slot index that select a slot in a bucket.
+     */
+    static constexpr uint32 SLOT_BITS = 2;
+
+    /**
+     * The number of slots in each bucket.
+     */
+    static constexpr uint32 SLOTS_PER_BUCKET = 1 << SLOT_BITS;
+
+    /**
+     * The number of buckets.
+     */
+    static constexpr uint32 BUCKET_COUNT = PowerOfTwo<N>::VALUE;
+
+    /**
+     * The number of slots.
+     */
+    static constexpr uint32 SLOT_COUNT = BUCKET_COUNT * SLOTS_PER_BUCKET;
+
+    /**
+     * The number of seeds that are tried before giving up.
+     */
+    static constexpr uint32 MAX_SEEDS = 256;
+
+    /**
+     * The slot value that indicates that it does not hold an entry.
+     */
+    static constexpr uint16 SLOT_EMPTY = 0xffff;
+
+    // BUILD STRUCTURES
+    /**
+     * Holds the hash code of each key while the map is built.
+     */
+    struct Hashes
+    {
+        uint32 values[N];
+    };
+
+    /**
+     * Holds the keys that are placed in a bucket while the map is built.
+     */
+    struct Bucket
+    {
+        uint16 keys[SLOTS_PER_BUCKET];
+        uint32 count;
+    };
+
+    /**
+     * Holds every bucket while the map is built.
+     */
+    struct Buckets
+    {
+        Bucket values[BUCKET_COUNT];
+    };
+
+    // MEMBERS
+    /**
+     * The entries.
+     */
+    Entry _entries[N];
+
+    /**
+     * The entry index in each slot.
+     */
+    uint16 _slots[SLOT_COUNT];
+
+    /**
+     * The seed of each bucket.
+     */
+    uint8 _seeds[BUCKET_COUNT];
+
+    /**
+     * The seed that selects the bucket.
+     */
+    uint32 _seed;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs the map after hashing each of the keys.
+     */
+    template <uint32... ENTRIES>
+    constexpr StaticMap( const Entry* entries, Indices<ENTRIES...> );
+
+    /**
+     * Constructs the map after finding the seed that selects the bucket.
+     */
+    template <uint32... ENTRIES>
+    constexpr StaticMap( const Entry* entries, const Hashes& hashes,
+                         Indices<ENTRIES...> );
+
+    /**
+     * Constructs the map after collecting the keys of each bucket.
+     */
+    template <uint32... ENTRIES, uint32... BUCKETS>
+    constexpr StaticMap( const Entry* entries, const uint32* hashes,
+                         uint32 seed, Indices<ENTRIES...>,
+                         Indices<BUCKETS...> );
+
+    /**
+     * Constructs the map from the entries, their hash codes, the seed, and
+     * the keys of each bucket.
+     */
+    template <uint32... ENTRIES, uint32... BUCKETS, uint32... SLOTS>
+    constexpr StaticMap( const Entry* entries, const uint32* hashes,
+                         uint32 seed, const Buckets& buckets,
+                         Indices<ENTRIES...>, Indices<BUCKETS...>,
+                         Indices<SLOTS...> );
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the bucket for the hash code.
+     */
+    static constexpr uint32 bucketOf( uint32 hashCode, uint32 seed );
+
+    /**
+     * Gets the slot for the hash code in the bucket.
+     */
+    static constexpr uint32 slotOf( uint32 hashCode, uint32 bucket,
+                                    uint32 bucketSeed );
+
+    /**
+     * Counts the keys in the range that are placed in the bucket.
+     */
+    static constexpr uint32 countBucket( const uint32* hashes, uint32 seed,
+                                         uint32 bucket, uint32 lo,
+                                         uint32 hi );
+
+    /**
+     * Checks that no bucket has more keys than slots for the keys in the
+     * range.
+     */
+    static constexpr bool isSeedValid( const uint32* hashes, uint32 seed,
+                                       uint32 lo, uint32 hi );
+
+    /**
+     * Finds the first valid seed starting from the given seed.
+     */
+    static constexpr uint32 findSeed( const uint32* hashes, uint32 seed );
+
+    /**
+     * Makes a bucket that holds only the given key.
+     *
+     * The bucket is empty if the key is SLOT_EMPTY.
+     */
+    template <uint32... KEYS>
+    static constexpr Bucket makeBucket( uint32 key, Indices<KEYS...> );
+
+    /**
+     * Makes a bucket that holds the keys of both buckets.
+     */
+    template <uint32... KEYS>
+    static constexpr Bucket mergeBuckets( const Bucket& first,
+                                          const Bucket& second,
+                                          Indices<KEYS...> );
+
+    /**
+     * Collects the keys in the range that are placed in the bucket.
+     */
+    static constexpr Bucket collectBucket( const uint32* hashes,
+                                           uint32 seed, uint32 bucket,
+                                           uint32 lo, uint32 hi );
+
+    /**
+     * Checks if a key of the bucket after the other key shares its slot.
+     */
+    static constexpr bool hasCollision( const uint32* hashes,
+                                        const Bucket& keys, uint32 bucket,
+                                        uint32 bucketSeed, uint32 key,
+                                        uint32 other );
+
+    /**
+     * Checks that the keys of the bucket starting from the given key do not
+     * share any slots.
+     */
+    static constexpr bool isBucketSeedValid( const uint32* hashes,
+                                             const Bucket& keys,
+                                             uint32 bucket,
+                                             uint32 bucketSeed,
+                                             uint32 key );
+
+    /**
+     * Finds the first valid seed of the bucket starting from the given seed.
+     */
+    static constexpr uint32 findBucketSeed( const uint32* hashes,
+                                            const Bucket& keys,
+                                            uint32 bucket,
+                                            uint32 bucketSeed );
+
+    /**
+     * Finds the key of the bucket starting from the given key that is
+     * placed in the slot.
+     */
+    static constexpr uint32 findEntry( const uint32* hashes,
+                                       const Bucket& keys, uint32 slot,
+                                       uint32 bucketSeed, uint32 key );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs the map from the given entries.
+     *
+     * Behavior is undefined when:
+     * - two entries have the same key
+     * - an entry has a null key
+     */
+    constexpr StaticMap( const Entry ( &entries )[N] );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the value mapped to the given key.
+     *
+     * Returns null if the key is not mapped.
+     */
+    const V* find( const char* key ) const;
+
+    /**
+     * Gets the value mapped to the given key using its precomputed hash.
+     *
+     * The hash code must have been computed using chash or one of the
+     * HashUtils fnv1a functions.
+     *
+     * Returns null if the key is not mapped.
+     */
+    const V* find( uint32 hashCode, const char* key ) const;
+
+    /**
+     * Gets the value mapped to the given key.
+     *
+     * Throws an exception if the key is not mapped.
+     */
+    const V& at( const char* key ) const;
+
+    /**
+     * Checks if the key is mapped.
+     */
+    bool has( const char* key ) const;
+
+    /**
+     * Gets the entries in the order they were given.
+     */
+    constexpr const Entry* entries() const;
+
+    /**
+     * Gets the number of entries.
+     */
+    constexpr uint32 size() const;
+
+    /**
+     * Gets the number of slots in the table.
+     */
+    constexpr uint32 slotCount() const;
+};
+
+template <typename V, uint32 N>
+constexpr uint32 StaticMap<V, N>::SLOT_BITS;
+
+template <typename V, uint32 N>
+constexpr uint32 StaticMap<V, N>::SLOTS_PER_BUCKET;
+
+template <typename V, uint32 N>
+constexpr uint32 StaticMap<V, N>::BUCKET_COUNT;
+
+template <typename V, uint32 N>
+constexpr uint32 StaticMap<V, N>::SLOT_COUNT;
+
+template <typename V, uint32 N>
+constexpr uint32 StaticMap<V, N>::MAX_SEEDS;
+
+template <typename V, uint32 N>
+constexpr uint16 StaticMap<V, N>::SLOT_EMPTY;
+
+// CONSTRUCTORS
+template <typename V, uint32 N>
+template <uint32... ENTRIES>
+inline
+constexpr StaticMap<V, N>::StaticMap( const Entry* entries,
+                                      Indices<ENTRIES...> indices )
+    : StaticMap( entries,
+                 Hashes{ { util::HashUtils::stringHash(
+                               entries[ENTRIES].key )... } },
+                 indices )
+{
+}
+
+template <typename V, uint32 N>
+template <uint32... ENTRIES>
+inline
+constexpr StaticMap<V, N>::StaticMap( const Entry* entries,
+                                      const Hashes& hashes,
+                                      Indices<ENTRIES...> indices )
+    : StaticMap( entries, hashes.values, findSeed( hashes.values, 0 ),
+                 indices, typename MakeIndices<BUCKET_COUNT>::Type() )
+{
+}
+
+template <typename V, uint32 N>
+template <uint32... ENTRIES, uint32... BUCKETS>
+inline
+constexpr StaticMap<V, N>::StaticMap( const Entry* entries,
+                                      const uint32* hashes, uint32 seed,
+                                      Indices<ENTRIES...> indices,
+                                      Indices<BUCKETS...> buckets )
+    : StaticMap( entries, hashes, seed,
+                 Buckets{ { collectBucket( hashes, seed, BUCKETS,
+                                           0, N )... } },
+                 indices, buckets,
+                 typename MakeIndices<SLOT_COUNT>::Type() )
+{
+}
+
+template <typename V, uint32 N>
+template <uint32... ENTRIES, uint32... BUCKETS, uint32... SLOTS>
+inline
+constexpr StaticMap<V, N>::StaticMap( const Entry* entries,
+                                      const uint32* hashes, uint32 seed,
+                                      const Buckets& buckets,
+                                      Indices<ENTRIES...>,
+                                      Indices<BUCKETS...>,
+                                      Indices<SLOTS...> )
+    : _entries{ entries[ENTRIES]... },
+      _slots{ static_cast<uint16>(
+                  findEntry( hashes, buckets.values[SLOTS >> SLOT_BITS],
+                             SLOTS,
+                             findBucketSeed(
+                                 hashes, buckets.values[SLOTS >> SLOT_BITS],
+                                 SLOTS >> SLOT_BITS, 0 ),
+                             0 ) )... },
+      _seeds{ static_cast<uint8>(
+                  findBucketSeed( hashes, buckets.values[BUCKETS],
+                                  BUCKETS, 0 ) )... },
+      _seed( seed )
+{
+}
+
+template <typename V, uint32 N>
+inline
+constexpr StaticMap<V, N>::StaticMap( const Entry ( &entries )[N] )
+    : StaticMap( entries, typename MakeIndices<N>::Type() )
+{
+}
+
+// HELPER FUNCTIONS
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::bucketOf( uint32 hashCode, uint32 seed )
+{
+    return util::HashUtils::mix( hashCode + seed ) & ( BUCKET_COUNT - 1 );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::slotOf( uint32 hashCode, uint32 bucket,
+                                          uint32 bucketSeed )
+{
+    return ( bucket << SLOT_BITS ) |
+           ( util::HashUtils::mix( hashCode ^ ( bucketSeed << 24 ) ) >>
+             ( 32 - SLOT_BITS ) );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::countBucket( const uint32* hashes,
+                                               uint32 seed, uint32 bucket,
+                                               uint32 lo, uint32 hi )
+{
+    return hi - lo == 1 ?
+           ( bucketOf( hashes[lo], seed ) == bucket ? 1 : 0 ) :
+           countBucket( hashes, seed, bucket, lo, lo + ( hi - lo ) / 2 ) +
+           countBucket( hashes, seed, bucket, lo + ( hi - lo ) / 2, hi );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr bool StaticMap<V, N>::isSeedValid( const uint32* hashes,
+                                             uint32 seed, uint32 lo,
+                                             uint32 hi )
+{
+    return hi - lo == 1 ?
+           countBucket( hashes, seed, bucketOf( hashes[lo], seed ),
+                        0, N ) <= SLOTS_PER_BUCKET :
+           isSeedValid( hashes, seed, lo, lo + ( hi - lo ) / 2 ) &&
+           isSeedValid( hashes, seed, lo + ( hi - lo ) / 2, hi );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::findSeed( const uint32* hashes,
+                                            uint32 seed )
+{
+    return seed == MAX_SEEDS ?
+           throw std::runtime_error( "no seed spreads the keys over the "
+                                     "buckets" ) :
+           isSeedValid( hashes, seed, 0, N ) ?
+           seed : findSeed( hashes, seed + 1 );
+}
+
+template <typename V, uint32 N>
+template <uint32... KEYS>
+inline
+constexpr typename StaticMap<V, N>::Bucket
+StaticMap<V, N>::makeBucket( uint32 key, Indices<KEYS...> )
+{
+    return Bucket{ { static_cast<uint16>( KEYS == 0 ? key :
+                                          SLOT_EMPTY )... },
+                   key == SLOT_EMPTY ? 0u : 1u };
+}
+
+template <typename V, uint32 N>
+template <uint32... KEYS>
+inline
+constexpr typename StaticMap<V, N>::Bucket
+StaticMap<V, N>::mergeBuckets( const Bucket& first, const Bucket& second,
+                               Indices<KEYS...> )
+{
+    return Bucket{ { static_cast<uint16>(
+                         KEYS < first.count ? first.keys[KEYS] :
+                         KEYS - first.count < second.count ?
+                         second.keys[KEYS - first.count] :
+                         SLOT_EMPTY )... },
+                   first.count + second.count };
+}
+
+template <typename V, uint32 N>
+inline
+constexpr typename StaticMap<V, N>::Bucket
+StaticMap<V, N>::collectBucket( const uint32* hashes, uint32 seed,
+                                uint32 bucket, uint32 lo, uint32 hi )
+{
+    return hi - lo == 1 ?
+           makeBucket( bucketOf( hashes[lo], seed ) == bucket ?
+                       lo : SLOT_EMPTY,
+                       typename MakeIndices<SLOTS_PER_BUCKET>::Type() ) :
+           mergeBuckets( collectBucket( hashes, seed, bucket,
+                                        lo, lo + ( hi - lo ) / 2 ),
+                         collectBucket( hashes, seed, bucket,
+                                        lo + ( hi - lo ) / 2, hi ),
+                         typename MakeIndices<SLOTS_PER_BUCKET>::Type() );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr bool StaticMap<V, N>::hasCollision( const uint32* hashes,
+                                              const Bucket& keys,
+                                              uint32 bucket,
+                                              uint32 bucketSeed,
+                                              uint32 key, uint32 other )
+{
+    return other < keys.count &&
+           ( slotOf( hashes[keys.keys[other]], bucket, bucketSeed ) ==
+             slotOf( hashes[keys.keys[key]], bucket, bucketSeed ) ||
+             hasCollision( hashes, keys, bucket, bucketSeed,
+                           key, other + 1 ) );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr bool StaticMap<V, N>::isBucketSeedValid( const uint32* hashes,
+                                                   const Bucket& keys,
+                                                   uint32 bucket,
+                                                   uint32 bucketSeed,
+                                                   uint32 key )
+{
+    return key >= keys.count ||
+           ( !hasCollision( hashes, keys, bucket, bucketSeed,
+                            key, key + 1 ) &&
+             isBucketSeedValid( hashes, keys, bucket, bucketSeed,
+                                key + 1 ) );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::findBucketSeed( const uint32* hashes,
+                                                  const Bucket& keys,
+                                                  uint32 bucket,
+                                                  uint32 bucketSeed )
+{
+    return bucketSeed == MAX_SEEDS ?
+           throw std::runtime_error( "no seed places the keys of a bucket "
+                                     "without collisions" ) :
+           isBucketSeedValid( hashes, keys, bucket, bucketSeed, 0 ) ?
+           bucketSeed :
+           findBucketSeed( hashes, keys, bucket, bucketSeed + 1 );
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::findEntry( const uint32* hashes,
+                                             const Bucket& keys,
+                                             uint32 slot,
+                                             uint32 bucketSeed,
+                                             uint32 key )
+{
+    return key >= keys.count ? SLOT_EMPTY :
+           slotOf( hashes[keys.keys[key]], slot >> SLOT_BITS,
+                   bucketSeed ) == slot ?
+           keys.keys[key] :
+           findEntry( hashes, keys, slot, bucketSeed, key + 1 );
+}
+
+// MEMBER FUNCTIONS
+template <typename V, uint32 N>
+inline
+const V* StaticMap<V, N>::find( const char* key ) const
+{
+    return find( util::HashUtils::stringHash( key ), key );
+}
+
+template <typename V, uint32 N>
+inline
+const V* StaticMap<V, N>::find( uint32 hashCode, const char* key ) const
+{
+    uint32 bucket;
+    uint16 index;
+
+    bucket = bucketOf( hashCode, _seed );
+    index = _slots[slotOf( hashCode, bucket, _seeds[bucket] )];
+    if ( index == SLOT_EMPTY ||
+         std::strcmp( _entries[index].key, key ) != 0 )
+    {
+        return nullptr;
+    }
+
+    return &_entries[index].value;
+}
+
+template <typename V, uint32 N>
+inline
+const V& StaticMap<V, N>::at( const char* key ) const
+{
+    const V* value;
+
+    value = find( key );
+    if ( value == nullptr )
+    {
+        throw std::runtime_error( "the key is not mapped" );
+    }
+
+    return *value;
+}
+
+template <typename V, uint32 N>
+inline
+bool StaticMap<V, N>::has( const char* key ) const
+{
+    return find( key ) != nullptr;
+}
+
+template <typename V, uint32 N>
+inline
+constexpr const typename StaticMap<V, N>::Entry*
+StaticMap<V, N>::entries() const
+{
+    return _entries;
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::size() const
+{
+    return N;
+}
+
+template <typename V, uint32 N>
+inline
+constexpr uint32 StaticMap<V, N>::slotCount() const
+{
+    return SLOT_COUNT;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif // NGE_CNTR_STATIC_MAP_H
@@ -0,0 +1,449 @@
+// batch.h
+//
+// The batch kernels transform, normalize, dot and interpolate whole arrays
+// of vectors at once. They process 8 vectors at a time with AVX2 or 4 at a
+// time with SSE, chosen when the program starts from what the processor
+// supports, and finish any remainder one vector at a time.
+//
+// Each kernel comes in two layouts. The array of structures (AoS) form
+// takes arrays of vectors. The structure of arrays (SoA) form takes one
+// array per component, which the kernels can load directly into their
+// lanes, so it is the faster of the two. The AoS form shuffles groups of
+// four vectors into components in registers and back, and stays on SSE
+// when AVX2 is used.
+//
+// Arrays are passed as ArrayIn and ArrayOut, which wrap a pointer and a
+// size, a FixedArray or a DynamicArray. Output arrays must already hold as
+// many items as the input and may be the same as an input.
+//
+// Every path adds and multiplies in the same order, so the results are the
+// same whichever instructions are used.
+//
+// Usage:
+//     DynamicArray<Vec3> positions;
+//     DynamicArray<Vec3> world;
+//
+//     world = positions;
+//     Batch::transformPoints( model, positions, world );
+//
+#ifndef NGE_MATH_BATCH_H
+#define NGE_MATH_BATCH_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/containers/dynamic_array.h"
+#include "engine/containers/fixed_array.h"
+#include "engine/math/mat.h"
+#include "engine/math/vec.h"
+
+namespace nge
+{
+
+namespace math
+{
+
+template <typename T>
+class ArrayIn
+{
+  private:
+    // MEMBERS
+    /**
+     * The first item of each contiguous run.
+     */
+    const T* _values[2];
+
+    /**
+     * The number of items in each contiguous run.
+     */
+    uint32 _sizes[2];
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a view of the given number of items.
+     */
+    ArrayIn( const T* values, uint32 size );
+
+    /**
+     * Constructs a view of the items of the array.
+     */
+    template <template <typename> class A>
+    ArrayIn( const cntr::FixedArray<T, A>& array );
+
+    /**
+     * Constructs a view of the items of the array.
+     */
+    template <template <typename> class A>
+    ArrayIn( const cntr::DynamicArray<T, A>& array );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the first item of the contiguous run.
+     *
+     * Behavior is undefined when:
+     * - run is not 0 or 1
+     */
+    const T* values( uint32 run ) const;
+
+    /**
+     * Gets the number of items in the contiguous run, which is zero when
+     * the items are in one run.
+     *
+     * Behavior is undefined when:
+     * - run is not 0 or 1
+     */
+    uint32 size( uint32 run ) const;
+
+    /**
+     * Gets the number of items.
+     */
+    uint32 size() const;
+};
+
+template <typename T>
+class ArrayOut
+{
+  private:
+    // MEMBERS
+    /**
+     * The first item of each contiguous run.
+     */
+    T* _values[2];
+
+    /**
+     * The number of items in each contiguous run.
+     */
+    uint32 _sizes[2];
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a view of the given number of items.
+     */
+    ArrayOut( T* values, uint32 size );
+
+    /**
+     * Constructs a view of the items of the array.
+     */
+    template <template <typename> class A>
+    ArrayOut( cntr::FixedArray<T, A>& array );
+
+    /**
+     * Constructs a view of the items of the array.
+     */
+    template <template <typename> class A>
+    ArrayOut( cntr::DynamicArray<T, A>& array );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the first item of the contiguous run.
+     *
+     * Behavior is undefined when:
+     * - run is not 0 or 1
+     */
+    T* values( uint32 run ) const;
+
+    /**
+     * Gets the number of items in the contiguous run, which is zero when
+     * the items are in one run.
+     *
+     * Behavior is undefined when:
+     * - run is not 0 or 1
+     */
+    uint32 size( uint32 run ) const;
+
+    /**
+     * Gets the number of items.
+     */
+    uint32 size() const;
+};
+
+struct Batch
+{
+    // TYPES
+    /**
+     * Defines the instructions that the kernels can use.
+     */
+    enum Instructions
+    {
+        SCALAR,
+        SSE,
+        AVX2
+    };
+
+    /**
+     * Gets the instructions that the kernels use.
+     */
+    static Instructions instructions();
+
+    /**
+     * Gets the best instructions that the processor and build support.
+     */
+    static Instructions supported();
+
+    /**
+     * Makes the kernels use the given instructions.
+     *
+     * This is meant for tests and benchmarks and is not thread safe.
+     *
+     * Behavior is undefined when:
+     * - instructions are better than those supported
+     */
+    static void setInstructions( Instructions instructions );
+
+    // TRANSFORMS
+    /**
+     * Transforms the points by the matrix.
+     *
+     * The points are treated as having a w of one. The last row of the
+     * matrix is ignored, so there is no perspective divide.
+     *
+     * Behavior is undefined when:
+     * - out has fewer items than in
+     */
+    static void transformPoints( const Mat4& m,
+                                 ArrayIn<Vec3> in,
+                                 ArrayOut<Vec3> out );
+
+    /**
+     * Transforms the points given as components by the matrix.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     */
+    static void transformPoints( const Mat4& m,
+                                 ArrayIn<float> x,
+                                 ArrayIn<float> y,
+                                 ArrayIn<float> z,
+                                 ArrayOut<float> outX,
+                                 ArrayOut<float> outY,
+                                 ArrayOut<float> outZ );
+
+    /**
+     * Transforms the 2D points by the matrix.
+     *
+     * The points are treated as having a z of one. The last row of the
+     * matrix is ignored.
+     *
+     * Behavior is undefined when:
+     * - out has fewer items than in
+     */
+    static void transform2D( const Mat3& m,
+                             ArrayIn<Vec2> in,
+                             ArrayOut<Vec2> out );
+
+    /**
+     * Transforms the 2D points given as components by the matrix.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     */
+    static void transform2D( const Mat3& m,
+                             ArrayIn<float> x,
+                             ArrayIn<float> y,
+                             ArrayOut<float> outX,
+                             ArrayOut<float> outY );
+
+    // VECTOR FUNCTIONS
+    /**
+     * Normalizes the vectors.
+     *
+     * Behavior is undefined when:
+     * - out has fewer items than in
+     * - any vector has a length of zero
+     */
+    static void normalizeAll( ArrayIn<Vec3> in, ArrayOut<Vec3> out );
+
+    /**
+     * Normalizes the vectors given as components.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     * - any vector has a length of zero
+     */
+    static void normalizeAll( ArrayIn<float> x,
+                              ArrayIn<float> y,
+                              ArrayIn<float> z,
+                              ArrayOut<float> outX,
+                              ArrayOut<float> outY,
+                              ArrayOut<float> outZ );
+
+    /**
+     * Calculates the dot product of each pair of vectors.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     */
+    static void dotMany( ArrayIn<Vec3> a,
+                         ArrayIn<Vec3> b,
+                         ArrayOut<float> out );
+
+    /**
+     * Calculates the dot product of each pair of vectors given as
+     * components.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     */
+    static void dotMany( ArrayIn<float> ax,
+                         ArrayIn<float> ay,
+                         ArrayIn<float> az,
+                         ArrayIn<float> bx,
+                         ArrayIn<float> by,
+                         ArrayIn<float> bz,
+                         ArrayOut<float> out );
+
+    /**
+     * Interpolates linearly from each vector of a to the vector of b.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     */
+    static void lerpMany( ArrayIn<Vec3> a,
+                          ArrayIn<Vec3> b,
+                          float t,
+                          ArrayOut<Vec3> out );
+
+    /**
+     * Interpolates linearly from each value of a to the value of b, which
+     * interpolates vectors given as components one component at a time.
+     *
+     * Behavior is undefined when:
+     * - the arrays have different sizes
+     */
+    static void lerpMany( ArrayIn<float> a,
+                          ArrayIn<float> b,
+                          float t,
+                          ArrayOut<float> out );
+};
+
+// ARRAY IN
+// CONSTRUCTORS
+template <typename T>
+inline
+ArrayIn<T>::ArrayIn( const T* values, uint32 size )
+    : _values { values, nullptr }, _sizes { size, 0 }
+{
+    assert( values != nullptr || size == 0 );
+}
+
+template <typename T>
+template <template <typename> class A>
+inline
+ArrayIn<T>::ArrayIn( const cntr::FixedArray<T, A>& array )
+    : _values { array.size() > 0 ? &array[0] : nullptr, nullptr },
+      _sizes { array.size(), 0 }
+{
+}
+
+template <typename T>
+template <template <typename> class A>
+inline
+ArrayIn<T>::ArrayIn( const cntr::DynamicArray<T, A>& array )
+    : _values { nullptr, nullptr }, _sizes { 0, 0 }
+{
+    if ( array.size() > 0 )
+    {
+        _values[0] = &array[0];
+        _sizes[0] = array.contiguousSize( 0 );
+    }
+
+    if ( _sizes[0] < array.size() )
+    {
+        _values[1] = &array[_sizes[0]];
+        _sizes[1] = array.size() - _sizes[0];
+    }
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+const T* ArrayIn<T>::values( uint32 run ) const
+{
+    assert( run < 2 );
+    return _values[run];
+}
+
+template <typename T>
+inline
+uint32 ArrayIn<T>::size( uint32 run ) const
+{
+    assert( run < 2 );
+    return _sizes[run];
+}
+
+template <typename T>
+inline
+uint32 ArrayIn<T>::size() const
+{
+    return _sizes[0] + _sizes[1];
+}
+
+// ARRAY OUT
+// CONSTRUCTORS
+template <typename T>
+inline
+ArrayOut<T>::ArrayOut( T* values, uint32 size )
+    : _values { values, nullptr }, _sizes { size, 0 }
+{
+    assert( values != nullptr || size == 0 );
+}
+
+template <typename T>
+template <template <typename> class A>
+inline
+ArrayOut<T>::ArrayOut( cntr::FixedArray<T, A>& array )
+    : _values { array.size() > 0 ? &array[0] : nullptr, nullptr },
+      _sizes { array.size(), 0 }
+{
+}
+
+template <typename T>
+template <template <typename> class A>
+inline
+ArrayOut<T>::ArrayOut( cntr::DynamicArray<T, A>& array )
+    : _values { nullptr, nullptr }, _sizes { 0, 0 }
+{
+    if ( array.size() > 0 )
+    {
+        _values[0] = &array[0];
+        _sizes[0] = array.contiguousSize( 0 );
+    }
+
+    if ( _sizes[0] < array.size() )
+    {
+        _values[1] = &array[_sizes[0]];
+        _sizes[1] = array.size() - _sizes[0];
+    }
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* ArrayOut<T>::values( uint32 run ) const
+{
+    assert( run < 2 );
+    return _values[run];
+}
+
+template <typename T>
+inline
+uint32 ArrayOut<T>::size( uint32 run ) const
+{
+    assert( run < 2 );
+    return _sizes[run];
+}
+
+template <typename T>
+inline
+uint32 ArrayOut<T>::size() const
+{
+    return _sizes[0] + _sizes[1];
+}
+
+} // End nspc math
+
+} // End nspc nge
+
+#endif // NGE_MATH_BATCH_H
@@ -1404,6 +1404,167 @@ bool operator!=( const TMat4x4<T>& m1, const TMat4x4<U>& m2 )
     return m1[0] != m2[0] || m1[1] != m2[1] || m1[2] != m2[2] || m1[3] != m2[3];
 }
 
+#ifdef NGE_MATH_SSE
+// SSE SPECIALIZATIONS
+template <>
+inline
+TVec4<float> operator*( const TMat4x4<float>& m, const TVec4<float>& v )
+{
+    TVec4<float> result;
+    __m128 sum;
+
+    // sum the columns scaled by the components in the same order as the
+    // scalar product so both give the same result
+    sum = _mm_mul_ps( _mm_load_ps( &m[0].x ), _mm_set1_ps( v.x ) );
+    sum = _mm_add_ps( sum, _mm_mul_ps( _mm_load_ps( &m[1].x ),
+                                       _mm_set1_ps( v.y ) ) );
+    sum = _mm_add_ps( sum, _mm_mul_ps( _mm_load_ps( &m[2].x ),
+                                       _mm_set1_ps( v.z ) ) );
+    sum = _mm_add_ps( sum, _mm_mul_ps( _mm_load_ps( &m[3].x ),
+                                       _mm_set1_ps( v.w ) ) );
+
+    _mm_store_ps( &result.x, sum );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator*( const TVec4<float>& v, const TMat4x4<float>& m )
+{
+    TVec4<float> result;
+    __m128 row0 = _mm_load_ps( &m[0].x );
+    __m128 row1 = _mm_load_ps( &m[1].x );
+    __m128 row2 = _mm_load_ps( &m[2].x );
+    __m128 row3 = _mm_load_ps( &m[3].x );
+    __m128 sum;
+
+    // the rows of the transpose are the columns of the matrix
+    _MM_TRANSPOSE4_PS( row0, row1, row2, row3 );
+
+    sum = _mm_mul_ps( _mm_set1_ps( v.x ), row0 );
+    sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( v.y ), row1 ) );
+    sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( v.z ), row2 ) );
+    sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( v.w ), row3 ) );
+
+    _mm_store_ps( &result.x, sum );
+    return result;
+}
+
+template <>
+inline
+TMat4x4<float> operator*( const TMat4x4<float>& a, const TMat4x4<float>& b )
+{
+    TMat4x4<float> result;
+    __m128 a0 = _mm_load_ps( &a[0].x );
+    __m128 a1 = _mm_load_ps( &a[1].x );
+    __m128 a2 = _mm_load_ps( &a[2].x );
+    __m128 a3 = _mm_load_ps( &a[3].x );
+    __m128 sum;
+    uint32 i;
+
+    // each column of the product is the first matrix times that column of
+    // the second
+    for ( i = 0; i < 4; ++i )
+    {
+        sum = _mm_mul_ps( a0, _mm_set1_ps( b[i].x ) );
+        sum = _mm_add_ps( sum, _mm_mul_ps( a1, _mm_set1_ps( b[i].y ) ) );
+        sum = _mm_add_ps( sum, _mm_mul_ps( a2, _mm_set1_ps( b[i].z ) ) );
+        sum = _mm_add_ps( sum, _mm_mul_ps( a3, _mm_set1_ps( b[i].w ) ) );
+        _mm_store_ps( &result[i].x, sum );
+    }
+
+    return result;
+}
+
+template <>
+inline
+TMat4x4<float> Mat::invert( const TMat4x4<float>& m )
+{
+    TMat4x4<float> result;
+    __m128 c0 = _mm_load_ps( &m[0].x );
+    __m128 c1 = _mm_load_ps( &m[1].x );
+    __m128 c2 = _mm_load_ps( &m[2].x );
+    __m128 c3 = _mm_load_ps( &m[3].x );
+    __m128 a;
+    __m128 b;
+    __m128 c;
+    __m128 d;
+    __m128 dets;
+    __m128 detA;
+    __m128 detB;
+    __m128 detC;
+    __m128 detD;
+    __m128 adjDC;
+    __m128 adjAB;
+    __m128 x;
+    __m128 y;
+    __m128 z;
+    __m128 w;
+    __m128 det;
+
+    // the columns are the rows of the transpose, whose inverse is the
+    // transpose of the inverse, so working on them as rows gives the
+    // columns of the inverse
+
+    // split the transpose into 2x2 blocks
+    // A B
+    // C D
+    a = _mm_movelh_ps( c0, c1 );
+    b = _mm_movehl_ps( c1, c0 );
+    c = _mm_movelh_ps( c2, c3 );
+    d = _mm_movehl_ps( c3, c2 );
+
+    // determinants of the blocks
+    dets = _mm_sub_ps(
+        _mm_mul_ps( _mm_shuffle_ps( c0, c2, _MM_SHUFFLE( 2, 0, 2, 0 ) ),
+                    _mm_shuffle_ps( c1, c3, _MM_SHUFFLE( 3, 1, 3, 1 ) ) ),
+        _mm_mul_ps( _mm_shuffle_ps( c0, c2, _MM_SHUFFLE( 3, 1, 3, 1 ) ),
+                    _mm_shuffle_ps( c1, c3, _MM_SHUFFLE( 2, 0, 2, 0 ) ) ) );
+    detA = _mm_shuffle_ps( dets, dets, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+    detB = _mm_shuffle_ps( dets, dets, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+    detC = _mm_shuffle_ps( dets, dets, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+    detD = _mm_shuffle_ps( dets, dets, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+
+    // adjugates of the blocks of the inverse by Cramer's rule
+    // X Y
+    // Z W
+    adjDC = Simd<float>::adjMul2x2( d, c );
+    adjAB = Simd<float>::adjMul2x2( a, b );
+    x = _mm_sub_ps( _mm_mul_ps( detD, a ), Simd<float>::mul2x2( b, adjDC ) );
+    w = _mm_sub_ps( _mm_mul_ps( detA, d ), Simd<float>::mul2x2( c, adjAB ) );
+    y = _mm_sub_ps( _mm_mul_ps( detB, c ),
+                    Simd<float>::mulAdj2x2( d, adjAB ) );
+    z = _mm_sub_ps( _mm_mul_ps( detC, b ),
+                    Simd<float>::mulAdj2x2( a, adjDC ) );
+
+    // |M| = |A| |D| + |B| |C| - tr( adj( A ) B adj( D ) C )
+    det = _mm_add_ps( _mm_mul_ps( detA, detD ), _mm_mul_ps( detB, detC ) );
+    det = _mm_sub_ps( det, Simd<float>::sum( _mm_mul_ps(
+        adjAB, _mm_shuffle_ps( adjDC, adjDC, _MM_SHUFFLE( 3, 1, 2, 0 ) ) ) ) );
+
+    assert( _mm_cvtss_f32( det ) != 0.0f );
+
+    // scale by the determinant with the signs of the adjugates
+    det = _mm_div_ps( _mm_setr_ps( 1.0f, -1.0f, -1.0f, 1.0f ), det );
+    x = _mm_mul_ps( x, det );
+    y = _mm_mul_ps( y, det );
+    z = _mm_mul_ps( z, det );
+    w = _mm_mul_ps( w, det );
+
+    // take the adjugates of the blocks and put them back together
+    _mm_store_ps( &result[0].x,
+                  _mm_shuffle_ps( x, y, _MM_SHUFFLE( 1, 3, 1, 3 ) ) );
+    _mm_store_ps( &result[1].x,
+                  _mm_shuffle_ps( x, y, _MM_SHUFFLE( 0, 2, 0, 2 ) ) );
+    _mm_store_ps( &result[2].x,
+                  _mm_shuffle_ps( z, w, _MM_SHUFFLE( 1, 3, 1, 3 ) ) );
+    _mm_store_ps( &result[3].x,
+                  _mm_shuffle_ps( z, w, _MM_SHUFFLE( 0, 2, 0, 2 ) ) );
+
+    return result;
+}
+#endif
+
 } // End nspc math
 
 } // End nspc nge
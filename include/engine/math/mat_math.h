@@ -48,7 +48,7 @@ struct Mat
      * @return The determinant.
      */
     template <typename T>
-    static TMat2x2<T> determinant( const TMat2x2<T>&m );
+    static T determinant( const TMat2x2<T>& m );
 
     /**
      * Computes the determinant of the matrix.
@@ -57,7 +57,7 @@ struct Mat
      * @return The determinant.
      */
     template <typename T>
-    static TMat3x3<T> determinant( const TMat3x3<T>&m );
+    static T determinant( const TMat3x3<T>& m );
 
     /**
      * Computes the determinant of the matrix.
@@ -66,7 +66,7 @@ struct Mat
      * @return The determinant.
      */
     template <typename T>
-    static TMat4x4<T> determinant( const TMat4x4<T>&m );
+    static T determinant( const TMat4x4<T>& m );
 
     /**
      * Computes the inverse of a matrix.
@@ -95,6 +95,39 @@ struct Mat
     template <typename T>
     static TMat4x4<T> invert( const TMat4x4<T>& m );
 
+    /**
+     * Computes the inverse of an affine transformation matrix.
+     *
+     * Only the upper 3x3 matrix needs a full inverse, which is then used to
+     * move the translation back, so this is much cheaper than invert.
+     *
+     * Behavior is undefined when:
+     * - the last row is not 0 0 0 1
+     * - the upper 3x3 matrix is singular
+     *
+     * @param m The matrix.
+     * @return The inverse matrix.
+     */
+    template <typename T>
+    static TMat4x4<T> invertAffine( const TMat4x4<T>& m );
+
+    /**
+     * Computes the inverse of a rigid transformation matrix, which is a
+     * rotation followed by a translation.
+     *
+     * The inverse of a rotation is its transpose, so this only transposes
+     * the upper 3x3 matrix and rotates the negated translation by it.
+     *
+     * Behavior is undefined when:
+     * - the last row is not 0 0 0 1
+     * - the upper 3x3 matrix is not orthonormal
+     *
+     * @param m The matrix.
+     * @return The inverse matrix.
+     */
+    template <typename T>
+    static TMat4x4<T> invertOrthonormal( const TMat4x4<T>& m );
+
     /**
      * Computes the transpose of a matrix.
      *
@@ -198,7 +231,7 @@ struct Mat
 };
 
 template <typename T>
-TMat2x2<T> Mat::determinant( const TMat2x2<T>& m )
+T Mat::determinant( const TMat2x2<T>& m )
 {
     // 2x2 Matrix
     // A B
@@ -222,7 +255,7 @@ TMat2x2<T> Mat::determinant( const TMat2x2<T>& m )
 }
 
 template <typename T>
-TMat3x3<T> Mat::determinant( const TMat3x3<T>& m )
+T Mat::determinant( const TMat3x3<T>& m )
 {
     // 3x3 Matrix
     // A B C
@@ -262,7 +295,7 @@ TMat3x3<T> Mat::determinant( const TMat3x3<T>& m )
 }
 
 template <typename T>
-TMat4x4<T> Mat::determinant( const TMat4x4<T>& m )
+T Mat::determinant( const TMat4x4<T>& m )
 {
     // 4x4 Matrix
     // A B C D
@@ -507,6 +540,104 @@ TMat4x4<T> Mat::invert( const TMat4x4<T>& m )
     return oneOverDet * adj;
 }
 
+template <typename T>
+TMat4x4<T> Mat::invertAffine( const TMat4x4<T>& m )
+{
+    // 4x4 Matrix
+    // A B C D
+    // E F G H
+    // I J K L
+    // 0 0 0 1
+
+    assert( m[0][3] == static_cast<T>( 0 ) &&
+            m[1][3] == static_cast<T>( 0 ) &&
+            m[2][3] == static_cast<T>( 0 ) &&
+            m[3][3] == static_cast<T>( 1 ) );
+
+    // assign meaningful names to the values for readability
+    #define A ( m[0][0] )
+    #define B ( m[1][0] )
+    #define C ( m[2][0] )
+    #define D ( m[3][0] )
+    #define E ( m[0][1] )
+    #define F ( m[1][1] )
+    #define G ( m[2][1] )
+    #define H ( m[3][1] )
+    #define I ( m[0][2] )
+    #define J ( m[1][2] )
+    #define K ( m[2][2] )
+    #define L ( m[3][2] )
+
+    // calculate cofactors of the upper 3x3 matrix
+    T Ca =  F * K - G * J;
+    T Cb = -E * K + G * I;
+    T Cc =  E * J - F * I;
+    T Cd = -B * K + C * J;
+    T Ce =  A * K - C * I;
+    T Cf = -A * J + B * I;
+    T Cg =  B * G - C * F;
+    T Ch = -A * G + C * E;
+    T Ci =  A * F - B * E;
+
+    // determinant from minors
+    T det = A * Ca + B * Cb + C * Cc;
+
+    assert( det != static_cast<T>( 0 ) );
+
+    T oneOverDet = static_cast<T>( 1 ) / det;
+
+    // inverse of the upper 3x3 matrix
+    Ca *= oneOverDet;
+    Cb *= oneOverDet;
+    Cc *= oneOverDet;
+    Cd *= oneOverDet;
+    Ce *= oneOverDet;
+    Cf *= oneOverDet;
+    Cg *= oneOverDet;
+    Ch *= oneOverDet;
+    Ci *= oneOverDet;
+
+    // the translation is undone by the inverse
+    TMat4x4<T> inv( Ca, Cd, Cg, -( Ca * D + Cd * H + Cg * L ),
+                    Cb, Ce, Ch, -( Cb * D + Ce * H + Ch * L ),
+                    Cc, Cf, Ci, -( Cc * D + Cf * H + Ci * L ),
+                    0, 0, 0, 1 );
+
+    #undef A
+    #undef B
+    #undef C
+    #undef D
+    #undef E
+    #undef F
+    #undef G
+    #undef H
+    #undef I
+    #undef J
+    #undef K
+    #undef L
+
+    return inv;
+}
+
+template <typename T>
+TMat4x4<T> Mat::invertOrthonormal( const TMat4x4<T>& m )
+{
+    assert( m[0][3] == static_cast<T>( 0 ) &&
+            m[1][3] == static_cast<T>( 0 ) &&
+            m[2][3] == static_cast<T>( 0 ) &&
+            m[3][3] == static_cast<T>( 1 ) );
+
+    // the columns of the rotation become the rows of its inverse
+    return TMat4x4<T>(
+        m[0][0], m[0][1], m[0][2],
+        -( m[0][0] * m[3][0] + m[0][1] * m[3][1] + m[0][2] * m[3][2] ),
+        m[1][0], m[1][1], m[1][2],
+        -( m[1][0] * m[3][0] + m[1][1] * m[3][1] + m[1][2] * m[3][2] ),
+        m[2][0], m[2][1], m[2][2],
+        -( m[2][0] * m[3][0] + m[2][1] * m[3][1] + m[2][2] * m[3][2] ),
+        0, 0, 0, 1 );
+}
+
 template <typename T>
 TMat4x4<T> Mat::transpose( const TMat4x4<T>& m )
 {
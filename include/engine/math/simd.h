@@ -0,0 +1,154 @@
+// simd.h
+//
+// Selects the SIMD instructions used by the float vector and matrix types.
+// When SSE2 is available, TVec4<float> and TMat4x4<float> have SSE versions
+// of their arithmetic, products and vector functions. Defining
+// NGE_MATH_SCALAR keeps every type on the generic scalar code.
+//
+// TVec4<float> is 16-byte aligned whether or not SSE is used so that the
+// layout of the types does not depend on the build.
+//
+#ifndef NGE_MATH_SIMD_H
+#define NGE_MATH_SIMD_H
+
+#include "engine/intdef.h"
+
+#if !defined( NGE_MATH_SCALAR ) && \
+    ( defined( __SSE2__ ) || defined( _M_X64 ) || \
+      ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) )
+#define NGE_MATH_SSE
+#endif
+
+#ifdef NGE_MATH_SSE
+#include <emmintrin.h>
+#endif
+
+namespace nge
+{
+
+namespace math
+{
+
+template <typename T>
+struct Simd
+{
+    /**
+     * The alignment of a 4D vector.
+     */
+    static constexpr uint32 VEC4_ALIGNMENT = alignof( T );
+};
+
+template <>
+struct Simd<float>
+{
+    /**
+     * The alignment of a 4D vector, which is the alignment of an SSE
+     * register.
+     */
+    static constexpr uint32 VEC4_ALIGNMENT = 16;
+
+#ifdef NGE_MATH_SSE
+    /**
+     * Gets the sum of the lanes in every lane.
+     *
+     * @param v The lanes.
+     * @return The sum.
+     */
+    static __m128 sum( __m128 v );
+
+    /**
+     * Gets the dot product of the lanes in every lane.
+     *
+     * @param a The first lanes.
+     * @param b The second lanes.
+     * @return The dot product.
+     */
+    static __m128 dot( __m128 a, __m128 b );
+
+    /**
+     * Multiplies two 2x2 matrices stored by rows in the lanes.
+     *
+     * @param a The first matrix.
+     * @param b The second matrix.
+     * @return The product a * b.
+     */
+    static __m128 mul2x2( __m128 a, __m128 b );
+
+    /**
+     * Multiplies the adjugate of a 2x2 matrix by another.
+     *
+     * @param a The matrix whose adjugate is used.
+     * @param b The second matrix.
+     * @return The product adj( a ) * b.
+     */
+    static __m128 adjMul2x2( __m128 a, __m128 b );
+
+    /**
+     * Multiplies a 2x2 matrix by the adjugate of another.
+     *
+     * @param a The first matrix.
+     * @param b The matrix whose adjugate is used.
+     * @return The product a * adj( b ).
+     */
+    static __m128 mulAdj2x2( __m128 a, __m128 b );
+#endif
+};
+
+template <typename T>
+constexpr uint32 Simd<T>::VEC4_ALIGNMENT;
+
+#ifdef NGE_MATH_SSE
+inline
+__m128 Simd<float>::sum( __m128 v )
+{
+    __m128 swapped;
+
+    // add the neighbouring lanes then the neighbouring pairs
+    swapped = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    v = _mm_add_ps( v, swapped );
+    swapped = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    return _mm_add_ps( v, swapped );
+}
+
+inline
+__m128 Simd<float>::dot( __m128 a, __m128 b )
+{
+    return sum( _mm_mul_ps( a, b ) );
+}
+
+inline
+__m128 Simd<float>::mul2x2( __m128 a, __m128 b )
+{
+    // a0 b0 + a1 b2, a0 b1 + a1 b3, a2 b0 + a3 b2, a2 b1 + a3 b3
+    return _mm_add_ps(
+        _mm_mul_ps( a, _mm_shuffle_ps( b, b, _MM_SHUFFLE( 3, 0, 3, 0 ) ) ),
+        _mm_mul_ps( _mm_shuffle_ps( a, a, _MM_SHUFFLE( 2, 3, 0, 1 ) ),
+                    _mm_shuffle_ps( b, b, _MM_SHUFFLE( 1, 2, 1, 2 ) ) ) );
+}
+
+inline
+__m128 Simd<float>::adjMul2x2( __m128 a, __m128 b )
+{
+    // the adjugate of a is a3 -a1 -a2 a0
+    return _mm_sub_ps(
+        _mm_mul_ps( _mm_shuffle_ps( a, a, _MM_SHUFFLE( 0, 0, 3, 3 ) ), b ),
+        _mm_mul_ps( _mm_shuffle_ps( a, a, _MM_SHUFFLE( 2, 2, 1, 1 ) ),
+                    _mm_shuffle_ps( b, b, _MM_SHUFFLE( 1, 0, 3, 2 ) ) ) );
+}
+
+inline
+__m128 Simd<float>::mulAdj2x2( __m128 a, __m128 b )
+{
+    // the adjugate of b is b3 -b1 -b2 b0
+    return _mm_sub_ps(
+        _mm_mul_ps( a, _mm_shuffle_ps( b, b, _MM_SHUFFLE( 0, 3, 0, 3 ) ) ),
+        _mm_mul_ps( _mm_shuffle_ps( a, a, _MM_SHUFFLE( 2, 3, 0, 1 ) ),
+                    _mm_shuffle_ps( b, b, _MM_SHUFFLE( 1, 2, 1, 2 ) ) ) );
+}
+#endif
+
+} // End nspc math
+
+} // End nspc nge
+
+#endif // NGE_MATH_SIMD_H
@@ -7,6 +7,7 @@
 
 #include "engine/intdef.h"
 #include "engine/math/math.h"
+#include "engine/math/simd.h"
 
 /**
  * This protects against template issues where U could also be one of the
@@ -50,7 +51,7 @@ template <typename T>
 class TMat4x4;
 
 template <typename T>
-class TVec4
+class alignas( Simd<T>::VEC4_ALIGNMENT ) TVec4
 {
   public:
     typedef T ValueType;
@@ -1695,6 +1696,134 @@ TRef4<T>::~TRef4()
 {
 }
 
+#ifdef NGE_MATH_SSE
+// SSE SPECIALIZATIONS
+template <>
+template <>
+inline
+TVec4<float>& TVec4<float>::operator+=( const TVec4<float>& v )
+{
+    _mm_store_ps( &x, _mm_add_ps( _mm_load_ps( &x ), _mm_load_ps( &v.x ) ) );
+    return *this;
+}
+
+template <>
+template <>
+inline
+TVec4<float>& TVec4<float>::operator-=( const TVec4<float>& v )
+{
+    _mm_store_ps( &x, _mm_sub_ps( _mm_load_ps( &x ), _mm_load_ps( &v.x ) ) );
+    return *this;
+}
+
+template <>
+template <>
+inline
+TVec4<float>& TVec4<float>::operator*=( const TVec4<float>& v )
+{
+    _mm_store_ps( &x, _mm_mul_ps( _mm_load_ps( &x ), _mm_load_ps( &v.x ) ) );
+    return *this;
+}
+
+template <>
+template <>
+inline
+TVec4<float>& TVec4<float>::operator/=( const TVec4<float>& v )
+{
+    assert( v.x != 0 && v.y != 0 && v.z != 0 && v.w != 0 );
+    _mm_store_ps( &x, _mm_div_ps( _mm_load_ps( &x ), _mm_load_ps( &v.x ) ) );
+    return *this;
+}
+
+template <>
+inline
+TVec4<float> TVec4<float>::operator-() const
+{
+    TVec4<float> result;
+
+    // flip the sign bits so that zero becomes negative zero like it does
+    // with scalar negation
+    _mm_store_ps( &result.x, _mm_xor_ps( _mm_load_ps( &x ),
+                                         _mm_set1_ps( -0.0f ) ) );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator+( const TVec4<float>& u, const TVec4<float>& v )
+{
+    TVec4<float> result;
+
+    _mm_store_ps( &result.x, _mm_add_ps( _mm_load_ps( &u.x ),
+                                         _mm_load_ps( &v.x ) ) );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator-( const TVec4<float>& u, const TVec4<float>& v )
+{
+    TVec4<float> result;
+
+    _mm_store_ps( &result.x, _mm_sub_ps( _mm_load_ps( &u.x ),
+                                         _mm_load_ps( &v.x ) ) );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator*( const TVec4<float>& v, const float& s )
+{
+    TVec4<float> result;
+
+    _mm_store_ps( &result.x, _mm_mul_ps( _mm_load_ps( &v.x ),
+                                         _mm_set1_ps( s ) ) );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator*( const float& s, const TVec4<float>& v )
+{
+    return v * s;
+}
+
+template <>
+inline
+TVec4<float> operator*( const TVec4<float>& u, const TVec4<float>& v )
+{
+    TVec4<float> result;
+
+    _mm_store_ps( &result.x, _mm_mul_ps( _mm_load_ps( &u.x ),
+                                         _mm_load_ps( &v.x ) ) );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator/( const TVec4<float>& v, const float& s )
+{
+    TVec4<float> result;
+
+    assert( s != 0 );
+    _mm_store_ps( &result.x, _mm_div_ps( _mm_load_ps( &v.x ),
+                                         _mm_set1_ps( s ) ) );
+    return result;
+}
+
+template <>
+inline
+TVec4<float> operator/( const TVec4<float>& u, const TVec4<float>& v )
+{
+    TVec4<float> result;
+
+    assert( v.x != 0 && v.y != 0 && v.z != 0 && v.w != 0 );
+    _mm_store_ps( &result.x, _mm_div_ps( _mm_load_ps( &u.x ),
+                                         _mm_load_ps( &v.x ) ) );
+    return result;
+}
+#endif
+
 } // End nspc math
 
 } // End nspc nge
@@ -2,7 +2,14 @@
 #ifndef NGE_MATH_VEC_MATH_H
 #define NGE_MATH_VEC_MATH_H
 
+#include <assert.h>
+
 #include "engine/math/math.h"
+#include "engine/math/simd.h"
+
+#ifdef NGE_MATH_SSE
+#include "engine/math/vec4.h"
+#endif
 
 namespace nge
 {
@@ -233,7 +240,9 @@ template <typename T>
 inline
 TVec3<T> Vec::cross( const TVec3<T>& a, const TVec3<T>& b )
 {
-
+    return TVec3<T>( a.y * b.z - a.z * b.y,
+                     a.z * b.x - a.x * b.z,
+                     a.x * b.y - a.y * b.x );
 }
 
 template <typename T>
@@ -257,6 +266,40 @@ TVec4<T> Vec::project( const TVec4<T>& a, const TVec4<T>& b )
 
 }
 
+#ifdef NGE_MATH_SSE
+// SSE SPECIALIZATIONS
+template <>
+inline
+float Vec::length( const TVec4<float>& v )
+{
+    __m128 lanes = _mm_load_ps( &v.x );
+
+    return _mm_cvtss_f32( _mm_sqrt_ss( Simd<float>::dot( lanes, lanes ) ) );
+}
+
+template <>
+inline
+TVec4<float> Vec::normalize( const TVec4<float>& v )
+{
+    TVec4<float> result;
+    __m128 lanes = _mm_load_ps( &v.x );
+    __m128 len = _mm_sqrt_ps( Simd<float>::dot( lanes, lanes ) );
+
+    assert( _mm_cvtss_f32( len ) != 0 );
+
+    _mm_store_ps( &result.x, _mm_div_ps( lanes, len ) );
+    return result;
+}
+
+template <>
+inline
+float Vec::dot( const TVec4<float>& a, const TVec4<float>& b )
+{
+    return _mm_cvtss_f32(
+        Simd<float>::dot( _mm_load_ps( &a.x ), _mm_load_ps( &b.x ) ) );
+}
+#endif
+
 } // End nspc math
 
 } // End nspc nge
@@ -0,0 +1,187 @@
+// aligned_allocator.h
+//
+// The aligned allocator allocates instances whose storage starts on the
+// given alignment, such as 16 or 32 bytes for SIMD loads and stores or a
+// cache line for data that is written by different threads.
+//
+// Instances are default constructed when they are allocated and destructed
+// when they are released like the default allocator does.
+//
+// Containers request aligned storage by using the aligned policy:
+//     cntr::DynamicArray<math::Vec4, mem::AlignedPolicy<16>::Allocator> a;
+//     cntr::FixedArray<float, mem::AlignedPolicy<32>::Allocator> b( 64 );
+//
+#ifndef NGE_MEM_ALIGNED_ALLOCATOR_H
+#define NGE_MEM_ALIGNED_ALLOCATOR_H
+
+#include <assert.h>
+#include <new>
+
+#include "engine/intdef.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T, uint32 ALIGN>
+class AlignedAllocator : public IAllocator<T>
+{
+    static_assert( ALIGN > 0 && ( ALIGN & ( ALIGN - 1 ) ) == 0,
+                   "the alignment must be a power of two" );
+    static_assert( ALIGN >= alignof( T ),
+                   "the alignment must be at least the alignment of T" );
+
+  public:
+    // CONSTANTS
+    /**
+     * The alignment of every allocation in bytes.
+     */
+    static constexpr uint32 ALIGNMENT = ALIGN;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs the allocator.
+     */
+    AlignedAllocator();
+
+    /**
+     * Constructs a copy of an allocator.
+     */
+    AlignedAllocator( const AlignedAllocator<T, ALIGN>& copy );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~AlignedAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns a copy of an allocator.
+     */
+    AlignedAllocator<T, ALIGN>& operator=(
+        const AlignedAllocator<T, ALIGN>& assign );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets the alignment of every allocation.
+     */
+    virtual uint32 alignment() const;
+};
+
+/**
+ * Defines the aligned allocator as a container policy for an alignment.
+ */
+template <uint32 ALIGN>
+struct AlignedPolicy
+{
+    template <typename T>
+    using Allocator = AlignedAllocator<T, ALIGN>;
+};
+
+// CONSTANTS
+template <typename T, uint32 ALIGN>
+constexpr uint32 AlignedAllocator<T, ALIGN>::ALIGNMENT;
+
+// CONSTRUCTORS
+template <typename T, uint32 ALIGN>
+inline
+AlignedAllocator<T, ALIGN>::AlignedAllocator()
+{
+}
+
+template <typename T, uint32 ALIGN>
+inline
+AlignedAllocator<T, ALIGN>::AlignedAllocator(
+    const AlignedAllocator<T, ALIGN>& /* copy */ )
+{
+}
+
+template <typename T, uint32 ALIGN>
+inline
+AlignedAllocator<T, ALIGN>::~AlignedAllocator()
+{
+}
+
+// OPERATORS
+template <typename T, uint32 ALIGN>
+inline
+AlignedAllocator<T, ALIGN>& AlignedAllocator<T, ALIGN>::operator=(
+    const AlignedAllocator<T, ALIGN>& /* assign */ )
+{
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T, uint32 ALIGN>
+inline
+T* AlignedAllocator<T, ALIGN>::get( uint32 count )
+{
+    T* values;
+    uint32 i;
+
+    assert( count > 0 );
+
+    values = static_cast<T*>(
+        MemoryUtils::allocateAligned(
+            static_cast<uint64>( sizeof( T ) ) * count, ALIGN ) );
+    for ( i = 0; i < count; ++i )
+    {
+        new ( values + i ) T();
+    }
+
+    return values;
+}
+
+template <typename T, uint32 ALIGN>
+inline
+void AlignedAllocator<T, ALIGN>::release( T* pointer, uint32 count )
+{
+    uint32 i;
+
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    for ( i = 0; i < count; ++i )
+    {
+        pointer[i].~T();
+    }
+
+    MemoryUtils::deallocateAligned( pointer );
+}
+
+template <typename T, uint32 ALIGN>
+inline
+uint32 AlignedAllocator<T, ALIGN>::alignment() const
+{
+    return ALIGN;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ALIGNED_ALLOCATOR_H
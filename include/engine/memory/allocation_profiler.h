@@ -0,0 +1,348 @@
+// allocation_profiler.h
+//
+// The allocation profiler records where memory is allocated from. Each
+// allocation is stored with the site that made it, where a site is the
+// short backtrace of the call that allocated. Sites keep counts for the
+// current frame, the whole run, and the allocations that are still live.
+// This makes it easy to find the sites that allocate the most in a frame
+// and the allocations that were never released.
+//
+// Both tables are open addressed arrays of atomics, so recording never
+// takes a lock and any thread can record. The tables do not grow. When
+// one is full the allocation is counted as dropped and is not profiled.
+// Released allocations leave a marker in the allocation table that keeps
+// lookups probing past them. Once a quarter of the table is markers it is
+// rebuilt without them, and recording waits while that happens.
+// Sites are identified by the hash of their backtrace, so two backtraces
+// with the same hash share a site.
+//
+// Backtraces are captured with backtrace() where it is available. Other
+// platforms still get counts and leak reports, but every allocation is
+// recorded against one empty site. Inlined frames may be missing from the
+// backtraces of optimized builds.
+//
+// The profiler is meant for debug builds. Capturing a backtrace is slow
+// compared to allocating, so wrap only the allocators being investigated.
+// Allocations that are still live when the profiler is destructed are
+// reported as leaks to its logger.
+//
+// Usage:
+//     AllocationProfiler profiler;
+//     profiler.setLogger( &logger );
+//     ProfilingAllocator<Particle> alloc( &profiler );
+//
+//     // every frame
+//     profiler.writeText( std::cout, 10 );
+//     profiler.endFrame();
+//
+#ifndef NGE_MEM_ALLOCATION_PROFILER_H
+#define NGE_MEM_ALLOCATION_PROFILER_H
+
+#include <atomic>
+#include <ostream>
+
+#include "engine/intdef.h"
+#include "engine/utility/logger.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class AllocationProfiler
+{
+  public:
+    // CONSTANTS
+    /**
+     * The largest number of frames kept in a backtrace.
+     */
+    static constexpr uint32 MAX_DEPTH = 16;
+
+    /**
+     * The number of sites that can be recorded.
+     */
+    static constexpr uint32 MAX_SITES = 4096;
+
+    /**
+     * The default number of allocations that can be live at once.
+     */
+    static constexpr uint32 DEFAULT_CAPACITY = 1 << 16;
+
+    // ENUMERATIONS
+    /**
+     * Defines the counts that sites can be ordered by.
+     */
+    enum Order
+    {
+        FRAME_COUNT = 0,
+        FRAME_BYTES,
+        LIVE_COUNT,
+        LIVE_BYTES
+    };
+
+    // STRUCTURES
+    /**
+     * Defines a snapshot of an allocation site.
+     */
+    struct Site
+    {
+        void* frames[MAX_DEPTH];
+        uint32 depth;
+        uint64 count;
+        uint64 bytes;
+        uint64 frameCount;
+        uint64 frameBytes;
+        uint64 liveCount;
+        uint64 liveBytes;
+    };
+
+  private:
+    /**
+     * Defines a site in the site table.
+     */
+    struct SiteEntry
+    {
+        std::atomic<uint64> hash;
+        std::atomic<bool> ready;
+        void* frames[MAX_DEPTH];
+        uint32 depth;
+        std::atomic<uint64> count;
+        std::atomic<uint64> bytes;
+        std::atomic<uint64> frameCount;
+        std::atomic<uint64> frameBytes;
+        std::atomic<uint64> liveCount;
+        std::atomic<uint64> liveBytes;
+    };
+
+    /**
+     * Defines a live allocation in the allocation table.
+     */
+    struct Record
+    {
+        std::atomic<uintptr_t> pointer;
+        std::atomic<uint64> bytes;
+        std::atomic<uint32> site;
+    };
+
+    // MEMBERS
+    /**
+     * The table of sites.
+     */
+    SiteEntry* _sites;
+
+    /**
+     * The table of live allocations.
+     */
+    Record* _records;
+
+    /**
+     * The number of records in the allocation table.
+     */
+    uint32 _capacity;
+
+    /**
+     * The number of allocations that are live.
+     */
+    std::atomic<uint64> _liveCount;
+
+    /**
+     * The number of bytes that are live.
+     */
+    std::atomic<uint64> _liveBytes;
+
+    /**
+     * The number of allocations that could not be profiled.
+     */
+    std::atomic<uint64> _dropped;
+
+    /**
+     * The number of frames that have ended.
+     */
+    std::atomic<uint64> _frame;
+
+    /**
+     * The number of records whose allocations were released.
+     */
+    std::atomic<uint32> _released;
+
+    /**
+     * The number of threads that are using the allocation table.
+     */
+    std::atomic<uint32> _recorders;
+
+    /**
+     * Whether the allocation table is being rebuilt.
+     */
+    std::atomic<bool> _purging;
+
+    /**
+     * The logger that leaks are reported to.
+     */
+    util::Logger* _logger;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the index of the site of the calling code or MAX_SITES if the
+     * site table is full.
+     */
+    uint32 findSite();
+
+    /**
+     * Gets the record of the live allocation at the pointer or null if the
+     * allocation was dropped.
+     */
+    Record* findRecord( const void* pointer );
+
+    /**
+     * Waits until the allocation table is not being rebuilt and marks the
+     * calling thread as using it.
+     */
+    void enter();
+
+    /**
+     * Marks the calling thread as no longer using the allocation table.
+     */
+    void leave();
+
+    /**
+     * Rebuilds the allocation table without the records of released
+     * allocations if there are too many of them.
+     */
+    void purge();
+
+    /**
+     * Takes a snapshot of the site at the given index.
+     */
+    void snapshot( Site* site, uint32 index ) const;
+
+    /**
+     * Writes the counts and backtrace of the site as text.
+     */
+    static void writeSiteText( std::ostream& stream, const Site& site );
+
+    /**
+     * Writes the counts and backtrace of the site as a JSON object.
+     */
+    static void writeSiteJson( std::ostream& stream, const Site& site );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a profiler for the default number of live allocations.
+     */
+    AllocationProfiler();
+
+    /**
+     * Constructs a profiler for the given number of live allocations.
+     *
+     * Behavior is undefined when:
+     * - capacity is not a power of two
+     */
+    explicit AllocationProfiler( uint32 capacity );
+
+    /**
+     * Profilers cannot be copied.
+     */
+    AllocationProfiler( const AllocationProfiler& profiler ) = delete;
+
+    /**
+     * Destructs the profiler.
+     *
+     * Allocations that are still live are reported to the logger as
+     * leaks.
+     */
+    ~AllocationProfiler();
+
+    // OPERATORS
+    /**
+     * Profilers cannot be copied.
+     */
+    AllocationProfiler& operator=( const AllocationProfiler& profiler ) =
+        delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Sets the logger that leaks are reported to or null to not report.
+     */
+    void setLogger( util::Logger* logger );
+
+    /**
+     * Records an allocation of the given number of bytes from the calling
+     * code.
+     */
+    void recordGet( const void* pointer, uint64 bytes );
+
+    /**
+     * Records the release of an allocation.
+     *
+     * Allocations that were dropped are ignored.
+     */
+    void recordRelease( const void* pointer );
+
+    /**
+     * Records that an allocation grew in place by the given number of bytes.
+     *
+     * The bytes are counted against the site that made the allocation.
+     * Allocations that were dropped are ignored.
+     */
+    void recordGrow( const void* pointer, uint64 bytes );
+
+    /**
+     * Clears the frame counts of every site.
+     *
+     * Allocations made by other threads while the frame ends may be
+     * counted in either frame.
+     */
+    void endFrame();
+
+    /**
+     * Gets the sites with the largest counts in the given order.
+     *
+     * Writes at most count sites and returns the number written.
+     */
+    uint32 topSites( Site* sites, uint32 count, Order order ) const;
+
+    /**
+     * Gets the number of allocations that are live.
+     */
+    uint64 liveCount() const;
+
+    /**
+     * Gets the number of bytes that are live.
+     */
+    uint64 liveBytes() const;
+
+    /**
+     * Gets the number of allocations that could not be profiled.
+     */
+    uint64 dropped() const;
+
+    /**
+     * Gets the number of frames that have ended.
+     */
+    uint64 frame() const;
+
+    /**
+     * Writes the sites that allocate the most in the current frame by
+     * count and by bytes as text.
+     */
+    void writeText( std::ostream& stream, uint32 count ) const;
+
+    /**
+     * Writes the sites that allocate the most in the current frame by
+     * count and by bytes as JSON.
+     */
+    void writeJson( std::ostream& stream, uint32 count ) const;
+
+    /**
+     * Writes every site with live allocations as text.
+     */
+    void writeLeaks( std::ostream& stream ) const;
+};
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ALLOCATION_PROFILER_H
@@ -0,0 +1,116 @@
+// allocation_registry.h
+//
+// The allocation registry owns every allocation tracker and finds them by
+// tag. Allocators that share a tag record into the same tracker, so the
+// registry gives one view of the memory used by each subsystem.
+//
+// Trackers are created the first time their tag is requested and live
+// until the program exits so that pointers to them never dangle. The
+// registry is shared by every thread and guarded by a mutex. The mutex is
+// only taken to find or visit trackers, never to record an allocation.
+//
+// Usage:
+//     AllocationTracker* renderer = AllocationRegistry::tracker( "renderer" );
+//
+//     AllocationRegistry::forEach( []( const AllocationTracker& tracker ) {
+//         log.info( tracker.tag(), tracker.liveBytes() );
+//     } );
+//
+#ifndef NGE_MEM_ALLOCATION_REGISTRY_H
+#define NGE_MEM_ALLOCATION_REGISTRY_H
+
+#include <mutex>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/memory/allocation_tracker.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class AllocationRegistry
+{
+  private:
+    // STRUCTURES
+    /**
+     * Defines the table of trackers.
+     */
+    struct Table
+    {
+        std::mutex mutex;
+        AllocationTracker* first;
+        uint32 size;
+    };
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the table of trackers.
+     */
+    static Table& table();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * The registry cannot be constructed.
+     */
+    AllocationRegistry() = delete;
+
+    // STATIC FUNCTIONS
+    /**
+     * Gets the tracker with the given tag, creating it if it does not
+     * exist.
+     */
+    static AllocationTracker* tracker( const String& tag );
+
+    /**
+     * Gets the tracker with the given tag or null if it does not exist.
+     */
+    static AllocationTracker* find( const String& tag );
+
+    /**
+     * Gets the number of trackers.
+     */
+    static uint32 size();
+
+    /**
+     * Gets the statistics of every tracker added together.
+     *
+     * The peak is the sum of the peaks of each tracker, which is an upper
+     * bound on the peak of the whole program.
+     */
+    static AllocationTracker::Stats total();
+
+    /**
+     * Calls the function with every tracker.
+     *
+     * Behavior is undefined when:
+     * - the function gets or finds a tracker
+     */
+    template <typename F>
+    static void forEach( F func );
+};
+
+// STATIC FUNCTIONS
+template <typename F>
+inline
+void AllocationRegistry::forEach( F func )
+{
+    Table& trackers = table();
+    const AllocationTracker* tracker;
+
+    std::lock_guard<std::mutex> lock( trackers.mutex );
+    for ( tracker = trackers.first; tracker != nullptr;
+          tracker = tracker->_next )
+    {
+        func( *tracker );
+    }
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ALLOCATION_REGISTRY_H
@@ -0,0 +1,197 @@
+// allocation_tracker.h
+//
+// An allocation tracker records how many bytes a subsystem has allocated.
+// It keeps the live and peak byte counts, the number of allocations and
+// releases, and a histogram of allocation sizes.
+//
+// Every counter is atomic so allocators on any thread can record into the
+// same tracker. The counts and the histogram are split into cache line
+// sized shards that are picked by thread, so threads that allocate at the
+// same time rarely touch the same line. The shards are summed when the
+// statistics are read. The live and peak byte counts are kept once since
+// the peak must be compared against the true total.
+//
+// Trackers are created by the allocation registry and are identified by
+// a tag such as "renderer" or "audio".
+//
+#ifndef NGE_MEM_ALLOCATION_TRACKER_H
+#define NGE_MEM_ALLOCATION_TRACKER_H
+
+#include <atomic>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class AllocationTracker
+{
+  public:
+    // CONSTANTS
+    /**
+     * The number of allocation size classes.
+     *
+     * Class zero holds allocations of up to 16 bytes and every class after
+     * it doubles the limit. The last class holds every larger allocation.
+     */
+    static constexpr uint32 SIZE_CLASSES = 16;
+
+    /**
+     * The number of shards that the counters are split into.
+     */
+    static constexpr uint32 SHARDS = 16;
+
+    // STRUCTURES
+    /**
+     * Defines a snapshot of the statistics of a tracker.
+     */
+    struct Stats
+    {
+        uint64 liveBytes;
+        uint64 peakBytes;
+        uint64 allocations;
+        uint64 releases;
+        uint64 histogram[SIZE_CLASSES];
+    };
+
+  private:
+    friend class AllocationRegistry;
+
+    /**
+     * Defines the counters that are written by one group of threads.
+     */
+    struct alignas( MemoryUtils::CACHE_LINE_SIZE ) Shard
+    {
+        std::atomic<uint64> allocations;
+        std::atomic<uint64> releases;
+        std::atomic<uint64> histogram[SIZE_CLASSES];
+    };
+
+    // MEMBERS
+    /**
+     * The counters of each shard.
+     */
+    Shard _shards[SHARDS];
+
+    /**
+     * The number of bytes that are allocated.
+     */
+    std::atomic<uint64> _liveBytes;
+
+    /**
+     * The largest number of bytes that were allocated at once.
+     */
+    std::atomic<uint64> _peakBytes;
+
+    /**
+     * The tag of the tracker.
+     */
+    String _tag;
+
+    /**
+     * The next tracker in the registry.
+     */
+    AllocationTracker* _next;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the shard of the calling thread.
+     */
+    Shard& shard();
+
+    /**
+     * Adds the bytes to the live byte count and raises the peak to match.
+     */
+    void addLiveBytes( uint64 bytes );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a tracker with the given tag.
+     */
+    explicit AllocationTracker( const String& tag );
+
+    /**
+     * Trackers cannot be copied.
+     */
+    AllocationTracker( const AllocationTracker& tracker ) = delete;
+
+    /**
+     * Destructs the tracker.
+     */
+    ~AllocationTracker();
+
+    // OPERATORS
+    /**
+     * Trackers cannot be copied.
+     */
+    AllocationTracker& operator=( const AllocationTracker& tracker ) = delete;
+
+    // STATIC FUNCTIONS
+    /**
+     * Gets the size class of an allocation with the given number of bytes.
+     */
+    static uint32 sizeClass( uint64 bytes );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Records an allocation with the given number of bytes.
+     */
+    void recordGet( uint64 bytes );
+
+    /**
+     * Records that an allocation grew in place by the given number of bytes.
+     *
+     * The bytes are live but no allocation is counted.
+     */
+    void recordGrow( uint64 bytes );
+
+    /**
+     * Records a release with the given number of bytes.
+     *
+     * Behavior is undefined when:
+     * - more bytes are released than are allocated
+     */
+    void recordRelease( uint64 bytes );
+
+    /**
+     * Clears the counters and sets the peak to the live byte count.
+     *
+     * Behavior is undefined when:
+     * - another thread is recording into the tracker
+     */
+    void reset();
+
+    /**
+     * Gets a snapshot of the statistics.
+     *
+     * The snapshot is only exact when no other thread is recording.
+     */
+    Stats stats() const;
+
+    /**
+     * Gets the number of bytes that are allocated.
+     */
+    uint64 liveBytes() const;
+
+    /**
+     * Gets the largest number of bytes that were allocated at once.
+     */
+    uint64 peakBytes() const;
+
+    /**
+     * Gets the tag of the tracker.
+     */
+    const String& tag() const;
+};
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ALLOCATION_TRACKER_H
@@ -76,6 +76,16 @@ class AllocatorGuard : public IAllocator<T>
      */
     virtual void release( T* pointer, uint32 count );
 
+    /**
+     * Gets the alignment of the underlying allocator.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Tries to grow the allocation in place using the underlying allocator.
+     */
+    virtual bool grow( T* pointer, uint32 count, uint32 newCount );
+
     /**
      * Gets the underlying allocator.
      */
@@ -155,6 +165,20 @@ void AllocatorGuard<T>::release( T* pointer, uint32 count )
     _allocator->release( pointer, count );
 }
 
+template <typename T>
+inline
+uint32 AllocatorGuard<T>::alignment() const
+{
+    return _allocator->alignment();
+}
+
+template <typename T>
+inline
+bool AllocatorGuard<T>::grow( T* pointer, uint32 count, uint32 newCount )
+{
+    return _allocator->grow( pointer, count, newCount );
+}
+
 template <typename T>
 inline
 IAllocator<T>* AllocatorGuard<T>::allocator() const
@@ -0,0 +1,415 @@
+// arena_allocator.h
+//
+// The arena allocator hands out instances by bumping an offset into a block
+// of memory. Releasing an allocation does nothing; the whole arena is reset
+// at once, typically at the end of every frame, or rolled back to a marker
+// that was taken earlier.
+//
+// Instances are default constructed when they are allocated like the default
+// allocator does, and they are destructed when the arena is rolled back or
+// reset rather than when they are released.
+//
+// When an allocation does not fit in the current block a new block is
+// chained on. Blocks that are freed by a rollback are kept and reused so an
+// arena that overflows every frame only touches the heap once.
+//
+#ifndef NGE_MEM_ARENA_ALLOCATOR_H
+#define NGE_MEM_ARENA_ALLOCATOR_H
+
+#include <assert.h>
+#include <new>
+
+#include "engine/intdef.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class ArenaAllocator : public IAllocator<T>
+{
+  private:
+    // STRUCTURES
+    /**
+     * Defines a block of instances.
+     */
+    struct Block
+    {
+        T* values;
+        uint32 capacity;
+        uint32 size;
+        Block* prev;
+    };
+
+  public:
+    /**
+     * Defines a position in the arena that it can be rolled back to.
+     */
+    struct Marker
+    {
+        Block* block;
+        uint32 size;
+    };
+
+  private:
+    // CONSTANTS
+    /**
+     * The default number of instances in each block.
+     */
+    static constexpr uint32 DEFAULT_CAPACITY = 1024;
+
+    // MEMBERS
+    /**
+     * The first block.
+     */
+    Block* _first;
+
+    /**
+     * The block that instances are allocated from.
+     */
+    Block* _top;
+
+    /**
+     * The blocks that were freed by a rollback.
+     */
+    Block* _spare;
+
+    /**
+     * The number of instances in each block.
+     */
+    uint32 _blockCapacity;
+
+    /**
+     * The number of allocated instances.
+     */
+    uint32 _size;
+
+    // HELPER FUNCTIONS
+    /**
+     * Makes a block with the given capacity.
+     */
+    static Block* makeBlock( uint32 capacity );
+
+    /**
+     * Frees the block without destructing its instances.
+     */
+    static void freeBlock( Block* block );
+
+    /**
+     * Destructs the instances of the block starting at the given index.
+     */
+    static void destruct( Block* block, uint32 index );
+
+    /**
+     * Gets a block with at least the given capacity.
+     *
+     * Spare blocks are used before making a new one.
+     */
+    Block* takeBlock( uint32 capacity );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an arena with the default block capacity.
+     */
+    ArenaAllocator();
+
+    /**
+     * Constructs an arena with the given number of instances per block.
+     *
+     * Behavior is undefined when:
+     * - capacity is zero
+     */
+    ArenaAllocator( uint32 capacity );
+
+    /**
+     * Arenas cannot be copied.
+     */
+    ArenaAllocator( const ArenaAllocator<T>& arena ) = delete;
+
+    /**
+     * Destructs the arena and every instance that is still allocated.
+     */
+    virtual ~ArenaAllocator();
+
+    // OPERATORS
+    /**
+     * Arenas cannot be copied.
+     */
+    ArenaAllocator<T>& operator=( const ArenaAllocator<T>& arena ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Does nothing. The instances are destructed when the arena is rolled
+     * back or reset.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets a marker for the current position in the arena.
+     */
+    Marker mark() const;
+
+    /**
+     * Destructs every instance allocated since the marker was taken and
+     * makes its memory available again.
+     *
+     * Behavior is undefined when:
+     * - the marker was taken after a later marker was rolled back
+     * - the marker was taken before the arena was reset
+     */
+    void rollback( const Marker& marker );
+
+    /**
+     * Destructs every instance and makes all memory available again.
+     */
+    void reset();
+
+    /**
+     * Gets the number of allocated instances.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of instances that fit in the blocks in use.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the number of instances in each block.
+     */
+    uint32 blockCapacity() const;
+};
+
+template <typename T>
+constexpr uint32 ArenaAllocator<T>::DEFAULT_CAPACITY;
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+typename ArenaAllocator<T>::Block* ArenaAllocator<T>::makeBlock(
+    uint32 capacity )
+{
+    Block* block = new Block;
+
+    block->values = static_cast<T*>(
+        ::operator new( sizeof( T ) * capacity ) );
+    block->capacity = capacity;
+    block->size = 0;
+    block->prev = nullptr;
+
+    return block;
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::freeBlock( Block* block )
+{
+    ::operator delete( block->values );
+    delete block;
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::destruct( Block* block, uint32 index )
+{
+    uint32 i;
+
+    for ( i = index; i < block->size; ++i )
+    {
+        block->values[i].~T();
+    }
+}
+
+template <typename T>
+inline
+typename ArenaAllocator<T>::Block* ArenaAllocator<T>::takeBlock(
+    uint32 capacity )
+{
+    Block** link;
+    Block* block;
+
+    for ( link = &_spare; *link != nullptr; link = &( *link )->prev )
+    {
+        if ( ( *link )->capacity >= capacity )
+        {
+            block = *link;
+            *link = block->prev;
+            block->prev = nullptr;
+
+            return block;
+        }
+    }
+
+    return makeBlock( capacity );
+}
+
+// CONSTRUCTORS
+template <typename T>
+inline
+ArenaAllocator<T>::ArenaAllocator()
+    : _first( nullptr ), _top( nullptr ), _spare( nullptr ),
+      _blockCapacity( DEFAULT_CAPACITY ), _size( 0 )
+{
+    _first = makeBlock( _blockCapacity );
+    _top = _first;
+}
+
+template <typename T>
+inline
+ArenaAllocator<T>::ArenaAllocator( uint32 capacity )
+    : _first( nullptr ), _top( nullptr ), _spare( nullptr ),
+      _blockCapacity( capacity ), _size( 0 )
+{
+    assert( capacity > 0 );
+
+    _first = makeBlock( _blockCapacity );
+    _top = _first;
+}
+
+template <typename T>
+inline
+ArenaAllocator<T>::~ArenaAllocator()
+{
+    Block* block;
+
+    reset();
+    freeBlock( _first );
+
+    while ( _spare != nullptr )
+    {
+        block = _spare;
+        _spare = block->prev;
+        freeBlock( block );
+    }
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* ArenaAllocator<T>::get( uint32 count )
+{
+    Block* block;
+    T* values;
+    uint32 i;
+
+    assert( count > 0 );
+
+    if ( _top->size + count > _top->capacity )
+    {
+        block = takeBlock( count > _blockCapacity ? count : _blockCapacity );
+        block->prev = _top;
+        _top = block;
+    }
+
+    values = _top->values + _top->size;
+    for ( i = 0; i < count; ++i )
+    {
+        new ( values + i ) T();
+    }
+
+    _top->size += count;
+    _size += count;
+
+    return values;
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::release( T* /* pointer */, uint32 /* count */ )
+{
+}
+
+template <typename T>
+inline
+typename ArenaAllocator<T>::Marker ArenaAllocator<T>::mark() const
+{
+    return Marker{ _top, _top->size };
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::rollback( const Marker& marker )
+{
+    Block* block;
+
+    while ( _top != marker.block )
+    {
+        assert( _top->prev != nullptr );
+
+        destruct( _top, 0 );
+        _size -= _top->size;
+        _top->size = 0;
+
+        block = _top;
+        _top = block->prev;
+        block->prev = _spare;
+        _spare = block;
+    }
+
+    assert( marker.size <= _top->size );
+
+    destruct( _top, marker.size );
+    _size -= _top->size - marker.size;
+    _top->size = marker.size;
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::reset()
+{
+    rollback( Marker{ _first, 0 } );
+}
+
+template <typename T>
+inline
+uint32 ArenaAllocator<T>::size() const
+{
+    return _size;
+}
+
+template <typename T>
+inline
+uint32 ArenaAllocator<T>::capacity() const
+{
+    const Block* block;
+    uint32 capacity = 0;
+
+    for ( block = _top; block != nullptr; block = block->prev )
+    {
+        capacity += block->capacity;
+    }
+
+    return capacity;
+}
+
+template <typename T>
+inline
+uint32 ArenaAllocator<T>::blockCapacity() const
+{
+    return _blockCapacity;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ARENA_ALLOCATOR_H
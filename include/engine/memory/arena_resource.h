@@ -0,0 +1,222 @@
+// arena_resource.h
+//
+// The arena resource is the untyped version of the arena allocator. It
+// bumps an aligned offset into a block of bytes, deallocation does nothing,
+// and the whole arena is reset at once or rolled back to a marker.
+//
+// Because it is untyped a single arena can back containers of different
+// types through resource allocators. It does not know the types of what it
+// holds so nothing is destructed when it is reset; the containers must be
+// destroyed or cleared before the memory is reused.
+//
+// When an allocation does not fit in the current block a new block is
+// chained on. Blocks that are freed by a rollback are kept and reused.
+//
+#ifndef NGE_MEM_ARENA_RESOURCE_H
+#define NGE_MEM_ARENA_RESOURCE_H
+
+#include "engine/intdef.h"
+#include "engine/memory/imemory_resource.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class ArenaResource : public IMemoryResource
+{
+  private:
+    // STRUCTURES
+    /**
+     * Defines a block of bytes.
+     */
+    struct Block
+    {
+        uint8* bytes;
+        uint32 capacity;
+        uint32 used;
+        Block* prev;
+    };
+
+  public:
+    /**
+     * Defines a position in the arena that it can be rolled back to.
+     */
+    struct Marker
+    {
+        Block* block;
+        uint32 used;
+    };
+
+  private:
+    // CONSTANTS
+    /**
+     * The default number of bytes in each block.
+     */
+    static constexpr uint32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    // MEMBERS
+    /**
+     * The first block.
+     */
+    Block* _first;
+
+    /**
+     * The block that bytes are allocated from.
+     */
+    Block* _top;
+
+    /**
+     * The blocks that were freed by a rollback.
+     */
+    Block* _spare;
+
+    /**
+     * The number of bytes in each block.
+     */
+    uint32 _blockSize;
+
+    /**
+     * The number of bytes that were allocated including alignment padding.
+     */
+    uint32 _size;
+
+    // HELPER FUNCTIONS
+    /**
+     * Makes a block with the given capacity.
+     */
+    static Block* makeBlock( uint32 capacity );
+
+    /**
+     * Frees the block.
+     */
+    static void freeBlock( Block* block );
+
+    /**
+     * Gets the offset of the first byte in the block that has the given
+     * alignment.
+     */
+    static uint32 alignedOffset( const Block* block, uint32 align );
+
+    /**
+     * Gets a block with at least the given capacity.
+     *
+     * Spare blocks are used before making a new one.
+     */
+    Block* takeBlock( uint32 capacity );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an arena with the default block size.
+     */
+    ArenaResource();
+
+    /**
+     * Constructs an arena with the given number of bytes per block.
+     *
+     * Behavior is undefined when:
+     * - blockSize is zero
+     */
+    ArenaResource( uint32 blockSize );
+
+    /**
+     * Arenas cannot be copied.
+     */
+    ArenaResource( const ArenaResource& arena ) = delete;
+
+    /**
+     * Destructs the arena and frees all of its blocks.
+     */
+    virtual ~ArenaResource();
+
+    // OPERATORS
+    /**
+     * Arenas cannot be copied.
+     */
+    ArenaResource& operator=( const ArenaResource& arena ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes aligned to the given alignment.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     * out of mem
+     */
+    virtual void* allocate( uint32 size, uint32 align );
+
+    /**
+     * Does nothing. The memory is reused after the arena is rolled back or
+     * reset.
+     */
+    virtual void deallocate( void* pointer, uint32 size, uint32 align );
+
+    /**
+     * Gets a marker for the current position in the arena.
+     */
+    Marker mark() const;
+
+    /**
+     * Makes the bytes allocated since the marker was taken available again.
+     *
+     * Behavior is undefined when:
+     * - the marker was taken after a later marker was rolled back
+     * - the marker was taken before the arena was reset
+     */
+    void rollback( const Marker& marker );
+
+    /**
+     * Makes all bytes available again.
+     */
+    void reset();
+
+    /**
+     * Gets the number of bytes that were allocated including alignment
+     * padding.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of bytes in the blocks in use.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the number of bytes in each block.
+     */
+    uint32 blockSize() const;
+};
+
+// MEMBER FUNCTIONS
+inline
+ArenaResource::Marker ArenaResource::mark() const
+{
+    return Marker{ _top, _top->used };
+}
+
+inline
+void ArenaResource::reset()
+{
+    rollback( Marker{ _first, 0 } );
+}
+
+inline
+uint32 ArenaResource::size() const
+{
+    return _size;
+}
+
+inline
+uint32 ArenaResource::blockSize() const
+{
+    return _blockSize;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ARENA_RESOURCE_H
@@ -0,0 +1,293 @@
+// buddy_allocator.h
+//
+// The buddy allocator suballocates variable sized ranges from one large
+// range. It only hands out offsets, so the range can be CPU memory, a GL
+// buffer, or the area of a texture atlas.
+//
+// The range is split into blocks whose sizes are the minimum block size
+// times a power of two. An allocation takes the smallest block that fits,
+// splitting larger blocks in half as needed. When a block is released it
+// is merged with its buddy, the other half of the block it was split from,
+// as long as the buddy is free. Both allocation and release take time in
+// the logarithm of the number of minimum sized blocks.
+//
+// The bookkeeping is kept apart from the range since the range may not be
+// addressable. It takes a few bytes for every minimum sized block.
+//
+// Usage:
+//     BuddyAllocator vertices( bufferSize, 256 );
+//
+//     uint64 offset = vertices.allocate( shape.vertexBytes(), 16 );
+//     if ( offset != BuddyAllocator::INVALID_OFFSET )
+//     {
+//         glBufferSubData( GL_ARRAY_BUFFER, offset, ... );
+//     }
+//
+#ifndef NGE_MEM_BUDDY_ALLOCATOR_H
+#define NGE_MEM_BUDDY_ALLOCATOR_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class BuddyAllocator
+{
+  public:
+    // CONSTANTS
+    /**
+     * The offset that is returned when an allocation does not fit.
+     */
+    static constexpr uint64 INVALID_OFFSET = ~0ull;
+
+    /**
+     * The number of block sizes.
+     */
+    static constexpr uint32 MAX_ORDERS = 32;
+
+  private:
+    // STRUCTURES
+    /**
+     * Defines the state of a minimum sized block.
+     *
+     * Only the first minimum sized block of a larger block is used.
+     */
+    struct Node
+    {
+        uint32 next;
+        uint32 prev;
+        uint8 order;
+        bool free;
+    };
+
+    // CONSTANTS
+    /**
+     * The index of no block.
+     */
+    static constexpr uint32 NONE = 0xFFFFFFFF;
+
+    // MEMBERS
+    /**
+     * The state of each minimum sized block.
+     */
+    Node* _nodes;
+
+    /**
+     * The first free block of each order.
+     */
+    uint32 _heads[MAX_ORDERS];
+
+    /**
+     * The number of free blocks of each order.
+     */
+    uint32 _freeCounts[MAX_ORDERS];
+
+    /**
+     * The number of bytes in the smallest block.
+     */
+    uint64 _minBlockSize;
+
+    /**
+     * The number of minimum sized blocks.
+     */
+    uint32 _blockCount;
+
+    /**
+     * The number of bytes in allocated blocks.
+     */
+    uint64 _used;
+
+    /**
+     * The number of bytes that were asked for by the allocations.
+     */
+    uint64 _requested;
+
+    /**
+     * The number of allocations.
+     */
+    uint32 _allocations;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the order of the smallest block that holds the given number of
+     * bytes.
+     */
+    uint32 orderOf( uint64 size ) const;
+
+    /**
+     * Adds the block to the free list of its order.
+     */
+    void push( uint32 block, uint32 order );
+
+    /**
+     * Removes the block from the free list of its order.
+     */
+    void remove( uint32 block );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an allocator for a range with the given number of bytes
+     * and smallest block size.
+     *
+     * Bytes at the end of the range that do not fill a smallest block are
+     * never allocated.
+     *
+     * Behavior is undefined when:
+     * - minBlockSize is not a power of two
+     * - size is less than minBlockSize
+     * - there are more than 2^32 - 1 smallest blocks
+     */
+    BuddyAllocator( uint64 size, uint64 minBlockSize );
+
+    /**
+     * Buddy allocators cannot be copied.
+     */
+    BuddyAllocator( const BuddyAllocator& alloc ) = delete;
+
+    /**
+     * Destructs the allocator.
+     */
+    ~BuddyAllocator();
+
+    // OPERATORS
+    /**
+     * Buddy allocators cannot be copied.
+     */
+    BuddyAllocator& operator=( const BuddyAllocator& alloc ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes at an offset that is a multiple
+     * of the given alignment.
+     *
+     * Returns INVALID_OFFSET when there is no free block that fits.
+     *
+     * Behavior is undefined when:
+     * - size is zero
+     * - align is not a power of two
+     */
+    uint64 allocate( uint64 size, uint64 align );
+
+    /**
+     * Releases the allocation of the given number of bytes at the offset
+     * and merges it with its free buddies.
+     *
+     * Behavior is undefined when:
+     * - offset was not returned by allocate
+     * - size differs from the allocation
+     */
+    void release( uint64 offset, uint64 size );
+
+    /**
+     * Frees every allocation.
+     */
+    void reset();
+
+    // STATISTICS FUNCTIONS
+    /**
+     * Gets the number of bytes that can be allocated.
+     */
+    uint64 capacity() const;
+
+    /**
+     * Gets the number of bytes in the smallest block.
+     */
+    uint64 minBlockSize() const;
+
+    /**
+     * Gets the number of bytes in allocated blocks.
+     */
+    uint64 used() const;
+
+    /**
+     * Gets the number of bytes that were asked for by the allocations.
+     */
+    uint64 requested() const;
+
+    /**
+     * Gets the number of bytes in free blocks.
+     */
+    uint64 available() const;
+
+    /**
+     * Gets the number of allocations.
+     */
+    uint32 allocationCount() const;
+
+    /**
+     * Gets the number of free blocks of the given order.
+     */
+    uint32 freeBlockCount( uint32 order ) const;
+
+    /**
+     * Gets the number of bytes in the largest free block.
+     */
+    uint64 largestFreeBlock() const;
+
+    /**
+     * Gets the fraction of the free bytes that are not in the largest free
+     * block.
+     *
+     * This is zero when all free bytes could be taken by one allocation.
+     */
+    float fragmentation() const;
+
+    /**
+     * Gets the fraction of the bytes in allocated blocks that were not asked
+     * for.
+     */
+    float waste() const;
+};
+
+// STATISTICS FUNCTIONS
+inline
+uint64 BuddyAllocator::capacity() const
+{
+    return _minBlockSize * _blockCount;
+}
+
+inline
+uint64 BuddyAllocator::minBlockSize() const
+{
+    return _minBlockSize;
+}
+
+inline
+uint64 BuddyAllocator::used() const
+{
+    return _used;
+}
+
+inline
+uint64 BuddyAllocator::requested() const
+{
+    return _requested;
+}
+
+inline
+uint64 BuddyAllocator::available() const
+{
+    return capacity() - _used;
+}
+
+inline
+uint32 BuddyAllocator::allocationCount() const
+{
+    return _allocations;
+}
+
+inline
+uint32 BuddyAllocator::freeBlockCount( uint32 order ) const
+{
+    return order < MAX_ORDERS ? _freeCounts[order] : 0;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_BUDDY_ALLOCATOR_H
@@ -0,0 +1,112 @@
+// buddy_resource.h
+//
+// The buddy resource is a memory resource that suballocates from one block
+// of CPU memory with a buddy allocator. Unlike the arena and stack
+// resources its allocations can be released in any order, and released
+// blocks are merged so that large allocations fit again later.
+//
+// Alignments up to MAX_ALIGNMENT are supported since the block starts on
+// that alignment and every buddy block is aligned to its own size.
+//
+#ifndef NGE_MEM_BUDDY_RESOURCE_H
+#define NGE_MEM_BUDDY_RESOURCE_H
+
+#include "engine/intdef.h"
+#include "engine/memory/buddy_allocator.h"
+#include "engine/memory/imemory_resource.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class BuddyResource : public IMemoryResource
+{
+  public:
+    // CONSTANTS
+    /**
+     * The largest alignment that allocations can ask for.
+     */
+    static constexpr uint32 MAX_ALIGNMENT = 4096;
+
+  private:
+    // MEMBERS
+    /**
+     * The block of bytes.
+     */
+    uint8* _bytes;
+
+    /**
+     * The allocator of the ranges of the block.
+     */
+    BuddyAllocator _buddies;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a resource with the given number of bytes and smallest
+     * block size.
+     *
+     * Behavior is undefined when:
+     * - minBlockSize is not a power of two
+     * - size is less than minBlockSize
+     */
+    BuddyResource( uint32 size, uint32 minBlockSize );
+
+    /**
+     * Resources cannot be copied.
+     */
+    BuddyResource( const BuddyResource& resource ) = delete;
+
+    /**
+     * Destructs the resource and frees its block.
+     */
+    virtual ~BuddyResource();
+
+    // OPERATORS
+    /**
+     * Resources cannot be copied.
+     */
+    BuddyResource& operator=( const BuddyResource& resource ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes aligned to the given alignment.
+     *
+     * Returns null when there is no free block that fits.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     * align is greater than MAX_ALIGNMENT
+     */
+    virtual void* allocate( uint32 size, uint32 align );
+
+    /**
+     * Releases the allocation and merges it with its free buddies.
+     *
+     * Behavior is undefined when:
+     * pointer was not allocated by this resource
+     * size differs from the allocation
+     */
+    virtual void deallocate( void* pointer, uint32 size, uint32 align );
+
+    /**
+     * Gets the buddy allocator of the block for its statistics.
+     */
+    const BuddyAllocator& buddies() const;
+};
+
+// MEMBER FUNCTIONS
+inline
+const BuddyAllocator& BuddyResource::buddies() const
+{
+    return _buddies;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_BUDDY_RESOURCE_H
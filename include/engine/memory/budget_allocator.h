@@ -0,0 +1,234 @@
+// budget_allocator.h
+//
+// The budget allocator wraps another allocator in a tracking allocator for
+// the tag of a memory budget and checks the budget after every allocation
+// and release. The bytes are recorded by the tracking allocator, so the
+// budget only adds the check.
+//
+// The budget is only checked, never enforced by failing an allocation. The
+// budget decides what to do through its logger and callback.
+//
+// Usage:
+//     BudgetAllocator<Mesh> meshAlloc( budgets.find( "render" ) );
+//     DynamicArray<Mesh, AllocatorGuard> meshes( &meshAlloc );
+//
+#ifndef NGE_MEM_BUDGET_ALLOCATOR_H
+#define NGE_MEM_BUDGET_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/memory_budget.h"
+#include "engine/memory/tracking_allocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class BudgetAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The tracking allocator that records into the tracker of the budget.
+     */
+    TrackingAllocator<T> _allocator;
+
+    /**
+     * The budget that allocations count against.
+     */
+    MemoryBudget* _budget;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a budget allocator for the budget that uses the default
+     * allocator.
+     *
+     * Behavior is undefined when:
+     * - budget is null
+     */
+    explicit BudgetAllocator( MemoryBudget* budget );
+
+    /**
+     * Constructs a budget allocator for the budget that performs
+     * allocation using the given allocator.
+     *
+     * Behavior is undefined when:
+     * - budget is null
+     * - alloc is null
+     */
+    BudgetAllocator( MemoryBudget* budget, IAllocator<T>* alloc );
+
+    /**
+     * Constructs a copy of a budget allocator.
+     *
+     * The copy counts against the same budget.
+     */
+    BudgetAllocator( const BudgetAllocator<T>& alloc );
+
+    /**
+     * Destructs the budget allocator.
+     */
+    virtual ~BudgetAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the allocator.
+     */
+    BudgetAllocator<T>& operator=( const BudgetAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets the alignment of the underlying allocator.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Tries to grow the allocation in place using the underlying allocator.
+     *
+     * The added bytes are budgeted when the allocation grows.
+     *
+     * Behavior is undefined when:
+     * pointer is invalid
+     * newCount is less than or equal to count
+     */
+    virtual bool grow( T* pointer, uint32 count, uint32 newCount );
+
+    /**
+     * Gets the budget that allocations count against.
+     */
+    MemoryBudget* budget() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+BudgetAllocator<T>::BudgetAllocator( MemoryBudget* budget )
+    : _allocator( budget->tag() ), _budget( budget )
+{
+    assert( _allocator.tracker() == budget->tracker() );
+}
+
+template <typename T>
+inline
+BudgetAllocator<T>::BudgetAllocator( MemoryBudget* budget,
+                                     IAllocator<T>* alloc )
+    : _allocator( budget->tag(), alloc ), _budget( budget )
+{
+    assert( _allocator.tracker() == budget->tracker() );
+}
+
+template <typename T>
+inline
+BudgetAllocator<T>::BudgetAllocator( const BudgetAllocator<T>& alloc )
+    : _allocator( alloc._allocator ), _budget( alloc._budget )
+{
+}
+
+template <typename T>
+inline
+BudgetAllocator<T>::~BudgetAllocator()
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+BudgetAllocator<T>& BudgetAllocator<T>::operator=(
+    const BudgetAllocator<T>& alloc )
+{
+    _allocator = alloc._allocator;
+    _budget = alloc._budget;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* BudgetAllocator<T>::get( uint32 count )
+{
+    T* values;
+
+    assert( count > 0 );
+
+    values = _allocator.get( count );
+    if ( values != nullptr )
+    {
+        _budget->check();
+    }
+
+    return values;
+}
+
+template <typename T>
+inline
+void BudgetAllocator<T>::release( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    _allocator.release( pointer, count );
+    _budget->check();
+}
+
+template <typename T>
+inline
+uint32 BudgetAllocator<T>::alignment() const
+{
+    return _allocator.alignment();
+}
+
+template <typename T>
+inline
+bool BudgetAllocator<T>::grow( T* pointer, uint32 count, uint32 newCount )
+{
+    assert( pointer != nullptr );
+    assert( newCount > count );
+
+    if ( !_allocator.grow( pointer, count, newCount ) )
+    {
+        return false;
+    }
+
+    _budget->check();
+
+    return true;
+}
+
+template <typename T>
+inline
+MemoryBudget* BudgetAllocator<T>::budget() const
+{
+    return _budget;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_BUDGET_ALLOCATOR_H
@@ -0,0 +1,146 @@
+// budget_table.h
+//
+// The budget table owns the named memory budgets of a program, such as
+// "render", "world" and "audio". It gives every budget the same logger and
+// callback, ends their frames together, and writes the frame report of
+// usage against budget.
+//
+// Budgets are added while the program starts. Adding and finding budgets
+// is not thread safe, but the budgets themselves may be checked from any
+// thread.
+//
+// Usage:
+//     BudgetTable budgets;
+//     budgets.setLogger( &logger );
+//     budgets.add( "render", 256 * 1024 * 1024 );
+//     budgets.add( "audio", 32 * 1024 * 1024 );
+//
+//     BudgetAllocator<Mesh> meshAlloc( budgets.find( "render" ) );
+//
+//     // every frame
+//     budgets.writeReport( std::cout );
+//     budgets.endFrame();
+//
+#ifndef NGE_MEM_BUDGET_TABLE_H
+#define NGE_MEM_BUDGET_TABLE_H
+
+#include <ostream>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/memory/memory_budget.h"
+#include "engine/utility/logger.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class BudgetTable
+{
+  private:
+    // MEMBERS
+    /**
+     * The first budget.
+     */
+    MemoryBudget* _first;
+
+    /**
+     * The number of budgets.
+     */
+    uint32 _size;
+
+    /**
+     * The function given to every budget.
+     */
+    MemoryBudget::Callback _callback;
+
+    /**
+     * The logger given to every budget.
+     */
+    util::Logger* _logger;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an empty budget table.
+     */
+    BudgetTable();
+
+    /**
+     * Budget tables cannot be copied.
+     */
+    BudgetTable( const BudgetTable& table ) = delete;
+
+    /**
+     * Destructs the table and its budgets.
+     */
+    ~BudgetTable();
+
+    // OPERATORS
+    /**
+     * Budget tables cannot be copied.
+     */
+    BudgetTable& operator=( const BudgetTable& table ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds a budget for the tag with the given limit in bytes.
+     *
+     * The budget is owned by the table.
+     *
+     * Behavior is undefined when:
+     * - the table has a budget for the tag
+     */
+    MemoryBudget* add( const String& tag, uint64 limit );
+
+    /**
+     * Gets the budget for the tag or null if there is none.
+     */
+    MemoryBudget* find( const String& tag ) const;
+
+    /**
+     * Gets the number of budgets.
+     */
+    uint32 size() const;
+
+    /**
+     * Sets the function called when any budget goes over its limit.
+     */
+    void setCallback( const MemoryBudget::Callback& callback );
+
+    /**
+     * Sets the logger that every budget warns to or null to not warn.
+     */
+    void setLogger( util::Logger* logger );
+
+    /**
+     * Starts a new frame and checks every budget.
+     */
+    void endFrame();
+
+    /**
+     * Checks if any budget was over its limit at its last check.
+     */
+    bool exceeded() const;
+
+    /**
+     * Writes the usage, frame peak and frame overruns of every budget as
+     * text.
+     */
+    void writeReport( std::ostream& stream ) const;
+};
+
+// MEMBER FUNCTIONS
+inline
+uint32 BudgetTable::size() const
+{
+    return _size;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_BUDGET_TABLE_H
@@ -0,0 +1,485 @@
+// compacting_heap.h
+//
+// The compacting heap hands out handles instead of pointers so that it can
+// move allocations to close the holes left by released ones. A long
+// running program that allocates and releases blocks of many sizes never
+// ends up with free memory that is split into pieces too small to use.
+//
+// Allocations are placed one after another at the top of one block of
+// bytes. Releasing an allocation leaves a hole, and compaction slides the
+// allocations above the hole down to close it. Compaction is incremental:
+// each call moves allocations until the time budget is spent and picks up
+// where it left off on the next call, so it can run for a fixed time every
+// frame. When an allocation does not fit above the top, the heap compacts
+// fully before it gives up.
+//
+// A handle is resolved to a pointer when the allocation is used. The
+// pointer is valid until the heap next allocates or compacts. Pinning an
+// allocation, usually through a handle guard, keeps it in place for longer;
+// compaction slides allocations up to a pinned one and continues above it.
+//
+// Allocations are moved with memmove, so only trivially copyable types can
+// be allocated. The heap is not thread safe.
+//
+// Usage:
+//     CompactingHeap heap( 64 * 1024 * 1024, "world" );
+//     Handle<Vertex> vertices = heap.allocate<Vertex>( count );
+//
+//     {
+//         HandleGuard<Vertex> guard( &heap, vertices );
+//         fill( guard.get(), count );
+//     }
+//
+//     // every frame
+//     heap.compact( 0.0005f );
+//
+#ifndef NGE_MEM_COMPACTING_HEAP_H
+#define NGE_MEM_COMPACTING_HEAP_H
+
+#include <assert.h>
+#include <type_traits>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/containers/dynamic_array.h"
+#include "engine/memory/allocation_tracker.h"
+#include "engine/memory/handle.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class CompactingHeap
+{
+  public:
+    // CONSTANTS
+    /**
+     * The largest alignment that an allocation can have.
+     */
+    static constexpr uint32 MAX_ALIGNMENT = 64;
+
+  private:
+    // STRUCTURES
+    /**
+     * Defines an entry in the handle table.
+     *
+     * Live entries are linked in address order. Free entries are linked
+     * through next.
+     */
+    struct Entry
+    {
+        uint32 offset;
+        uint32 size;
+        uint32 align;
+        uint32 generation;
+        uint32 pins;
+        uint32 prev;
+        uint32 next;
+        bool live;
+    };
+
+    // CONSTANTS
+    /**
+     * The index of no entry.
+     */
+    static constexpr uint32 NONE = Handle<void>::NONE;
+
+    // MEMBERS
+    /**
+     * The block of bytes.
+     */
+    uint8* _bytes;
+
+    /**
+     * The number of bytes in the block.
+     */
+    uint32 _capacity;
+
+    /**
+     * The offset of the first byte above every allocation.
+     */
+    uint32 _top;
+
+    /**
+     * The handle table.
+     */
+    cntr::DynamicArray<Entry> _entries;
+
+    /**
+     * The first free entry.
+     */
+    uint32 _freeEntry;
+
+    /**
+     * The live entry with the lowest address.
+     */
+    uint32 _head;
+
+    /**
+     * The live entry with the highest address.
+     */
+    uint32 _tail;
+
+    /**
+     * The next entry that compaction will look at.
+     */
+    uint32 _cursor;
+
+    /**
+     * The offset of the first byte above the compacted allocations.
+     */
+    uint32 _compacted;
+
+    /**
+     * The number of bytes in live allocations.
+     */
+    uint32 _used;
+
+    /**
+     * The number of live allocations.
+     */
+    uint32 _allocations;
+
+    /**
+     * The number of bytes moved by compaction.
+     */
+    uint64 _moved;
+
+    /**
+     * The tracker that allocations are recorded into or null.
+     */
+    AllocationTracker* _tracker;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the offset rounded up to the alignment.
+     */
+    static uint32 alignUp( uint32 offset, uint32 align );
+
+    /**
+     * Allocates the given number of bytes and returns the index of its
+     * entry or NONE when it does not fit.
+     */
+    uint32 allocateBlock( uint32 size, uint32 align );
+
+    /**
+     * Releases the allocation of the entry.
+     */
+    void releaseBlock( uint32 index );
+
+    /**
+     * Undoes a pin of the allocation of the entry.
+     */
+    void unpinBlock( uint32 index );
+
+    /**
+     * Gets the entry of the handle or null if the allocation was released.
+     */
+    const Entry* find( uint32 index, uint32 generation ) const;
+
+    /**
+     * Moves the allocation of the entry at the cursor if it can be moved
+     * and advances the cursor.
+     *
+     * Returns the number of bytes moved.
+     */
+    uint32 step();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a heap with the given number of bytes.
+     *
+     * Behavior is undefined when:
+     * - capacity is zero
+     */
+    explicit CompactingHeap( uint32 capacity );
+
+    /**
+     * Constructs a heap with the given number of bytes that records its
+     * allocations into the tracker of the tag.
+     *
+     * Behavior is undefined when:
+     * - capacity is zero
+     */
+    CompactingHeap( uint32 capacity, const String& tag );
+
+    /**
+     * Heaps cannot be copied.
+     */
+    CompactingHeap( const CompactingHeap& heap ) = delete;
+
+    /**
+     * Destructs the heap and frees its block.
+     */
+    ~CompactingHeap();
+
+    // OPERATORS
+    /**
+     * Heaps cannot be copied.
+     */
+    CompactingHeap& operator=( const CompactingHeap& heap ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Returns a null handle when the heap is out of memory.
+     *
+     * Behavior is undefined when:
+     * - count is zero
+     */
+    template <typename T>
+    Handle<T> allocate( uint32 count );
+
+    /**
+     * Releases the allocation of the handle.
+     *
+     * Behavior is undefined when:
+     * - the allocation was already released
+     * - the allocation is pinned
+     */
+    template <typename T>
+    void release( const Handle<T>& handle );
+
+    /**
+     * Gets a pointer to the allocation of the handle or null if it was
+     * released.
+     *
+     * The pointer is valid until the heap allocates or compacts.
+     */
+    template <typename T>
+    T* resolve( const Handle<T>& handle ) const;
+
+    /**
+     * Checks if the allocation of the handle has not been released.
+     */
+    template <typename T>
+    bool valid( const Handle<T>& handle ) const;
+
+    /**
+     * Keeps the allocation of the handle from being moved.
+     *
+     * Pins are counted, so each pin must be undone by an unpin.
+     *
+     * Behavior is undefined when:
+     * - the allocation was released
+     */
+    template <typename T>
+    void pin( const Handle<T>& handle );
+
+    /**
+     * Undoes a pin of the allocation of the handle.
+     *
+     * Behavior is undefined when:
+     * - the allocation was released
+     * - the allocation is not pinned
+     */
+    template <typename T>
+    void unpin( const Handle<T>& handle );
+
+    /**
+     * Moves allocations to close holes until the given number of seconds
+     * has passed or the heap is compacted.
+     *
+     * At least one allocation is looked at. Returns the number of bytes
+     * moved.
+     */
+    uint64 compact( float budgetS );
+
+    /**
+     * Moves allocations until the heap is compacted.
+     *
+     * Returns the number of bytes moved.
+     */
+    uint64 compact();
+
+    /**
+     * Checks if there are no holes below the top other than those below
+     * pinned allocations.
+     */
+    bool isCompacted() const;
+
+    // STATISTICS FUNCTIONS
+    /**
+     * Gets the number of bytes in the heap.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the number of bytes in live allocations.
+     */
+    uint32 used() const;
+
+    /**
+     * Gets the number of bytes that are not in live allocations.
+     */
+    uint32 available() const;
+
+    /**
+     * Gets the number of bytes above the top, which is the largest
+     * allocation that fits without compacting.
+     */
+    uint32 availableAtTop() const;
+
+    /**
+     * Gets the fraction of the available bytes that are in holes below the
+     * top.
+     */
+    float fragmentation() const;
+
+    /**
+     * Gets the number of live allocations.
+     */
+    uint32 allocationCount() const;
+
+    /**
+     * Gets the number of bytes moved by compaction.
+     */
+    uint64 movedBytes() const;
+};
+
+// HELPER FUNCTIONS
+inline
+uint32 CompactingHeap::alignUp( uint32 offset, uint32 align )
+{
+    return ( offset + align - 1 ) & ~( align - 1 );
+}
+
+inline
+const CompactingHeap::Entry* CompactingHeap::find( uint32 index,
+                                                   uint32 generation ) const
+{
+    const Entry* entry;
+
+    if ( index >= _entries.size() )
+    {
+        return nullptr;
+    }
+
+    entry = &_entries[index];
+    return entry->live && entry->generation == generation ? entry : nullptr;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+Handle<T> CompactingHeap::allocate( uint32 count )
+{
+    uint32 index;
+
+    static_assert( std::is_trivially_copyable<T>::value,
+                   "compacting heap allocations are moved with memmove" );
+    static_assert( alignof( T ) <= MAX_ALIGNMENT,
+                   "the alignment of T is larger than the block alignment" );
+    assert( count > 0 );
+
+    index = allocateBlock( sizeof( T ) * count, alignof( T ) );
+    if ( index == NONE )
+    {
+        return Handle<T>();
+    }
+
+    return Handle<T>( index, _entries[index].generation );
+}
+
+template <typename T>
+inline
+void CompactingHeap::release( const Handle<T>& handle )
+{
+    assert( valid( handle ) );
+    releaseBlock( handle._index );
+}
+
+template <typename T>
+inline
+T* CompactingHeap::resolve( const Handle<T>& handle ) const
+{
+    const Entry* entry = find( handle._index, handle._generation );
+
+    return entry != nullptr ? reinterpret_cast<T*>( _bytes + entry->offset )
+                            : nullptr;
+}
+
+template <typename T>
+inline
+bool CompactingHeap::valid( const Handle<T>& handle ) const
+{
+    return find( handle._index, handle._generation ) != nullptr;
+}
+
+template <typename T>
+inline
+void CompactingHeap::pin( const Handle<T>& handle )
+{
+    assert( valid( handle ) );
+    ++_entries[handle._index].pins;
+}
+
+template <typename T>
+inline
+void CompactingHeap::unpin( const Handle<T>& handle )
+{
+    assert( valid( handle ) );
+    assert( _entries[handle._index].pins > 0 );
+    unpinBlock( handle._index );
+}
+
+inline
+bool CompactingHeap::isCompacted() const
+{
+    return _cursor == NONE;
+}
+
+// STATISTICS FUNCTIONS
+inline
+uint32 CompactingHeap::capacity() const
+{
+    return _capacity;
+}
+
+inline
+uint32 CompactingHeap::used() const
+{
+    return _used;
+}
+
+inline
+uint32 CompactingHeap::available() const
+{
+    return _capacity - _used;
+}
+
+inline
+uint32 CompactingHeap::availableAtTop() const
+{
+    return _capacity - _top;
+}
+
+inline
+float CompactingHeap::fragmentation() const
+{
+    return available() == 0 ? 0.0f
+                            : 1.0f - static_cast<float>( availableAtTop() ) /
+                                         available();
+}
+
+inline
+uint32 CompactingHeap::allocationCount() const
+{
+    return _allocations;
+}
+
+inline
+uint64 CompactingHeap::movedBytes() const
+{
+    return _moved;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_COMPACTING_HEAP_H
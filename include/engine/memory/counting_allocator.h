@@ -3,6 +3,7 @@
 #define NGE_MEM_COUNTING_ALLOCATOR_H
 
 #include <assert.h>
+#include <atomic>
 
 #include "engine/intdef.h"
 #include "engine/memory/allocator_guard.h"
@@ -20,8 +21,10 @@ class CountingAllocator : public IAllocator<T>
     // GLOBALS
     /**
      * Global instance count of type T.
+     *
+     * This is atomic so that allocators on different threads can count.
      */
-    static uint32 g_count;
+    static std::atomic<uint32> g_count;
 
     // MEMBERS
     /**
@@ -104,7 +107,7 @@ class CountingAllocator : public IAllocator<T>
 
 // GLOBALS
 template <typename T>
-uint32 CountingAllocator<T>::g_count = 0;
+std::atomic<uint32> CountingAllocator<T>::g_count( 0 );
 
 // CONSTRUCTORS
 template <typename T>
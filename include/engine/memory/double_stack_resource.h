@@ -0,0 +1,320 @@
+// double_stack_resource.h
+//
+// The double stack resource is a memory resource that allocates from both
+// ends of one block of bytes. The bottom grows up and the top grows down,
+// and the block is full when they meet.
+//
+// The two ends are meant for allocations with different lifetimes. Data
+// that must last, such as a loaded level, is allocated from the bottom
+// while temporary buffers for loading or for an algorithm are allocated
+// from the top. Each end is rolled back to a marker on its own, which only
+// moves an offset. Stack markers roll an end back when they go out of
+// scope.
+//
+// Like the arena resource it is untyped, so nothing is destructed when an
+// end is rolled back. Unlike the arena resource the block never grows.
+//
+// Usage:
+//     DoubleStackResource stack( 16 * 1024 * 1024 );
+//     ResourceAllocator<Mesh> meshAlloc( &stack );
+//
+//     {
+//         StackMarker scratch( &stack, DoubleStackResource::TOP );
+//         ResourceAllocator<uint8> fileAlloc(
+//             stack.resource( DoubleStackResource::TOP ) );
+//
+//         // read the file into the top and the meshes into the bottom
+//     }
+//
+#ifndef NGE_MEM_DOUBLE_STACK_RESOURCE_H
+#define NGE_MEM_DOUBLE_STACK_RESOURCE_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/imemory_resource.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class DoubleStackResource : public IMemoryResource
+{
+  public:
+    // ENUMERATIONS
+    /**
+     * Defines the ends of the stack.
+     */
+    enum Side
+    {
+        BOTTOM = 0,
+        TOP
+    };
+
+    // STRUCTURES
+    /**
+     * Defines a position on one end of the stack that it can be rolled back
+     * to.
+     */
+    struct Marker
+    {
+        Side side;
+        uint32 offset;
+    };
+
+  private:
+    /**
+     * Defines a memory resource that allocates from one end of the stack.
+     */
+    class End : public IMemoryResource
+    {
+      private:
+        // MEMBERS
+        /**
+         * The stack that is allocated from.
+         */
+        DoubleStackResource* _stack;
+
+        /**
+         * The end of the stack that is allocated from.
+         */
+        Side _side;
+
+      public:
+        // CONSTRUCTORS
+        /**
+         * Constructs the end of the stack on the given side.
+         */
+        End( DoubleStackResource* stack, Side side );
+
+        /**
+         * Destructs the end.
+         */
+        virtual ~End();
+
+        // MEMBER FUNCTIONS
+        /**
+         * Allocates the given number of bytes from the end of the stack.
+         */
+        virtual void* allocate( uint32 size, uint32 align );
+
+        /**
+         * Does nothing. The memory is reused after the end is rolled back.
+         */
+        virtual void deallocate( void* pointer, uint32 size, uint32 align );
+    };
+
+    // MEMBERS
+    /**
+     * The block of bytes.
+     */
+    uint8* _bytes;
+
+    /**
+     * The number of bytes in the block.
+     */
+    uint32 _capacity;
+
+    /**
+     * The offset of the first free byte above the bottom allocations.
+     */
+    uint32 _bottom;
+
+    /**
+     * The offset of the first byte of the top allocations.
+     */
+    uint32 _top;
+
+    /**
+     * The resources that allocate from each end.
+     */
+    End _ends[2];
+
+    // HELPER FUNCTIONS
+    /**
+     * Finds the offset an allocation of the given size and alignment would
+     * get on the given end.
+     *
+     * Returns false when the allocation does not fit.
+     */
+    bool place( Side side, uint32 size, uint32 align, uint32* offset ) const;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a stack with the given number of bytes.
+     *
+     * Behavior is undefined when:
+     * - capacity is zero
+     */
+    explicit DoubleStackResource( uint32 capacity );
+
+    /**
+     * Stacks cannot be copied.
+     */
+    DoubleStackResource( const DoubleStackResource& stack ) = delete;
+
+    /**
+     * Destructs the stack and frees its block.
+     */
+    virtual ~DoubleStackResource();
+
+    // OPERATORS
+    /**
+     * Stacks cannot be copied.
+     */
+    DoubleStackResource& operator=( const DoubleStackResource& stack ) =
+        delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes from the bottom of the stack.
+     *
+     * Returns nullptr and leaves the stack unchanged when the allocation
+     * does not fit between the ends.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     */
+    virtual void* allocate( uint32 size, uint32 align );
+
+    /**
+     * Allocates the given number of bytes from the given end of the stack.
+     *
+     * Returns nullptr and leaves the stack unchanged when the allocation
+     * does not fit between the ends.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     */
+    void* allocate( Side side, uint32 size, uint32 align );
+
+    /**
+     * Does nothing. The memory is reused after its end is rolled back.
+     */
+    virtual void deallocate( void* pointer, uint32 size, uint32 align );
+
+    /**
+     * Gets a memory resource that allocates from the given end.
+     *
+     * The resource is owned by the stack.
+     */
+    IMemoryResource* resource( Side side );
+
+    /**
+     * Gets a marker for the current position of the given end.
+     */
+    Marker mark( Side side ) const;
+
+    /**
+     * Makes the bytes allocated from the end of the marker since it was
+     * taken available again.
+     *
+     * Behavior is undefined when:
+     * - the marker was taken after a later marker of its end was rolled
+     *   back
+     * - the marker was taken before its end was reset
+     */
+    void rollback( const Marker& marker );
+
+    /**
+     * Makes all bytes of the given end available again.
+     */
+    void reset( Side side );
+
+    /**
+     * Makes all bytes of both ends available again.
+     */
+    void reset();
+
+    /**
+     * Checks if an allocation of the given size and alignment fits on the
+     * given end.
+     */
+    bool fits( Side side, uint32 size, uint32 align ) const;
+
+    /**
+     * Gets the number of bytes allocated from the given end including
+     * alignment padding.
+     */
+    uint32 size( Side side ) const;
+
+    /**
+     * Gets the number of bytes between the ends.
+     */
+    uint32 available() const;
+
+    /**
+     * Gets the number of bytes in the block.
+     */
+    uint32 capacity() const;
+};
+
+// MEMBER FUNCTIONS
+inline
+IMemoryResource* DoubleStackResource::resource( Side side )
+{
+    return &_ends[side];
+}
+
+inline
+DoubleStackResource::Marker DoubleStackResource::mark( Side side ) const
+{
+    return Marker{ side, side == BOTTOM ? _bottom : _top };
+}
+
+inline
+void DoubleStackResource::rollback( const Marker& marker )
+{
+    if ( marker.side == BOTTOM )
+    {
+        assert( marker.offset <= _bottom );
+        _bottom = marker.offset;
+    }
+    else
+    {
+        assert( marker.offset >= _top && marker.offset <= _capacity );
+        _top = marker.offset;
+    }
+}
+
+inline
+void DoubleStackResource::reset( Side side )
+{
+    rollback( Marker{ side, side == BOTTOM ? 0 : _capacity } );
+}
+
+inline
+void DoubleStackResource::reset()
+{
+    _bottom = 0;
+    _top = _capacity;
+}
+
+inline
+uint32 DoubleStackResource::size( Side side ) const
+{
+    return side == BOTTOM ? _bottom : _capacity - _top;
+}
+
+inline
+uint32 DoubleStackResource::available() const
+{
+    return _top - _bottom;
+}
+
+inline
+uint32 DoubleStackResource::capacity() const
+{
+    return _capacity;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_DOUBLE_STACK_RESOURCE_H
@@ -0,0 +1,162 @@
+// handle.h
+//
+// A handle names an allocation of a compacting heap without pointing at
+// it, so the heap is free to move the allocation. The handle is resolved to
+// a pointer by the heap when the allocation is used.
+//
+// Handles hold the index of the allocation in the handle table of the heap
+// and the generation of that entry. Releasing an allocation bumps the
+// generation, so a handle that outlives its allocation resolves to null
+// instead of to whatever reuses the entry.
+//
+#ifndef NGE_MEM_HANDLE_H
+#define NGE_MEM_HANDLE_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class CompactingHeap;
+
+template <typename T>
+class Handle
+{
+  private:
+    // MEMBERS
+    /**
+     * The index of the entry in the handle table.
+     */
+    uint32 _index;
+
+    /**
+     * The generation of the entry when the allocation was made.
+     */
+    uint32 _generation;
+
+    friend class CompactingHeap;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a handle for the given entry.
+     */
+    Handle( uint32 index, uint32 generation );
+
+  public:
+    // CONSTANTS
+    /**
+     * The index of the null handle.
+     */
+    static constexpr uint32 NONE = 0xFFFFFFFF;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a null handle.
+     */
+    Handle();
+
+    // OPERATORS
+    /**
+     * Checks if the handles name the same allocation.
+     */
+    bool operator==( const Handle<T>& handle ) const;
+
+    /**
+     * Checks if the handles name different allocations.
+     */
+    bool operator!=( const Handle<T>& handle ) const;
+
+    /**
+     * Checks if the handle is null.
+     */
+    bool operator!() const;
+
+    /**
+     * Checks if the handle is not null.
+     *
+     * A handle that is not null may still name a released allocation.
+     */
+    explicit operator bool() const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the index of the entry in the handle table.
+     */
+    uint32 index() const;
+
+    /**
+     * Gets the generation of the entry when the allocation was made.
+     */
+    uint32 generation() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 Handle<T>::NONE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+Handle<T>::Handle() : _index( NONE ), _generation( 0 )
+{
+}
+
+template <typename T>
+inline
+Handle<T>::Handle( uint32 index, uint32 generation )
+    : _index( index ), _generation( generation )
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+bool Handle<T>::operator==( const Handle<T>& handle ) const
+{
+    return _index == handle._index && _generation == handle._generation;
+}
+
+template <typename T>
+inline
+bool Handle<T>::operator!=( const Handle<T>& handle ) const
+{
+    return !( *this == handle );
+}
+
+template <typename T>
+inline
+bool Handle<T>::operator!() const
+{
+    return _index == NONE;
+}
+
+template <typename T>
+inline
+Handle<T>::operator bool() const
+{
+    return _index != NONE;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+uint32 Handle<T>::index() const
+{
+    return _index;
+}
+
+template <typename T>
+inline
+uint32 Handle<T>::generation() const
+{
+    return _generation;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_HANDLE_H
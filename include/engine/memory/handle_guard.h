@@ -0,0 +1,223 @@
+// handle_guard.h
+//
+// A handle guard pins the allocation of a handle when it is constructed and
+// unpins it when it is destructed, so the pointer it resolves to stays valid
+// for the scope of the guard even if the heap allocates or compacts.
+//
+#ifndef NGE_MEM_HANDLE_GUARD_H
+#define NGE_MEM_HANDLE_GUARD_H
+
+#include <assert.h>
+
+#include "engine/memory/compacting_heap.h"
+#include "engine/memory/handle.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class HandleGuard
+{
+  private:
+    /**
+     * The heap of the allocation.
+     */
+    CompactingHeap* _heap;
+
+    /**
+     * The handle of the pinned allocation.
+     */
+    Handle<T> _handle;
+
+    /**
+     * The pinned allocation.
+     */
+    T* _pointer;
+
+    /**
+     * Constructs a copy of the given guard.
+     *
+     * This is not a supported operation for handle guards.
+     */
+    HandleGuard( const HandleGuard<T>& guard ) = delete;
+
+    /**
+     * Assigns this as a copy of the other guard.
+     *
+     * This is not a supported operation for handle guards.
+     */
+    HandleGuard<T>& operator=( const HandleGuard<T>& guard ) = delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a guard that pins nothing.
+     */
+    HandleGuard();
+
+    /**
+     * Constructs a guard that pins the allocation of the handle.
+     *
+     * Behavior is undefined when:
+     * - the allocation was released
+     */
+    HandleGuard( CompactingHeap* heap, const Handle<T>& handle );
+
+    /**
+     * Moves the pin to this instance.
+     */
+    HandleGuard( HandleGuard<T>&& guard );
+
+    /**
+     * Destructs the guard and unpins the allocation.
+     */
+    ~HandleGuard();
+
+    // OPERATORS
+    /**
+     * Moves the pin to this instance.
+     *
+     * Behavior is undefined when:
+     * Already pinning an allocation.
+     */
+    HandleGuard<T>& operator=( HandleGuard<T>&& guard );
+
+    /**
+     * Gets the pinned allocation.
+     */
+    T& operator*() const;
+
+    /**
+     * Gets the pinned allocation.
+     */
+    T* operator->() const;
+
+    /**
+     * Checks if the guard is not pinning an allocation.
+     */
+    bool operator!() const;
+
+    /**
+     * Checks if the guard is pinning an allocation.
+     */
+    operator bool() const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the pinned allocation or null if nothing is pinned.
+     */
+    T* get() const;
+
+    /**
+     * Gets the handle of the pinned allocation.
+     */
+    const Handle<T>& handle() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+HandleGuard<T>::HandleGuard()
+    : _heap( nullptr ), _handle(), _pointer( nullptr )
+{
+}
+
+template <typename T>
+inline
+HandleGuard<T>::HandleGuard( CompactingHeap* heap, const Handle<T>& handle )
+    : _heap( heap ), _handle( handle ), _pointer( nullptr )
+{
+    _heap->pin( _handle );
+    _pointer = _heap->resolve( _handle );
+}
+
+template <typename T>
+inline
+HandleGuard<T>::HandleGuard( HandleGuard<T>&& guard )
+    : _heap( guard._heap ), _handle( guard._handle ),
+      _pointer( guard._pointer )
+{
+    guard._heap = nullptr;
+    guard._pointer = nullptr;
+}
+
+template <typename T>
+inline
+HandleGuard<T>::~HandleGuard()
+{
+    if ( _heap != nullptr )
+    {
+        _heap->unpin( _handle );
+        _heap = nullptr;
+    }
+}
+
+// OPERATORS
+template <typename T>
+inline
+HandleGuard<T>& HandleGuard<T>::operator=( HandleGuard<T>&& guard )
+{
+    assert( _heap == nullptr );
+
+    _heap = guard._heap;
+    _handle = guard._handle;
+    _pointer = guard._pointer;
+    guard._heap = nullptr;
+    guard._pointer = nullptr;
+
+    return *this;
+}
+
+template <typename T>
+inline
+T& HandleGuard<T>::operator*() const
+{
+    assert( _pointer != nullptr );
+    return *_pointer;
+}
+
+template <typename T>
+inline
+T* HandleGuard<T>::operator->() const
+{
+    assert( _pointer != nullptr );
+    return _pointer;
+}
+
+template <typename T>
+inline
+bool HandleGuard<T>::operator!() const
+{
+    return _heap == nullptr;
+}
+
+template <typename T>
+inline
+HandleGuard<T>::operator bool() const
+{
+    return _heap != nullptr;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* HandleGuard<T>::get() const
+{
+    return _pointer;
+}
+
+template <typename T>
+inline
+const Handle<T>& HandleGuard<T>::handle() const
+{
+    return _handle;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_HANDLE_GUARD_H
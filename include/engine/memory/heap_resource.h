@@ -0,0 +1,73 @@
+// heap_resource.h
+//
+// The heap resource is a memory resource that uses the global new and
+// delete operators.
+//
+// Alignments up to the fundamental alignment come straight from operator
+// new. Larger alignments over allocate and keep the address returned by
+// operator new just before the aligned bytes.
+//
+#ifndef NGE_MEM_HEAP_RESOURCE_H
+#define NGE_MEM_HEAP_RESOURCE_H
+
+#include "engine/intdef.h"
+#include "engine/memory/imemory_resource.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class HeapResource : public IMemoryResource
+{
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs the heap resource.
+     */
+    HeapResource();
+
+    /**
+     * Destructs the heap resource.
+     */
+    virtual ~HeapResource();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes aligned to the given alignment.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     * out of mem
+     */
+    virtual void* allocate( uint32 size, uint32 align );
+
+    /**
+     * Deallocates memory that was allocated with the given size and
+     * alignment.
+     *
+     * Behavior is undefined when:
+     * pointer was not allocated by this resource
+     * size or align differ from the allocation
+     */
+    virtual void deallocate( void* pointer, uint32 size, uint32 align );
+};
+
+// CONSTRUCTORS
+inline
+HeapResource::HeapResource()
+{
+}
+
+inline
+HeapResource::~HeapResource()
+{
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_HEAP_RESOURCE_H
@@ -2,6 +2,8 @@
 #ifndef NGE_MEM_IALLOCATOR_H
 #define NGE_MEM_IALLOCATOR_H
 
+#include <cstddef>
+
 #include "engine/intdef.h"
 
 namespace nge
@@ -41,6 +43,28 @@ class IAllocator
      * out of mem
      */
     virtual void release( T* pointer, uint32 count ) = 0;
+
+    /**
+     * Gets the alignment in bytes that every allocation is guaranteed to
+     * have.
+     *
+     * By default this is the alignment of T up to the fundamental alignment
+     * since that is all that new guarantees.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Tries to grow the allocation to the new number of instances without
+     * moving it. The added instances are constructed like those of get.
+     *
+     * Returns false and leaves the allocation alone when it cannot grow in
+     * place, which is all that the default implementation does.
+     *
+     * Behavior is undefined when:
+     * pointer is invalid
+     * newCount is less than or equal to count
+     */
+    virtual bool grow( T* pointer, uint32 count, uint32 newCount );
 };
 
 // CONSTRUCTORS
@@ -50,6 +74,24 @@ IAllocator<T>::~IAllocator()
 {
 }
 
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+uint32 IAllocator<T>::alignment() const
+{
+    return alignof( T ) < alignof( std::max_align_t ) ?
+           alignof( T ) : alignof( std::max_align_t );
+}
+
+template <typename T>
+inline
+bool IAllocator<T>::grow( T* /* pointer */,
+                          uint32 /* count */,
+                          uint32 /* newCount */ )
+{
+    return false;
+}
+
 } // End nspc mem
 
 } // End nspc nge
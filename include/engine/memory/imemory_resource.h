@@ -0,0 +1,65 @@
+// imemory_resource.h
+//
+// Interface definition of an untyped memory resource.
+//
+// Memory resources hand out raw bytes with a given alignment. Unlike
+// allocators they are not tied to a type so one resource, such as an arena
+// or a budget, can back containers of any number of different types through
+// resource allocators.
+//
+#ifndef NGE_MEM_IMEMORY_RESOURCE_H
+#define NGE_MEM_IMEMORY_RESOURCE_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class IMemoryResource
+{
+  public:
+    // CONSTRUCTORS
+    /**
+     * Destructs the memory resource.
+     */
+    virtual ~IMemoryResource() = 0;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes aligned to the given alignment.
+     *
+     * A resource that manages a fixed amount of memory returns nullptr
+     * when the allocation does not fit.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     * out of mem
+     */
+    virtual void* allocate( uint32 size, uint32 align ) = 0;
+
+    /**
+     * Deallocates memory that was allocated with the given size and
+     * alignment.
+     *
+     * Behavior is undefined when:
+     * pointer was not allocated by this resource
+     * size or align differ from the allocation
+     */
+    virtual void deallocate( void* pointer, uint32 size, uint32 align ) = 0;
+};
+
+// CONSTRUCTORS
+inline
+IMemoryResource::~IMemoryResource()
+{
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_IMEMORY_RESOURCE_H
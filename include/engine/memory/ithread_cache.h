@@ -0,0 +1,51 @@
+// ithread_cache.h
+//
+// Interface definition of a set of per thread caches.
+//
+// Allocators and resources that give each thread a cache of free memory
+// register with the thread index. When a thread exits its index is handed
+// to every registered cache so the memory it holds can go back to the
+// shared pool before the index is given to another thread.
+//
+#ifndef NGE_MEM_ITHREAD_CACHE_H
+#define NGE_MEM_ITHREAD_CACHE_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class IThreadCache
+{
+  public:
+    // CONSTRUCTORS
+    /**
+     * Destructs the thread cache.
+     */
+    virtual ~IThreadCache() = 0;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Returns everything in the cache of the thread with the given index to
+     * the shared pool.
+     *
+     * This is called on the exiting thread while the thread index is
+     * locked, so it must not use the thread index itself.
+     */
+    virtual void releaseThread( uint32 index ) = 0;
+};
+
+// CONSTRUCTORS
+inline
+IThreadCache::~IThreadCache()
+{
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_ITHREAD_CACHE_H
@@ -0,0 +1,275 @@
+// memory_budget.h
+//
+// A memory budget is a limit on the number of live bytes of a subsystem.
+// It reads the tracker of its tag from the allocation registry, so every
+// allocator that records into the tag counts against the budget.
+//
+// Budget allocators check the budget after every allocation and release.
+// When the live bytes first go over the limit the budget writes a warning
+// to its logger and calls its callback, which may assert, flush caches, or
+// just count. It does not warn again until the live bytes have come back
+// under the limit. Allocations made through other allocators of the tag
+// are checked when the frame ends.
+//
+// The budget also keeps the peak live bytes and the number of overruns of
+// the current frame so that a frame report can show usage against budget.
+//
+// Checks may run on any thread. The callback and the logger are called on
+// the thread that went over the limit.
+//
+// Usage:
+//     MemoryBudget audio( "audio", 32 * 1024 * 1024 );
+//     audio.setLogger( &logger );
+//
+//     BudgetAllocator<Sample> alloc( &audio );
+//
+#ifndef NGE_MEM_MEMORY_BUDGET_H
+#define NGE_MEM_MEMORY_BUDGET_H
+
+#include <atomic>
+#include <functional>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/memory/allocation_tracker.h"
+#include "engine/utility/logger.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class MemoryBudget
+{
+  public:
+    // TYPES
+    /**
+     * Defines a function that is called when a budget goes over its limit
+     * with the number of live bytes.
+     */
+    typedef std::function<void( const MemoryBudget&, uint64 )> Callback;
+
+  private:
+    // MEMBERS
+    /**
+     * The tracker of the tag.
+     */
+    AllocationTracker* _tracker;
+
+    /**
+     * The largest number of live bytes that is within budget.
+     */
+    std::atomic<uint64> _limit;
+
+    /**
+     * The largest number of live bytes seen by a check in this frame.
+     */
+    std::atomic<uint64> _framePeakBytes;
+
+    /**
+     * The number of times the budget went over its limit.
+     */
+    std::atomic<uint64> _overruns;
+
+    /**
+     * The number of times the budget went over its limit in this frame.
+     */
+    std::atomic<uint32> _frameOverruns;
+
+    /**
+     * If the last check found the budget over its limit.
+     */
+    std::atomic<bool> _exceeded;
+
+    /**
+     * The function called when the budget goes over its limit.
+     */
+    Callback _callback;
+
+    /**
+     * The logger that warnings are written to.
+     */
+    util::Logger* _logger;
+
+    /**
+     * The next budget of the budget table.
+     */
+    MemoryBudget* _next;
+
+    friend class BudgetTable;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a budget for the tag with the given limit in bytes.
+     */
+    MemoryBudget( const String& tag, uint64 limit );
+
+    /**
+     * Budgets cannot be copied.
+     */
+    MemoryBudget( const MemoryBudget& budget ) = delete;
+
+    /**
+     * Destructs the budget.
+     */
+    ~MemoryBudget();
+
+    // OPERATORS
+    /**
+     * Budgets cannot be copied.
+     */
+    MemoryBudget& operator=( const MemoryBudget& budget ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Sets the largest number of live bytes that is within budget.
+     */
+    void setLimit( uint64 limit );
+
+    /**
+     * Sets the function called when the budget goes over its limit.
+     *
+     * Behavior is undefined when:
+     * - the budget is checked while the callback is set
+     */
+    void setCallback( const Callback& callback );
+
+    /**
+     * Sets the logger that warnings are written to or null to not warn.
+     *
+     * Behavior is undefined when:
+     * - the budget is checked while the logger is set
+     */
+    void setLogger( util::Logger* logger );
+
+    /**
+     * Compares the live bytes to the limit.
+     *
+     * Warns and calls the callback if the budget has just gone over its
+     * limit.
+     */
+    void check();
+
+    /**
+     * Starts a new frame and checks the budget.
+     *
+     * An overrun found by this check is counted in the new frame.
+     */
+    void endFrame();
+
+    /**
+     * Gets the tag of the budget.
+     */
+    const String& tag() const;
+
+    /**
+     * Gets the largest number of live bytes that is within budget.
+     */
+    uint64 limit() const;
+
+    /**
+     * Gets the number of live bytes.
+     */
+    uint64 liveBytes() const;
+
+    /**
+     * Gets the largest number of live bytes seen by a check in this frame.
+     */
+    uint64 framePeakBytes() const;
+
+    /**
+     * Gets the number of times the budget went over its limit.
+     */
+    uint64 overruns() const;
+
+    /**
+     * Gets the number of times the budget went over its limit in this
+     * frame.
+     */
+    uint32 frameOverruns() const;
+
+    /**
+     * Checks if the last check found the budget over its limit.
+     */
+    bool exceeded() const;
+
+    /**
+     * Gets the tracker of the tag.
+     */
+    AllocationTracker* tracker() const;
+};
+
+// MEMBER FUNCTIONS
+inline
+void MemoryBudget::setLimit( uint64 limit )
+{
+    _limit.store( limit, std::memory_order_relaxed );
+}
+
+inline
+void MemoryBudget::setCallback( const Callback& callback )
+{
+    _callback = callback;
+}
+
+inline
+void MemoryBudget::setLogger( util::Logger* logger )
+{
+    _logger = logger;
+}
+
+inline
+const String& MemoryBudget::tag() const
+{
+    return _tracker->tag();
+}
+
+inline
+uint64 MemoryBudget::limit() const
+{
+    return _limit.load( std::memory_order_relaxed );
+}
+
+inline
+uint64 MemoryBudget::liveBytes() const
+{
+    return _tracker->liveBytes();
+}
+
+inline
+uint64 MemoryBudget::framePeakBytes() const
+{
+    return _framePeakBytes.load( std::memory_order_relaxed );
+}
+
+inline
+uint64 MemoryBudget::overruns() const
+{
+    return _overruns.load( std::memory_order_relaxed );
+}
+
+inline
+uint32 MemoryBudget::frameOverruns() const
+{
+    return _frameOverruns.load( std::memory_order_relaxed );
+}
+
+inline
+bool MemoryBudget::exceeded() const
+{
+    return _exceeded.load( std::memory_order_relaxed );
+}
+
+inline
+AllocationTracker* MemoryBudget::tracker() const
+{
+    return _tracker;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_MEMORY_BUDGET_H
@@ -1,7 +1,22 @@
 // memory_utils.h
+//
+// Arrays of trivially copyable items are copied and filled as bytes, and
+// arrays of integers, enumerations and pointers are compared as bytes.
+// Other items are copied, assigned and compared one at a time.
+//
+// Fills store whole vectors of the repeated item. Copies and fills of at
+// least NON_TEMPORAL_THRESHOLD bytes use streaming stores that bypass the
+// cache. A block that large would evict most of the cache only to be read
+// again much later, if at all. Smaller copies and compares, and fills of
+// one repeated byte, go to the C library, which picks the widest vectors
+// of the processor at run time.
+//
 #ifndef NGE_MEM_MEMORY_UTILS_H
 #define NGE_MEM_MEMORY_UTILS_H
 
+#include <string.h>
+
+#include <type_traits>
 #include <utility>
 
 #include "engine/intdef.h"
@@ -15,8 +30,69 @@ namespace mem
 struct MemoryUtils
 {
   public:
+    // CONSTANTS
+    /**
+     * The size of a cache line in bytes.
+     *
+     * Data that is written by different threads should be at least this far
+     * apart so that the threads do not share a cache line.
+     */
+    static constexpr uint32 CACHE_LINE_SIZE = 64;
+
+    /**
+     * The number of bytes at which copies and fills use streaming stores.
+     *
+     * This is twice the size of a common second level cache.
+     */
+    static constexpr uint64 NON_TEMPORAL_THRESHOLD = 1 << 22;
+
+  private:
+    // HELPER FUNCTIONS
+    /**
+     * Copies items one at a time.
+     */
+    template <typename T>
+    static void copy( T* dst, T* src, uint32 count, std::false_type );
+
+    /**
+     * Copies the bytes of trivially copyable items.
+     */
+    template <typename T>
+    static void copy( T* dst, T* src, uint32 count, std::true_type );
+
+    /**
+     * Sets items one at a time.
+     */
+    template <typename T>
+    static void set( T* ptr, const T& value, uint32 count, std::false_type );
+
+    /**
+     * Fills the bytes of trivially copyable items of 1, 2, 4 or 8 bytes.
+     */
+    template <typename T>
+    static void set( T* ptr, const T& value, uint32 count, std::true_type );
+
+    /**
+     * Compares items one at a time.
+     */
+    template <typename T>
+    static bool equals( const T* lhs, const T* rhs, uint32 count,
+                        std::false_type );
+
+    /**
+     * Compares the bytes of items that are equal only when their bytes are.
+     */
+    template <typename T>
+    static bool equals( const T* lhs, const T* rhs, uint32 count,
+                        std::true_type );
+
+  public:
+    // MEMBER FUNCTIONS
     /**
      * Copies items from the source to the destination.
+     *
+     * Behavior is undefined when:
+     * the source and the destination overlap
      */
     template <typename T>
     static void copy( T* dst, T* src, uint32 count );
@@ -32,10 +108,76 @@ struct MemoryUtils
      */
     template <typename T>
     static void set( T* ptr, const T& value, uint32 count );
+
+    /**
+     * Checks if the items of the two arrays are equal.
+     */
+    template <typename T>
+    static bool equals( const T* lhs, const T* rhs, uint32 count );
+
+    /**
+     * Copies the given number of bytes from the source to the destination.
+     *
+     * Behavior is undefined when:
+     * the source and the destination overlap
+     */
+    static void copyBytes( void* dst, const void* src, uint64 size );
+
+    /**
+     * Fills the destination with the bytes of the pattern.
+     *
+     * The pattern holds copies of one item of the given width, so the
+     * destination is filled with whole items.
+     *
+     * Behavior is undefined when:
+     * width is not 1, 2, 4 or 8
+     * the pattern does not repeat every width bytes
+     * size is not a multiple of width
+     */
+    static void fillBytes( void* dst, uint64 pattern, uint32 width,
+                           uint64 size );
+
+    /**
+     * Checks if the given number of bytes of the two blocks are equal.
+     */
+    static bool equalBytes( const void* lhs, const void* rhs, uint64 size );
+
+    /**
+     * Allocates the given number of bytes aligned to the given alignment.
+     *
+     * The memory must be deallocated using deallocateAligned.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * align is not a power of two
+     * out of mem
+     */
+    static void* allocateAligned( uint64 size, uint32 align );
+
+    /**
+     * Deallocates memory that was allocated using allocateAligned.
+     *
+     * Behavior is undefined when:
+     * pointer was not allocated using allocateAligned
+     */
+    static void deallocateAligned( void* pointer );
+
+    /**
+     * Checks if the pointer is aligned to the given alignment.
+     */
+    static bool isAligned( const void* pointer, uint32 align );
 };
 
+inline
+bool MemoryUtils::isAligned( const void* pointer, uint32 align )
+{
+    return ( reinterpret_cast<uintptr_t>( pointer ) & ( align - 1 ) ) == 0;
+}
+
+// HELPER FUNCTIONS
 template <typename T>
-void MemoryUtils::copy( T* dst, T* src, uint32 count )
+inline
+void MemoryUtils::copy( T* dst, T* src, uint32 count, std::false_type )
 {
     uint32 i;
     for ( i = 0; i < count; ++i )
@@ -45,27 +187,113 @@ void MemoryUtils::copy( T* dst, T* src, uint32 count )
 }
 
 template <typename T>
-void MemoryUtils::move( T* dst, T* src, uint32 count )
+inline
+void MemoryUtils::copy( T* dst, T* src, uint32 count, std::true_type )
+{
+    copyBytes( dst, src, static_cast<uint64>( sizeof( T ) ) * count );
+}
+
+template <typename T>
+inline
+void MemoryUtils::set( T* ptr, const T& value, uint32 count,
+                       std::false_type )
 {
     uint32 i;
     for ( i = 0; i < count; ++i )
     {
-        dst[i] = std::move( src[i] );
+        ptr[i] = value;
     }
 }
 
 template <typename T>
-void MemoryUtils::set( T* ptr, const T& value, uint32 count )
+inline
+void MemoryUtils::set( T* ptr, const T& value, uint32 count,
+                       std::true_type )
+{
+    uint64 pattern;
+    uint32 i;
+
+    for ( i = 0; i < 8; i += sizeof( T ) )
+    {
+        memcpy( reinterpret_cast<uint8*>( &pattern ) + i, &value,
+                sizeof( T ) );
+    }
+
+    fillBytes( ptr, pattern, sizeof( T ),
+               static_cast<uint64>( sizeof( T ) ) * count );
+}
+
+template <typename T>
+inline
+bool MemoryUtils::equals( const T* lhs, const T* rhs, uint32 count,
+                          std::false_type )
 {
     uint32 i;
     for ( i = 0; i < count; ++i )
     {
-        ptr[i] = value;
+        if ( !( lhs[i] == rhs[i] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+inline
+bool MemoryUtils::equals( const T* lhs, const T* rhs, uint32 count,
+                          std::true_type )
+{
+    return equalBytes( lhs, rhs, static_cast<uint64>( sizeof( T ) ) * count );
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+void MemoryUtils::copy( T* dst, T* src, uint32 count )
+{
+    copy( dst, src, count,
+          std::integral_constant<bool,
+                                 std::is_trivially_copyable<T>::value>() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::move( T* dst, T* src, uint32 count )
+{
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        dst[i] = std::move( src[i] );
     }
 }
 
+template <typename T>
+inline
+void MemoryUtils::set( T* ptr, const T& value, uint32 count )
+{
+    set( ptr, value, count,
+         std::integral_constant<bool,
+                                std::is_trivially_copyable<T>::value &&
+                                sizeof( T ) <= 8 &&
+                                ( sizeof( T ) & ( sizeof( T ) - 1 ) ) ==
+                                    0>() );
+}
+
+template <typename T>
+inline
+bool MemoryUtils::equals( const T* lhs, const T* rhs, uint32 count )
+{
+    // floats and padded structures can be equal with different bytes
+    return equals( lhs, rhs, count,
+            std::integral_constant<bool, std::is_integral<T>::value ||
+                                         std::is_enum<T>::value ||
+                                         std::is_pointer<T>::value>() );
+}
+
 } // End nspc mem
 
 } // End nspc nge
 
-#endif // NGE_MEM_MEMORY_UTILS_H
\ No newline at end of file
+#endif // NGE_MEM_MEMORY_UTILS_H
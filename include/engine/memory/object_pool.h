@@ -0,0 +1,638 @@
+// object_pool.h
+//
+// The object pool constructs objects in slots that are cut from contiguous
+// chunks. Destroying an object frees its slot for the next object, so
+// objects that come and go during play, such as projectiles and effects,
+// do not fragment the heap. Chunks are returned to the heap when the pool
+// is trimmed and they hold no live objects, or when the pool is destructed.
+//
+// Objects can also be recycled instead of destroyed. A recycled object is
+// reset, kept constructed, and handed out again by acquire, which saves
+// the cost of destructing and constructing objects that own buffers or
+// other resources.
+//
+// The live objects of a pool can be visited in chunk order, which touches
+// memory far more predictably than visiting objects that were allocated one
+// by one.
+//
+// The pool is not thread safe.
+//
+// Usage:
+//     ObjectPool<Bullet> bullets( 256 );
+//     bullets.setResetter( []( Bullet& bullet ) { bullet.reset(); } );
+//
+//     Bullet* bullet = bullets.acquire();
+//     scene.addTickable( bullet );
+//
+//     scene.removeTickable( bullet );
+//     bullets.recycle( bullet );
+//
+#ifndef NGE_MEM_OBJECT_POOL_H
+#define NGE_MEM_OBJECT_POOL_H
+
+#include <assert.h>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class ObjectPool
+{
+  public:
+    // CONSTANTS
+    /**
+     * The default number of objects in a chunk.
+     */
+    static constexpr uint32 DEFAULT_CHUNK_SIZE = 64;
+
+    // TYPES
+    /**
+     * Defines a function that resets an object that is recycled.
+     */
+    typedef std::function<void( T& )> Resetter;
+
+  private:
+    // ENUMERATIONS
+    /**
+     * Defines the states of a slot.
+     */
+    enum State : uint8
+    {
+        FREE = 0,
+        LIVE,
+        IDLE
+    };
+
+    // STRUCTURES
+    /**
+     * Defines a slot for one object.
+     *
+     * The storage must be the first member so that an object can be turned
+     * back into its slot.
+     */
+    struct Slot
+    {
+        typename std::aligned_storage<sizeof( T ), alignof( T )>::type
+            storage;
+        Slot* next;
+        State state;
+    };
+
+    /**
+     * Defines the header at the start of every chunk.
+     */
+    struct Chunk
+    {
+        Chunk* next;
+    };
+
+    // MEMBERS
+    /**
+     * The chunks from newest to oldest.
+     */
+    Chunk* _chunks;
+
+    /**
+     * The slots without an object.
+     */
+    Slot* _free;
+
+    /**
+     * The slots with a recycled object.
+     */
+    Slot* _idle;
+
+    /**
+     * The function that resets recycled objects.
+     */
+    Resetter _resetter;
+
+    /**
+     * The number of slots in a chunk.
+     */
+    uint32 _chunkSize;
+
+    /**
+     * The number of chunks.
+     */
+    uint32 _chunkCount;
+
+    /**
+     * The number of live objects.
+     */
+    uint32 _size;
+
+    /**
+     * The number of recycled objects.
+     */
+    uint32 _idleCount;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the number of bytes from the start of a chunk to its slots.
+     */
+    static uint32 slotOffset();
+
+    /**
+     * Gets the slots of the chunk.
+     */
+    static Slot* slots( Chunk* chunk );
+
+    /**
+     * Gets the slot of the object.
+     */
+    static Slot* slotOf( T* object );
+
+    /**
+     * Gets the object in the slot.
+     */
+    static T* objectOf( Slot* slot );
+
+    /**
+     * Adds a chunk and puts its slots on the free list.
+     */
+    void grow();
+
+    /**
+     * Gets the slot at the head of the free list without taking it,
+     * destroying a recycled object if there is no free slot.
+     */
+    Slot* nextFree();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an empty pool with the default chunk size.
+     */
+    ObjectPool();
+
+    /**
+     * Constructs an empty pool with the given number of objects in each
+     * chunk.
+     *
+     * Behavior is undefined when:
+     * - chunkSize is zero
+     */
+    explicit ObjectPool( uint32 chunkSize );
+
+    /**
+     * Pools cannot be copied.
+     */
+    ObjectPool( const ObjectPool<T>& pool ) = delete;
+
+    /**
+     * Destructs the pool, every object still in it, and its chunks.
+     */
+    ~ObjectPool();
+
+    // OPERATORS
+    /**
+     * Pools cannot be copied.
+     */
+    ObjectPool<T>& operator=( const ObjectPool<T>& pool ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Constructs an object in a free slot with the given arguments.
+     */
+    template <typename... Args>
+    T* create( Args&&... args );
+
+    /**
+     * Destructs the object and frees its slot.
+     *
+     * Behavior is undefined when:
+     * - the object is not a live object of the pool
+     */
+    void destroy( T* object );
+
+    /**
+     * Gets a recycled object or default constructs one when there is none.
+     */
+    T* acquire();
+
+    /**
+     * Resets the object and keeps it constructed for a later acquire.
+     *
+     * Behavior is undefined when:
+     * - the object is not a live object of the pool
+     */
+    void recycle( T* object );
+
+    /**
+     * Destructs every recycled object and returns the chunks without live
+     * objects to the heap.
+     */
+    void trim();
+
+    /**
+     * Destructs every object but keeps the chunks.
+     */
+    void clear();
+
+    /**
+     * Constructs chunks until the pool holds at least the given number of
+     * objects.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Calls the function with every live object in chunk order.
+     *
+     * Behavior is undefined when:
+     * - the function creates, destroys, acquires or recycles objects
+     */
+    template <typename F>
+    void forEach( F func );
+
+    /**
+     * Sets the function that resets recycled objects.
+     */
+    void setResetter( const Resetter& resetter );
+
+    /**
+     * Gets the number of live objects.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of recycled objects.
+     */
+    uint32 idleCount() const;
+
+    /**
+     * Gets the number of slots.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the number of slots in a chunk.
+     */
+    uint32 chunkSize() const;
+
+    /**
+     * Gets the number of chunks.
+     */
+    uint32 chunkCount() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 ObjectPool<T>::DEFAULT_CHUNK_SIZE;
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+uint32 ObjectPool<T>::slotOffset()
+{
+    return ( sizeof( Chunk ) + alignof( Slot ) - 1 ) / alignof( Slot ) *
+           alignof( Slot );
+}
+
+template <typename T>
+inline
+typename ObjectPool<T>::Slot* ObjectPool<T>::slots( Chunk* chunk )
+{
+    return reinterpret_cast<Slot*>( reinterpret_cast<uint8*>( chunk ) +
+                                    slotOffset() );
+}
+
+template <typename T>
+inline
+typename ObjectPool<T>::Slot* ObjectPool<T>::slotOf( T* object )
+{
+    return reinterpret_cast<Slot*>( object );
+}
+
+template <typename T>
+inline
+T* ObjectPool<T>::objectOf( Slot* slot )
+{
+    return reinterpret_cast<T*>( &slot->storage );
+}
+
+template <typename T>
+void ObjectPool<T>::grow()
+{
+    Chunk* chunk;
+    Slot* first;
+    uint32 i;
+
+    chunk = static_cast<Chunk*>( MemoryUtils::allocateAligned(
+        slotOffset() + sizeof( Slot ) * _chunkSize,
+        alignof( Slot ) > alignof( Chunk ) ? alignof( Slot )
+                                           : alignof( Chunk ) ) );
+    chunk->next = _chunks;
+    _chunks = chunk;
+    ++_chunkCount;
+
+    // push in reverse so that slots are taken in address order
+    first = slots( chunk );
+    for ( i = _chunkSize; i > 0; --i )
+    {
+        first[i - 1].state = FREE;
+        first[i - 1].next = _free;
+        _free = &first[i - 1];
+    }
+}
+
+template <typename T>
+typename ObjectPool<T>::Slot* ObjectPool<T>::nextFree()
+{
+    Slot* slot;
+
+    if ( _free == nullptr && _idle != nullptr )
+    {
+        slot = _idle;
+        _idle = slot->next;
+        --_idleCount;
+
+        objectOf( slot )->~T();
+        slot->state = FREE;
+        slot->next = nullptr;
+        _free = slot;
+    }
+    else if ( _free == nullptr )
+    {
+        grow();
+    }
+
+    return _free;
+}
+
+// CONSTRUCTORS
+template <typename T>
+inline
+ObjectPool<T>::ObjectPool() : ObjectPool( DEFAULT_CHUNK_SIZE )
+{
+}
+
+template <typename T>
+inline
+ObjectPool<T>::ObjectPool( uint32 chunkSize )
+    : _chunks( nullptr ), _free( nullptr ), _idle( nullptr ), _resetter(),
+      _chunkSize( chunkSize ), _chunkCount( 0 ), _size( 0 ), _idleCount( 0 )
+{
+    assert( chunkSize > 0 );
+}
+
+template <typename T>
+ObjectPool<T>::~ObjectPool()
+{
+    Chunk* chunk;
+
+    clear();
+
+    while ( _chunks != nullptr )
+    {
+        chunk = _chunks;
+        _chunks = chunk->next;
+        MemoryUtils::deallocateAligned( chunk );
+    }
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::create( Args&&... args )
+{
+    Slot* slot = nextFree();
+
+    // construct before unlinking so that the slot stays on the free list
+    // if the constructor throws
+    new ( &slot->storage ) T( std::forward<Args>( args )... );
+    _free = slot->next;
+    slot->state = LIVE;
+    ++_size;
+
+    return objectOf( slot );
+}
+
+template <typename T>
+void ObjectPool<T>::destroy( T* object )
+{
+    Slot* slot = slotOf( object );
+
+    assert( object != nullptr );
+    assert( slot->state == LIVE );
+
+    object->~T();
+    slot->state = FREE;
+    slot->next = _free;
+    _free = slot;
+    --_size;
+}
+
+template <typename T>
+T* ObjectPool<T>::acquire()
+{
+    Slot* slot;
+
+    if ( _idle == nullptr )
+    {
+        return create();
+    }
+
+    slot = _idle;
+    _idle = slot->next;
+    slot->state = LIVE;
+    --_idleCount;
+    ++_size;
+
+    return objectOf( slot );
+}
+
+template <typename T>
+void ObjectPool<T>::recycle( T* object )
+{
+    Slot* slot = slotOf( object );
+
+    assert( object != nullptr );
+    assert( slot->state == LIVE );
+
+    if ( _resetter )
+    {
+        _resetter( *object );
+    }
+
+    slot->state = IDLE;
+    slot->next = _idle;
+    _idle = slot;
+    --_size;
+    ++_idleCount;
+}
+
+template <typename T>
+void ObjectPool<T>::trim()
+{
+    Chunk** link;
+    Chunk* chunk;
+    Slot* slot;
+    Slot* first;
+    uint32 live;
+    uint32 i;
+
+    while ( _idle != nullptr )
+    {
+        slot = _idle;
+        _idle = slot->next;
+
+        objectOf( slot )->~T();
+        slot->state = FREE;
+    }
+
+    _idleCount = 0;
+
+    // the free list may point into released chunks so it is rebuilt from
+    // the chunks that are kept
+    _free = nullptr;
+    link = &_chunks;
+    while ( *link != nullptr )
+    {
+        chunk = *link;
+        first = slots( chunk );
+
+        live = 0;
+        for ( i = 0; i < _chunkSize; ++i )
+        {
+            live += first[i].state == LIVE ? 1 : 0;
+        }
+
+        if ( live == 0 )
+        {
+            *link = chunk->next;
+            --_chunkCount;
+            MemoryUtils::deallocateAligned( chunk );
+            continue;
+        }
+
+        for ( i = _chunkSize; i > 0; --i )
+        {
+            if ( first[i - 1].state == FREE )
+            {
+                first[i - 1].next = _free;
+                _free = &first[i - 1];
+            }
+        }
+
+        link = &chunk->next;
+    }
+}
+
+template <typename T>
+void ObjectPool<T>::clear()
+{
+    Chunk* chunk;
+    Slot* first;
+    uint32 i;
+
+    // rebuild the free list from scratch so slots are taken in order again
+    _free = nullptr;
+    _idle = nullptr;
+    for ( chunk = _chunks; chunk != nullptr; chunk = chunk->next )
+    {
+        first = slots( chunk );
+        for ( i = _chunkSize; i > 0; --i )
+        {
+            if ( first[i - 1].state != FREE )
+            {
+                objectOf( &first[i - 1] )->~T();
+                first[i - 1].state = FREE;
+            }
+
+            first[i - 1].next = _free;
+            _free = &first[i - 1];
+        }
+    }
+
+    _size = 0;
+    _idleCount = 0;
+}
+
+template <typename T>
+void ObjectPool<T>::reserve( uint32 capacity )
+{
+    while ( this->capacity() < capacity )
+    {
+        grow();
+    }
+}
+
+template <typename T>
+template <typename F>
+void ObjectPool<T>::forEach( F func )
+{
+    Chunk* chunk;
+    Slot* first;
+    uint32 i;
+
+    for ( chunk = _chunks; chunk != nullptr; chunk = chunk->next )
+    {
+        first = slots( chunk );
+        for ( i = 0; i < _chunkSize; ++i )
+        {
+            if ( first[i].state == LIVE )
+            {
+                func( *objectOf( &first[i] ) );
+            }
+        }
+    }
+}
+
+template <typename T>
+inline
+void ObjectPool<T>::setResetter( const Resetter& resetter )
+{
+    _resetter = resetter;
+}
+
+template <typename T>
+inline
+uint32 ObjectPool<T>::size() const
+{
+    return _size;
+}
+
+template <typename T>
+inline
+uint32 ObjectPool<T>::idleCount() const
+{
+    return _idleCount;
+}
+
+template <typename T>
+inline
+uint32 ObjectPool<T>::capacity() const
+{
+    return _chunkSize * _chunkCount;
+}
+
+template <typename T>
+inline
+uint32 ObjectPool<T>::chunkSize() const
+{
+    return _chunkSize;
+}
+
+template <typename T>
+inline
+uint32 ObjectPool<T>::chunkCount() const
+{
+    return _chunkCount;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_OBJECT_POOL_H
@@ -0,0 +1,864 @@
+// pool_allocator.h
+//
+// The pool allocator hands out fixed size chunks of instances that are cut
+// from larger slabs. Free chunks are kept in an intrusive list that is
+// threaded through the chunks themselves, so getting and releasing a chunk
+// is a couple of pointer writes and memory is never returned to the heap
+// until the pool is destructed.
+//
+// Each chunk holds the chunk size number of instances, one by default.
+// Requests for more instances than that are passed to the heap, so the pool
+// suits node based containers and object pools that allocate one instance
+// at a time rather than growing arrays.
+//
+// A pool is not thread safe by default. Enabling the thread cache guards
+// the shared free list with a mutex and gives each thread a small front
+// cache of chunks that it can get and release without locking. Caches are
+// picked by the thread index, so when a thread exits its chunks go back to
+// the shared free list and its cache is reused by new threads.
+//
+#ifndef NGE_MEM_POOL_ALLOCATOR_H
+#define NGE_MEM_POOL_ALLOCATOR_H
+
+#include <assert.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "engine/intdef.h"
+#include "engine/memory/aligned_allocator.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/ithread_cache.h"
+#include "engine/memory/memory_utils.h"
+#include "engine/memory/thread_index.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class PoolAllocator : public IAllocator<T>, private IThreadCache
+{
+  private:
+    // STRUCTURES
+    /**
+     * Defines a free chunk.
+     */
+    struct Chunk
+    {
+        Chunk* next;
+    };
+
+    /**
+     * Defines the header at the start of every slab.
+     */
+    struct Slab
+    {
+        Slab* next;
+    };
+
+    // CONSTANTS
+    /**
+     * The number of chunks that each thread cache can hold.
+     */
+    static constexpr uint32 CACHE_SIZE = 16;
+
+    /**
+     * The number of threads that can have a cache at once.
+     *
+     * Other threads always use the shared free list.
+     */
+    static constexpr uint32 MAX_THREADS = ThreadIndex::MAX_THREADS;
+
+    /**
+     * The default number of chunks in each slab.
+     */
+    static constexpr uint32 DEFAULT_SLAB_SIZE = 256;
+
+    /**
+     * The number of slabs that fragmentation sorts at a time.
+     */
+    static constexpr uint32 FRAGMENTATION_BATCH = 64;
+
+    /**
+     * The alignment of every chunk.
+     */
+    static constexpr uint32 CHUNK_ALIGN = alignof( T ) > alignof( Chunk ) ?
+                                          alignof( T ) : alignof( Chunk );
+
+    /**
+     * Defines the cache of free chunks for one thread.
+     *
+     * Each cache starts on its own cache line so that the caches of
+     * different threads never share one. Only the owning thread writes its
+     * cache; the fields are atomic so that the statistics functions can
+     * read them from other threads.
+     */
+    struct alignas( MemoryUtils::CACHE_LINE_SIZE ) Cache
+    {
+        std::atomic<Chunk*> chunks[CACHE_SIZE];
+        std::atomic<uint32> count;
+    };
+
+    // MEMBERS
+    /**
+     * The shared list of free chunks.
+     */
+    Chunk* _free;
+
+    /**
+     * The slabs.
+     */
+    Slab* _slabs;
+
+    /**
+     * The thread caches or null if they are disabled.
+     */
+    Cache* _caches;
+
+    /**
+     * The mutex that guards the shared free list when the thread caches
+     * are enabled.
+     */
+    mutable std::mutex _mutex;
+
+    /**
+     * The number of instances in each chunk.
+     */
+    uint32 _chunkSize;
+
+    /**
+     * The number of bytes in each chunk.
+     */
+    uint32 _chunkBytes;
+
+    /**
+     * The number of chunks in each slab.
+     */
+    uint32 _slabSize;
+
+    /**
+     * The number of slabs.
+     */
+    uint32 _slabCount;
+
+    /**
+     * The number of chunks that are not in the shared free list.
+     *
+     * This includes the chunks in the thread caches.
+     */
+    uint32 _taken;
+
+    /**
+     * The number of allocations that were passed to the heap.
+     */
+    std::atomic<uint32> _oversized;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the cache of the calling thread or null if it does not have one.
+     */
+    Cache* threadCache();
+
+    /**
+     * Gets the number of bytes at the start of a slab used by its header.
+     */
+    uint32 headerBytes() const;
+
+    /**
+     * Adds a slab and puts its chunks in the shared free list.
+     */
+    void grow();
+
+    /**
+     * Adds the free chunk to the count of its slab if the slab is in the
+     * given batch.
+     *
+     * The starts of the slabs in the batch must be sorted by address.
+     */
+    void countFree( const Chunk* chunk,
+                    const uint8* const* starts,
+                    uint32* freeCounts,
+                    uint32 count ) const;
+
+    /**
+     * Gets the number of chunks that are in use.
+     *
+     * The caller must hold the pool mutex.
+     */
+    uint32 used() const;
+
+    /**
+     * Takes a chunk from the shared free list.
+     */
+    Chunk* take();
+
+    /**
+     * Puts a chunk back in the shared free list.
+     */
+    void give( Chunk* chunk );
+
+    /**
+     * Gets a free chunk.
+     */
+    Chunk* pop();
+
+    /**
+     * Frees a chunk.
+     */
+    void push( Chunk* chunk );
+
+    /**
+     * Puts every chunk in the cache of the thread index back in the shared
+     * free list.
+     */
+    virtual void releaseThread( uint32 index );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a pool with single instance chunks and the default slab
+     * size.
+     */
+    PoolAllocator();
+
+    /**
+     * Constructs a pool with single instance chunks and the given number of
+     * chunks per slab.
+     *
+     * Behavior is undefined when:
+     * - slabSize is zero
+     */
+    PoolAllocator( uint32 slabSize );
+
+    /**
+     * Constructs a pool with the given number of chunks per slab and
+     * instances per chunk.
+     *
+     * Behavior is undefined when:
+     * - slabSize is zero
+     * - chunkSize is zero
+     */
+    PoolAllocator( uint32 slabSize, uint32 chunkSize );
+
+    /**
+     * Pools cannot be copied.
+     */
+    PoolAllocator( const PoolAllocator<T>& pool ) = delete;
+
+    /**
+     * Destructs the pool and frees all of its slabs.
+     *
+     * Instances that were not released are not destructed.
+     */
+    virtual ~PoolAllocator();
+
+    // OPERATORS
+    /**
+     * Pools cannot be copied.
+     */
+    PoolAllocator<T>& operator=( const PoolAllocator<T>& pool ) = delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Enables the thread caches and makes the pool thread safe.
+     *
+     * Behavior is undefined when:
+     * - the pool is in use by another thread
+     */
+    void enableThreadCache();
+
+    /**
+     * Checks if the thread caches are enabled.
+     */
+    bool isThreadCached() const;
+
+    // STATISTICS FUNCTIONS
+    /**
+     * Gets the number of chunks that are in use.
+     *
+     * The statistics functions take the pool mutex, so the result is a
+     * snapshot when other threads are using the pool.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of chunks in all slabs.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the number of instances in each chunk.
+     */
+    uint32 chunkSize() const;
+
+    /**
+     * Gets the number of chunks in each slab.
+     */
+    uint32 slabSize() const;
+
+    /**
+     * Gets the number of slabs.
+     */
+    uint32 slabCount() const;
+
+    /**
+     * Gets the number of allocations that were too large for a chunk.
+     */
+    uint32 oversizedCount() const;
+
+    /**
+     * Gets the fraction of the chunks that are in use.
+     */
+    float occupancy() const;
+
+    /**
+     * Gets the fraction of the free chunks that are in slabs that also hold
+     * chunks in use.
+     *
+     * Those chunks keep memory reserved that could not be returned even if
+     * slabs were freed. This walks every free chunk.
+     */
+    float fragmentation() const;
+};
+
+template <typename T>
+constexpr uint32 PoolAllocator<T>::CACHE_SIZE;
+
+template <typename T>
+constexpr uint32 PoolAllocator<T>::MAX_THREADS;
+
+template <typename T>
+constexpr uint32 PoolAllocator<T>::DEFAULT_SLAB_SIZE;
+
+template <typename T>
+constexpr uint32 PoolAllocator<T>::CHUNK_ALIGN;
+
+template <typename T>
+constexpr uint32 PoolAllocator<T>::FRAGMENTATION_BATCH;
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+typename PoolAllocator<T>::Cache* PoolAllocator<T>::threadCache()
+{
+    uint32 index;
+
+    if ( _caches == nullptr )
+    {
+        return nullptr;
+    }
+
+    index = ThreadIndex::current();
+    return index < MAX_THREADS ? _caches + index : nullptr;
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::headerBytes() const
+{
+    return ( sizeof( Slab ) + CHUNK_ALIGN - 1 ) / CHUNK_ALIGN * CHUNK_ALIGN;
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::grow()
+{
+    uint8* memory;
+    Slab* slab;
+    Chunk* chunk;
+    uint32 i;
+
+    // operator new only guarantees the fundamental alignment
+    memory = static_cast<uint8*>( MemoryUtils::allocateAligned(
+        headerBytes() + _chunkBytes * _slabSize, CHUNK_ALIGN ) );
+
+    slab = reinterpret_cast<Slab*>( memory );
+    slab->next = _slabs;
+    _slabs = slab;
+    ++_slabCount;
+
+    // link the chunks so they are handed out in address order
+    memory += headerBytes();
+    for ( i = _slabSize; i > 0; --i )
+    {
+        chunk = reinterpret_cast<Chunk*>( memory + _chunkBytes * ( i - 1 ) );
+        chunk->next = _free;
+        _free = chunk;
+    }
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::countFree( const Chunk* chunk,
+                                  const uint8* const* starts,
+                                  uint32* freeCounts,
+                                  uint32 count ) const
+{
+    const uint8* address = reinterpret_cast<const uint8*>( chunk );
+    uint32 low = 0;
+    uint32 high = count;
+    uint32 middle;
+
+    // find the last slab that starts at or before the chunk
+    while ( low < high )
+    {
+        middle = ( low + high ) / 2;
+        if ( starts[middle] <= address )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if ( low > 0 &&
+         address < starts[low - 1] + headerBytes() + _chunkBytes * _slabSize )
+    {
+        ++freeCounts[low - 1];
+    }
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::used() const
+{
+    uint32 size = _taken;
+    uint32 i;
+
+    if ( _caches != nullptr )
+    {
+        for ( i = 0; i < MAX_THREADS; ++i )
+        {
+            size -= _caches[i].count.load( std::memory_order_relaxed );
+        }
+    }
+
+    return size;
+}
+
+template <typename T>
+inline
+typename PoolAllocator<T>::Chunk* PoolAllocator<T>::take()
+{
+    Chunk* chunk;
+
+    if ( _free == nullptr )
+    {
+        grow();
+    }
+
+    chunk = _free;
+    _free = chunk->next;
+    ++_taken;
+
+    return chunk;
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::give( Chunk* chunk )
+{
+    chunk->next = _free;
+    _free = chunk;
+    --_taken;
+}
+
+template <typename T>
+inline
+typename PoolAllocator<T>::Chunk* PoolAllocator<T>::pop()
+{
+    Cache* cache = threadCache();
+    uint32 count;
+
+    if ( cache == nullptr )
+    {
+        if ( _caches == nullptr )
+        {
+            return take();
+        }
+
+        std::lock_guard<std::mutex> lock( _mutex );
+        return take();
+    }
+
+    count = cache->count.load( std::memory_order_relaxed );
+    if ( count == 0 )
+    {
+        // refill half of the cache at once to amortize the lock
+        std::lock_guard<std::mutex> lock( _mutex );
+        while ( count < CACHE_SIZE / 2 )
+        {
+            cache->chunks[count++].store( take(), std::memory_order_relaxed );
+        }
+        cache->count.store( count, std::memory_order_relaxed );
+    }
+
+    cache->count.store( --count, std::memory_order_relaxed );
+    return cache->chunks[count].load( std::memory_order_relaxed );
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::push( Chunk* chunk )
+{
+    Cache* cache = threadCache();
+    uint32 count;
+
+    if ( cache == nullptr )
+    {
+        if ( _caches == nullptr )
+        {
+            give( chunk );
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock( _mutex );
+        give( chunk );
+        return;
+    }
+
+    count = cache->count.load( std::memory_order_relaxed );
+    if ( count == CACHE_SIZE )
+    {
+        // return half of the cache so that the next get does not refill
+        std::lock_guard<std::mutex> lock( _mutex );
+        while ( count > CACHE_SIZE / 2 )
+        {
+            give( cache->chunks[--count].load( std::memory_order_relaxed ) );
+        }
+        cache->count.store( count, std::memory_order_relaxed );
+    }
+
+    cache->chunks[count].store( chunk, std::memory_order_relaxed );
+    cache->count.store( count + 1, std::memory_order_relaxed );
+}
+
+template <typename T>
+void PoolAllocator<T>::releaseThread( uint32 index )
+{
+    Cache& cache = _caches[index];
+
+    assert( index < MAX_THREADS );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    while ( cache.count.load( std::memory_order_relaxed ) > 0 )
+    {
+        give( cache.chunks[--cache.count].load( std::memory_order_relaxed ) );
+    }
+}
+
+// CONSTRUCTORS
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator() : PoolAllocator( DEFAULT_SLAB_SIZE, 1 )
+{
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator( uint32 slabSize )
+    : PoolAllocator( slabSize, 1 )
+{
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator( uint32 slabSize, uint32 chunkSize )
+    : _free( nullptr ), _slabs( nullptr ), _caches( nullptr ), _mutex(),
+      _chunkSize( chunkSize ), _chunkBytes( 0 ), _slabSize( slabSize ),
+      _slabCount( 0 ), _taken( 0 ), _oversized( 0 )
+{
+    assert( slabSize > 0 );
+    assert( chunkSize > 0 );
+
+    _chunkBytes = sizeof( T ) * chunkSize;
+    if ( _chunkBytes < sizeof( Chunk ) )
+    {
+        _chunkBytes = sizeof( Chunk );
+    }
+
+    _chunkBytes = ( _chunkBytes + CHUNK_ALIGN - 1 ) / CHUNK_ALIGN *
+                  CHUNK_ALIGN;
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::~PoolAllocator()
+{
+    Slab* slab;
+
+    if ( _caches != nullptr )
+    {
+        ThreadIndex::removeCache( this );
+    }
+
+    while ( _slabs != nullptr )
+    {
+        slab = _slabs;
+        _slabs = slab->next;
+        MemoryUtils::deallocateAligned( slab );
+    }
+
+    if ( _caches != nullptr )
+    {
+        AlignedAllocator<Cache, MemoryUtils::CACHE_LINE_SIZE>().release(
+            _caches, MAX_THREADS );
+    }
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* PoolAllocator<T>::get( uint32 count )
+{
+    T* values;
+    uint32 i;
+
+    assert( count > 0 );
+
+    if ( count > _chunkSize )
+    {
+        // keep the chunk alignment so that over aligned types stay aligned
+        values = static_cast<T*>( MemoryUtils::allocateAligned(
+            static_cast<uint64>( sizeof( T ) ) * count, CHUNK_ALIGN ) );
+        ++_oversized;
+    }
+    else
+    {
+        values = reinterpret_cast<T*>( pop() );
+    }
+
+    for ( i = 0; i < count; ++i )
+    {
+        new ( values + i ) T();
+    }
+
+    return values;
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::release( T* pointer, uint32 count )
+{
+    uint32 i;
+
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    for ( i = 0; i < count; ++i )
+    {
+        pointer[i].~T();
+    }
+
+    if ( count > _chunkSize )
+    {
+        MemoryUtils::deallocateAligned( pointer );
+    }
+    else
+    {
+        push( reinterpret_cast<Chunk*>( pointer ) );
+    }
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::enableThreadCache()
+{
+    uint32 i;
+
+    if ( _caches != nullptr )
+    {
+        return;
+    }
+
+    _caches = AlignedAllocator<Cache, MemoryUtils::CACHE_LINE_SIZE>().get(
+        MAX_THREADS );
+    for ( i = 0; i < MAX_THREADS; ++i )
+    {
+        _caches[i].count = 0;
+    }
+
+    ThreadIndex::addCache( this );
+}
+
+template <typename T>
+inline
+bool PoolAllocator<T>::isThreadCached() const
+{
+    return _caches != nullptr;
+}
+
+// STATISTICS FUNCTIONS
+template <typename T>
+inline
+uint32 PoolAllocator<T>::size() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return used();
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::capacity() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _slabCount * _slabSize;
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::chunkSize() const
+{
+    return _chunkSize;
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::slabSize() const
+{
+    return _slabSize;
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::slabCount() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _slabCount;
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::oversizedCount() const
+{
+    return _oversized;
+}
+
+template <typename T>
+inline
+float PoolAllocator<T>::occupancy() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    if ( _slabCount == 0 )
+    {
+        return 0.0f;
+    }
+
+    // read both counts under one lock so that they agree
+    return static_cast<float>( used() ) / ( _slabCount * _slabSize );
+}
+
+template <typename T>
+inline
+float PoolAllocator<T>::fragmentation() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    const uint8* starts[FRAGMENTATION_BATCH];
+    uint32 freeCounts[FRAGMENTATION_BATCH];
+    const Slab* slab;
+    const Chunk* chunk;
+    const uint8* start;
+    uint32 total;
+    uint32 stranded;
+    uint32 count;
+    uint32 i;
+    uint32 j;
+
+    total = _slabCount * _slabSize - _taken;
+    if ( _caches != nullptr )
+    {
+        for ( i = 0; i < MAX_THREADS; ++i )
+        {
+            total += _caches[i].count.load( std::memory_order_relaxed );
+        }
+    }
+
+    stranded = 0;
+    slab = _slabs;
+
+    // count the free chunks of a batch of slabs at a time so that the walk
+    // needs no memory of its own
+    while ( slab != nullptr )
+    {
+        for ( count = 0;
+              slab != nullptr && count < FRAGMENTATION_BATCH;
+              slab = slab->next, ++count )
+        {
+            // insertion sort the batch by address
+            start = reinterpret_cast<const uint8*>( slab );
+            for ( i = count; i > 0 && starts[i - 1] > start; --i )
+            {
+                starts[i] = starts[i - 1];
+            }
+            starts[i] = start;
+            freeCounts[count] = 0;
+        }
+
+        for ( chunk = _free; chunk != nullptr; chunk = chunk->next )
+        {
+            countFree( chunk, starts, freeCounts, count );
+        }
+
+        if ( _caches != nullptr )
+        {
+            for ( i = 0; i < MAX_THREADS; ++i )
+            {
+                for ( j = _caches[i].count.load( std::memory_order_relaxed );
+                      j > 0;
+                      --j )
+                {
+                    chunk = _caches[i].chunks[j - 1].load(
+                        std::memory_order_relaxed );
+                    countFree( chunk, starts, freeCounts, count );
+                }
+            }
+        }
+
+        for ( i = 0; i < count; ++i )
+        {
+            if ( freeCounts[i] < _slabSize )
+            {
+                stranded += freeCounts[i];
+            }
+        }
+    }
+
+    if ( total == 0 )
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>( stranded ) / total;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_POOL_ALLOCATOR_H
@@ -0,0 +1,235 @@
+// profiling_allocator.h
+//
+// The profiling allocator wraps another allocator and records every
+// allocation it makes in an allocation profiler, along with the backtrace
+// of the code that asked for it.
+//
+// Allocations are matched to their release by address. Allocators that
+// reuse memory without releasing it, like the arena allocator, have their
+// allocations reported as leaks.
+//
+#ifndef NGE_MEM_PROFILING_ALLOCATOR_H
+#define NGE_MEM_PROFILING_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocation_profiler.h"
+#include "engine/memory/allocator_guard.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class ProfilingAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The underlying allocator.
+     */
+    AllocatorGuard<T> _allocator;
+
+    /**
+     * The profiler that allocations are recorded in.
+     */
+    AllocationProfiler* _profiler;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a profiling allocator that uses the default allocator.
+     *
+     * Behavior is undefined when:
+     * - profiler is null
+     */
+    explicit ProfilingAllocator( AllocationProfiler* profiler );
+
+    /**
+     * Constructs a profiling allocator that performs allocation using the
+     * given allocator.
+     *
+     * Behavior is undefined when:
+     * - profiler is null
+     * - alloc is null
+     */
+    ProfilingAllocator( AllocationProfiler* profiler, IAllocator<T>* alloc );
+
+    /**
+     * Constructs a copy of a profiling allocator.
+     *
+     * The copy records in the same profiler.
+     */
+    ProfilingAllocator( const ProfilingAllocator<T>& alloc );
+
+    /**
+     * Destructs the profiling allocator.
+     */
+    virtual ~ProfilingAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the allocator.
+     */
+    ProfilingAllocator<T>& operator=( const ProfilingAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Returns null without recording when the wrapped allocator does.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets the alignment of the underlying allocator.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Tries to grow the allocation in place using the underlying allocator.
+     *
+     * The added bytes are profiled when the allocation grows.
+     *
+     * Behavior is undefined when:
+     * pointer is invalid
+     * newCount is less than or equal to count
+     */
+    virtual bool grow( T* pointer, uint32 count, uint32 newCount );
+
+    /**
+     * Gets the profiler that allocations are recorded in.
+     */
+    AllocationProfiler* profiler() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+ProfilingAllocator<T>::ProfilingAllocator( AllocationProfiler* profiler )
+    : _allocator(), _profiler( profiler )
+{
+    assert( profiler != nullptr );
+}
+
+template <typename T>
+inline
+ProfilingAllocator<T>::ProfilingAllocator( AllocationProfiler* profiler,
+                                           IAllocator<T>* alloc )
+    : _allocator( alloc ), _profiler( profiler )
+{
+    assert( profiler != nullptr );
+    assert( alloc != nullptr );
+}
+
+template <typename T>
+inline
+ProfilingAllocator<T>::ProfilingAllocator(
+    const ProfilingAllocator<T>& alloc )
+    : _allocator( alloc._allocator ), _profiler( alloc._profiler )
+{
+}
+
+template <typename T>
+inline
+ProfilingAllocator<T>::~ProfilingAllocator()
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+ProfilingAllocator<T>& ProfilingAllocator<T>::operator=(
+    const ProfilingAllocator<T>& alloc )
+{
+    _allocator = alloc._allocator;
+    _profiler = alloc._profiler;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* ProfilingAllocator<T>::get( uint32 count )
+{
+    T* values;
+
+    assert( count > 0 );
+
+    values = _allocator.get( count );
+    if ( values != nullptr )
+    {
+        _profiler->recordGet( values,
+                              static_cast<uint64>( sizeof( T ) ) * count );
+    }
+
+    return values;
+}
+
+template <typename T>
+inline
+void ProfilingAllocator<T>::release( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    _profiler->recordRelease( pointer );
+    _allocator.release( pointer, count );
+}
+
+template <typename T>
+inline
+uint32 ProfilingAllocator<T>::alignment() const
+{
+    return _allocator.alignment();
+}
+
+template <typename T>
+inline
+bool ProfilingAllocator<T>::grow( T* pointer, uint32 count, uint32 newCount )
+{
+    assert( pointer != nullptr );
+    assert( newCount > count );
+
+    if ( !_allocator.grow( pointer, count, newCount ) )
+    {
+        return false;
+    }
+
+    _profiler->recordGrow( pointer, static_cast<uint64>( sizeof( T ) ) *
+                                       ( newCount - count ) );
+
+    return true;
+}
+
+template <typename T>
+inline
+AllocationProfiler* ProfilingAllocator<T>::profiler() const
+{
+    return _profiler;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_PROFILING_ALLOCATOR_H
@@ -0,0 +1,206 @@
+// resource_allocator.h
+//
+// The resource allocator adapts an untyped memory resource to the typed
+// allocator interface so that containers of any type can share the same
+// resource.
+//
+// Instances are default constructed when they are allocated and destructed
+// when they are released like the default allocator does. The allocator
+// does not own the resource.
+//
+#ifndef NGE_MEM_RESOURCE_ALLOCATOR_H
+#define NGE_MEM_RESOURCE_ALLOCATOR_H
+
+#include <assert.h>
+#include <new>
+
+#include "engine/intdef.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/imemory_resource.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class ResourceAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The underlying resource.
+     */
+    IMemoryResource* _resource;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an allocator that uses the given resource.
+     *
+     * Behavior is undefined when:
+     * - resource is null
+     */
+    ResourceAllocator( IMemoryResource* resource );
+
+    /**
+     * Constructs an allocator that uses the same resource as the given one.
+     */
+    ResourceAllocator( const ResourceAllocator<T>& alloc );
+
+    /**
+     * Constructs an allocator for T that uses the same resource as an
+     * allocator of another type.
+     */
+    template <typename U>
+    ResourceAllocator( const ResourceAllocator<U>& alloc );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~ResourceAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this to use the same resource as the given allocator.
+     */
+    ResourceAllocator<T>& operator=( const ResourceAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Returns nullptr without constructing anything when the resource
+     * returns nullptr, which a resource with a fixed size does when it is
+     * out of space.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets the alignment of T since resources honor any alignment.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Gets the underlying resource.
+     */
+    IMemoryResource* resource() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+ResourceAllocator<T>::ResourceAllocator( IMemoryResource* resource )
+    : _resource( resource )
+{
+    assert( resource != nullptr );
+}
+
+template <typename T>
+inline
+ResourceAllocator<T>::ResourceAllocator( const ResourceAllocator<T>& alloc )
+    : _resource( alloc._resource )
+{
+}
+
+template <typename T>
+template <typename U>
+inline
+ResourceAllocator<T>::ResourceAllocator( const ResourceAllocator<U>& alloc )
+    : _resource( alloc.resource() )
+{
+}
+
+template <typename T>
+inline
+ResourceAllocator<T>::~ResourceAllocator()
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+ResourceAllocator<T>& ResourceAllocator<T>::operator=(
+    const ResourceAllocator<T>& alloc )
+{
+    _resource = alloc._resource;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* ResourceAllocator<T>::get( uint32 count )
+{
+    T* values;
+    uint32 i;
+
+    assert( count > 0 );
+
+    values = static_cast<T*>(
+        _resource->allocate( sizeof( T ) * count, alignof( T ) ) );
+    if ( values == nullptr )
+    {
+        return nullptr;
+    }
+
+    for ( i = 0; i < count; ++i )
+    {
+        new ( values + i ) T();
+    }
+
+    return values;
+}
+
+template <typename T>
+inline
+void ResourceAllocator<T>::release( T* pointer, uint32 count )
+{
+    uint32 i;
+
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    for ( i = 0; i < count; ++i )
+    {
+        pointer[i].~T();
+    }
+
+    _resource->deallocate( pointer, sizeof( T ) * count, alignof( T ) );
+}
+
+template <typename T>
+inline
+uint32 ResourceAllocator<T>::alignment() const
+{
+    return alignof( T );
+}
+
+template <typename T>
+inline
+IMemoryResource* ResourceAllocator<T>::resource() const
+{
+    return _resource;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_RESOURCE_ALLOCATOR_H
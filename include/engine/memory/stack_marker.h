@@ -0,0 +1,194 @@
+// stack_marker.h
+//
+// A stack marker marks one end of a double stack resource when it is
+// constructed and rolls that end back when it is destructed, so everything
+// allocated from the end inside the scope of the marker is freed at once.
+//
+// Markers on the same end must be destructed in the reverse order that
+// they were constructed, which is always the case for markers on the call
+// stack.
+//
+#ifndef NGE_MEM_STACK_MARKER_H
+#define NGE_MEM_STACK_MARKER_H
+
+#include <assert.h>
+
+#include "engine/memory/double_stack_resource.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class StackMarker
+{
+  private:
+    /**
+     * The stack that is rolled back.
+     */
+    DoubleStackResource* _stack;
+
+    /**
+     * The position that the stack is rolled back to.
+     */
+    DoubleStackResource::Marker _marker;
+
+    /**
+     * Constructs a copy of the given marker.
+     *
+     * This is not a supported operation for stack markers.
+     */
+    StackMarker( const StackMarker& marker ) = delete;
+
+    /**
+     * Assigns this as a copy of the other marker.
+     *
+     * This is not a supported operation for stack markers.
+     */
+    StackMarker& operator=( const StackMarker& marker ) = delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an invalid stack marker.
+     */
+    StackMarker();
+
+    /**
+     * Constructs a stack marker for the current position of the given end
+     * of the stack.
+     */
+    StackMarker( DoubleStackResource* stack,
+                 DoubleStackResource::Side side );
+
+    /**
+     * Moves the marked position to this instance.
+     */
+    StackMarker( StackMarker&& marker );
+
+    /**
+     * Destructs the stack marker and rolls the stack back.
+     */
+    ~StackMarker();
+
+    // OPERATORS
+    /**
+     * Moves the stack marker to this instance.
+     *
+     * If this is already marking a stack, that stack is rolled back first,
+     * just as if this marker had been destructed.
+     */
+    StackMarker& operator=( StackMarker&& marker );
+
+    /**
+     * Checks if the marker is not marking a stack.
+     */
+    bool operator!() const;
+
+    /**
+     * Checks if the marker is marking a stack.
+     */
+    operator bool() const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Rolls the stack back to the marked position now.
+     *
+     * The marker still rolls the stack back again when it is destructed.
+     *
+     * Behavior is undefined when:
+     * There is no marked stack.
+     */
+    void rollback();
+
+    /**
+     * Gets the marked position.
+     */
+    const DoubleStackResource::Marker& marker() const;
+};
+
+// CONSTRUCTORS
+inline
+StackMarker::StackMarker()
+    : _stack( nullptr ), _marker{ DoubleStackResource::BOTTOM, 0 }
+{
+}
+
+inline
+StackMarker::StackMarker( DoubleStackResource* stack,
+                          DoubleStackResource::Side side )
+    : _stack( stack ), _marker( stack->mark( side ) )
+{
+}
+
+inline
+StackMarker::StackMarker( StackMarker&& marker )
+    : _stack( marker._stack ), _marker( marker._marker )
+{
+    marker._stack = nullptr;
+}
+
+inline
+StackMarker::~StackMarker()
+{
+    if ( _stack != nullptr )
+    {
+        _stack->rollback( _marker );
+        _stack = nullptr;
+    }
+}
+
+// OPERATORS
+inline
+StackMarker& StackMarker::operator=( StackMarker&& marker )
+{
+    if ( this == &marker )
+    {
+        return *this;
+    }
+
+    if ( _stack != nullptr )
+    {
+        _stack->rollback( _marker );
+    }
+
+    _stack = marker._stack;
+    _marker = marker._marker;
+
+    marker._stack = nullptr;
+
+    return *this;
+}
+
+inline
+bool StackMarker::operator!() const
+{
+    return _stack == nullptr;
+}
+
+inline
+StackMarker::operator bool() const
+{
+    return _stack != nullptr;
+}
+
+// MEMBER FUNCTIONS
+inline
+void StackMarker::rollback()
+{
+    assert( _stack != nullptr );
+    _stack->rollback( _marker );
+}
+
+inline
+const DoubleStackResource::Marker& StackMarker::marker() const
+{
+    return _marker;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_STACK_MARKER_H
@@ -0,0 +1,106 @@
+// static_allocator.h
+//
+// The static allocator is the default allocator policy of the containers.
+// Like the default allocator it is a simple wrapper for the new and delete
+// functions, but it does not implement the allocator interface. It has no
+// virtual functions and no members, so a container that uses it takes no
+// extra space for it and its allocations are inlined.
+//
+// Containers that need an allocator chosen at runtime use the allocator
+// guard as their policy instead.
+//
+// Usage:
+//     cntr::DynamicArray<uint32> fast;
+//     cntr::DynamicArray<uint32, mem::AllocatorGuard> custom( &alloc );
+//
+#ifndef NGE_MEM_STATIC_ALLOCATOR_H
+#define NGE_MEM_STATIC_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class StaticAllocator
+{
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs the allocator.
+     */
+    StaticAllocator();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    void release( T* pointer, uint32 count );
+
+    /**
+     * Does nothing since new cannot grow an allocation in place.
+     *
+     * Returns false.
+     */
+    bool grow( T* pointer, uint32 count, uint32 newCount );
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+StaticAllocator<T>::StaticAllocator()
+{
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* StaticAllocator<T>::get( uint32 count )
+{
+    assert( count > 0 );
+    return new T[count];
+}
+
+template <typename T>
+inline
+void StaticAllocator<T>::release( T* pointer, uint32 count )
+{
+    assert( count > 0 );
+    assert( pointer != nullptr );
+    delete[] pointer;
+}
+
+template <typename T>
+inline
+bool StaticAllocator<T>::grow( T* /* pointer */,
+                               uint32 /* count */,
+                               uint32 /* newCount */ )
+{
+    return false;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_STATIC_ALLOCATOR_H
@@ -0,0 +1,245 @@
+// thread_cache_resource.h
+//
+// The thread cache resource is a memory resource for programs that allocate
+// from many threads at once. Each thread keeps a cache of free blocks for
+// every size class and allocates from it without taking a lock. Only when a
+// cache runs dry or grows too large does the thread take the lock of the
+// shared pool of its size class, and then it moves a whole batch of blocks
+// at a time.
+//
+// Size classes are the powers of two from 16 bytes to 32 KiB. Blocks are
+// cut from 64 KiB slabs and are aligned to their size up to 4 KiB. Larger
+// requests go straight to the heap.
+//
+// A block may be deallocated by any thread, not only the one that
+// allocated it. The block goes into the cache of the deallocating thread
+// and returns to the shared pool with the next batch. Slabs are only
+// returned to the heap when the resource is destructed.
+//
+// Up to MAX_THREADS threads can have caches at once. When a thread exits
+// its cache is returned to the shared pools and its index is reused by new
+// threads. Any further threads allocate from the shared pools directly.
+//
+// Usage:
+//     ThreadCacheResource threadCache;
+//     ResourceAllocator<Particle> alloc( &threadCache );
+//
+//     // any thread
+//     DynamicArray<Particle, AllocatorGuard> particles( &alloc );
+//
+#ifndef NGE_MEM_THREAD_CACHE_RESOURCE_H
+#define NGE_MEM_THREAD_CACHE_RESOURCE_H
+
+#include <assert.h>
+#include <mutex>
+#include <vector>
+
+#include "engine/intdef.h"
+#include "engine/memory/imemory_resource.h"
+#include "engine/memory/ithread_cache.h"
+#include "engine/memory/memory_utils.h"
+#include "engine/memory/thread_index.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class ThreadCacheResource : public IMemoryResource, private IThreadCache
+{
+  public:
+    // CONSTANTS
+    /**
+     * The number of size classes.
+     */
+    static constexpr uint32 SIZE_CLASSES = 12;
+
+    /**
+     * The largest block size that is cached.
+     */
+    static constexpr uint32 MAX_CACHED_SIZE = 16 << ( SIZE_CLASSES - 1 );
+
+    /**
+     * The number of bytes in each slab.
+     */
+    static constexpr uint32 SLAB_SIZE = 64 * 1024;
+
+    /**
+     * The alignment of each slab and so the largest alignment of a block.
+     */
+    static constexpr uint32 SLAB_ALIGNMENT = 4096;
+
+    /**
+     * The number of threads that can have a cache at once.
+     */
+    static constexpr uint32 MAX_THREADS = ThreadIndex::MAX_THREADS;
+
+  private:
+    // STRUCTURES
+    /**
+     * Defines a free block.
+     */
+    struct Block
+    {
+        Block* next;
+    };
+
+    /**
+     * Defines the free blocks of one thread.
+     *
+     * Each cache starts on its own cache line so that the caches of
+     * different threads never share one.
+     */
+    struct alignas( MemoryUtils::CACHE_LINE_SIZE ) Cache
+    {
+        Block* blocks[SIZE_CLASSES];
+        uint32 counts[SIZE_CLASSES];
+    };
+
+    /**
+     * Defines the shared pool of one size class.
+     */
+    struct alignas( MemoryUtils::CACHE_LINE_SIZE ) Pool
+    {
+        std::mutex mutex;
+        Block* blocks;
+        uint32 count;
+        std::vector<void*> slabs;
+    };
+
+    // MEMBERS
+    /**
+     * The cache of each thread index.
+     */
+    Cache* _caches;
+
+    /**
+     * The shared pool of each size class.
+     */
+    Pool* _pools;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the size class of an allocation or SIZE_CLASSES if it is not
+     * cached.
+     */
+    static uint32 sizeClass( uint32 size, uint32 align );
+
+    /**
+     * Gets the number of blocks moved between a cache and a pool at once.
+     */
+    static uint32 batchSize( uint32 sizeClass );
+
+    /**
+     * Gets the cache of the calling thread or null if it has none.
+     */
+    Cache* cache();
+
+    /**
+     * Moves up to the given number of blocks from the pool of the size
+     * class to the list, cutting a new slab if the pool is empty.
+     *
+     * Returns the number of blocks moved.
+     */
+    uint32 take( uint32 sizeClass, Block** blocks, uint32 count );
+
+    /**
+     * Moves the given number of blocks from the list to the pool of the
+     * size class.
+     */
+    void give( uint32 sizeClass, Block* blocks, uint32 count );
+
+    /**
+     * Returns every block in the cache of the thread index to the pools.
+     */
+    virtual void releaseThread( uint32 index );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a resource with empty caches and pools.
+     */
+    ThreadCacheResource();
+
+    /**
+     * Resources cannot be copied.
+     */
+    ThreadCacheResource( const ThreadCacheResource& resource ) = delete;
+
+    /**
+     * Destructs the resource and frees its slabs.
+     *
+     * Behavior is undefined when:
+     * - any thread is still using the resource
+     */
+    virtual ~ThreadCacheResource();
+
+    // OPERATORS
+    /**
+     * Resources cannot be copied.
+     */
+    ThreadCacheResource& operator=( const ThreadCacheResource& resource ) =
+        delete;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes with the given alignment.
+     *
+     * Behavior is undefined when:
+     * - size is zero
+     * - align is not a power of two
+     * - out of mem
+     */
+    virtual void* allocate( uint32 size, uint32 align );
+
+    /**
+     * Deallocates the bytes from any thread.
+     *
+     * Behavior is undefined when:
+     * - pointer was not allocated by this resource
+     * - size or align differ from the allocation
+     */
+    virtual void deallocate( void* pointer, uint32 size, uint32 align );
+
+    /**
+     * Returns every block in the cache of the calling thread to the pools.
+     */
+    void flush();
+
+    // STATISTICS FUNCTIONS
+    /**
+     * Gets the number of blocks in the cache of the calling thread for the
+     * size class.
+     */
+    uint32 cachedCount( uint32 sizeClass );
+
+    /**
+     * Gets the number of blocks in the pool of the size class.
+     */
+    uint32 pooledCount( uint32 sizeClass );
+
+    /**
+     * Gets the number of slabs cut for the size class.
+     */
+    uint32 slabCount( uint32 sizeClass );
+
+    /**
+     * Gets the number of bytes in blocks of the size class.
+     */
+    static uint32 classSize( uint32 sizeClass );
+};
+
+// STATISTICS FUNCTIONS
+inline
+uint32 ThreadCacheResource::classSize( uint32 sizeClass )
+{
+    assert( sizeClass < SIZE_CLASSES );
+    return 16 << sizeClass;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_THREAD_CACHE_RESOURCE_H
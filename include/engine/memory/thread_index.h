@@ -0,0 +1,71 @@
+// thread_index.h
+//
+// The thread index gives each thread that asks for one a small index that
+// can be used to pick its cache from an array. Indices are taken back when
+// threads exit and given to new threads, so a program that starts many
+// short lived threads does not run out.
+//
+// Caches that are indexed this way register with the thread index. When a
+// thread exits every registered cache returns what the thread held before
+// its index is reused.
+//
+// Usage:
+//     uint32 index = ThreadIndex::current();
+//     if ( index < ThreadIndex::MAX_THREADS )
+//     {
+//         // use the cache at the index
+//     }
+//
+#ifndef NGE_MEM_THREAD_INDEX_H
+#define NGE_MEM_THREAD_INDEX_H
+
+#include "engine/intdef.h"
+#include "engine/memory/ithread_cache.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class ThreadIndex
+{
+  public:
+    // CONSTANTS
+    /**
+     * The number of threads that can have an index at once.
+     */
+    static constexpr uint32 MAX_THREADS = 64;
+
+    // STATIC FUNCTIONS
+    /**
+     * Gets the index of the calling thread or MAX_THREADS if every index is
+     * in use.
+     *
+     * The first call on a thread takes a lock.
+     */
+    static uint32 current();
+
+    /**
+     * Registers the cache to be released when threads exit.
+     *
+     * Behavior is undefined when:
+     * - cache is null
+     * - cache is already registered
+     */
+    static void addCache( IThreadCache* cache );
+
+    /**
+     * Stops releasing the cache when threads exit.
+     *
+     * Behavior is undefined when:
+     * - cache is not registered
+     */
+    static void removeCache( IThreadCache* cache );
+};
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_THREAD_INDEX_H
@@ -0,0 +1,235 @@
+// tracking_allocator.h
+//
+// The tracking allocator wraps another allocator and records the number of
+// bytes it allocates into the tracker of a tag. Allocators of any type that
+// share a tag record into the same tracker, so the memory of a subsystem
+// can be read from the allocation registry no matter how many allocators
+// it uses.
+//
+// Recording is lock free and safe from any thread, but the tracking
+// allocator is only as thread safe as the allocator it wraps.
+//
+// Usage:
+//     TrackingAllocator<Mesh> meshAlloc( "renderer" );
+//     DynamicArray<Mesh, AllocatorGuard> meshes( &meshAlloc );
+//
+//     AllocationRegistry::find( "renderer" )->liveBytes();
+//
+#ifndef NGE_MEM_TRACKING_ALLOCATOR_H
+#define NGE_MEM_TRACKING_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/memory/allocation_registry.h"
+#include "engine/memory/allocation_tracker.h"
+#include "engine/memory/allocator_guard.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class TrackingAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The underlying allocator.
+     */
+    AllocatorGuard<T> _allocator;
+
+    /**
+     * The tracker that allocations are recorded into.
+     */
+    AllocationTracker* _tracker;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a tracking allocator for the tag that uses the default
+     * allocator.
+     */
+    explicit TrackingAllocator( const String& tag );
+
+    /**
+     * Constructs a tracking allocator for the tag that performs allocation
+     * using the given allocator.
+     *
+     * Behavior is undefined when:
+     * - alloc is null
+     */
+    TrackingAllocator( const String& tag, IAllocator<T>* alloc );
+
+    /**
+     * Constructs a copy of a tracking allocator.
+     *
+     * The copy records into the same tracker.
+     */
+    TrackingAllocator( const TrackingAllocator<T>& alloc );
+
+    /**
+     * Destructs the tracking allocator.
+     */
+    virtual ~TrackingAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the allocator.
+     */
+    TrackingAllocator<T>& operator=( const TrackingAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of mem
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets the alignment of the underlying allocator.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Tries to grow the allocation in place using the underlying allocator.
+     *
+     * The added bytes are tracked when the allocation grows.
+     *
+     * Behavior is undefined when:
+     * pointer is invalid
+     * newCount is less than or equal to count
+     */
+    virtual bool grow( T* pointer, uint32 count, uint32 newCount );
+
+    /**
+     * Gets the tracker that allocations are recorded into.
+     */
+    AllocationTracker* tracker() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const String& tag )
+    : _allocator(), _tracker( AllocationRegistry::tracker( tag ) )
+{
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const String& tag,
+                                         IAllocator<T>* alloc )
+    : _allocator( alloc ), _tracker( AllocationRegistry::tracker( tag ) )
+{
+    assert( alloc != nullptr );
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const TrackingAllocator<T>& alloc )
+    : _allocator( alloc._allocator ), _tracker( alloc._tracker )
+{
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::~TrackingAllocator()
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+TrackingAllocator<T>& TrackingAllocator<T>::operator=(
+    const TrackingAllocator<T>& alloc )
+{
+    _allocator = alloc._allocator;
+    _tracker = alloc._tracker;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* TrackingAllocator<T>::get( uint32 count )
+{
+    T* values;
+
+    assert( count > 0 );
+
+    values = _allocator.get( count );
+    if ( values != nullptr )
+    {
+        _tracker->recordGet( static_cast<uint64>( sizeof( T ) ) * count );
+    }
+
+    return values;
+}
+
+template <typename T>
+inline
+void TrackingAllocator<T>::release( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    _tracker->recordRelease( static_cast<uint64>( sizeof( T ) ) * count );
+    _allocator.release( pointer, count );
+}
+
+template <typename T>
+inline
+uint32 TrackingAllocator<T>::alignment() const
+{
+    return _allocator.alignment();
+}
+
+template <typename T>
+inline
+bool TrackingAllocator<T>::grow( T* pointer, uint32 count, uint32 newCount )
+{
+    assert( pointer != nullptr );
+    assert( newCount > count );
+
+    if ( !_allocator.grow( pointer, count, newCount ) )
+    {
+        return false;
+    }
+
+    _tracker->recordGrow( static_cast<uint64>( sizeof( T ) ) *
+                             ( newCount - count ) );
+
+    return true;
+}
+
+template <typename T>
+inline
+AllocationTracker* TrackingAllocator<T>::tracker() const
+{
+    return _tracker;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_TRACKING_ALLOCATOR_H
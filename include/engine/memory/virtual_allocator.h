@@ -0,0 +1,300 @@
+// virtual_allocator.h
+//
+// The virtual allocator gives every allocation its own reserved range of
+// virtual memory and only commits the pages that the instances use. An
+// allocation can later grow in place up to the size of its range, so a
+// dynamic array that uses it never copies its items when it grows.
+//
+// It is meant for a few large arrays such as terrain, navigation grids and
+// particle pools. Every allocation takes at least one page, or one huge
+// page when huge pages are used, so small allocations waste a lot of
+// memory.
+//
+// Usage:
+//     VirtualAllocator<Cell> alloc( 512 * 1024 * 1024 );
+//     DynamicArray<Cell, AllocatorGuard> grid( &alloc );
+//
+#ifndef NGE_MEM_VIRTUAL_ALLOCATOR_H
+#define NGE_MEM_VIRTUAL_ALLOCATOR_H
+
+#include <assert.h>
+#include <new>
+
+#include "engine/intdef.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/virtual_memory.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class VirtualAllocator : public IAllocator<T>
+{
+  private:
+    // CONSTANTS
+    /**
+     * The default number of bytes reserved for each allocation.
+     */
+    static constexpr uint64 DEFAULT_RESERVE_SIZE = 1ull << 30;
+
+    // MEMBERS
+    /**
+     * The number of bytes reserved for each allocation.
+     */
+    uint64 _reserveSize;
+
+    /**
+     * The kind of pages that allocations use.
+     */
+    VirtualMemory::PageMode _mode;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an allocator that reserves the default number of bytes for
+     * each allocation and uses transparent huge pages.
+     */
+    VirtualAllocator();
+
+    /**
+     * Constructs an allocator that reserves the given number of bytes for
+     * each allocation and uses the given kind of pages.
+     *
+     * The number of bytes is rounded up to the granularity of the pages.
+     *
+     * Behavior is undefined when:
+     * - reserveSize is zero
+     */
+    explicit VirtualAllocator( uint64 reserveSize,
+                               VirtualMemory::PageMode mode =
+                                   VirtualMemory::TRANSPARENT_HUGE_PAGES );
+
+    /**
+     * Constructs a copy of the allocator.
+     */
+    VirtualAllocator( const VirtualAllocator<T>& alloc );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~VirtualAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the allocator.
+     */
+    VirtualAllocator<T>& operator=( const VirtualAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of instances.
+     *
+     * Returns null when the range could not be reserved or the instances
+     * could not be committed.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * the instances do not fit in the reserved size
+     */
+    virtual T* get( uint32 count );
+
+    /**
+     * Releases the allocation with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer is invalid
+     * count is less than or equal to zero
+     */
+    virtual void release( T* pointer, uint32 count );
+
+    /**
+     * Gets the alignment of allocations, which start on a page.
+     */
+    virtual uint32 alignment() const;
+
+    /**
+     * Grows the allocation in place by committing more of its range.
+     *
+     * Returns false when the instances do not fit in the reserved size.
+     */
+    virtual bool grow( T* pointer, uint32 count, uint32 newCount );
+
+    /**
+     * Gets the number of bytes reserved for each allocation.
+     */
+    uint64 reserveSize() const;
+
+    /**
+     * Gets the largest number of instances that an allocation can hold.
+     */
+    uint32 maxCount() const;
+
+    /**
+     * Gets the kind of pages that allocations use.
+     */
+    VirtualMemory::PageMode mode() const;
+};
+
+template <typename T>
+constexpr uint64 VirtualAllocator<T>::DEFAULT_RESERVE_SIZE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+VirtualAllocator<T>::VirtualAllocator()
+    : _reserveSize( VirtualMemory::roundUp(
+          DEFAULT_RESERVE_SIZE, VirtualMemory::TRANSPARENT_HUGE_PAGES ) ),
+      _mode( VirtualMemory::TRANSPARENT_HUGE_PAGES )
+{
+}
+
+template <typename T>
+inline
+VirtualAllocator<T>::VirtualAllocator( uint64 reserveSize,
+                                       VirtualMemory::PageMode mode )
+    : _reserveSize( VirtualMemory::roundUp( reserveSize, mode ) ),
+      _mode( mode )
+{
+    assert( reserveSize > 0 );
+}
+
+template <typename T>
+inline
+VirtualAllocator<T>::VirtualAllocator( const VirtualAllocator<T>& alloc )
+    : _reserveSize( alloc._reserveSize ), _mode( alloc._mode )
+{
+}
+
+template <typename T>
+inline
+VirtualAllocator<T>::~VirtualAllocator()
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+VirtualAllocator<T>& VirtualAllocator<T>::operator=(
+    const VirtualAllocator<T>& alloc )
+{
+    _reserveSize = alloc._reserveSize;
+    _mode = alloc._mode;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* VirtualAllocator<T>::get( uint32 count )
+{
+    T* values;
+    uint64 size = static_cast<uint64>( sizeof( T ) ) * count;
+    uint32 i;
+
+    assert( count > 0 );
+    assert( size <= _reserveSize );
+
+    values = static_cast<T*>( VirtualMemory::reserve( _reserveSize, _mode ) );
+    if ( values == nullptr )
+    {
+        return nullptr;
+    }
+
+    if ( !VirtualMemory::commit( values,
+                                 VirtualMemory::roundUp( size, _mode ) ) )
+    {
+        VirtualMemory::release( values, _reserveSize );
+        return nullptr;
+    }
+
+    for ( i = 0; i < count; ++i )
+    {
+        new ( values + i ) T();
+    }
+
+    return values;
+}
+
+template <typename T>
+inline
+void VirtualAllocator<T>::release( T* pointer, uint32 count )
+{
+    uint32 i;
+
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    for ( i = 0; i < count; ++i )
+    {
+        pointer[i].~T();
+    }
+
+    VirtualMemory::release( pointer, _reserveSize );
+}
+
+template <typename T>
+inline
+uint32 VirtualAllocator<T>::alignment() const
+{
+    return static_cast<uint32>( VirtualMemory::pageSize() );
+}
+
+template <typename T>
+inline
+bool VirtualAllocator<T>::grow( T* pointer, uint32 count, uint32 newCount )
+{
+    uint64 size = static_cast<uint64>( sizeof( T ) ) * newCount;
+    uint32 i;
+
+    assert( pointer != nullptr );
+    assert( newCount > count );
+
+    if ( size > _reserveSize ||
+         !VirtualMemory::commit( pointer,
+                                 VirtualMemory::roundUp( size, _mode ) ) )
+    {
+        return false;
+    }
+
+    for ( i = count; i < newCount; ++i )
+    {
+        new ( pointer + i ) T();
+    }
+
+    return true;
+}
+
+template <typename T>
+inline
+uint64 VirtualAllocator<T>::reserveSize() const
+{
+    return _reserveSize;
+}
+
+template <typename T>
+inline
+uint32 VirtualAllocator<T>::maxCount() const
+{
+    uint64 count = _reserveSize / sizeof( T );
+
+    return count < 0xFFFFFFFFull ? static_cast<uint32>( count ) : 0xFFFFFFFF;
+}
+
+template <typename T>
+inline
+VirtualMemory::PageMode VirtualAllocator<T>::mode() const
+{
+    return _mode;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_VIRTUAL_ALLOCATOR_H
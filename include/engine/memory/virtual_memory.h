@@ -0,0 +1,115 @@
+// virtual_memory.h
+//
+// Wraps the virtual memory functions of the operating system.
+//
+// Memory is first reserved, which only claims a range of addresses, and
+// then committed in pages as it is needed. A large range can be reserved up
+// front so that an allocation can grow in place without ever being moved.
+//
+// Reserved memory can ask for huge pages. Transparent huge pages are a hint
+// to the kernel to back the range with huge pages when it can. Explicit
+// huge pages come from the pool set aside by the system administrator and
+// fall back to transparent huge pages when the pool is empty. Both are
+// only supported on Linux and are ignored on other platforms.
+//
+#ifndef NGE_MEM_VIRTUAL_MEMORY_H
+#define NGE_MEM_VIRTUAL_MEMORY_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+struct VirtualMemory
+{
+  public:
+    // ENUMERATIONS
+    /**
+     * Defines the kinds of pages that reserved memory can use.
+     */
+    enum PageMode
+    {
+        SMALL_PAGES = 0,
+        TRANSPARENT_HUGE_PAGES,
+        HUGE_PAGES
+    };
+
+    // CONSTANTS
+    /**
+     * The size of a huge page in bytes.
+     *
+     * This is the default huge page size on x86-64 and ARM64.
+     */
+    static constexpr uint64 HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the size of a page in bytes.
+     */
+    static uint64 pageSize();
+
+    /**
+     * Gets the number of bytes that memory of the given page mode is
+     * reserved and committed in.
+     */
+    static uint64 granularity( PageMode mode );
+
+    /**
+     * Rounds the size up to the granularity of the given page mode.
+     */
+    static uint64 roundUp( uint64 size, PageMode mode );
+
+    /**
+     * Reserves a range of addresses with the given number of bytes.
+     *
+     * None of the range is committed. Returns null when the range could not
+     * be reserved.
+     *
+     * Behavior is undefined when:
+     * - size is zero
+     * - size is not a multiple of the granularity of the mode
+     */
+    static void* reserve( uint64 size, PageMode mode );
+
+    /**
+     * Commits the given number of bytes of a reserved range so that they
+     * can be used.
+     *
+     * Committing bytes that are already committed does nothing. Returns
+     * false when the bytes could not be committed.
+     *
+     * Behavior is undefined when:
+     * - the bytes are not in a reserved range
+     * - pointer is not aligned to a page
+     */
+    static bool commit( void* pointer, uint64 size );
+
+    /**
+     * Gives the physical memory of committed bytes back to the system.
+     *
+     * The bytes stay reserved and must be committed again before they are
+     * used.
+     *
+     * Behavior is undefined when:
+     * - the bytes are not in a reserved range
+     * - pointer is not aligned to a page
+     */
+    static void decommit( void* pointer, uint64 size );
+
+    /**
+     * Releases a whole reserved range.
+     *
+     * Behavior is undefined when:
+     * - pointer and size are not those of a reserved range
+     */
+    static void release( void* pointer, uint64 size );
+};
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif // NGE_MEM_VIRTUAL_MEMORY_H
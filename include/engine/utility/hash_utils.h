@@ -55,11 +55,48 @@ struct HashUtils
      */
     static uint32 fnv1a( const String& value );
 
+    /**
+     * Computes the 64 bit fnv1a hash of a string value.
+     */
+    static uint64 fnv1a64( const String& value );
+
+    /**
+     * Computes the fnv1a hash of a null terminated string.
+     *
+     * This can be evaluated at compile time and produces the same hash as
+     * fnv1a and chash.
+     */
+    static constexpr uint32 stringHash( const char* value,
+                                        uint32 hashCode = FNV_OFFSET_32 );
+
+    /**
+     * Computes the 64 bit fnv1a hash of a null terminated string.
+     *
+     * This can be evaluated at compile time and produces the same hash as
+     * fnv1a64.
+     */
+    static constexpr uint64 stringHash64( const char* value,
+                                          uint64 hashCode = FNV_OFFSET_64 );
+
     /**
      * Compiles the fnv hash code at compile time.
      */
     template <uint32 length>
     static constexpr uint32 compileTimeHash( const char* value );
+
+    /**
+     * Mixes the bits of a hash code so that every input bit affects every
+     * output bit.
+     *
+     * This is the finalizer of murmur3 and is useful when only some of the
+     * bits of a weak hash code are used, such as a block index.
+     */
+    static constexpr uint32 mix( uint32 hashCode );
+
+    /**
+     * Xors the value with itself shifted right by the given amount.
+     */
+    static constexpr uint32 shiftXor( uint32 value, uint32 shift );
 };
 
 template <>
@@ -77,6 +114,34 @@ constexpr uint32 HashUtils::compileTimeHash( const char* value )
         FNV_PRIME_32;
 }
 
+inline
+constexpr uint32 HashUtils::stringHash( const char* value, uint32 hashCode )
+{
+    return *value == '\0' ? hashCode :
+           stringHash( value + 1, ( hashCode ^ *value ) * FNV_PRIME_32 );
+}
+
+inline
+constexpr uint64 HashUtils::stringHash64( const char* value,
+                                          uint64 hashCode )
+{
+    return *value == '\0' ? hashCode :
+           stringHash64( value + 1, ( hashCode ^ *value ) * FNV_PRIME_64 );
+}
+
+inline
+constexpr uint32 HashUtils::mix( uint32 hashCode )
+{
+    return shiftXor( shiftXor( shiftXor( hashCode, 16 ) * 0x85ebca6b, 13 ) *
+                     0xc2b2ae35, 16 );
+}
+
+inline
+constexpr uint32 HashUtils::shiftXor( uint32 value, uint32 shift )
+{
+    return value ^ ( value >> shift );
+}
+
 } // End nspc util
 
 } // End nspc nge
@@ -0,0 +1,350 @@
+// string_id.h
+//
+// A string id is the hash of a string that is used in place of the string.
+// Ids are compared and hashed as integers so they are much cheaper keys than
+// strings for tags, resource paths, and event names.
+//
+// Ids of string literals are computed at compile time using NGE_SID.
+// Ids of dynamic strings are created by interning them, which also records
+// the string in a global table so that it can be looked up again for
+// logging. The table is shared by every thread and guarded by a mutex.
+//
+// Two strings with the same hash share an id. Debug builds check every
+// interned string against the table and assert when a collision is found.
+// Literal ids do not go through the table, so they are missing from the
+// reverse lookup: isInterned is false and toString gives the hexadecimal
+// value until the same string is interned. A literal should be interned
+// once during startup when its collisions should be checked or its string
+// should be available for logging.
+//
+// Usage:
+//     constexpr StringId TAG = NGE_SID( "renderer" );
+//     StringId path = StringId::intern( shaderPath );
+//
+//     assert( TAG == StringId::intern( "renderer" ) );
+//     log.info( path.toString(), "loaded" );
+//
+#ifndef NGE_UTIL_STRING_ID_H
+#define NGE_UTIL_STRING_ID_H
+
+#include <assert.h>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+#include "engine/containers/map.h"
+#include "engine/utility/hash_utils.h"
+#include "engine/utility/hasher.h"
+
+/**
+ * Computes the 32 bit string id of a string literal at compile time.
+ *
+ * The id is not added to the table of interned strings.
+ */
+#define NGE_SID( string ) \
+nge::util::StringId( chash( string ) )
+
+namespace nge
+{
+
+namespace util
+{
+
+template <typename H>
+class TStringId
+{
+  private:
+    // STRUCTURES
+    /**
+     * Defines the table of interned strings.
+     */
+    struct Table
+    {
+        std::mutex mutex;
+        cntr::Map<H, String> strings;
+    };
+
+    // MEMBERS
+    /**
+     * The hash of the string.
+     */
+    H _value;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the table of interned strings.
+     */
+    static Table& table();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs the empty id.
+     *
+     * The empty id is not the id of any string, including the empty string.
+     */
+    constexpr TStringId();
+
+    /**
+     * Constructs an id from the hash of a string.
+     */
+    constexpr explicit TStringId( H value );
+
+    // OPERATORS
+    /**
+     * Checks if the ids are the same.
+     */
+    constexpr bool operator==( const TStringId<H>& id ) const;
+
+    /**
+     * Checks if the ids are different.
+     */
+    constexpr bool operator!=( const TStringId<H>& id ) const;
+
+    /**
+     * Orders the ids by their value.
+     *
+     * The order is stable but has nothing to do with the order of the
+     * strings.
+     */
+    constexpr bool operator<( const TStringId<H>& id ) const;
+
+    // STATIC FUNCTIONS
+    /**
+     * Computes the hash of the string without interning it.
+     */
+    static constexpr H hash( const char* value );
+
+    /**
+     * Computes the hash of every character of the string without interning
+     * it.
+     *
+     * This produces the same hash as the literal overload for strings
+     * without null characters.
+     */
+    static H hash( const String& value );
+
+    /**
+     * Interns the string and gets its id.
+     *
+     * Behavior is undefined when:
+     * - a different string with the same hash was interned
+     */
+    static TStringId<H> intern( const char* value );
+
+    /**
+     * Interns the string and gets its id.
+     *
+     * Behavior is undefined when:
+     * - a different string with the same hash was interned
+     */
+    static TStringId<H> intern( const String& value );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the hash of the string.
+     */
+    constexpr H value() const;
+
+    /**
+     * Checks if this is the empty id.
+     */
+    constexpr bool isEmpty() const;
+
+    /**
+     * Checks if the string of this id was interned.
+     */
+    bool isInterned() const;
+
+    /**
+     * Gets the string of this id.
+     *
+     * Ids that were not interned produce their value as a hexadecimal
+     * number prefixed with '#'.
+     */
+    String toString() const;
+};
+
+// TYPES
+/**
+ * Defines a 32 bit string id that matches chash.
+ */
+typedef TStringId<uint32> StringId;
+
+/**
+ * Defines a 64 bit string id for large sets of strings.
+ */
+typedef TStringId<uint64> StringId64;
+
+// HELPER FUNCTIONS
+template <typename H>
+inline
+typename TStringId<H>::Table& TStringId<H>::table()
+{
+    static Table table;
+    return table;
+}
+
+// CONSTRUCTORS
+template <typename H>
+inline
+constexpr TStringId<H>::TStringId() : _value( 0 )
+{
+}
+
+template <typename H>
+inline
+constexpr TStringId<H>::TStringId( H value ) : _value( value )
+{
+}
+
+// OPERATORS
+template <typename H>
+inline
+constexpr bool TStringId<H>::operator==( const TStringId<H>& id ) const
+{
+    return _value == id._value;
+}
+
+template <typename H>
+inline
+constexpr bool TStringId<H>::operator!=( const TStringId<H>& id ) const
+{
+    return _value != id._value;
+}
+
+template <typename H>
+inline
+constexpr bool TStringId<H>::operator<( const TStringId<H>& id ) const
+{
+    return _value < id._value;
+}
+
+// STATIC FUNCTIONS
+template <>
+inline
+constexpr uint32 TStringId<uint32>::hash( const char* value )
+{
+    return HashUtils::stringHash( value );
+}
+
+template <>
+inline
+constexpr uint64 TStringId<uint64>::hash( const char* value )
+{
+    return HashUtils::stringHash64( value );
+}
+
+template <>
+inline
+uint32 TStringId<uint32>::hash( const String& value )
+{
+    return HashUtils::fnv1a( value );
+}
+
+template <>
+inline
+uint64 TStringId<uint64>::hash( const String& value )
+{
+    return HashUtils::fnv1a64( value );
+}
+
+template <typename H>
+inline
+TStringId<H> TStringId<H>::intern( const char* value )
+{
+    return intern( String( value ) );
+}
+
+template <typename H>
+inline
+TStringId<H> TStringId<H>::intern( const String& value )
+{
+    Table& strings = table();
+    TStringId<H> id( hash( value ) );
+
+    std::lock_guard<std::mutex> lock( strings.mutex );
+    if ( !strings.strings.has( id._value ) )
+    {
+        strings.strings.put( id._value, value );
+    }
+#ifndef NDEBUG
+    else
+    {
+        assert( strings.strings[id._value] == value &&
+                "the string id collides with another string" );
+    }
+#endif
+
+    return id;
+}
+
+// MEMBER FUNCTIONS
+template <typename H>
+inline
+constexpr H TStringId<H>::value() const
+{
+    return _value;
+}
+
+template <typename H>
+inline
+constexpr bool TStringId<H>::isEmpty() const
+{
+    return _value == 0;
+}
+
+template <typename H>
+inline
+bool TStringId<H>::isInterned() const
+{
+    Table& strings = table();
+
+    std::lock_guard<std::mutex> lock( strings.mutex );
+    return strings.strings.has( _value );
+}
+
+template <typename H>
+inline
+String TStringId<H>::toString() const
+{
+    Table& strings = table();
+    std::ostringstream stream;
+
+    {
+        std::lock_guard<std::mutex> lock( strings.mutex );
+        if ( strings.strings.has( _value ) )
+        {
+            return strings.strings[_value];
+        }
+    }
+
+    stream << '#' << std::hex << std::setfill( '0' )
+           << std::setw( sizeof( H ) * 2 ) << _value;
+    return stream.str();
+}
+
+// HASHER
+template <typename H>
+struct Hasher<TStringId<H>>
+{
+    /**
+     * Computes the hash for a string id.
+     */
+    static uint32 hash( const TStringId<H>& value );
+};
+
+template <typename H>
+inline
+uint32 Hasher<TStringId<H>>::hash( const TStringId<H>& value )
+{
+    return Hasher<H>::hash( value.value() );
+}
+
+} // End nspc util
+
+} // End nspc nge
+
+#endif // NGE_UTIL_STRING_ID_H
@@ -24,7 +24,7 @@ class Scene
     /**
      * The items that are updated during the update cycle..
      */
-    cntr::DynamicArray<ITickable*> _tickables;
+    cntr::DynamicArray<ITickable*, mem::AllocatorGuard> _tickables;
 
     /**
      * The warning capacity threshold.
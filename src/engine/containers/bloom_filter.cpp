@@ -0,0 +1,2 @@
+// bloom_filter.cpp
+#include "engine/containers/bloom_filter.h"
@@ -0,0 +1,2 @@
+// colony.cpp
+#include "engine/containers/colony.h"
@@ -0,0 +1,2 @@
+// lru_cache.cpp
+#include "engine/containers/lru_cache.h"
@@ -0,0 +1,2 @@
+// priority_queue.cpp
+#include "engine/containers/priority_queue.h"
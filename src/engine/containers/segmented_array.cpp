@@ -0,0 +1,2 @@
+// segmented_array.cpp
+#include "engine/containers/segmented_array.h"
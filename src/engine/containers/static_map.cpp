@@ -0,0 +1,2 @@
+// static_map.cpp
+#include "engine/containers/static_map.h"
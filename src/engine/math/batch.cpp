@@ -0,0 +1,1241 @@
+// batch.cpp
+#include "engine/math/batch.h"
+
+#include <algorithm>
+#include <math.h>
+
+#include "engine/math/simd.h"
+
+// AVX2 kernels are compiled for their own target and only run when the
+// processor supports them, so the rest of the build needs no AVX flags
+#if defined( NGE_MATH_SSE ) && defined( __GNUC__ ) && \
+    ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define NGE_MATH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace nge
+{
+
+namespace math
+{
+
+namespace
+{
+
+static_assert( sizeof( Vec2 ) == 2 * sizeof( float ),
+               "the AoS kernels expect packed 2D vectors" );
+static_assert( sizeof( Vec3 ) == 3 * sizeof( float ),
+               "the AoS kernels expect packed 3D vectors" );
+
+// TYPES
+/**
+ * Defines the kernels of one instruction set.
+ *
+ * Matrices are passed as the rows that are used, three floats for 2D and
+ * four for 3D. The AoS kernels take vectors as interleaved components.
+ */
+struct Kernels
+{
+    void ( *transformPoints )( const float* m,
+                               const float* x,
+                               const float* y,
+                               const float* z,
+                               float* outX,
+                               float* outY,
+                               float* outZ,
+                               uint32 count );
+
+    void ( *transformPointsAos )( const float* m,
+                                  const float* in,
+                                  float* out,
+                                  uint32 count );
+
+    void ( *transform2D )( const float* m,
+                           const float* x,
+                           const float* y,
+                           float* outX,
+                           float* outY,
+                           uint32 count );
+
+    void ( *transform2DAos )( const float* m,
+                              const float* in,
+                              float* out,
+                              uint32 count );
+
+    void ( *normalize )( const float* x,
+                         const float* y,
+                         const float* z,
+                         float* outX,
+                         float* outY,
+                         float* outZ,
+                         uint32 count );
+
+    void ( *normalizeAos )( const float* in, float* out, uint32 count );
+
+    void ( *dot )( const float* ax,
+                   const float* ay,
+                   const float* az,
+                   const float* bx,
+                   const float* by,
+                   const float* bz,
+                   float* out,
+                   uint32 count );
+
+    void ( *dotAos )( const float* a,
+                      const float* b,
+                      float* out,
+                      uint32 count );
+
+    void ( *lerp )( const float* a,
+                    const float* b,
+                    float t,
+                    float* out,
+                    uint32 count );
+};
+
+// SCALAR KERNELS
+void transformPointsScalar( const float* m,
+                            const float* x,
+                            const float* y,
+                            const float* z,
+                            float* outX,
+                            float* outY,
+                            float* outZ,
+                            uint32 count )
+{
+    float px;
+    float py;
+    float pz;
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        px = x[i];
+        py = y[i];
+        pz = z[i];
+        outX[i] = m[0] * px + m[1] * py + m[2] * pz + m[3];
+        outY[i] = m[4] * px + m[5] * py + m[6] * pz + m[7];
+        outZ[i] = m[8] * px + m[9] * py + m[10] * pz + m[11];
+    }
+}
+
+void transformPointsAosScalar( const float* m,
+                               const float* in,
+                               float* out,
+                               uint32 count )
+{
+    float px;
+    float py;
+    float pz;
+    uint32 i;
+
+    for ( i = 0; i < count * 3; i += 3 )
+    {
+        px = in[i];
+        py = in[i + 1];
+        pz = in[i + 2];
+        out[i] = m[0] * px + m[1] * py + m[2] * pz + m[3];
+        out[i + 1] = m[4] * px + m[5] * py + m[6] * pz + m[7];
+        out[i + 2] = m[8] * px + m[9] * py + m[10] * pz + m[11];
+    }
+}
+
+void transform2DScalar( const float* m,
+                        const float* x,
+                        const float* y,
+                        float* outX,
+                        float* outY,
+                        uint32 count )
+{
+    float px;
+    float py;
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        px = x[i];
+        py = y[i];
+        outX[i] = m[0] * px + m[1] * py + m[2];
+        outY[i] = m[3] * px + m[4] * py + m[5];
+    }
+}
+
+void transform2DAosScalar( const float* m,
+                           const float* in,
+                           float* out,
+                           uint32 count )
+{
+    float px;
+    float py;
+    uint32 i;
+
+    for ( i = 0; i < count * 2; i += 2 )
+    {
+        px = in[i];
+        py = in[i + 1];
+        out[i] = m[0] * px + m[1] * py + m[2];
+        out[i + 1] = m[3] * px + m[4] * py + m[5];
+    }
+}
+
+void normalizeScalar( const float* x,
+                      const float* y,
+                      const float* z,
+                      float* outX,
+                      float* outY,
+                      float* outZ,
+                      uint32 count )
+{
+    float px;
+    float py;
+    float pz;
+    float length;
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        px = x[i];
+        py = y[i];
+        pz = z[i];
+        length = sqrtf( px * px + py * py + pz * pz );
+        outX[i] = px / length;
+        outY[i] = py / length;
+        outZ[i] = pz / length;
+    }
+}
+
+void normalizeAosScalar( const float* in, float* out, uint32 count )
+{
+    float px;
+    float py;
+    float pz;
+    float length;
+    uint32 i;
+
+    for ( i = 0; i < count * 3; i += 3 )
+    {
+        px = in[i];
+        py = in[i + 1];
+        pz = in[i + 2];
+        length = sqrtf( px * px + py * py + pz * pz );
+        out[i] = px / length;
+        out[i + 1] = py / length;
+        out[i + 2] = pz / length;
+    }
+}
+
+void dotScalar( const float* ax,
+                const float* ay,
+                const float* az,
+                const float* bx,
+                const float* by,
+                const float* bz,
+                float* out,
+                uint32 count )
+{
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+    }
+}
+
+void dotAosScalar( const float* a, const float* b, float* out, uint32 count )
+{
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        out[i] = a[i * 3] * b[i * 3] + a[i * 3 + 1] * b[i * 3 + 1] +
+                 a[i * 3 + 2] * b[i * 3 + 2];
+    }
+}
+
+void lerpScalar( const float* a,
+                 const float* b,
+                 float t,
+                 float* out,
+                 uint32 count )
+{
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        out[i] = a[i] + ( b[i] - a[i] ) * t;
+    }
+}
+
+const Kernels SCALAR_KERNELS = {
+    transformPointsScalar,
+    transformPointsAosScalar,
+    transform2DScalar,
+    transform2DAosScalar,
+    normalizeScalar,
+    normalizeAosScalar,
+    dotScalar,
+    dotAosScalar,
+    lerpScalar
+};
+
+#ifdef NGE_MATH_SSE
+// SSE HELPER FUNCTIONS
+/**
+ * Loads four 3D vectors and splits them into components.
+ */
+inline
+void load3( const float* in, __m128* x, __m128* y, __m128* z )
+{
+    __m128 a0 = _mm_loadu_ps( in );     // x0 y0 z0 x1
+    __m128 a1 = _mm_loadu_ps( in + 4 ); // y1 z1 x2 y2
+    __m128 a2 = _mm_loadu_ps( in + 8 ); // z2 x3 y3 z3
+    __m128 x2y2x3y3 = _mm_shuffle_ps( a1, a2, _MM_SHUFFLE( 2, 1, 3, 2 ) );
+    __m128 y0z0y1z1 = _mm_shuffle_ps( a0, a1, _MM_SHUFFLE( 1, 0, 2, 1 ) );
+
+    *x = _mm_shuffle_ps( a0, x2y2x3y3, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+    *y = _mm_shuffle_ps( y0z0y1z1, x2y2x3y3, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    *z = _mm_shuffle_ps( y0z0y1z1, a2, _MM_SHUFFLE( 3, 0, 3, 1 ) );
+}
+
+/**
+ * Interleaves the components of four 3D vectors and stores them.
+ */
+inline
+void store3( float* out, __m128 x, __m128 y, __m128 z )
+{
+    __m128 xy01 = _mm_unpacklo_ps( x, y );
+    __m128 xy23 = _mm_unpackhi_ps( x, y );
+    __m128 t;
+
+    t = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) );
+    _mm_storeu_ps( out, _mm_shuffle_ps( xy01, t, _MM_SHUFFLE( 2, 0, 1, 0 ) ) );
+    t = _mm_shuffle_ps( xy01, z, _MM_SHUFFLE( 1, 1, 3, 3 ) );
+    _mm_storeu_ps( out + 4,
+                   _mm_shuffle_ps( t, xy23, _MM_SHUFFLE( 1, 0, 2, 0 ) ) );
+    t = _mm_shuffle_ps( z, xy23, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+    _mm_storeu_ps( out + 8, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 1, 3, 2, 0 ) ) );
+}
+
+/**
+ * Copies each of the values into every lane.
+ *
+ * The kernels broadcast the matrix before their loops, since the output
+ * may alias it and the compiler would otherwise load it again each time.
+ */
+inline
+void broadcast( const float* values, __m128* lanes, uint32 count )
+{
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        lanes[i] = _mm_set1_ps( values[i] );
+    }
+}
+
+/**
+ * Transforms the points in the lanes by the broadcast matrix rows.
+ */
+inline
+void transformLanes( const __m128* m, __m128* x, __m128* y, __m128* z )
+{
+    __m128 r[3];
+    uint32 i;
+
+    for ( i = 0; i < 3; ++i )
+    {
+        r[i] = _mm_add_ps(
+            _mm_add_ps( _mm_add_ps( _mm_mul_ps( m[i * 4], *x ),
+                                    _mm_mul_ps( m[i * 4 + 1], *y ) ),
+                        _mm_mul_ps( m[i * 4 + 2], *z ) ),
+            m[i * 4 + 3] );
+    }
+
+    *x = r[0];
+    *y = r[1];
+    *z = r[2];
+}
+
+/**
+ * Transforms the 2D points in the lanes by the broadcast matrix rows.
+ */
+inline
+void transformLanes( const __m128* m, __m128* x, __m128* y )
+{
+    __m128 rx = _mm_add_ps(
+        _mm_add_ps( _mm_mul_ps( m[0], *x ), _mm_mul_ps( m[1], *y ) ), m[2] );
+    __m128 ry = _mm_add_ps(
+        _mm_add_ps( _mm_mul_ps( m[3], *x ), _mm_mul_ps( m[4], *y ) ), m[5] );
+
+    *x = rx;
+    *y = ry;
+}
+
+/**
+ * Normalizes the vectors in the lanes.
+ */
+inline
+void normalizeLanes( __m128* x, __m128* y, __m128* z )
+{
+    __m128 length = _mm_sqrt_ps( _mm_add_ps(
+        _mm_add_ps( _mm_mul_ps( *x, *x ), _mm_mul_ps( *y, *y ) ),
+        _mm_mul_ps( *z, *z ) ) );
+
+    *x = _mm_div_ps( *x, length );
+    *y = _mm_div_ps( *y, length );
+    *z = _mm_div_ps( *z, length );
+}
+
+/**
+ * Calculates the dot products of the vectors in the lanes.
+ */
+inline
+__m128 dotLanes( __m128 ax, __m128 ay, __m128 az,
+                 __m128 bx, __m128 by, __m128 bz )
+{
+    return _mm_add_ps(
+        _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) ),
+        _mm_mul_ps( az, bz ) );
+}
+
+// SSE KERNELS
+void transformPointsSse( const float* m,
+                         const float* x,
+                         const float* y,
+                         const float* z,
+                         float* outX,
+                         float* outY,
+                         float* outZ,
+                         uint32 count )
+{
+    __m128 px;
+    __m128 py;
+    __m128 pz;
+    __m128 rows[12];
+    uint32 i;
+
+    broadcast( m, rows, 12 );
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        px = _mm_loadu_ps( x + i );
+        py = _mm_loadu_ps( y + i );
+        pz = _mm_loadu_ps( z + i );
+        transformLanes( rows, &px, &py, &pz );
+        _mm_storeu_ps( outX + i, px );
+        _mm_storeu_ps( outY + i, py );
+        _mm_storeu_ps( outZ + i, pz );
+    }
+
+    transformPointsScalar( m, x + i, y + i, z + i, outX + i, outY + i,
+                           outZ + i, count - i );
+}
+
+void transformPointsAosSse( const float* m,
+                            const float* in,
+                            float* out,
+                            uint32 count )
+{
+    __m128 px;
+    __m128 py;
+    __m128 pz;
+    __m128 rows[12];
+    uint32 i;
+
+    broadcast( m, rows, 12 );
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        load3( in + i * 3, &px, &py, &pz );
+        transformLanes( rows, &px, &py, &pz );
+        store3( out + i * 3, px, py, pz );
+    }
+
+    transformPointsAosScalar( m, in + i * 3, out + i * 3, count - i );
+}
+
+void transform2DSse( const float* m,
+                     const float* x,
+                     const float* y,
+                     float* outX,
+                     float* outY,
+                     uint32 count )
+{
+    __m128 px;
+    __m128 py;
+    __m128 rows[6];
+    uint32 i;
+
+    broadcast( m, rows, 6 );
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        px = _mm_loadu_ps( x + i );
+        py = _mm_loadu_ps( y + i );
+        transformLanes( rows, &px, &py );
+        _mm_storeu_ps( outX + i, px );
+        _mm_storeu_ps( outY + i, py );
+    }
+
+    transform2DScalar( m, x + i, y + i, outX + i, outY + i, count - i );
+}
+
+void transform2DAosSse( const float* m,
+                        const float* in,
+                        float* out,
+                        uint32 count )
+{
+    __m128 a0;
+    __m128 a1;
+    __m128 px;
+    __m128 py;
+    __m128 rows[6];
+    uint32 i;
+
+    broadcast( m, rows, 6 );
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        a0 = _mm_loadu_ps( in + i * 2 );
+        a1 = _mm_loadu_ps( in + i * 2 + 4 );
+        px = _mm_shuffle_ps( a0, a1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+        py = _mm_shuffle_ps( a0, a1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+        transformLanes( rows, &px, &py );
+        _mm_storeu_ps( out + i * 2, _mm_unpacklo_ps( px, py ) );
+        _mm_storeu_ps( out + i * 2 + 4, _mm_unpackhi_ps( px, py ) );
+    }
+
+    transform2DAosScalar( m, in + i * 2, out + i * 2, count - i );
+}
+
+void normalizeSse( const float* x,
+                   const float* y,
+                   const float* z,
+                   float* outX,
+                   float* outY,
+                   float* outZ,
+                   uint32 count )
+{
+    __m128 px;
+    __m128 py;
+    __m128 pz;
+    uint32 i;
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        px = _mm_loadu_ps( x + i );
+        py = _mm_loadu_ps( y + i );
+        pz = _mm_loadu_ps( z + i );
+        normalizeLanes( &px, &py, &pz );
+        _mm_storeu_ps( outX + i, px );
+        _mm_storeu_ps( outY + i, py );
+        _mm_storeu_ps( outZ + i, pz );
+    }
+
+    normalizeScalar( x + i, y + i, z + i, outX + i, outY + i, outZ + i,
+                     count - i );
+}
+
+void normalizeAosSse( const float* in, float* out, uint32 count )
+{
+    __m128 px;
+    __m128 py;
+    __m128 pz;
+    uint32 i;
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        load3( in + i * 3, &px, &py, &pz );
+        normalizeLanes( &px, &py, &pz );
+        store3( out + i * 3, px, py, pz );
+    }
+
+    normalizeAosScalar( in + i * 3, out + i * 3, count - i );
+}
+
+void dotSse( const float* ax,
+             const float* ay,
+             const float* az,
+             const float* bx,
+             const float* by,
+             const float* bz,
+             float* out,
+             uint32 count )
+{
+    uint32 i;
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        _mm_storeu_ps( out + i, dotLanes( _mm_loadu_ps( ax + i ),
+                                          _mm_loadu_ps( ay + i ),
+                                          _mm_loadu_ps( az + i ),
+                                          _mm_loadu_ps( bx + i ),
+                                          _mm_loadu_ps( by + i ),
+                                          _mm_loadu_ps( bz + i ) ) );
+    }
+
+    dotScalar( ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i,
+               count - i );
+}
+
+void dotAosSse( const float* a, const float* b, float* out, uint32 count )
+{
+    __m128 ax;
+    __m128 ay;
+    __m128 az;
+    __m128 bx;
+    __m128 by;
+    __m128 bz;
+    uint32 i;
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        load3( a + i * 3, &ax, &ay, &az );
+        load3( b + i * 3, &bx, &by, &bz );
+        _mm_storeu_ps( out + i, dotLanes( ax, ay, az, bx, by, bz ) );
+    }
+
+    dotAosScalar( a + i * 3, b + i * 3, out + i, count - i );
+}
+
+void lerpSse( const float* a,
+              const float* b,
+              float t,
+              float* out,
+              uint32 count )
+{
+    __m128 pa;
+    __m128 pt = _mm_set1_ps( t );
+    uint32 i;
+
+    for ( i = 0; i + 4 <= count; i += 4 )
+    {
+        pa = _mm_loadu_ps( a + i );
+        _mm_storeu_ps( out + i, _mm_add_ps(
+            pa, _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( b + i ), pa ), pt ) ) );
+    }
+
+    lerpScalar( a + i, b + i, t, out + i, count - i );
+}
+
+const Kernels SSE_KERNELS = {
+    transformPointsSse,
+    transformPointsAosSse,
+    transform2DSse,
+    transform2DAosSse,
+    normalizeSse,
+    normalizeAosSse,
+    dotSse,
+    dotAosSse,
+    lerpSse
+};
+#endif
+
+#ifdef NGE_MATH_AVX2
+// AVX2 HELPER FUNCTIONS
+__attribute__(( target( "avx2" ) ))
+inline
+void broadcast( const float* values, __m256* lanes, uint32 count )
+{
+    uint32 i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        lanes[i] = _mm256_set1_ps( values[i] );
+    }
+}
+
+__attribute__(( target( "avx2" ) ))
+inline
+void transformLanes( const __m256* m, __m256* x, __m256* y, __m256* z )
+{
+    __m256 r[3];
+    uint32 i;
+
+    for ( i = 0; i < 3; ++i )
+    {
+        r[i] = _mm256_add_ps(
+            _mm256_add_ps(
+                _mm256_add_ps( _mm256_mul_ps( m[i * 4], *x ),
+                               _mm256_mul_ps( m[i * 4 + 1], *y ) ),
+                _mm256_mul_ps( m[i * 4 + 2], *z ) ),
+            m[i * 4 + 3] );
+    }
+
+    *x = r[0];
+    *y = r[1];
+    *z = r[2];
+}
+
+__attribute__(( target( "avx2" ) ))
+inline
+void transformLanes( const __m256* m, __m256* x, __m256* y )
+{
+    __m256 rx = _mm256_add_ps(
+        _mm256_add_ps( _mm256_mul_ps( m[0], *x ), _mm256_mul_ps( m[1], *y ) ),
+        m[2] );
+    __m256 ry = _mm256_add_ps(
+        _mm256_add_ps( _mm256_mul_ps( m[3], *x ), _mm256_mul_ps( m[4], *y ) ),
+        m[5] );
+
+    *x = rx;
+    *y = ry;
+}
+
+__attribute__(( target( "avx2" ) ))
+inline
+void normalizeLanes( __m256* x, __m256* y, __m256* z )
+{
+    __m256 length = _mm256_sqrt_ps( _mm256_add_ps(
+        _mm256_add_ps( _mm256_mul_ps( *x, *x ), _mm256_mul_ps( *y, *y ) ),
+        _mm256_mul_ps( *z, *z ) ) );
+
+    *x = _mm256_div_ps( *x, length );
+    *y = _mm256_div_ps( *y, length );
+    *z = _mm256_div_ps( *z, length );
+}
+
+// AVX2 KERNELS
+// the AoS kernels stay on SSE, since splitting 3D vectors into components
+// takes lane crossing shuffles that cost more than the wider lanes gain
+__attribute__(( target( "avx2" ) ))
+void transformPointsAvx2( const float* m,
+                          const float* x,
+                          const float* y,
+                          const float* z,
+                          float* outX,
+                          float* outY,
+                          float* outZ,
+                          uint32 count )
+{
+    __m256 px;
+    __m256 py;
+    __m256 pz;
+    __m256 rows[12];
+    uint32 i;
+
+    broadcast( m, rows, 12 );
+
+    for ( i = 0; i + 8 <= count; i += 8 )
+    {
+        px = _mm256_loadu_ps( x + i );
+        py = _mm256_loadu_ps( y + i );
+        pz = _mm256_loadu_ps( z + i );
+        transformLanes( rows, &px, &py, &pz );
+        _mm256_storeu_ps( outX + i, px );
+        _mm256_storeu_ps( outY + i, py );
+        _mm256_storeu_ps( outZ + i, pz );
+    }
+
+    transformPointsSse( m, x + i, y + i, z + i, outX + i, outY + i,
+                        outZ + i, count - i );
+}
+
+__attribute__(( target( "avx2" ) ))
+void transform2DAvx2( const float* m,
+                      const float* x,
+                      const float* y,
+                      float* outX,
+                      float* outY,
+                      uint32 count )
+{
+    __m256 px;
+    __m256 py;
+    __m256 rows[6];
+    uint32 i;
+
+    broadcast( m, rows, 6 );
+
+    for ( i = 0; i + 8 <= count; i += 8 )
+    {
+        px = _mm256_loadu_ps( x + i );
+        py = _mm256_loadu_ps( y + i );
+        transformLanes( rows, &px, &py );
+        _mm256_storeu_ps( outX + i, px );
+        _mm256_storeu_ps( outY + i, py );
+    }
+
+    transform2DSse( m, x + i, y + i, outX + i, outY + i, count - i );
+}
+
+__attribute__(( target( "avx2" ) ))
+void normalizeAvx2( const float* x,
+                    const float* y,
+                    const float* z,
+                    float* outX,
+                    float* outY,
+                    float* outZ,
+                    uint32 count )
+{
+    __m256 px;
+    __m256 py;
+    __m256 pz;
+    uint32 i;
+
+    for ( i = 0; i + 8 <= count; i += 8 )
+    {
+        px = _mm256_loadu_ps( x + i );
+        py = _mm256_loadu_ps( y + i );
+        pz = _mm256_loadu_ps( z + i );
+        normalizeLanes( &px, &py, &pz );
+        _mm256_storeu_ps( outX + i, px );
+        _mm256_storeu_ps( outY + i, py );
+        _mm256_storeu_ps( outZ + i, pz );
+    }
+
+    normalizeSse( x + i, y + i, z + i, outX + i, outY + i, outZ + i,
+                  count - i );
+}
+
+__attribute__(( target( "avx2" ) ))
+void dotAvx2( const float* ax,
+              const float* ay,
+              const float* az,
+              const float* bx,
+              const float* by,
+              const float* bz,
+              float* out,
+              uint32 count )
+{
+    __m256 sum;
+    uint32 i;
+
+    for ( i = 0; i + 8 <= count; i += 8 )
+    {
+        sum = _mm256_add_ps(
+            _mm256_mul_ps( _mm256_loadu_ps( ax + i ),
+                           _mm256_loadu_ps( bx + i ) ),
+            _mm256_mul_ps( _mm256_loadu_ps( ay + i ),
+                           _mm256_loadu_ps( by + i ) ) );
+        sum = _mm256_add_ps(
+            sum, _mm256_mul_ps( _mm256_loadu_ps( az + i ),
+                                _mm256_loadu_ps( bz + i ) ) );
+        _mm256_storeu_ps( out + i, sum );
+    }
+
+    dotSse( ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i,
+            count - i );
+}
+
+__attribute__(( target( "avx2" ) ))
+void lerpAvx2( const float* a,
+               const float* b,
+               float t,
+               float* out,
+               uint32 count )
+{
+    __m256 pa;
+    __m256 pt = _mm256_set1_ps( t );
+    uint32 i;
+
+    for ( i = 0; i + 8 <= count; i += 8 )
+    {
+        pa = _mm256_loadu_ps( a + i );
+        _mm256_storeu_ps( out + i, _mm256_add_ps(
+            pa, _mm256_mul_ps( _mm256_sub_ps( _mm256_loadu_ps( b + i ), pa ),
+                               pt ) ) );
+    }
+
+    lerpSse( a + i, b + i, t, out + i, count - i );
+}
+
+const Kernels AVX2_KERNELS = {
+    transformPointsAvx2,
+    transformPointsAosSse,
+    transform2DAvx2,
+    transform2DAosSse,
+    normalizeAvx2,
+    normalizeAosSse,
+    dotAvx2,
+    dotAosSse,
+    lerpAvx2
+};
+#endif
+
+// HELPER FUNCTIONS
+/**
+ * Gets the instructions that the kernels use.
+ */
+Batch::Instructions& current()
+{
+    static Batch::Instructions instructions = Batch::supported();
+
+    return instructions;
+}
+
+/**
+ * Gets the kernels of the instructions that are used.
+ */
+const Kernels& kernels()
+{
+    switch ( current() )
+    {
+#ifdef NGE_MATH_AVX2
+      case Batch::AVX2:
+        return AVX2_KERNELS;
+#endif
+#ifdef NGE_MATH_SSE
+      case Batch::SSE:
+        return SSE_KERNELS;
+#endif
+      default:
+        return SCALAR_KERNELS;
+    }
+}
+
+/**
+ * Gets the item of the array at the index and lowers the count to the
+ * number of items that follow it in the same run.
+ */
+template <typename T>
+const T* at( const ArrayIn<T>& array, uint32 index, uint32* count )
+{
+    uint32 run = index < array.size( 0 ) ? 0 : 1;
+
+    index -= run == 0 ? 0 : array.size( 0 );
+    *count = std::min( *count, array.size( run ) - index );
+    return array.values( run ) + index;
+}
+
+/**
+ * Gets the item of the array at the index and lowers the count to the
+ * number of items that follow it in the same run.
+ */
+template <typename T>
+T* at( const ArrayOut<T>& array, uint32 index, uint32* count )
+{
+    uint32 run = index < array.size( 0 ) ? 0 : 1;
+
+    index -= run == 0 ? 0 : array.size( 0 );
+    *count = std::min( *count, array.size( run ) - index );
+    return array.values( run ) + index;
+}
+
+} // End nspc anonymous
+
+// MEMBER FUNCTIONS
+Batch::Instructions Batch::instructions()
+{
+    return current();
+}
+
+Batch::Instructions Batch::supported()
+{
+#ifdef NGE_MATH_AVX2
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx2" ) )
+    {
+        return AVX2;
+    }
+#endif
+
+#ifdef NGE_MATH_SSE
+    return SSE;
+#else
+    return SCALAR;
+#endif
+}
+
+void Batch::setInstructions( Instructions instructions )
+{
+    assert( instructions <= supported() );
+    current() = instructions;
+}
+
+// TRANSFORMS
+void Batch::transformPoints( const Mat4& m,
+                             ArrayIn<Vec3> in,
+                             ArrayOut<Vec3> out )
+{
+    float rows[12];
+    const Vec3* source;
+    Vec3* target;
+    uint32 count;
+    uint32 i;
+
+    assert( out.size() >= in.size() );
+
+    for ( i = 0; i < 12; ++i )
+    {
+        rows[i] = m[i % 4][i / 4];
+    }
+
+    for ( i = 0; i < in.size(); i += count )
+    {
+        count = in.size() - i;
+        source = at( in, i, &count );
+        target = at( out, i, &count );
+
+        kernels().transformPointsAos( rows, &source->x, &target->x, count );
+    }
+}
+
+void Batch::transformPoints( const Mat4& m,
+                             ArrayIn<float> x,
+                             ArrayIn<float> y,
+                             ArrayIn<float> z,
+                             ArrayOut<float> outX,
+                             ArrayOut<float> outY,
+                             ArrayOut<float> outZ )
+{
+    float rows[12];
+    const float* px;
+    const float* py;
+    const float* pz;
+    float* ox;
+    float* oy;
+    float* oz;
+    uint32 count;
+    uint32 i;
+
+    assert( y.size() == x.size() && z.size() == x.size() );
+    assert( outX.size() == x.size() && outY.size() == x.size() &&
+            outZ.size() == x.size() );
+
+    for ( i = 0; i < 12; ++i )
+    {
+        rows[i] = m[i % 4][i / 4];
+    }
+
+    for ( i = 0; i < x.size(); i += count )
+    {
+        count = x.size() - i;
+        px = at( x, i, &count );
+        py = at( y, i, &count );
+        pz = at( z, i, &count );
+        ox = at( outX, i, &count );
+        oy = at( outY, i, &count );
+        oz = at( outZ, i, &count );
+
+        kernels().transformPoints( rows, px, py, pz, ox, oy, oz, count );
+    }
+}
+
+void Batch::transform2D( const Mat3& m,
+                         ArrayIn<Vec2> in,
+                         ArrayOut<Vec2> out )
+{
+    float rows[6];
+    const Vec2* source;
+    Vec2* target;
+    uint32 count;
+    uint32 i;
+
+    assert( out.size() >= in.size() );
+
+    for ( i = 0; i < 6; ++i )
+    {
+        rows[i] = m[i % 3][i / 3];
+    }
+
+    for ( i = 0; i < in.size(); i += count )
+    {
+        count = in.size() - i;
+        source = at( in, i, &count );
+        target = at( out, i, &count );
+
+        kernels().transform2DAos( rows, &source->x, &target->x, count );
+    }
+}
+
+void Batch::transform2D( const Mat3& m,
+                         ArrayIn<float> x,
+                         ArrayIn<float> y,
+                         ArrayOut<float> outX,
+                         ArrayOut<float> outY )
+{
+    float rows[6];
+    const float* px;
+    const float* py;
+    float* ox;
+    float* oy;
+    uint32 count;
+    uint32 i;
+
+    assert( y.size() == x.size() );
+    assert( outX.size() == x.size() && outY.size() == x.size() );
+
+    for ( i = 0; i < 6; ++i )
+    {
+        rows[i] = m[i % 3][i / 3];
+    }
+
+    for ( i = 0; i < x.size(); i += count )
+    {
+        count = x.size() - i;
+        px = at( x, i, &count );
+        py = at( y, i, &count );
+        ox = at( outX, i, &count );
+        oy = at( outY, i, &count );
+
+        kernels().transform2D( rows, px, py, ox, oy, count );
+    }
+}
+
+// VECTOR FUNCTIONS
+void Batch::normalizeAll( ArrayIn<Vec3> in, ArrayOut<Vec3> out )
+{
+    const Vec3* source;
+    Vec3* target;
+    uint32 count;
+    uint32 i;
+
+    assert( out.size() >= in.size() );
+
+    for ( i = 0; i < in.size(); i += count )
+    {
+        count = in.size() - i;
+        source = at( in, i, &count );
+        target = at( out, i, &count );
+
+        kernels().normalizeAos( &source->x, &target->x, count );
+    }
+}
+
+void Batch::normalizeAll( ArrayIn<float> x,
+                          ArrayIn<float> y,
+                          ArrayIn<float> z,
+                          ArrayOut<float> outX,
+                          ArrayOut<float> outY,
+                          ArrayOut<float> outZ )
+{
+    const float* px;
+    const float* py;
+    const float* pz;
+    float* ox;
+    float* oy;
+    float* oz;
+    uint32 count;
+    uint32 i;
+
+    assert( y.size() == x.size() && z.size() == x.size() );
+    assert( outX.size() == x.size() && outY.size() == x.size() &&
+            outZ.size() == x.size() );
+
+    for ( i = 0; i < x.size(); i += count )
+    {
+        count = x.size() - i;
+        px = at( x, i, &count );
+        py = at( y, i, &count );
+        pz = at( z, i, &count );
+        ox = at( outX, i, &count );
+        oy = at( outY, i, &count );
+        oz = at( outZ, i, &count );
+
+        kernels().normalize( px, py, pz, ox, oy, oz, count );
+    }
+}
+
+void Batch::dotMany( ArrayIn<Vec3> a, ArrayIn<Vec3> b, ArrayOut<float> out )
+{
+    const Vec3* sourceA;
+    const Vec3* sourceB;
+    float* target;
+    uint32 count;
+    uint32 i;
+
+    assert( b.size() == a.size() && out.size() == a.size() );
+
+    for ( i = 0; i < a.size(); i += count )
+    {
+        count = a.size() - i;
+        sourceA = at( a, i, &count );
+        sourceB = at( b, i, &count );
+        target = at( out, i, &count );
+
+        kernels().dotAos( &sourceA->x, &sourceB->x, target, count );
+    }
+}
+
+void Batch::dotMany( ArrayIn<float> ax,
+                     ArrayIn<float> ay,
+                     ArrayIn<float> az,
+                     ArrayIn<float> bx,
+                     ArrayIn<float> by,
+                     ArrayIn<float> bz,
+                     ArrayOut<float> out )
+{
+    const float* pax;
+    const float* pay;
+    const float* paz;
+    const float* pbx;
+    const float* pby;
+    const float* pbz;
+    float* target;
+    uint32 count;
+    uint32 i;
+
+    assert( ay.size() == ax.size() && az.size() == ax.size() );
+    assert( bx.size() == ax.size() && by.size() == ax.size() &&
+            bz.size() == ax.size() );
+    assert( out.size() == ax.size() );
+
+    for ( i = 0; i < ax.size(); i += count )
+    {
+        count = ax.size() - i;
+        pax = at( ax, i, &count );
+        pay = at( ay, i, &count );
+        paz = at( az, i, &count );
+        pbx = at( bx, i, &count );
+        pby = at( by, i, &count );
+        pbz = at( bz, i, &count );
+        target = at( out, i, &count );
+
+        kernels().dot( pax, pay, paz, pbx, pby, pbz, target, count );
+    }
+}
+
+void Batch::lerpMany( ArrayIn<Vec3> a,
+                      ArrayIn<Vec3> b,
+                      float t,
+                      ArrayOut<Vec3> out )
+{
+    const Vec3* sourceA;
+    const Vec3* sourceB;
+    Vec3* target;
+    uint32 count;
+    uint32 i;
+
+    assert( b.size() == a.size() && out.size() == a.size() );
+
+    // interpolation treats every component the same, so each run of
+    // vectors is interpolated as a run of floats
+    for ( i = 0; i < a.size(); i += count )
+    {
+        count = a.size() - i;
+        sourceA = at( a, i, &count );
+        sourceB = at( b, i, &count );
+        target = at( out, i, &count );
+
+        kernels().lerp( &sourceA->x, &sourceB->x, t, &target->x, count * 3 );
+    }
+}
+
+void Batch::lerpMany( ArrayIn<float> a,
+                      ArrayIn<float> b,
+                      float t,
+                      ArrayOut<float> out )
+{
+    const float* sourceA;
+    const float* sourceB;
+    float* target;
+    uint32 count;
+    uint32 i;
+
+    assert( b.size() == a.size() && out.size() == a.size() );
+
+    for ( i = 0; i < a.size(); i += count )
+    {
+        count = a.size() - i;
+        sourceA = at( a, i, &count );
+        sourceB = at( b, i, &count );
+        target = at( out, i, &count );
+
+        kernels().lerp( sourceA, sourceB, t, target, count );
+    }
+}
+
+} // End nspc math
+
+} // End nspc nge
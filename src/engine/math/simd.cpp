@@ -0,0 +1,2 @@
+// simd.cpp
+#include "engine/math/simd.h"
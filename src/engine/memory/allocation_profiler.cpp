@@ -0,0 +1,630 @@
+// allocation_profiler.cpp
+#include "engine/memory/allocation_profiler.h"
+
+#include <assert.h>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined( __GLIBC__ ) || defined( __APPLE__ )
+#include <execinfo.h>
+#define NGE_MEM_HAS_BACKTRACE
+#endif
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 AllocationProfiler::MAX_DEPTH;
+constexpr uint32 AllocationProfiler::MAX_SITES;
+constexpr uint32 AllocationProfiler::DEFAULT_CAPACITY;
+
+/**
+ * The pointer of a record that was never used.
+ */
+static constexpr uintptr_t EMPTY = 0;
+
+/**
+ * The pointer of a record whose allocation was released.
+ */
+static constexpr uintptr_t RELEASED = 1;
+
+/**
+ * The number of frames of the profiler itself at the top of a backtrace.
+ */
+static constexpr uint32 SKIPPED_FRAMES = 2;
+
+/**
+ * The allocation table is rebuilt once more than one in this many of its
+ * records are released.
+ */
+static constexpr uint32 PURGE_RATIO = 4;
+
+// HELPER FUNCTIONS
+uint32 AllocationProfiler::findSite()
+{
+    void* frames[MAX_DEPTH + SKIPPED_FRAMES];
+    uint64 hash = 14695981039346656037ull;
+    uint64 current;
+    uint32 depth = 0;
+    uint32 index;
+    uint32 i;
+    uint32 j;
+
+#ifdef NGE_MEM_HAS_BACKTRACE
+    depth = static_cast<uint32>(
+        backtrace( frames, MAX_DEPTH + SKIPPED_FRAMES ) );
+    depth = depth > SKIPPED_FRAMES ? depth - SKIPPED_FRAMES : 0;
+#endif
+
+    for ( i = 0; i < depth; ++i )
+    {
+        hash ^= reinterpret_cast<uintptr_t>( frames[i + SKIPPED_FRAMES] );
+        hash *= 1099511628211ull;
+    }
+    hash = hash != 0 ? hash : 1;
+
+    for ( i = 0; i < MAX_SITES; ++i )
+    {
+        index = static_cast<uint32>( hash + i ) & ( MAX_SITES - 1 );
+        SiteEntry& entry = _sites[index];
+
+        current = entry.hash.load( std::memory_order_acquire );
+        if ( current == 0 &&
+             entry.hash.compare_exchange_strong( current, hash ) )
+        {
+            for ( j = 0; j < depth; ++j )
+            {
+                entry.frames[j] = frames[j + SKIPPED_FRAMES];
+            }
+            entry.depth = depth;
+            entry.ready.store( true, std::memory_order_release );
+
+            return index;
+        }
+
+        if ( current == hash )
+        {
+            // another thread is still writing the backtrace
+            while ( !entry.ready.load( std::memory_order_acquire ) )
+            {
+                std::this_thread::yield();
+            }
+
+            return index;
+        }
+    }
+
+    return MAX_SITES;
+}
+
+AllocationProfiler::Record* AllocationProfiler::findRecord(
+    const void* pointer )
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>( pointer );
+    uintptr_t current;
+    uint32 index;
+    uint32 i;
+
+    for ( i = 0; i < _capacity; ++i )
+    {
+        index = static_cast<uint32>( ( address >> 4 ) + i ) & ( _capacity - 1 );
+        current = _records[index].pointer.load( std::memory_order_relaxed );
+        if ( current == EMPTY )
+        {
+            return nullptr;
+        }
+
+        if ( current == address )
+        {
+            return &_records[index];
+        }
+    }
+
+    return nullptr;
+}
+
+void AllocationProfiler::enter()
+{
+    for ( ;; )
+    {
+        while ( _purging.load() )
+        {
+            std::this_thread::yield();
+        }
+
+        // announce the thread before checking again so that a purge that
+        // starts now waits for it
+        _recorders.fetch_add( 1 );
+        if ( !_purging.load() )
+        {
+            return;
+        }
+        _recorders.fetch_sub( 1 );
+    }
+}
+
+void AllocationProfiler::leave()
+{
+    _recorders.fetch_sub( 1 );
+}
+
+void AllocationProfiler::purge()
+{
+    Record* records;
+    uintptr_t address;
+    uint32 index;
+    uint32 i;
+    uint32 j;
+    bool expected = false;
+
+    if ( !_purging.compare_exchange_strong( expected, true ) )
+    {
+        return;
+    }
+
+    while ( _recorders.load() > 0 )
+    {
+        std::this_thread::yield();
+    }
+
+    // another thread may have purged while this one waited
+    if ( _released.load() > _capacity / PURGE_RATIO )
+    {
+        records = new Record[_capacity];
+        for ( i = 0; i < _capacity; ++i )
+        {
+            records[i].pointer = EMPTY;
+            records[i].bytes = 0;
+            records[i].site = MAX_SITES;
+        }
+
+        for ( i = 0; i < _capacity; ++i )
+        {
+            address = _records[i].pointer.load( std::memory_order_relaxed );
+            if ( address <= RELEASED )
+            {
+                continue;
+            }
+
+            for ( j = 0; j < _capacity; ++j )
+            {
+                index = static_cast<uint32>( ( address >> 4 ) + j ) &
+                        ( _capacity - 1 );
+                if ( records[index].pointer == EMPTY )
+                {
+                    records[index].pointer = address;
+                    records[index].bytes = _records[i].bytes.load();
+                    records[index].site = _records[i].site.load();
+                    break;
+                }
+            }
+        }
+
+        delete[] _records;
+        _records = records;
+        _released = 0;
+    }
+
+    _purging.store( false );
+}
+
+void AllocationProfiler::snapshot( Site* site, uint32 index ) const
+{
+    const SiteEntry& entry = _sites[index];
+    uint32 i;
+
+    for ( i = 0; i < entry.depth; ++i )
+    {
+        site->frames[i] = entry.frames[i];
+    }
+    site->depth = entry.depth;
+    site->count = entry.count.load( std::memory_order_relaxed );
+    site->bytes = entry.bytes.load( std::memory_order_relaxed );
+    site->frameCount = entry.frameCount.load( std::memory_order_relaxed );
+    site->frameBytes = entry.frameBytes.load( std::memory_order_relaxed );
+    site->liveCount = entry.liveCount.load( std::memory_order_relaxed );
+    site->liveBytes = entry.liveBytes.load( std::memory_order_relaxed );
+}
+
+void AllocationProfiler::writeSiteText( std::ostream& stream,
+                                        const Site& site )
+{
+    uint32 i;
+
+    stream << "  " << site.frameCount << " allocations, "
+           << site.frameBytes << " bytes this frame, "
+           << site.liveCount << " allocations, "
+           << site.liveBytes << " bytes live\n";
+
+#ifdef NGE_MEM_HAS_BACKTRACE
+    char** symbols = backtrace_symbols( site.frames, site.depth );
+    for ( i = 0; i < site.depth; ++i )
+    {
+        stream << "    at "
+               << ( symbols != nullptr ? symbols[i] : "??" ) << '\n';
+    }
+    std::free( symbols );
+#else
+    for ( i = 0; i < site.depth; ++i )
+    {
+        stream << "    at " << site.frames[i] << '\n';
+    }
+#endif
+}
+
+void AllocationProfiler::writeSiteJson( std::ostream& stream,
+                                        const Site& site )
+{
+    const char* symbol;
+    uint32 i;
+
+    stream << "{\"frameCount\":" << site.frameCount
+           << ",\"frameBytes\":" << site.frameBytes
+           << ",\"count\":" << site.count
+           << ",\"bytes\":" << site.bytes
+           << ",\"liveCount\":" << site.liveCount
+           << ",\"liveBytes\":" << site.liveBytes
+           << ",\"frames\":[";
+
+#ifdef NGE_MEM_HAS_BACKTRACE
+    char** symbols = backtrace_symbols( site.frames, site.depth );
+#endif
+    for ( i = 0; i < site.depth; ++i )
+    {
+        stream << ( i > 0 ? ",\"" : "\"" );
+#ifdef NGE_MEM_HAS_BACKTRACE
+        symbol = symbols != nullptr ? symbols[i] : "??";
+#else
+        symbol = "??";
+#endif
+        for ( ; *symbol != '\0'; ++symbol )
+        {
+            if ( *symbol == '"' || *symbol == '\\' )
+            {
+                stream << '\\';
+            }
+            stream << ( static_cast<uint8>( *symbol ) < 0x20 ? ' ' : *symbol );
+        }
+        stream << '"';
+    }
+#ifdef NGE_MEM_HAS_BACKTRACE
+    std::free( symbols );
+#endif
+
+    stream << "]}";
+}
+
+// CONSTRUCTORS
+AllocationProfiler::AllocationProfiler()
+    : AllocationProfiler( DEFAULT_CAPACITY )
+{
+}
+
+AllocationProfiler::AllocationProfiler( uint32 capacity )
+    : _sites( new SiteEntry[MAX_SITES] ), _records( new Record[capacity] ),
+      _capacity( capacity ), _liveCount( 0 ), _liveBytes( 0 ),
+      _dropped( 0 ), _frame( 0 ), _released( 0 ), _recorders( 0 ),
+      _purging( false ), _logger( nullptr )
+{
+    uint32 i;
+
+    assert( capacity > 0 && ( capacity & ( capacity - 1 ) ) == 0 );
+
+    for ( i = 0; i < MAX_SITES; ++i )
+    {
+        _sites[i].hash = 0;
+        _sites[i].ready = false;
+        _sites[i].depth = 0;
+        _sites[i].count = 0;
+        _sites[i].bytes = 0;
+        _sites[i].frameCount = 0;
+        _sites[i].frameBytes = 0;
+        _sites[i].liveCount = 0;
+        _sites[i].liveBytes = 0;
+    }
+
+    for ( i = 0; i < _capacity; ++i )
+    {
+        _records[i].pointer = EMPTY;
+        _records[i].bytes = 0;
+        _records[i].site = MAX_SITES;
+    }
+}
+
+AllocationProfiler::~AllocationProfiler()
+{
+    std::ostringstream leaks;
+
+    if ( _logger != nullptr && liveCount() > 0 )
+    {
+        writeLeaks( leaks );
+        _logger->w( "memory", leaks.str() );
+    }
+
+    delete[] _sites;
+    delete[] _records;
+}
+
+// MEMBER FUNCTIONS
+void AllocationProfiler::setLogger( util::Logger* logger )
+{
+    _logger = logger;
+}
+
+void AllocationProfiler::recordGet( const void* pointer, uint64 bytes )
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>( pointer );
+    uintptr_t current;
+    uint32 site = findSite();
+    uint32 index;
+    uint32 i;
+
+    assert( address > RELEASED );
+
+    if ( site < MAX_SITES )
+    {
+        _sites[site].count.fetch_add( 1, std::memory_order_relaxed );
+        _sites[site].bytes.fetch_add( bytes, std::memory_order_relaxed );
+        _sites[site].frameCount.fetch_add( 1, std::memory_order_relaxed );
+        _sites[site].frameBytes.fetch_add( bytes, std::memory_order_relaxed );
+    }
+
+    enter();
+    for ( i = 0; i < _capacity; ++i )
+    {
+        index = static_cast<uint32>( ( address >> 4 ) + i ) & ( _capacity - 1 );
+        Record& record = _records[index];
+
+        current = record.pointer.load( std::memory_order_relaxed );
+        if ( ( current == EMPTY || current == RELEASED ) &&
+             record.pointer.compare_exchange_strong( current, address ) )
+        {
+            if ( current == RELEASED )
+            {
+                _released.fetch_sub( 1, std::memory_order_relaxed );
+            }
+
+            record.bytes.store( bytes, std::memory_order_relaxed );
+            record.site.store( site, std::memory_order_relaxed );
+
+            _liveCount.fetch_add( 1, std::memory_order_relaxed );
+            _liveBytes.fetch_add( bytes, std::memory_order_relaxed );
+            if ( site < MAX_SITES )
+            {
+                _sites[site].liveCount.fetch_add(
+                    1, std::memory_order_relaxed );
+                _sites[site].liveBytes.fetch_add(
+                    bytes, std::memory_order_relaxed );
+            }
+
+            leave();
+            return;
+        }
+    }
+    leave();
+
+    _dropped.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void AllocationProfiler::recordRelease( const void* pointer )
+{
+    Record* record;
+    uint64 bytes;
+    uint32 released;
+    uint32 site;
+
+    enter();
+    record = findRecord( pointer );
+    if ( record == nullptr )
+    {
+        leave();
+        return;
+    }
+
+    bytes = record->bytes.load( std::memory_order_relaxed );
+    site = record->site.load( std::memory_order_relaxed );
+    record->pointer.store( RELEASED, std::memory_order_relaxed );
+    released = _released.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    leave();
+
+    _liveCount.fetch_sub( 1, std::memory_order_relaxed );
+    _liveBytes.fetch_sub( bytes, std::memory_order_relaxed );
+    if ( site < MAX_SITES )
+    {
+        _sites[site].liveCount.fetch_sub( 1, std::memory_order_relaxed );
+        _sites[site].liveBytes.fetch_sub( bytes, std::memory_order_relaxed );
+    }
+
+    if ( released > _capacity / PURGE_RATIO )
+    {
+        purge();
+    }
+}
+
+void AllocationProfiler::recordGrow( const void* pointer, uint64 bytes )
+{
+    Record* record;
+    uint32 site;
+
+    enter();
+    record = findRecord( pointer );
+    if ( record == nullptr )
+    {
+        leave();
+        return;
+    }
+
+    site = record->site.load( std::memory_order_relaxed );
+    record->bytes.fetch_add( bytes, std::memory_order_relaxed );
+    leave();
+
+    _liveBytes.fetch_add( bytes, std::memory_order_relaxed );
+    if ( site < MAX_SITES )
+    {
+        _sites[site].bytes.fetch_add( bytes, std::memory_order_relaxed );
+        _sites[site].frameBytes.fetch_add( bytes, std::memory_order_relaxed );
+        _sites[site].liveBytes.fetch_add( bytes, std::memory_order_relaxed );
+    }
+}
+
+void AllocationProfiler::endFrame()
+{
+    uint32 i;
+
+    for ( i = 0; i < MAX_SITES; ++i )
+    {
+        _sites[i].frameCount.store( 0, std::memory_order_relaxed );
+        _sites[i].frameBytes.store( 0, std::memory_order_relaxed );
+    }
+
+    _frame.fetch_add( 1, std::memory_order_relaxed );
+}
+
+uint32 AllocationProfiler::topSites( Site* sites, uint32 count,
+                                     Order order ) const
+{
+    const uint64 Site::* key;
+    Site site;
+    uint32 size = 0;
+    uint32 i;
+    uint32 j;
+
+    if ( count == 0 )
+    {
+        return 0;
+    }
+
+    switch ( order )
+    {
+      case FRAME_COUNT: key = &Site::frameCount; break;
+      case FRAME_BYTES: key = &Site::frameBytes; break;
+      case LIVE_COUNT: key = &Site::liveCount; break;
+      default: key = &Site::liveBytes; break;
+    }
+
+    for ( i = 0; i < MAX_SITES; ++i )
+    {
+        if ( !_sites[i].ready.load( std::memory_order_acquire ) )
+        {
+            continue;
+        }
+
+        snapshot( &site, i );
+        if ( site.*key == 0 ||
+             ( size == count && site.*key <= sites[size - 1].*key ) )
+        {
+            continue;
+        }
+
+        // insert the site in order, dropping the smallest when full
+        j = size < count ? size++ : size - 1;
+        for ( ; j > 0 && sites[j - 1].*key < site.*key; --j )
+        {
+            sites[j] = sites[j - 1];
+        }
+        sites[j] = site;
+    }
+
+    return size;
+}
+
+uint64 AllocationProfiler::liveCount() const
+{
+    return _liveCount.load( std::memory_order_relaxed );
+}
+
+uint64 AllocationProfiler::liveBytes() const
+{
+    return _liveBytes.load( std::memory_order_relaxed );
+}
+
+uint64 AllocationProfiler::dropped() const
+{
+    return _dropped.load( std::memory_order_relaxed );
+}
+
+uint64 AllocationProfiler::frame() const
+{
+    return _frame.load( std::memory_order_relaxed );
+}
+
+void AllocationProfiler::writeText( std::ostream& stream,
+                                    uint32 count ) const
+{
+    std::vector<Site> sites( count );
+    uint32 size;
+    uint32 i;
+
+    stream << "frame " << frame() << ": " << liveCount()
+           << " allocations, " << liveBytes() << " bytes live, "
+           << dropped() << " dropped\n";
+
+    size = topSites( sites.data(), count, FRAME_COUNT );
+    stream << "top sites by count:\n";
+    for ( i = 0; i < size; ++i )
+    {
+        writeSiteText( stream, sites[i] );
+    }
+
+    size = topSites( sites.data(), count, FRAME_BYTES );
+    stream << "top sites by bytes:\n";
+    for ( i = 0; i < size; ++i )
+    {
+        writeSiteText( stream, sites[i] );
+    }
+}
+
+void AllocationProfiler::writeJson( std::ostream& stream,
+                                    uint32 count ) const
+{
+    std::vector<Site> sites( count );
+    uint32 size;
+    uint32 i;
+
+    stream << "{\"frame\":" << frame()
+           << ",\"liveCount\":" << liveCount()
+           << ",\"liveBytes\":" << liveBytes()
+           << ",\"dropped\":" << dropped()
+           << ",\"byCount\":[";
+
+    size = topSites( sites.data(), count, FRAME_COUNT );
+    for ( i = 0; i < size; ++i )
+    {
+        stream << ( i > 0 ? "," : "" );
+        writeSiteJson( stream, sites[i] );
+    }
+
+    stream << "],\"byBytes\":[";
+
+    size = topSites( sites.data(), count, FRAME_BYTES );
+    for ( i = 0; i < size; ++i )
+    {
+        stream << ( i > 0 ? "," : "" );
+        writeSiteJson( stream, sites[i] );
+    }
+
+    stream << "]}";
+}
+
+void AllocationProfiler::writeLeaks( std::ostream& stream ) const
+{
+    std::vector<Site> sites( MAX_SITES );
+    uint32 size = topSites( sites.data(), MAX_SITES, LIVE_BYTES );
+    uint32 i;
+
+    stream << liveCount() << " allocations, " << liveBytes()
+           << " bytes leaked\n";
+    for ( i = 0; i < size; ++i )
+    {
+        writeSiteText( stream, sites[i] );
+    }
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,99 @@
+// allocation_registry.cpp
+#include "engine/memory/allocation_registry.h"
+
+#include <new>
+
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+// HELPER FUNCTIONS
+AllocationRegistry::Table& AllocationRegistry::table()
+{
+    // never destructed so allocators in static storage can still record
+    static Table* table = new Table{ {}, nullptr, 0 };
+    return *table;
+}
+
+// STATIC FUNCTIONS
+AllocationTracker* AllocationRegistry::tracker( const String& tag )
+{
+    Table& trackers = table();
+    AllocationTracker* tracker;
+    void* memory;
+
+    std::lock_guard<std::mutex> lock( trackers.mutex );
+    for ( tracker = trackers.first; tracker != nullptr;
+          tracker = tracker->_next )
+    {
+        if ( tracker->_tag == tag )
+        {
+            return tracker;
+        }
+    }
+
+    // the shards are over aligned so operator new cannot be used
+    memory = MemoryUtils::allocateAligned( sizeof( AllocationTracker ),
+                                           alignof( AllocationTracker ) );
+    tracker = new ( memory ) AllocationTracker( tag );
+    tracker->_next = trackers.first;
+    trackers.first = tracker;
+    ++trackers.size;
+
+    return tracker;
+}
+
+AllocationTracker* AllocationRegistry::find( const String& tag )
+{
+    Table& trackers = table();
+    AllocationTracker* tracker;
+
+    std::lock_guard<std::mutex> lock( trackers.mutex );
+    for ( tracker = trackers.first; tracker != nullptr;
+          tracker = tracker->_next )
+    {
+        if ( tracker->_tag == tag )
+        {
+            return tracker;
+        }
+    }
+
+    return nullptr;
+}
+
+uint32 AllocationRegistry::size()
+{
+    Table& trackers = table();
+
+    std::lock_guard<std::mutex> lock( trackers.mutex );
+    return trackers.size;
+}
+
+AllocationTracker::Stats AllocationRegistry::total()
+{
+    AllocationTracker::Stats total = {};
+
+    forEach( [&total]( const AllocationTracker& tracker ) {
+        AllocationTracker::Stats stats = tracker.stats();
+        uint32 i;
+
+        total.liveBytes += stats.liveBytes;
+        total.peakBytes += stats.peakBytes;
+        total.allocations += stats.allocations;
+        total.releases += stats.releases;
+        for ( i = 0; i < AllocationTracker::SIZE_CLASSES; ++i )
+        {
+            total.histogram[i] += stats.histogram[i];
+        }
+    } );
+
+    return total;
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,169 @@
+// allocation_tracker.cpp
+#include "engine/memory/allocation_tracker.h"
+
+#include <assert.h>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 AllocationTracker::SIZE_CLASSES;
+constexpr uint32 AllocationTracker::SHARDS;
+
+// HELPER FUNCTIONS
+AllocationTracker::Shard& AllocationTracker::shard()
+{
+    static std::atomic<uint32> nextIndex( 0 );
+    static thread_local uint32 index = nextIndex++;
+
+    return _shards[index % SHARDS];
+}
+
+void AllocationTracker::addLiveBytes( uint64 bytes )
+{
+    uint64 live;
+    uint64 peak;
+
+    live = _liveBytes.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+    peak = _peakBytes.load( std::memory_order_relaxed );
+    while ( live > peak &&
+            !_peakBytes.compare_exchange_weak(
+                peak, live, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+// CONSTRUCTORS
+AllocationTracker::AllocationTracker( const String& tag )
+    : _liveBytes( 0 ), _peakBytes( 0 ), _tag( tag ), _next( nullptr )
+{
+    uint32 i;
+    uint32 j;
+
+    for ( i = 0; i < SHARDS; ++i )
+    {
+        _shards[i].allocations = 0;
+        _shards[i].releases = 0;
+        for ( j = 0; j < SIZE_CLASSES; ++j )
+        {
+            _shards[i].histogram[j] = 0;
+        }
+    }
+}
+
+AllocationTracker::~AllocationTracker()
+{
+}
+
+// STATIC FUNCTIONS
+uint32 AllocationTracker::sizeClass( uint64 bytes )
+{
+    uint32 index = 0;
+    uint64 limit = 16;
+
+    while ( bytes > limit && index < SIZE_CLASSES - 1 )
+    {
+        limit <<= 1;
+        ++index;
+    }
+
+    return index;
+}
+
+// MEMBER FUNCTIONS
+void AllocationTracker::recordGet( uint64 bytes )
+{
+    Shard& local = shard();
+
+    local.allocations.fetch_add( 1, std::memory_order_relaxed );
+    local.histogram[sizeClass( bytes )].fetch_add(
+        1, std::memory_order_relaxed );
+
+    addLiveBytes( bytes );
+}
+
+void AllocationTracker::recordGrow( uint64 bytes )
+{
+    addLiveBytes( bytes );
+}
+
+void AllocationTracker::recordRelease( uint64 bytes )
+{
+    Shard& local = shard();
+
+    assert( _liveBytes.load( std::memory_order_relaxed ) >= bytes );
+
+    local.releases.fetch_add( 1, std::memory_order_relaxed );
+    _liveBytes.fetch_sub( bytes, std::memory_order_relaxed );
+}
+
+void AllocationTracker::reset()
+{
+    uint32 i;
+    uint32 j;
+
+    for ( i = 0; i < SHARDS; ++i )
+    {
+        _shards[i].allocations = 0;
+        _shards[i].releases = 0;
+        for ( j = 0; j < SIZE_CLASSES; ++j )
+        {
+            _shards[i].histogram[j] = 0;
+        }
+    }
+
+    _peakBytes = _liveBytes.load();
+}
+
+AllocationTracker::Stats AllocationTracker::stats() const
+{
+    Stats stats;
+    uint32 i;
+    uint32 j;
+
+    stats.liveBytes = _liveBytes.load( std::memory_order_relaxed );
+    stats.peakBytes = _peakBytes.load( std::memory_order_relaxed );
+    stats.allocations = 0;
+    stats.releases = 0;
+    for ( j = 0; j < SIZE_CLASSES; ++j )
+    {
+        stats.histogram[j] = 0;
+    }
+
+    for ( i = 0; i < SHARDS; ++i )
+    {
+        stats.allocations +=
+            _shards[i].allocations.load( std::memory_order_relaxed );
+        stats.releases +=
+            _shards[i].releases.load( std::memory_order_relaxed );
+        for ( j = 0; j < SIZE_CLASSES; ++j )
+        {
+            stats.histogram[j] +=
+                _shards[i].histogram[j].load( std::memory_order_relaxed );
+        }
+    }
+
+    return stats;
+}
+
+uint64 AllocationTracker::liveBytes() const
+{
+    return _liveBytes.load( std::memory_order_relaxed );
+}
+
+uint64 AllocationTracker::peakBytes() const
+{
+    return _peakBytes.load( std::memory_order_relaxed );
+}
+
+const String& AllocationTracker::tag() const
+{
+    return _tag;
+}
+
+} // End nspc mem
+
+} // End nspc nge
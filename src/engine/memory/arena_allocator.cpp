@@ -0,0 +1,2 @@
+// arena_allocator.cpp
+#include "engine/memory/arena_allocator.h"
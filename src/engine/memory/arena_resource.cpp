@@ -0,0 +1,172 @@
+// arena_resource.cpp
+#include "engine/memory/arena_resource.h"
+
+#include <assert.h>
+#include <new>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 ArenaResource::DEFAULT_BLOCK_SIZE;
+
+// HELPER FUNCTIONS
+ArenaResource::Block* ArenaResource::makeBlock( uint32 capacity )
+{
+    Block* block = new Block;
+
+    block->bytes = static_cast<uint8*>( ::operator new( capacity ) );
+    block->capacity = capacity;
+    block->used = 0;
+    block->prev = nullptr;
+
+    return block;
+}
+
+void ArenaResource::freeBlock( Block* block )
+{
+    ::operator delete( block->bytes );
+    delete block;
+}
+
+uint32 ArenaResource::alignedOffset( const Block* block, uint32 align )
+{
+    uintptr_t address;
+
+    address = reinterpret_cast<uintptr_t>( block->bytes + block->used );
+    address = ( address + align - 1 ) & ~static_cast<uintptr_t>( align - 1 );
+
+    return static_cast<uint32>(
+        address - reinterpret_cast<uintptr_t>( block->bytes ) );
+}
+
+ArenaResource::Block* ArenaResource::takeBlock( uint32 capacity )
+{
+    Block** link;
+    Block* block;
+
+    for ( link = &_spare; *link != nullptr; link = &( *link )->prev )
+    {
+        if ( ( *link )->capacity >= capacity )
+        {
+            block = *link;
+            *link = block->prev;
+            block->prev = nullptr;
+
+            return block;
+        }
+    }
+
+    return makeBlock( capacity );
+}
+
+// CONSTRUCTORS
+ArenaResource::ArenaResource()
+    : _first( nullptr ), _top( nullptr ), _spare( nullptr ),
+      _blockSize( DEFAULT_BLOCK_SIZE ), _size( 0 )
+{
+    _first = makeBlock( _blockSize );
+    _top = _first;
+}
+
+ArenaResource::ArenaResource( uint32 blockSize )
+    : _first( nullptr ), _top( nullptr ), _spare( nullptr ),
+      _blockSize( blockSize ), _size( 0 )
+{
+    assert( blockSize > 0 );
+
+    _first = makeBlock( _blockSize );
+    _top = _first;
+}
+
+ArenaResource::~ArenaResource()
+{
+    Block* block;
+
+    reset();
+    freeBlock( _first );
+
+    while ( _spare != nullptr )
+    {
+        block = _spare;
+        _spare = block->prev;
+        freeBlock( block );
+    }
+}
+
+// MEMBER FUNCTIONS
+void* ArenaResource::allocate( uint32 size, uint32 align )
+{
+    Block* block;
+    uint32 offset;
+    uint32 needed;
+
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+
+    offset = alignedOffset( _top, align );
+    if ( offset + size > _top->capacity )
+    {
+        // a new block has room for the worst case padding
+        needed = size + align - 1;
+        block = takeBlock( needed > _blockSize ? needed : _blockSize );
+        block->prev = _top;
+        _top = block;
+
+        offset = alignedOffset( _top, align );
+    }
+
+    _size += offset + size - _top->used;
+    _top->used = offset + size;
+
+    return _top->bytes + offset;
+}
+
+void ArenaResource::deallocate( void* /* pointer */,
+                                uint32 /* size */,
+                                uint32 /* align */ )
+{
+}
+
+void ArenaResource::rollback( const Marker& marker )
+{
+    Block* block;
+
+    while ( _top != marker.block )
+    {
+        assert( _top->prev != nullptr );
+
+        _size -= _top->used;
+        _top->used = 0;
+
+        block = _top;
+        _top = block->prev;
+        block->prev = _spare;
+        _spare = block;
+    }
+
+    assert( marker.used <= _top->used );
+
+    _size -= _top->used - marker.used;
+    _top->used = marker.used;
+}
+
+uint32 ArenaResource::capacity() const
+{
+    const Block* block;
+    uint32 capacity = 0;
+
+    for ( block = _top; block != nullptr; block = block->prev )
+    {
+        capacity += block->capacity;
+    }
+
+    return capacity;
+}
+
+} // End nspc mem
+
+} // End nspc nge
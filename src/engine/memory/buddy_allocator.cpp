@@ -0,0 +1,251 @@
+// buddy_allocator.cpp
+#include "engine/memory/buddy_allocator.h"
+
+#include <assert.h>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint64 BuddyAllocator::INVALID_OFFSET;
+constexpr uint32 BuddyAllocator::MAX_ORDERS;
+constexpr uint32 BuddyAllocator::NONE;
+
+// HELPER FUNCTIONS
+uint32 BuddyAllocator::orderOf( uint64 size ) const
+{
+    uint64 blocks = ( size + _minBlockSize - 1 ) / _minBlockSize;
+    uint32 order = 0;
+
+    while ( order < MAX_ORDERS && ( 1ull << order ) < blocks )
+    {
+        ++order;
+    }
+
+    return order;
+}
+
+void BuddyAllocator::push( uint32 block, uint32 order )
+{
+    Node& node = _nodes[block];
+
+    node.next = _heads[order];
+    node.prev = NONE;
+    node.order = static_cast<uint8>( order );
+    node.free = true;
+
+    if ( _heads[order] != NONE )
+    {
+        _nodes[_heads[order]].prev = block;
+    }
+    _heads[order] = block;
+    ++_freeCounts[order];
+}
+
+void BuddyAllocator::remove( uint32 block )
+{
+    Node& node = _nodes[block];
+
+    if ( node.prev != NONE )
+    {
+        _nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        _heads[node.order] = node.next;
+    }
+
+    if ( node.next != NONE )
+    {
+        _nodes[node.next].prev = node.prev;
+    }
+
+    node.free = false;
+    --_freeCounts[node.order];
+}
+
+// CONSTRUCTORS
+BuddyAllocator::BuddyAllocator( uint64 size, uint64 minBlockSize )
+    : _nodes( nullptr ), _minBlockSize( minBlockSize ),
+      _blockCount( 0 ), _used( 0 ), _requested( 0 ), _allocations( 0 )
+{
+    assert( minBlockSize > 0 && ( minBlockSize & ( minBlockSize - 1 ) ) == 0 );
+    assert( size >= minBlockSize );
+    assert( size / minBlockSize < NONE );
+
+    _blockCount = static_cast<uint32>( size / minBlockSize );
+    _nodes = new Node[_blockCount];
+
+    reset();
+}
+
+BuddyAllocator::~BuddyAllocator()
+{
+    delete[] _nodes;
+}
+
+// MEMBER FUNCTIONS
+uint64 BuddyAllocator::allocate( uint64 size, uint64 align )
+{
+    uint32 order;
+    uint32 split;
+    uint32 block;
+
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+
+    // blocks are aligned to their own size so a larger block gives a larger
+    // alignment
+    order = orderOf( size );
+    split = orderOf( align );
+    order = order > split ? order : split;
+
+    for ( split = order; split < MAX_ORDERS; ++split )
+    {
+        if ( _heads[split] != NONE )
+        {
+            break;
+        }
+    }
+
+    if ( split >= MAX_ORDERS )
+    {
+        return INVALID_OFFSET;
+    }
+
+    block = _heads[split];
+    remove( block );
+
+    while ( split > order )
+    {
+        --split;
+        push( block + ( 1u << split ), split );
+    }
+
+    _nodes[block].order = static_cast<uint8>( order );
+    _used += _minBlockSize << order;
+    _requested += size;
+    ++_allocations;
+
+    return block * _minBlockSize;
+}
+
+void BuddyAllocator::release( uint64 offset, uint64 size )
+{
+    uint32 block = static_cast<uint32>( offset / _minBlockSize );
+    uint32 order;
+    uint32 buddy;
+
+    assert( offset % _minBlockSize == 0 );
+    assert( block < _blockCount );
+    assert( !_nodes[block].free );
+
+    order = _nodes[block].order;
+    assert( size <= _minBlockSize << order );
+
+    _used -= _minBlockSize << order;
+    _requested -= size;
+    --_allocations;
+
+    while ( order + 1 < MAX_ORDERS )
+    {
+        buddy = block ^ ( 1u << order );
+        if ( buddy >= _blockCount || !_nodes[buddy].free ||
+             _nodes[buddy].order != order )
+        {
+            break;
+        }
+
+        remove( buddy );
+        block = block < buddy ? block : buddy;
+        ++order;
+    }
+
+    push( block, order );
+}
+
+void BuddyAllocator::reset()
+{
+    uint32 block;
+    uint32 order;
+    uint32 i;
+
+    for ( i = 0; i < _blockCount; ++i )
+    {
+        _nodes[i].next = NONE;
+        _nodes[i].prev = NONE;
+        _nodes[i].order = 0;
+        _nodes[i].free = false;
+    }
+
+    for ( i = 0; i < MAX_ORDERS; ++i )
+    {
+        _heads[i] = NONE;
+        _freeCounts[i] = 0;
+    }
+
+    // cover the range with the largest blocks that are aligned to their size
+    for ( block = 0; block < _blockCount; block += 1u << order )
+    {
+        order = 0;
+        while ( order + 1 < MAX_ORDERS &&
+                block % ( 1ull << ( order + 1 ) ) == 0 &&
+                block + ( 1ull << ( order + 1 ) ) <= _blockCount )
+        {
+            ++order;
+        }
+
+        push( block, order );
+    }
+
+    _used = 0;
+    _requested = 0;
+    _allocations = 0;
+}
+
+// STATISTICS FUNCTIONS
+uint64 BuddyAllocator::largestFreeBlock() const
+{
+    uint32 order;
+
+    for ( order = MAX_ORDERS; order > 0; --order )
+    {
+        if ( _heads[order - 1] != NONE )
+        {
+            return _minBlockSize << ( order - 1 );
+        }
+    }
+
+    return 0;
+}
+
+float BuddyAllocator::fragmentation() const
+{
+    uint64 free = available();
+
+    if ( free == 0 )
+    {
+        return 0.0f;
+    }
+
+    return 1.0f - static_cast<float>( largestFreeBlock() ) /
+                  static_cast<float>( free );
+}
+
+float BuddyAllocator::waste() const
+{
+    if ( _used == 0 )
+    {
+        return 0.0f;
+    }
+
+    return 1.0f - static_cast<float>( _requested ) /
+                  static_cast<float>( _used );
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,57 @@
+// buddy_resource.cpp
+#include "engine/memory/buddy_resource.h"
+
+#include <assert.h>
+
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 BuddyResource::MAX_ALIGNMENT;
+
+// CONSTRUCTORS
+BuddyResource::BuddyResource( uint32 size, uint32 minBlockSize )
+    : _bytes( nullptr ), _buddies( size, minBlockSize )
+{
+    _bytes = static_cast<uint8*>( MemoryUtils::allocateAligned(
+        static_cast<uint32>( _buddies.capacity() ), MAX_ALIGNMENT ) );
+}
+
+BuddyResource::~BuddyResource()
+{
+    MemoryUtils::deallocateAligned( _bytes );
+}
+
+// MEMBER FUNCTIONS
+void* BuddyResource::allocate( uint32 size, uint32 align )
+{
+    uint64 offset;
+
+    assert( align <= MAX_ALIGNMENT );
+
+    offset = _buddies.allocate( size, align );
+    if ( offset == BuddyAllocator::INVALID_OFFSET )
+    {
+        return nullptr;
+    }
+
+    return _bytes + offset;
+}
+
+void BuddyResource::deallocate( void* pointer,
+                                uint32 size,
+                                uint32 /* align */ )
+{
+    assert( pointer != nullptr );
+
+    _buddies.release( static_cast<uint8*>( pointer ) - _bytes, size );
+}
+
+} // End nspc mem
+
+} // End nspc nge
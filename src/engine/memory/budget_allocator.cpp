@@ -0,0 +1,2 @@
+// budget_allocator.cpp
+#include "engine/memory/budget_allocator.h"
@@ -0,0 +1,144 @@
+// budget_table.cpp
+#include "engine/memory/budget_table.h"
+
+#include <assert.h>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTRUCTORS
+BudgetTable::BudgetTable()
+    : _first( nullptr ), _size( 0 ), _callback(), _logger( nullptr )
+{
+}
+
+BudgetTable::~BudgetTable()
+{
+    MemoryBudget* budget;
+
+    while ( _first != nullptr )
+    {
+        budget = _first;
+        _first = budget->_next;
+        delete budget;
+    }
+}
+
+// MEMBER FUNCTIONS
+MemoryBudget* BudgetTable::add( const String& tag, uint64 limit )
+{
+    MemoryBudget* budget;
+    MemoryBudget** last;
+
+    assert( find( tag ) == nullptr );
+
+    budget = new MemoryBudget( tag, limit );
+    budget->setCallback( _callback );
+    budget->setLogger( _logger );
+
+    // keep the budgets in the order they were added for the report
+    for ( last = &_first; *last != nullptr; last = &( *last )->_next )
+    {
+    }
+    *last = budget;
+    ++_size;
+
+    return budget;
+}
+
+MemoryBudget* BudgetTable::find( const String& tag ) const
+{
+    MemoryBudget* budget;
+
+    for ( budget = _first; budget != nullptr; budget = budget->_next )
+    {
+        if ( budget->tag() == tag )
+        {
+            return budget;
+        }
+    }
+
+    return nullptr;
+}
+
+void BudgetTable::setCallback( const MemoryBudget::Callback& callback )
+{
+    MemoryBudget* budget;
+
+    _callback = callback;
+    for ( budget = _first; budget != nullptr; budget = budget->_next )
+    {
+        budget->setCallback( callback );
+    }
+}
+
+void BudgetTable::setLogger( util::Logger* logger )
+{
+    MemoryBudget* budget;
+
+    _logger = logger;
+    for ( budget = _first; budget != nullptr; budget = budget->_next )
+    {
+        budget->setLogger( logger );
+    }
+}
+
+void BudgetTable::endFrame()
+{
+    MemoryBudget* budget;
+
+    for ( budget = _first; budget != nullptr; budget = budget->_next )
+    {
+        budget->endFrame();
+    }
+}
+
+bool BudgetTable::exceeded() const
+{
+    MemoryBudget* budget;
+
+    for ( budget = _first; budget != nullptr; budget = budget->_next )
+    {
+        if ( budget->exceeded() )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BudgetTable::writeReport( std::ostream& stream ) const
+{
+    MemoryBudget* budget;
+    uint64 live;
+    uint64 limit;
+
+    stream << "memory budgets:\n";
+    for ( budget = _first; budget != nullptr; budget = budget->_next )
+    {
+        live = budget->liveBytes();
+        limit = budget->limit();
+
+        stream << "  " << budget->tag() << ": " << live << " / " << limit
+               << " bytes";
+        if ( limit > 0 )
+        {
+            stream << " (" << live * 100 / limit << "%)";
+        }
+        stream << ", frame peak " << budget->framePeakBytes()
+               << ", frame overruns " << budget->frameOverruns();
+        if ( live > limit )
+        {
+            stream << ", OVER BUDGET";
+        }
+        stream << "\n";
+    }
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,270 @@
+// compacting_heap.cpp
+#include "engine/memory/compacting_heap.h"
+
+#include <string.h>
+
+#include <chrono>
+
+#include "engine/memory/allocation_registry.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 CompactingHeap::MAX_ALIGNMENT;
+constexpr uint32 CompactingHeap::NONE;
+
+// HELPER FUNCTIONS
+uint32 CompactingHeap::allocateBlock( uint32 size, uint32 align )
+{
+    Entry entry;
+    uint32 index;
+    uint32 offset;
+
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+    assert( align <= MAX_ALIGNMENT );
+
+    offset = alignUp( _top, align );
+    if ( static_cast<uint64>( offset ) + size > _capacity )
+    {
+        if ( size > available() )
+        {
+            return NONE;
+        }
+
+        compact();
+
+        offset = alignUp( _top, align );
+        if ( static_cast<uint64>( offset ) + size > _capacity )
+        {
+            return NONE;
+        }
+    }
+
+    if ( _freeEntry != NONE )
+    {
+        index = _freeEntry;
+        _freeEntry = _entries[index].next;
+    }
+    else
+    {
+        index = _entries.size();
+        entry.generation = 0;
+        _entries.push( entry );
+    }
+
+    // new allocations are always above every other allocation
+    _entries[index].offset = offset;
+    _entries[index].size = size;
+    _entries[index].align = align;
+    _entries[index].pins = 0;
+    _entries[index].prev = _tail;
+    _entries[index].next = NONE;
+    _entries[index].live = true;
+
+    if ( _tail != NONE )
+    {
+        _entries[_tail].next = index;
+    }
+    else
+    {
+        _head = index;
+    }
+    _tail = index;
+
+    _top = offset + size;
+    if ( _cursor == NONE )
+    {
+        _compacted = _top;
+    }
+
+    _used += size;
+    ++_allocations;
+    if ( _tracker != nullptr )
+    {
+        _tracker->recordGet( size );
+    }
+
+    return index;
+}
+
+void CompactingHeap::releaseBlock( uint32 index )
+{
+    Entry& entry = _entries[index];
+
+    assert( entry.pins == 0 );
+
+    if ( entry.prev != NONE )
+    {
+        _entries[entry.prev].next = entry.next;
+    }
+    else
+    {
+        _head = entry.next;
+    }
+
+    if ( entry.next != NONE )
+    {
+        _entries[entry.next].prev = entry.prev;
+    }
+    else
+    {
+        // releasing the top allocation lowers the top instead of leaving a
+        // hole
+        _tail = entry.prev;
+        _top = _tail != NONE ? _entries[_tail].offset + _entries[_tail].size
+                             : 0;
+    }
+
+    if ( _cursor == index )
+    {
+        _cursor = entry.next;
+    }
+    else if ( entry.offset < _compacted && entry.next != NONE )
+    {
+        // everything below the hole is still compacted
+        _cursor = entry.next;
+        _compacted = entry.prev != NONE
+                         ? _entries[entry.prev].offset +
+                               _entries[entry.prev].size
+                         : 0;
+    }
+
+    if ( _cursor == NONE )
+    {
+        _compacted = _top;
+    }
+
+    _used -= entry.size;
+    --_allocations;
+    if ( _tracker != nullptr )
+    {
+        _tracker->recordRelease( entry.size );
+    }
+
+    ++entry.generation;
+    entry.live = false;
+    entry.next = _freeEntry;
+    _freeEntry = index;
+}
+
+void CompactingHeap::unpinBlock( uint32 index )
+{
+    Entry& entry = _entries[index];
+    uint32 below;
+
+    --entry.pins;
+    if ( entry.pins > 0 || entry.offset >= _compacted )
+    {
+        return;
+    }
+
+    // compaction passed over the block while it was pinned, so go back and
+    // close the hole below it
+    below = entry.prev != NONE
+                ? _entries[entry.prev].offset + _entries[entry.prev].size
+                : 0;
+    if ( alignUp( below, entry.align ) < entry.offset )
+    {
+        _cursor = index;
+        _compacted = below;
+    }
+}
+
+uint32 CompactingHeap::step()
+{
+    Entry& entry = _entries[_cursor];
+    uint32 target;
+    uint32 moved = 0;
+
+    target = alignUp( _compacted, entry.align );
+    if ( entry.pins == 0 && target < entry.offset )
+    {
+        memmove( _bytes + target, _bytes + entry.offset, entry.size );
+        entry.offset = target;
+        moved = entry.size;
+        _moved += moved;
+    }
+
+    // pinned allocations stay put and compaction continues above them
+    _compacted = entry.offset + entry.size;
+    if ( _cursor == _tail )
+    {
+        _top = _compacted;
+    }
+
+    _cursor = entry.next;
+    return moved;
+}
+
+// CONSTRUCTORS
+CompactingHeap::CompactingHeap( uint32 capacity )
+    : _bytes( nullptr ), _capacity( capacity ), _top( 0 ), _entries(),
+      _freeEntry( NONE ), _head( NONE ), _tail( NONE ), _cursor( NONE ),
+      _compacted( 0 ), _used( 0 ), _allocations( 0 ), _moved( 0 ),
+      _tracker( nullptr )
+{
+    assert( capacity > 0 );
+
+    _bytes = static_cast<uint8*>(
+        MemoryUtils::allocateAligned( capacity, MAX_ALIGNMENT ) );
+}
+
+CompactingHeap::CompactingHeap( uint32 capacity, const String& tag )
+    : CompactingHeap( capacity )
+{
+    _tracker = AllocationRegistry::tracker( tag );
+}
+
+CompactingHeap::~CompactingHeap()
+{
+    if ( _tracker != nullptr && _used > 0 )
+    {
+        _tracker->recordRelease( _used );
+    }
+
+    MemoryUtils::deallocateAligned( _bytes );
+}
+
+// MEMBER FUNCTIONS
+uint64 CompactingHeap::compact( float budgetS )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point start = Clock::now();
+    uint64 moved = 0;
+
+    while ( _cursor != NONE )
+    {
+        moved += step();
+
+        if ( std::chrono::duration<float>( Clock::now() - start ).count() >=
+             budgetS )
+        {
+            break;
+        }
+    }
+
+    return moved;
+}
+
+uint64 CompactingHeap::compact()
+{
+    uint64 moved = 0;
+
+    while ( _cursor != NONE )
+    {
+        moved += step();
+    }
+
+    return moved;
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,127 @@
+// double_stack_resource.cpp
+#include "engine/memory/double_stack_resource.h"
+
+#include <new>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// END
+DoubleStackResource::End::End( DoubleStackResource* stack, Side side )
+    : _stack( stack ), _side( side )
+{
+}
+
+DoubleStackResource::End::~End()
+{
+}
+
+void* DoubleStackResource::End::allocate( uint32 size, uint32 align )
+{
+    return _stack->allocate( _side, size, align );
+}
+
+void DoubleStackResource::End::deallocate( void* pointer, uint32 size,
+                                           uint32 align )
+{
+    _stack->deallocate( pointer, size, align );
+}
+
+// HELPER FUNCTIONS
+bool DoubleStackResource::place( Side side, uint32 size, uint32 align,
+                                 uint32* offset ) const
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>( _bytes );
+    uintptr_t mask = ~static_cast<uintptr_t>( align - 1 );
+    uintptr_t address;
+
+    if ( size > _top - _bottom )
+    {
+        return false;
+    }
+
+    if ( side == BOTTOM )
+    {
+        address = ( base + _bottom + align - 1 ) & mask;
+        if ( address + size > base + _top )
+        {
+            return false;
+        }
+    }
+    else
+    {
+        address = ( base + _top - size ) & mask;
+        if ( address < base + _bottom )
+        {
+            return false;
+        }
+    }
+
+    *offset = static_cast<uint32>( address - base );
+    return true;
+}
+
+// CONSTRUCTORS
+DoubleStackResource::DoubleStackResource( uint32 capacity )
+    : _bytes( nullptr ), _capacity( capacity ), _bottom( 0 ),
+      _top( capacity ), _ends{ End( this, BOTTOM ), End( this, TOP ) }
+{
+    assert( capacity > 0 );
+
+    _bytes = static_cast<uint8*>( ::operator new( capacity ) );
+}
+
+DoubleStackResource::~DoubleStackResource()
+{
+    ::operator delete( _bytes );
+}
+
+// MEMBER FUNCTIONS
+void* DoubleStackResource::allocate( uint32 size, uint32 align )
+{
+    return allocate( BOTTOM, size, align );
+}
+
+void* DoubleStackResource::allocate( Side side, uint32 size, uint32 align )
+{
+    uint32 offset = 0;
+
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+
+    if ( !place( side, size, align, &offset ) )
+    {
+        return nullptr;
+    }
+
+    if ( side == BOTTOM )
+    {
+        _bottom = offset + size;
+    }
+    else
+    {
+        _top = offset;
+    }
+
+    return _bytes + offset;
+}
+
+void DoubleStackResource::deallocate( void* /* pointer */,
+                                      uint32 /* size */,
+                                      uint32 /* align */ )
+{
+}
+
+bool DoubleStackResource::fits( Side side, uint32 size, uint32 align ) const
+{
+    uint32 offset;
+
+    return place( side, size, align, &offset );
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// handle.cpp
+#include "engine/memory/handle.h"
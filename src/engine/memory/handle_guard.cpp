@@ -0,0 +1,2 @@
+// handle_guard.cpp
+#include "engine/memory/handle_guard.h"
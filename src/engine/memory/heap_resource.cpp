@@ -0,0 +1,47 @@
+// heap_resource.cpp
+#include "engine/memory/heap_resource.h"
+
+#include <assert.h>
+#include <cstddef>
+#include <new>
+
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+// MEMBER FUNCTIONS
+void* HeapResource::allocate( uint32 size, uint32 align )
+{
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+
+    if ( align <= alignof( std::max_align_t ) )
+    {
+        return ::operator new( size );
+    }
+
+    return MemoryUtils::allocateAligned( size, align );
+}
+
+void HeapResource::deallocate( void* pointer,
+                               uint32 /* size */,
+                               uint32 align )
+{
+    assert( pointer != nullptr );
+
+    if ( align <= alignof( std::max_align_t ) )
+    {
+        ::operator delete( pointer );
+        return;
+    }
+
+    MemoryUtils::deallocateAligned( pointer );
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// imemory_resource.cpp
+#include "engine/memory/imemory_resource.h"
@@ -0,0 +1,2 @@
+// ithread_cache.cpp
+#include "engine/memory/ithread_cache.h"
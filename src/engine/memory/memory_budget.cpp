@@ -0,0 +1,79 @@
+// memory_budget.cpp
+#include "engine/memory/memory_budget.h"
+
+#include "engine/memory/allocation_registry.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTRUCTORS
+MemoryBudget::MemoryBudget( const String& tag, uint64 limit )
+    : _tracker( AllocationRegistry::tracker( tag ) ), _limit( limit ),
+      _framePeakBytes( _tracker->liveBytes() ), _overruns( 0 ),
+      _frameOverruns( 0 ), _exceeded( false ), _callback(),
+      _logger( nullptr ), _next( nullptr )
+{
+}
+
+MemoryBudget::~MemoryBudget()
+{
+}
+
+// MEMBER FUNCTIONS
+void MemoryBudget::check()
+{
+    uint64 live;
+    uint64 peak;
+    uint64 limit;
+
+    live = _tracker->liveBytes();
+    peak = _framePeakBytes.load( std::memory_order_relaxed );
+    while ( live > peak &&
+            !_framePeakBytes.compare_exchange_weak(
+                peak, live, std::memory_order_relaxed ) )
+    {
+    }
+
+    limit = _limit.load( std::memory_order_relaxed );
+    if ( live <= limit )
+    {
+        _exceeded.store( false, std::memory_order_relaxed );
+        return;
+    }
+
+    // only the check that goes over the limit reports it
+    if ( _exceeded.exchange( true, std::memory_order_relaxed ) )
+    {
+        return;
+    }
+
+    _overruns.fetch_add( 1, std::memory_order_relaxed );
+    _frameOverruns.fetch_add( 1, std::memory_order_relaxed );
+
+    if ( _logger != nullptr )
+    {
+        _logger->w( "memory", tag() + " is over budget: " +
+                              std::to_string( live ) + " of " +
+                              std::to_string( limit ) + " bytes" );
+    }
+
+    if ( _callback )
+    {
+        _callback( *this, live );
+    }
+}
+
+void MemoryBudget::endFrame()
+{
+    _framePeakBytes.store( 0, std::memory_order_relaxed );
+    _frameOverruns.store( 0, std::memory_order_relaxed );
+
+    check();
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -1,2 +1,177 @@
 // memory_utils.cpp
 #include "engine/memory/memory_utils.h"
+
+#include <assert.h>
+#include <new>
+
+#if defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define NGE_MEM_SSE2
+#endif
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 MemoryUtils::CACHE_LINE_SIZE;
+constexpr uint64 MemoryUtils::NON_TEMPORAL_THRESHOLD;
+
+// MEMBER FUNCTIONS
+void MemoryUtils::copyBytes( void* dst, const void* src, uint64 size )
+{
+    uint8* out = static_cast<uint8*>( dst );
+    const uint8* in = static_cast<const uint8*>( src );
+
+#ifdef NGE_MEM_SSE2
+    uint64 head;
+    __m128i a;
+    __m128i b;
+    __m128i c;
+    __m128i d;
+
+    if ( size >= NON_TEMPORAL_THRESHOLD )
+    {
+        // streaming stores must be aligned to 16 bytes
+        head = ( 16 - ( reinterpret_cast<uintptr_t>( out ) & 15 ) ) & 15;
+        memcpy( out, in, head );
+        out += head;
+        in += head;
+        size -= head;
+
+        for ( ; size >= 64; size -= 64, out += 64, in += 64 )
+        {
+            a = _mm_loadu_si128( reinterpret_cast<const __m128i*>( in ) );
+            b = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>( in + 16 ) );
+            c = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>( in + 32 ) );
+            d = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>( in + 48 ) );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out ), a );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out + 16 ), b );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out + 32 ), c );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out + 48 ), d );
+        }
+
+        // order the streaming stores before any later store
+        _mm_sfence();
+    }
+#endif
+
+    // the C library copies through the cache with the widest vectors the
+    // processor has, which the baseline instruction set cannot match
+    if ( size > 0 )
+    {
+        memcpy( out, in, size );
+    }
+}
+
+void MemoryUtils::fillBytes( void* dst, uint64 pattern, uint32 width,
+                             uint64 size )
+{
+    uint8* out = static_cast<uint8*>( dst );
+
+    assert( width == 1 || width == 2 || width == 4 || width == 8 );
+    assert( size % width == 0 );
+
+    // patterns of one repeated byte, such as all zeros or all ones, are
+    // left to the C library below the streaming threshold
+    if ( size < NON_TEMPORAL_THRESHOLD &&
+         pattern == ( pattern & 0xFF ) * 0x0101010101010101ull )
+    {
+        memset( out, static_cast<int>( pattern & 0xFF ), size );
+        return;
+    }
+
+#ifdef NGE_MEM_SSE2
+    __m128i value = _mm_set1_epi64x( static_cast<int64>( pattern ) );
+
+    // streaming stores must be aligned to 16 bytes, which whole items only
+    // reach when the destination is aligned to the item width
+    if ( size >= NON_TEMPORAL_THRESHOLD &&
+         ( reinterpret_cast<uintptr_t>( out ) & ( width - 1 ) ) == 0 )
+    {
+        for ( ; ( reinterpret_cast<uintptr_t>( out ) & 15 ) != 0;
+              size -= width, out += width )
+        {
+            memcpy( out, &pattern, width );
+        }
+
+        for ( ; size >= 64; size -= 64, out += 64 )
+        {
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out ), value );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out + 16 ),
+                              value );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out + 32 ),
+                              value );
+            _mm_stream_si128( reinterpret_cast<__m128i*>( out + 48 ),
+                              value );
+        }
+
+        _mm_sfence();
+    }
+    else
+    {
+        for ( ; size >= 64; size -= 64, out += 64 )
+        {
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( out ), value );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( out + 16 ),
+                              value );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( out + 32 ),
+                              value );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( out + 48 ),
+                              value );
+        }
+    }
+
+    for ( ; size >= 16; size -= 16, out += 16 )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( out ), value );
+    }
+#endif
+
+    for ( ; size >= 8; size -= 8, out += 8 )
+    {
+        memcpy( out, &pattern, 8 );
+    }
+    memcpy( out, &pattern, size );
+}
+
+bool MemoryUtils::equalBytes( const void* lhs, const void* rhs, uint64 size )
+{
+    // the C library compares with the widest vectors the processor has
+    return size == 0 || memcmp( lhs, rhs, size ) == 0;
+}
+
+void* MemoryUtils::allocateAligned( uint64 size, uint32 align )
+{
+    uint8* raw;
+    uint8* aligned;
+
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+
+    // leave room for the raw address in front of the aligned bytes
+    raw = static_cast<uint8*>( ::operator new(
+        static_cast<size_t>( size + align - 1 + sizeof( void* ) ) ) );
+    aligned = reinterpret_cast<uint8*>(
+        ( reinterpret_cast<uintptr_t>( raw + sizeof( void* ) ) + align - 1 ) &
+        ~static_cast<uintptr_t>( align - 1 ) );
+
+    reinterpret_cast<void**>( aligned )[-1] = raw;
+    return aligned;
+}
+
+void MemoryUtils::deallocateAligned( void* pointer )
+{
+    assert( pointer != nullptr );
+
+    ::operator delete( static_cast<void**>( pointer )[-1] );
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// object_pool.cpp
+#include "engine/memory/object_pool.h"
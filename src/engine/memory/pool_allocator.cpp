@@ -0,0 +1,2 @@
+// pool_allocator.cpp
+#include "engine/memory/pool_allocator.h"
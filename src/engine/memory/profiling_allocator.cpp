@@ -0,0 +1,2 @@
+// profiling_allocator.cpp
+#include "engine/memory/profiling_allocator.h"
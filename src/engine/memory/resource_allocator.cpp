@@ -0,0 +1,2 @@
+// resource_allocator.cpp
+#include "engine/memory/resource_allocator.h"
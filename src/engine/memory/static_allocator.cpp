@@ -0,0 +1,2 @@
+// static_allocator.cpp
+#include "engine/memory/static_allocator.h"
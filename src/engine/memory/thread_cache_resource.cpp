@@ -0,0 +1,316 @@
+// thread_cache_resource.cpp
+#include "engine/memory/thread_cache_resource.h"
+
+#include "engine/memory/aligned_allocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 ThreadCacheResource::SIZE_CLASSES;
+constexpr uint32 ThreadCacheResource::MAX_CACHED_SIZE;
+constexpr uint32 ThreadCacheResource::SLAB_SIZE;
+constexpr uint32 ThreadCacheResource::SLAB_ALIGNMENT;
+constexpr uint32 ThreadCacheResource::MAX_THREADS;
+
+// HELPER FUNCTIONS
+uint32 ThreadCacheResource::sizeClass( uint32 size, uint32 align )
+{
+    uint32 sizeClass = 0;
+
+    if ( align > size )
+    {
+        size = align;
+    }
+
+    if ( size > MAX_CACHED_SIZE || align > SLAB_ALIGNMENT )
+    {
+        return SIZE_CLASSES;
+    }
+
+    while ( classSize( sizeClass ) < size )
+    {
+        ++sizeClass;
+    }
+
+    return sizeClass;
+}
+
+uint32 ThreadCacheResource::batchSize( uint32 sizeClass )
+{
+    uint32 batch = 32768 / classSize( sizeClass );
+
+    // small blocks move in batches of 32 and the largest in pairs so that a
+    // batch is never more than one slab
+    return batch < 2 ? 2 : ( batch > 32 ? 32 : batch );
+}
+
+ThreadCacheResource::Cache* ThreadCacheResource::cache()
+{
+    const uint32 index = ThreadIndex::current();
+
+    return index < MAX_THREADS ? _caches + index : nullptr;
+}
+
+uint32 ThreadCacheResource::take( uint32 sizeClass,
+                                  Block** blocks,
+                                  uint32 count )
+{
+    Pool& pool = _pools[sizeClass];
+    uint32 size = classSize( sizeClass );
+    uint8* slab;
+    Block* block;
+    Block* first;
+    uint32 taken;
+    uint32 offset;
+
+    std::lock_guard<std::mutex> lock( pool.mutex );
+
+    if ( pool.blocks == nullptr )
+    {
+        slab = static_cast<uint8*>(
+            MemoryUtils::allocateAligned( SLAB_SIZE, SLAB_ALIGNMENT ) );
+        pool.slabs.push_back( slab );
+
+        // link the blocks so they are handed out in address order
+        for ( offset = SLAB_SIZE; offset > 0; offset -= size )
+        {
+            block = reinterpret_cast<Block*>( slab + offset - size );
+            block->next = pool.blocks;
+            pool.blocks = block;
+        }
+        pool.count += SLAB_SIZE / size;
+    }
+
+    // cut the batch off the front of the pool in one piece so that it keeps
+    // its order
+    block = pool.blocks;
+    for ( taken = 1; taken < count && block->next != nullptr; ++taken )
+    {
+        block = block->next;
+    }
+
+    first = pool.blocks;
+    pool.blocks = block->next;
+    pool.count -= taken;
+
+    block->next = *blocks;
+    *blocks = first;
+
+    return taken;
+}
+
+void ThreadCacheResource::give( uint32 sizeClass, Block* blocks, uint32 count )
+{
+    Pool& pool = _pools[sizeClass];
+    Block* last = blocks;
+
+    while ( last->next != nullptr )
+    {
+        last = last->next;
+    }
+
+    std::lock_guard<std::mutex> lock( pool.mutex );
+
+    last->next = pool.blocks;
+    pool.blocks = blocks;
+    pool.count += count;
+}
+
+void ThreadCacheResource::releaseThread( uint32 index )
+{
+    Cache& cache = _caches[index];
+    uint32 i;
+
+    assert( index < MAX_THREADS );
+
+    for ( i = 0; i < SIZE_CLASSES; ++i )
+    {
+        if ( cache.blocks[i] != nullptr )
+        {
+            give( i, cache.blocks[i], cache.counts[i] );
+            cache.blocks[i] = nullptr;
+            cache.counts[i] = 0;
+        }
+    }
+}
+
+// CONSTRUCTORS
+ThreadCacheResource::ThreadCacheResource()
+    : _caches( nullptr ), _pools( nullptr )
+{
+    uint32 i;
+    uint32 j;
+
+    _caches = AlignedAllocator<Cache, MemoryUtils::CACHE_LINE_SIZE>().get(
+        MAX_THREADS );
+    for ( i = 0; i < MAX_THREADS; ++i )
+    {
+        for ( j = 0; j < SIZE_CLASSES; ++j )
+        {
+            _caches[i].blocks[j] = nullptr;
+            _caches[i].counts[j] = 0;
+        }
+    }
+
+    _pools = AlignedAllocator<Pool, MemoryUtils::CACHE_LINE_SIZE>().get(
+        SIZE_CLASSES );
+    for ( i = 0; i < SIZE_CLASSES; ++i )
+    {
+        _pools[i].blocks = nullptr;
+        _pools[i].count = 0;
+    }
+
+    ThreadIndex::addCache( this );
+}
+
+ThreadCacheResource::~ThreadCacheResource()
+{
+    uint32 i;
+    uint32 j;
+
+    ThreadIndex::removeCache( this );
+
+    for ( i = 0; i < SIZE_CLASSES; ++i )
+    {
+        for ( j = 0; j < _pools[i].slabs.size(); ++j )
+        {
+            MemoryUtils::deallocateAligned( _pools[i].slabs[j] );
+        }
+    }
+
+    AlignedAllocator<Pool, MemoryUtils::CACHE_LINE_SIZE>().release(
+        _pools, SIZE_CLASSES );
+    AlignedAllocator<Cache, MemoryUtils::CACHE_LINE_SIZE>().release(
+        _caches, MAX_THREADS );
+}
+
+// MEMBER FUNCTIONS
+void* ThreadCacheResource::allocate( uint32 size, uint32 align )
+{
+    uint32 index;
+    Cache* cache;
+    Block* block = nullptr;
+
+    assert( size > 0 );
+    assert( align > 0 && ( align & ( align - 1 ) ) == 0 );
+
+    index = sizeClass( size, align );
+    if ( index == SIZE_CLASSES )
+    {
+        return MemoryUtils::allocateAligned( size, align );
+    }
+
+    cache = this->cache();
+    if ( cache == nullptr )
+    {
+        take( index, &block, 1 );
+        return block;
+    }
+
+    if ( cache->blocks[index] == nullptr )
+    {
+        cache->counts[index] =
+            take( index, &cache->blocks[index], batchSize( index ) );
+    }
+
+    block = cache->blocks[index];
+    cache->blocks[index] = block->next;
+    --cache->counts[index];
+
+    return block;
+}
+
+void ThreadCacheResource::deallocate( void* pointer,
+                                      uint32 size,
+                                      uint32 align )
+{
+    uint32 index;
+    uint32 batch;
+    uint32 i;
+    Cache* cache;
+    Block* block = static_cast<Block*>( pointer );
+    Block* blocks;
+
+    assert( pointer != nullptr );
+    assert( size > 0 );
+
+    index = sizeClass( size, align );
+    if ( index == SIZE_CLASSES )
+    {
+        MemoryUtils::deallocateAligned( pointer );
+        return;
+    }
+
+    cache = this->cache();
+    if ( cache == nullptr )
+    {
+        block->next = nullptr;
+        give( index, block, 1 );
+        return;
+    }
+
+    block->next = cache->blocks[index];
+    cache->blocks[index] = block;
+    ++cache->counts[index];
+
+    // keep one batch for the next allocations and return the rest in one go
+    // so that the lock is taken once per batch rather than per block
+    batch = batchSize( index );
+    if ( cache->counts[index] > 2 * batch )
+    {
+        block = cache->blocks[index];
+        for ( i = 1; i < batch; ++i )
+        {
+            block = block->next;
+        }
+
+        blocks = block->next;
+        block->next = nullptr;
+        give( index, blocks, cache->counts[index] - batch );
+        cache->counts[index] = batch;
+    }
+}
+
+void ThreadCacheResource::flush()
+{
+    const uint32 index = ThreadIndex::current();
+
+    if ( index < MAX_THREADS )
+    {
+        releaseThread( index );
+    }
+}
+
+// STATISTICS FUNCTIONS
+uint32 ThreadCacheResource::cachedCount( uint32 sizeClass )
+{
+    Cache* cache = this->cache();
+
+    assert( sizeClass < SIZE_CLASSES );
+
+    return cache != nullptr ? cache->counts[sizeClass] : 0;
+}
+
+uint32 ThreadCacheResource::pooledCount( uint32 sizeClass )
+{
+    assert( sizeClass < SIZE_CLASSES );
+
+    std::lock_guard<std::mutex> lock( _pools[sizeClass].mutex );
+    return _pools[sizeClass].count;
+}
+
+uint32 ThreadCacheResource::slabCount( uint32 sizeClass )
+{
+    assert( sizeClass < SIZE_CLASSES );
+
+    std::lock_guard<std::mutex> lock( _pools[sizeClass].mutex );
+    return _pools[sizeClass].slabs.size();
+}
+
+} // End nspc mem
+
+} // End nspc nge
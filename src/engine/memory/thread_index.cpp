@@ -0,0 +1,138 @@
+// thread_index.cpp
+#include "engine/memory/thread_index.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <mutex>
+#include <vector>
+
+namespace nge
+{
+
+namespace mem
+{
+
+namespace
+{
+
+/**
+ * Gets the mutex that guards the free indices and the caches.
+ */
+std::mutex& mutex()
+{
+    // leaked so that threads exiting after main returns can use it
+    static std::mutex* mutex = new std::mutex();
+
+    return *mutex;
+}
+
+/**
+ * Gets the indices that were taken back from exited threads.
+ */
+std::vector<uint32>& freeIndices()
+{
+    static std::vector<uint32>* indices = new std::vector<uint32>();
+
+    return *indices;
+}
+
+/**
+ * Gets the registered caches.
+ */
+std::vector<IThreadCache*>& caches()
+{
+    static std::vector<IThreadCache*>* caches =
+        new std::vector<IThreadCache*>();
+
+    return *caches;
+}
+
+/**
+ * Holds the index of one thread and gives it back when the thread exits.
+ */
+class ThreadSlot
+{
+  private:
+    uint32 _index;
+
+  public:
+    ThreadSlot() : _index( ThreadIndex::MAX_THREADS )
+    {
+        static uint32 nextIndex = 0;
+
+        std::lock_guard<std::mutex> lock( mutex() );
+
+        if ( !freeIndices().empty() )
+        {
+            _index = freeIndices().back();
+            freeIndices().pop_back();
+        }
+        else if ( nextIndex < ThreadIndex::MAX_THREADS )
+        {
+            _index = nextIndex++;
+        }
+    }
+
+    ~ThreadSlot()
+    {
+        uint32 i;
+
+        if ( _index >= ThreadIndex::MAX_THREADS )
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock( mutex() );
+
+        for ( i = 0; i < caches().size(); ++i )
+        {
+            caches()[i]->releaseThread( _index );
+        }
+
+        freeIndices().push_back( _index );
+    }
+
+    uint32 index() const
+    {
+        return _index;
+    }
+};
+
+} // End nspc anonymous
+
+// CONSTANTS
+constexpr uint32 ThreadIndex::MAX_THREADS;
+
+// STATIC FUNCTIONS
+uint32 ThreadIndex::current()
+{
+    static thread_local ThreadSlot slot;
+
+    return slot.index();
+}
+
+void ThreadIndex::addCache( IThreadCache* cache )
+{
+    assert( cache != nullptr );
+
+    std::lock_guard<std::mutex> lock( mutex() );
+
+    assert( std::find( caches().begin(), caches().end(), cache ) ==
+            caches().end() );
+    caches().push_back( cache );
+}
+
+void ThreadIndex::removeCache( IThreadCache* cache )
+{
+    std::vector<IThreadCache*>::iterator found;
+
+    std::lock_guard<std::mutex> lock( mutex() );
+
+    found = std::find( caches().begin(), caches().end(), cache );
+    assert( found != caches().end() );
+    caches().erase( found );
+}
+
+} // End nspc mem
+
+} // End nspc nge
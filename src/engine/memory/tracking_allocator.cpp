@@ -0,0 +1,2 @@
+// tracking_allocator.cpp
+#include "engine/memory/tracking_allocator.h"
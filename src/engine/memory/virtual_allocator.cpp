@@ -0,0 +1,2 @@
+// virtual_allocator.cpp
+#include "engine/memory/virtual_allocator.h"
@@ -0,0 +1,148 @@
+// virtual_memory.cpp
+#include "engine/memory/virtual_memory.h"
+
+#include <assert.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint64 VirtualMemory::HUGE_PAGE_SIZE;
+
+// MEMBER FUNCTIONS
+uint64 VirtualMemory::pageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo( &info );
+    return info.dwPageSize;
+#else
+    return static_cast<uint64>( sysconf( _SC_PAGESIZE ) );
+#endif
+}
+
+uint64 VirtualMemory::granularity( PageMode mode )
+{
+    return mode == SMALL_PAGES ? pageSize() : HUGE_PAGE_SIZE;
+}
+
+uint64 VirtualMemory::roundUp( uint64 size, PageMode mode )
+{
+    uint64 step = granularity( mode );
+
+    return ( size + step - 1 ) / step * step;
+}
+
+void* VirtualMemory::reserve( uint64 size, PageMode mode )
+{
+    assert( size > 0 );
+    assert( size % granularity( mode ) == 0 );
+
+#ifdef _WIN32
+    return VirtualAlloc( nullptr, size, MEM_RESERVE, PAGE_NOACCESS );
+#else
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    uintptr_t address;
+    uintptr_t aligned;
+    void* pointer;
+
+#ifdef MAP_HUGETLB
+    if ( mode == HUGE_PAGES )
+    {
+        // the huge pages are taken from the pool now so an empty pool fails
+        // here rather than when the memory is first touched
+        pointer = mmap( nullptr, size, PROT_NONE, flags | MAP_HUGETLB, -1, 0 );
+        if ( pointer != MAP_FAILED )
+        {
+            return pointer;
+        }
+    }
+#endif
+
+    if ( mode == SMALL_PAGES )
+    {
+        pointer = mmap( nullptr, size, PROT_NONE, flags | MAP_NORESERVE,
+                        -1, 0 );
+        return pointer != MAP_FAILED ? pointer : nullptr;
+    }
+
+    // start the range on a huge page so that all of it can use huge pages
+    pointer = mmap( nullptr, size + HUGE_PAGE_SIZE, PROT_NONE,
+                    flags | MAP_NORESERVE, -1, 0 );
+    if ( pointer == MAP_FAILED )
+    {
+        return nullptr;
+    }
+
+    address = reinterpret_cast<uintptr_t>( pointer );
+    aligned = ( address + HUGE_PAGE_SIZE - 1 ) & ~( HUGE_PAGE_SIZE - 1 );
+    if ( aligned > address )
+    {
+        munmap( pointer, aligned - address );
+    }
+    if ( address + HUGE_PAGE_SIZE > aligned )
+    {
+        munmap( reinterpret_cast<void*>( aligned + size ),
+                address + HUGE_PAGE_SIZE - aligned );
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise( reinterpret_cast<void*>( aligned ), size, MADV_HUGEPAGE );
+#endif
+
+    return reinterpret_cast<void*>( aligned );
+#endif
+}
+
+bool VirtualMemory::commit( void* pointer, uint64 size )
+{
+    assert( pointer != nullptr );
+    assert( reinterpret_cast<uintptr_t>( pointer ) % pageSize() == 0 );
+
+#ifdef _WIN32
+    return VirtualAlloc( pointer, size, MEM_COMMIT, PAGE_READWRITE ) !=
+           nullptr;
+#else
+    return mprotect( pointer, size, PROT_READ | PROT_WRITE ) == 0;
+#endif
+}
+
+void VirtualMemory::decommit( void* pointer, uint64 size )
+{
+    assert( pointer != nullptr );
+    assert( reinterpret_cast<uintptr_t>( pointer ) % pageSize() == 0 );
+
+#ifdef _WIN32
+    VirtualFree( pointer, size, MEM_DECOMMIT );
+#else
+    madvise( pointer, size, MADV_DONTNEED );
+    mprotect( pointer, size, PROT_NONE );
+#endif
+}
+
+void VirtualMemory::release( void* pointer, uint64 size )
+{
+    assert( pointer != nullptr );
+    assert( size > 0 );
+
+#ifdef _WIN32
+    VirtualFree( pointer, 0, MEM_RELEASE );
+#else
+    munmap( pointer, size );
+#endif
+}
+
+} // End nspc mem
+
+} // End nspc nge
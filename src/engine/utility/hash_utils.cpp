@@ -21,6 +21,20 @@ uint32 HashUtils::fnv1a( const String& value )
     return hashCode;
 }
 
+uint64 HashUtils::fnv1a64( const String& value )
+{
+    uint64 hashCode = FNV_OFFSET_64;
+    uint32 i;
+
+    for ( i = 0; i < value.length(); ++i )
+    {
+        hashCode ^= value[i];
+        hashCode *= FNV_PRIME_64;
+    }
+
+    return hashCode;
+}
+
 } // End nspc util
 
 } // End nspc nge
\ No newline at end of file
@@ -1,2 +1,58 @@
 // logger.cpp
 #include "engine/utility/logger.h"
+
+namespace nge
+{
+
+namespace util
+{
+
+// CONSTRUCTORS
+Logger::Logger() : _logs(), _level( Log::Level::VERBOSE )
+{
+}
+
+Logger::Logger( const Logger& logger )
+    : _logs( logger._logs ), _level( logger._level )
+{
+}
+
+Logger::~Logger()
+{
+}
+
+// OPERATORS
+Logger& Logger::operator=( const Logger& logger )
+{
+    _logs = logger._logs;
+    _level = logger._level;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+void Logger::setLogLevel( Log::Level level )
+{
+    _level = level;
+}
+
+void Logger::log( Log::Level level, const String& tag, const String& msg,
+                  std::exception* exc )
+{
+    uint32 i;
+
+    if ( level < _level )
+    {
+        return;
+    }
+
+    for ( i = 0; i < _logs.size(); ++i )
+    {
+        _logs[i]->write( level, tag, msg,
+                         exc != nullptr ? *exc : std::exception() );
+    }
+}
+
+} // End nspc util
+
+} // End nspc nge
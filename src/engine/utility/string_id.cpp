@@ -0,0 +1,2 @@
+// string_id.cpp
+#include "engine/utility/string_id.h"
@@ -10,7 +10,7 @@ namespace world
 // MEMBER FUNCTIONS
 void Scene::update( float dtS )
 {
-    cntr::DynamicArray<ITickable*>::Iterator iter;
+    cntr::DynamicArray<ITickable*, mem::AllocatorGuard>::Iterator iter;
 
     for ( iter = _tickables.begin(); iter != _tickables.end(); ++iter )
     {
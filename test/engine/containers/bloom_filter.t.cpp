@@ -0,0 +1,104 @@
+// bloom_filter.t.cpp
+#include <engine/containers/bloom_filter.h>
+#include <engine/memory/allocator_guard.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( BloomFilter, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<uint32> alloc;
+
+    BloomFilter<uint32> def;
+    BloomFilter<uint32> capacity( 1000 );
+    BloomFilter<uint32, AllocatorGuard> withAlloc( &alloc, 1000 );
+
+    // the default policy does not take any space
+    EXPECT_EQ( sizeof( uint32* ) + sizeof( BloomFilter<uint32>::Block* ) +
+               2 * sizeof( uint32 ),
+               sizeof( BloomFilter<uint32> ) );
+
+    EXPECT_FALSE( def.isEnabled() );
+    EXPECT_TRUE( def.mayContain( 1 ) );
+    EXPECT_TRUE( capacity.isEnabled() );
+    // the blocks are padded so that they can start on a cache line
+    EXPECT_EQ( withAlloc.blockCount() * BloomFilter<uint32>::WORDS_PER_BLOCK +
+               MemoryUtils::CACHE_LINE_SIZE / sizeof( uint32 ) - 1,
+               alloc.getAllocationCount() );
+
+    withAlloc.add( 1 );
+
+    BloomFilter<uint32, AllocatorGuard> copy( withAlloc );
+    EXPECT_TRUE( copy.mayContain( 1 ) );
+    EXPECT_EQ( 1, copy.size() );
+
+    BloomFilter<uint32, AllocatorGuard> move( std::move( copy ) );
+    EXPECT_TRUE( move.mayContain( 1 ) );
+    EXPECT_FALSE( copy.isEnabled() );
+
+    capacity.add( 2 );
+    def = capacity;
+    EXPECT_TRUE( def.mayContain( 2 ) );
+    def = std::move( capacity );
+    EXPECT_EQ( 1, def.size() );
+
+    withAlloc = move;
+    EXPECT_TRUE( withAlloc.mayContain( 1 ) );
+    withAlloc = std::move( move );
+    EXPECT_EQ( 1, withAlloc.size() );
+
+    BloomFilter<uint32, AllocatorGuard>& self = withAlloc;
+    withAlloc = self;
+    EXPECT_TRUE( withAlloc.mayContain( 1 ) );
+    EXPECT_EQ( 1, withAlloc.size() );
+    withAlloc = std::move( self );
+    EXPECT_TRUE( withAlloc.mayContain( 1 ) );
+    EXPECT_EQ( 1, withAlloc.size() );
+}
+
+TEST( BloomFilter, Membership )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 4096;
+
+    uint32 i;
+    uint32 falsePositives;
+
+    BloomFilter<uint32> filter( SIZE );
+    for ( i = 0; i < SIZE; ++i )
+    {
+        filter.add( i * 3 );
+    }
+
+    EXPECT_EQ( SIZE, filter.size() );
+
+    // there are never false negatives
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_TRUE( filter.mayContain( i * 3 ) );
+    }
+
+    falsePositives = 0;
+    for ( i = 0; i < SIZE; ++i )
+    {
+        if ( filter.mayContain( i * 3 + 1 ) )
+        {
+            ++falsePositives;
+        }
+    }
+
+    EXPECT_LT( falsePositives, SIZE / 20 );
+
+    filter.clear();
+    EXPECT_EQ( 0, filter.size() );
+    EXPECT_FALSE( filter.mayContain( 0 ) );
+
+    filter.resize( SIZE * 2 );
+    filter.add( 5 );
+    EXPECT_TRUE( filter.mayContain( 5 ) );
+}
@@ -0,0 +1,211 @@
+// colony.t.cpp
+#include <engine/containers/colony.h>
+#include <gtest/gtest.h>
+
+TEST( Colony, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    DefaultAllocator<uint32> alloc;
+
+    Colony<uint32> blockSize( 16 );
+    Colony<uint32> colony( &alloc, &alloc );
+    Colony<uint32> full( &alloc, &alloc, 16 );
+    Colony<uint32> def;
+
+    full.insert( 1 );
+    full.insert( 2 );
+
+    Colony<uint32> copy( full );
+    EXPECT_EQ( 2, copy.size() );
+    EXPECT_EQ( 16, copy.blockSize() );
+
+    Colony<uint32> move( std::move( copy ) );
+    EXPECT_EQ( 2, move.size() );
+    EXPECT_EQ( 0, copy.size() );
+
+    def = move;
+    EXPECT_EQ( 2, def.size() );
+    def = std::move( move );
+    EXPECT_EQ( 2, def.size() );
+}
+
+TEST( Colony, InsertionAndRemoval )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 1000;
+
+    uint32 i;
+    uint32 sum;
+    uint32* pointers[SIZE];
+
+    Colony<uint32> colony( 32 );
+    EXPECT_TRUE( colony.isEmpty() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        pointers[i] = colony.insert( i );
+    }
+
+    EXPECT_EQ( SIZE, colony.size() );
+    EXPECT_GE( colony.capacity(), SIZE );
+
+    // remove every third item and make sure the others did not move
+    for ( i = 0; i < SIZE; i += 3 )
+    {
+        colony.remove( pointers[i] );
+    }
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        if ( i % 3 != 0 )
+        {
+            ASSERT_EQ( i, *pointers[i] );
+        }
+    }
+
+    // removed slots are reused before new blocks are allocated
+    const uint32 capacity = colony.capacity();
+    for ( i = 0; i < SIZE; i += 3 )
+    {
+        pointers[i] = colony.insert( i );
+    }
+
+    EXPECT_EQ( SIZE, colony.size() );
+    EXPECT_EQ( capacity, colony.capacity() );
+
+    sum = 0;
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i, *pointers[i] );
+        sum += *pointers[i];
+    }
+
+    EXPECT_EQ( SIZE * ( SIZE - 1 ) / 2, sum );
+
+    colony.clear();
+    EXPECT_TRUE( colony.isEmpty() );
+    EXPECT_EQ( 0, colony.capacity() );
+}
+
+TEST( Colony, RemovalMergesRuns )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    // the slots removed before the iterator removes slot 2 and the value
+    // the iterator should point to afterwards, where 8 removes nothing
+    const uint32 removed[][2] = { { 1, 8 }, { 3, 8 }, { 1, 3 }, { 3, 4 } };
+    const uint32 expected[] = { 3, 4, 4, 5 };
+    uint32 i;
+    uint32 j;
+
+    for ( i = 0; i < 4; ++i )
+    {
+        Colony<uint32> colony( 8 );
+        uint32* pointers[8];
+
+        for ( j = 0; j < 8; ++j )
+        {
+            pointers[j] = colony.insert( j );
+        }
+
+        for ( j = 0; j < 2; ++j )
+        {
+            if ( removed[i][j] < 8 )
+            {
+                colony.remove( pointers[removed[i][j]] );
+            }
+        }
+
+        Colony<uint32>::Iterator iter = colony.begin();
+        while ( *iter != 2 )
+        {
+            ++iter;
+        }
+
+        iter = colony.remove( iter );
+        ASSERT_TRUE( iter != colony.end() );
+        EXPECT_EQ( expected[i], *iter );
+    }
+}
+
+TEST( Colony, Iteration )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 256;
+
+    uint32 i;
+    uint32 count;
+    uint32 sum;
+
+    Colony<uint32> colony( 16 );
+    EXPECT_TRUE( colony.begin() == colony.end() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        colony.insert( i );
+    }
+
+    // remove all of the odd items and an entire block
+    Colony<uint32>::Iterator iter = colony.begin();
+    while ( iter != colony.end() )
+    {
+        if ( *iter % 2 == 1 || ( *iter >= 32 && *iter < 48 ) )
+        {
+            iter = colony.remove( iter );
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    count = 0;
+    sum = 0;
+    Colony<uint32>::ConstIterator citer = colony.cbegin();
+    for ( ; citer != colony.cend(); ++citer )
+    {
+        ASSERT_EQ( 0, *citer % 2 );
+        ASSERT_TRUE( *citer < 32 || *citer >= 48 );
+        ++count;
+        sum += *citer;
+    }
+
+    EXPECT_EQ( colony.size(), count );
+    EXPECT_EQ( SIZE / 2 - 8, count );
+
+    // iterating backwards visits the same items
+    for ( iter = colony.end(); iter != colony.begin(); )
+    {
+        --iter;
+        --count;
+        sum -= *iter;
+    }
+
+    EXPECT_EQ( 0, count );
+    EXPECT_EQ( 0, sum );
+
+    // fill the holes back in
+    for ( i = 0; i < SIZE / 2 + 8; ++i )
+    {
+        colony.insert( i );
+    }
+
+    EXPECT_EQ( SIZE, colony.size() );
+    EXPECT_EQ( SIZE, colony.capacity() );
+
+    count = 0;
+    for ( iter = colony.begin(); iter != colony.end(); ++iter )
+    {
+        ++count;
+    }
+
+    EXPECT_EQ( SIZE, count );
+}
@@ -10,11 +10,12 @@ TEST( DynamicArray, ConstructionAndAssignment )
 
     DefaultAllocator<uint32> alloc;
 
-    DynamicArray<uint32> array( &alloc );
-    DynamicArray<uint32> copy( array );
-    DynamicArray<uint32> move( std::move( array ) );
-    DynamicArray<uint32> capacity( &alloc, static_cast<uint32>( 100 ) );
-    DynamicArray<uint32> def;
+    DynamicArray<uint32, AllocatorGuard> array( &alloc );
+    DynamicArray<uint32, AllocatorGuard> copy( array );
+    DynamicArray<uint32, AllocatorGuard> move( std::move( array ) );
+    DynamicArray<uint32, AllocatorGuard> capacity( &alloc,
+                                                   static_cast<uint32>( 100 ) );
+    DynamicArray<uint32, AllocatorGuard> def;
 
     def = copy;
     def = std::move( copy );
@@ -32,7 +33,7 @@ TEST( DynamicArray, PushAndPop )
     uint32 tmp;
 
     DefaultAllocator<uint32> alloc;
-    DynamicArray<uint32> array( &alloc );
+    DynamicArray<uint32, AllocatorGuard> array( &alloc );
 
     // push
     array.push( 0 );
@@ -104,7 +105,7 @@ TEST( DynamicArray, At )
     uint32 i;
 
     DefaultAllocator<uint32> alloc;
-    DynamicArray<uint32> array( &alloc );
+    DynamicArray<uint32, AllocatorGuard> array( &alloc );
 
     for ( i = 0; i < 64; ++i )
     {
@@ -131,7 +132,7 @@ TEST( DynamicArray, InsertAndRemove )
     uint32 tmp;
 
     DefaultAllocator<uint32> alloc;
-    DynamicArray<uint32> array( &alloc );
+    DynamicArray<uint32, AllocatorGuard> array( &alloc );
 
     // force wrap
     array.push( 0 );
@@ -161,20 +162,20 @@ TEST( DynamicArray, Iterator )
     uint32 i;
 
     DefaultAllocator<uint32> alloc;
-    DynamicArray<uint32> list( &alloc );
+    DynamicArray<uint32, AllocatorGuard> list( &alloc );
 
     for ( i = 0; i < 64; ++i )
     {
         list.push( i );
     }
 
-    DynamicArray<uint32>::Iterator iter;
+    DynamicArray<uint32, AllocatorGuard>::Iterator iter;
     for ( i = 0, iter = list.begin(); iter != list.end(); ++iter, ++i )
     {
         ASSERT_EQ( i, *iter );
     }
 
-    DynamicArray<uint32>::Iterator iter2;
+    DynamicArray<uint32, AllocatorGuard>::Iterator iter2;
     for ( iter = iter2 = list.begin(); iter != list.end(); ++iter, ++iter2 )
     {
         ASSERT_EQ( iter, iter2 );
@@ -185,11 +186,48 @@ TEST( DynamicArray, Iterator )
         ASSERT_EQ( i, *iter );
     }
 
-    DynamicArray<uint32>::ConstIterator citer;
+    DynamicArray<uint32, AllocatorGuard>::ConstIterator citer;
     for ( i = 0, citer = list.cbegin(); citer != list.cend(); ++i, ++citer )
     {
         ASSERT_EQ( i, *citer );
     }
 
     EXPECT_THROW( list.at( 65 ), std::runtime_error );
-}
\ No newline at end of file
+}
+
+TEST( DynamicArray, ContiguousSize )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<uint32> array;
+    uint32 first;
+    uint32 i;
+
+    for ( i = 0; i < 10; ++i )
+    {
+        array.push( i );
+    }
+    EXPECT_EQ( 10, array.contiguousSize( 0 ) );
+    EXPECT_EQ( 4, array.contiguousSize( 6 ) );
+
+    // move the front forward so that the back wraps around
+    for ( i = 0; i < 8; ++i )
+    {
+        array.popFront();
+    }
+    for ( i = 10; i < 35; ++i )
+    {
+        array.push( i );
+    }
+
+    first = array.contiguousSize( 0 );
+    ASSERT_LT( first, array.size() );
+    EXPECT_EQ( array.size(), first + array.contiguousSize( first ) );
+    EXPECT_EQ( 1, array.contiguousSize( first - 1 ) );
+
+    for ( i = 1; i < first; ++i )
+    {
+        EXPECT_EQ( &array[0] + i, &array[i] );
+    }
+}
@@ -10,11 +10,12 @@ TEST( FixedArray, ConstructionAndAssignment )
 
     DefaultAllocator<uint32> alloc;
 
-    FixedArray<uint32> array( &alloc );
-    FixedArray<uint32> copy( array );
-    FixedArray<uint32> move( std::move( array ) );
-    FixedArray<uint32> capacity( &alloc, static_cast<uint32>( 100 ) );
-    FixedArray<uint32> def;
+    FixedArray<uint32, AllocatorGuard> array( &alloc );
+    FixedArray<uint32, AllocatorGuard> copy( array );
+    FixedArray<uint32, AllocatorGuard> move( std::move( array ) );
+    FixedArray<uint32, AllocatorGuard> capacity( &alloc,
+                                                 static_cast<uint32>( 100 ) );
+    FixedArray<uint32, AllocatorGuard> def;
 
     def = copy;
     def = std::move( copy );
@@ -33,7 +34,7 @@ TEST( FixedArray, PushAndPop )
     uint32 tmp;
 
     DefaultAllocator<uint32> alloc;
-    FixedArray<uint32> array( &alloc, MAX_SIZE );
+    FixedArray<uint32, AllocatorGuard> array( &alloc, MAX_SIZE );
 
     // push
     array.push( 0 );
@@ -107,7 +108,7 @@ TEST( FixedArray, At )
     uint32 i;
 
     DefaultAllocator<uint32> alloc;
-    FixedArray<uint32> array( &alloc, SIZE );
+    FixedArray<uint32, AllocatorGuard> array( &alloc, SIZE );
 
     for ( i = 0; i < SIZE; ++i )
     {
@@ -134,7 +135,7 @@ TEST( FixedArray, InsertAndRemove )
     uint32 tmp;
 
     DefaultAllocator<uint32> alloc;
-    FixedArray<uint32> array( &alloc, SIZE );
+    FixedArray<uint32, AllocatorGuard> array( &alloc, SIZE );
 
     for ( i = 0; i < SIZE; ++i )
     {
@@ -161,20 +162,20 @@ TEST( FixedArray, Iterator )
     uint32 i;
 
     DefaultAllocator<uint32> alloc;
-    FixedArray<uint32> list( &alloc, SIZE );
+    FixedArray<uint32, AllocatorGuard> list( &alloc, SIZE );
 
     for ( i = 0; i < SIZE; ++i )
     {
         list.push( i );
     }
 
-    FixedArray<uint32>::Iterator iter;
+    FixedArray<uint32, AllocatorGuard>::Iterator iter;
     for ( i = 0, iter = list.begin(); iter != list.end(); ++iter, ++i )
     {
         ASSERT_EQ( i, *iter );
     }
 
-    FixedArray<uint32>::Iterator iter2;
+    FixedArray<uint32, AllocatorGuard>::Iterator iter2;
     for ( iter = iter2 = list.begin(); iter != list.end(); ++iter, ++iter2 )
     {
         ASSERT_EQ( iter, iter2 );
@@ -185,7 +186,7 @@ TEST( FixedArray, Iterator )
         ASSERT_EQ( i, *iter );
     }
 
-    FixedArray<uint32>::ConstIterator citer;
+    FixedArray<uint32, AllocatorGuard>::ConstIterator citer;
     for ( i = 0, citer = list.cbegin(); citer != list.cend(); ++i, ++citer )
     {
         ASSERT_EQ( i, *citer );
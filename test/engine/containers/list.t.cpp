@@ -11,11 +11,11 @@ TEST( List, ConstructionAndAssignment )
     DefaultAllocator<List<uint32>::Node> alloc;
 
     List<uint32> capacity( 128 );
-    List<uint32> list( &alloc );
-    List<uint32> copy( list );
-    List<uint32> move( std::move( list ) );
-    List<uint32> capacityWithAlloc( &alloc, 128 );
-    List<uint32> def;
+    List<uint32, AllocatorGuard> list( &alloc );
+    List<uint32, AllocatorGuard> copy( list );
+    List<uint32, AllocatorGuard> move( std::move( list ) );
+    List<uint32, AllocatorGuard> capacityWithAlloc( &alloc, 128 );
+    List<uint32, AllocatorGuard> def;
 
     def = copy;
     def = std::move( copy );
@@ -33,7 +33,7 @@ TEST( List, PushAndPop )
     uint32 tmp;
 
     DefaultAllocator<List<uint32>::Node> alloc;
-    List<uint32> list( &alloc );
+    List<uint32, AllocatorGuard> list( &alloc );
 
     // push
     list.push( 0 );
@@ -105,7 +105,7 @@ TEST( List, At )
     uint32 i;
 
     DefaultAllocator<List<uint32>::Node> alloc;
-    List<uint32> list( &alloc );
+    List<uint32, AllocatorGuard> list( &alloc );
 
     for ( i = 0; i < 64; ++i )
     {
@@ -132,7 +132,7 @@ TEST( List, InsertAndRemove )
     uint32 tmp;
 
     DefaultAllocator<List<uint32>::Node> alloc;
-    List<uint32> list( &alloc );
+    List<uint32, AllocatorGuard> list( &alloc );
 
     // force wrap
     list.push( 0 );
@@ -162,20 +162,20 @@ TEST( List, Iterator )
     uint32 i;
 
     DefaultAllocator<List<uint32>::Node> alloc;
-    List<uint32> list( &alloc );
+    List<uint32, AllocatorGuard> list( &alloc );
 
     for ( i = 0; i < 64; ++i )
     {
         list.push( i );
     }
 
-    List<uint32>::Iterator iter;
+    List<uint32, AllocatorGuard>::Iterator iter;
     for ( i = 0, iter = list.begin(); iter != list.end(); ++iter, ++i )
     {
         ASSERT_EQ( i, *iter );
     }
 
-    List<uint32>::Iterator iter2;
+    List<uint32, AllocatorGuard>::Iterator iter2;
     for ( iter = iter2 = list.begin(); iter != list.end(); ++iter, ++iter2 )
     {
         ASSERT_EQ( iter, iter2 );
@@ -186,7 +186,7 @@ TEST( List, Iterator )
         ASSERT_EQ( i, *iter );
     }
 
-    List<uint32>::ConstIterator citer;
+    List<uint32, AllocatorGuard>::ConstIterator citer;
     for ( i = 0, citer = list.cbegin(); citer != list.cend(); ++i, ++citer )
     {
         ASSERT_EQ( i, *citer );
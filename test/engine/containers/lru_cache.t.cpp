@@ -0,0 +1,161 @@
+// lru_cache.t.cpp
+#include <engine/containers/lru_cache.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( LruCache, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    typedef LruCache<uint32, uint32> Cache;
+
+    CountingAllocator<Cache::Node> nodeAlloc;
+    CountingAllocator<Cache::Pair> pairAlloc;
+    CountingAllocator<uint32> binAlloc;
+
+    Cache weighed( 16, []( const uint32&, const uint32& v ) { return v; } );
+    Cache withAlloc( &nodeAlloc, &pairAlloc, &binAlloc, 16 );
+    Cache def( 16 );
+
+    EXPECT_LT( 0, nodeAlloc.getAllocationCount() );
+    EXPECT_LT( 0, binAlloc.getAllocationCount() );
+
+    withAlloc.put( 1, 2 );
+    withAlloc.put( 3, 4 );
+
+    Cache copy( withAlloc );
+    EXPECT_EQ( 2, copy.size() );
+    EXPECT_EQ( 2, *copy.get( 1 ) );
+
+    Cache move( std::move( copy ) );
+    EXPECT_EQ( 2, move.size() );
+    EXPECT_EQ( 0, copy.size() );
+
+    def = move;
+    EXPECT_EQ( 4, *def.get( 3 ) );
+    def = std::move( move );
+    EXPECT_EQ( 2, def.size() );
+}
+
+TEST( LruCache, PutGetAndEvict )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 CAPACITY = 64;
+
+    uint32 i;
+    uint32 evicted = 0;
+    uint32 lastEvicted = 0;
+
+    LruCache<uint32, uint32> cache( CAPACITY );
+    cache.setEvictionCallback( [&]( const uint32& key, uint32& value ) {
+        EXPECT_EQ( key * 2, value );
+        lastEvicted = key;
+        ++evicted;
+    } );
+
+    EXPECT_TRUE( cache.isEmpty() );
+    EXPECT_EQ( nullptr, cache.get( 0 ) );
+
+    for ( i = 0; i < CAPACITY; ++i )
+    {
+        cache.put( i, i * 2 );
+    }
+
+    EXPECT_EQ( CAPACITY, cache.size() );
+    EXPECT_EQ( 0, evicted );
+
+    // touching the oldest entry makes the next one the least recently used
+    EXPECT_EQ( 0, *cache.get( 0 ) );
+    cache.put( CAPACITY, CAPACITY * 2 );
+
+    EXPECT_EQ( 1, evicted );
+    EXPECT_EQ( 1, lastEvicted );
+    EXPECT_TRUE( cache.has( 0 ) );
+    EXPECT_FALSE( cache.has( 1 ) );
+
+    // replacing an entry does not evict anything
+    cache.put( 2, 4 );
+    EXPECT_EQ( 1, evicted );
+    EXPECT_EQ( CAPACITY, cache.size() );
+
+    EXPECT_TRUE( cache.remove( 3 ) );
+    EXPECT_FALSE( cache.remove( 3 ) );
+    EXPECT_EQ( 1, evicted );
+
+    cache.setCapacity( CAPACITY / 2 );
+    EXPECT_EQ( CAPACITY / 2, cache.size() );
+    EXPECT_EQ( CAPACITY / 2, evicted );
+    EXPECT_TRUE( cache.has( 2 ) );
+    EXPECT_TRUE( cache.has( CAPACITY ) );
+
+    while ( cache.evict() )
+    {
+        // do nothing
+    }
+
+    EXPECT_TRUE( cache.isEmpty() );
+    EXPECT_EQ( CAPACITY, evicted );
+
+    cache.put( 1, 2 );
+    cache.clear();
+    EXPECT_TRUE( cache.isEmpty() );
+    EXPECT_EQ( CAPACITY, evicted );
+}
+
+TEST( LruCache, Weigher )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    LruCache<uint32, String> cache(
+        16, []( const uint32&, const String& value ) {
+            return static_cast<uint32>( value.size() );
+        } );
+
+    cache.put( 1, "aaaa" );
+    cache.put( 2, "bbbbbbbb" );
+    EXPECT_EQ( 12, cache.weight() );
+
+    cache.put( 3, "cccccc" );
+    EXPECT_EQ( 14, cache.weight() );
+    EXPECT_FALSE( cache.has( 1 ) );
+
+    // an entry heavier than the capacity is evicted immediately
+    cache.put( 4, String( 17, 'd' ) );
+    EXPECT_FALSE( cache.has( 4 ) );
+    EXPECT_TRUE( cache.isEmpty() );
+    EXPECT_EQ( 0, cache.weight() );
+}
+
+TEST( LruCache, StableValues )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 256;
+
+    uint32 i;
+
+    LruCache<uint32, uint32> cache( SIZE );
+    cache.put( 0, 7 );
+    uint32* value = cache.get( 0 );
+
+    // growing the node pool does not move the entries
+    for ( i = 1; i < SIZE; ++i )
+    {
+        cache.put( i, i );
+    }
+
+    EXPECT_EQ( value, cache.get( 0 ) );
+    EXPECT_EQ( 7, *value );
+
+    LruCache<uint32, uint32> copy( cache );
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i == 0 ? 7 : i, *copy.get( i ) );
+    }
+}
@@ -2,18 +2,19 @@
 #include <engine/containers/map.h>
 #include <gtest/gtest.h>
 #include <engine/memory/counting_allocator.h>
+#include <engine/memory/tracking_allocator.h>
 
 namespace
 {
 
-nge::cntr::DynamicArray<nge::String>
+nge::cntr::DynamicArray<nge::String, nge::mem::AllocatorGuard>
 getKeys( nge::mem::IAllocator<nge::String>* allocator )
 {
     using namespace nge::cntr;
     using namespace nge::mem;
     using namespace nge;
 
-    DynamicArray<String> arr( allocator );
+    DynamicArray<String, AllocatorGuard> arr( allocator );
 
     int32 i;
     int32 j;
@@ -51,13 +52,14 @@ TEST( Map, Construction )
     Map<String, String> map1();
     Map<String, String> map2( func );
     Map<String, String> map3( 3000 );
-    Map<String, String> map4( &pairAlloc, &intAlloc );
-    Map<String, String> map5( &pairAlloc, &intAlloc, 3000 );
-    Map<String, String> map6( &pairAlloc, &intAlloc, func );
-    Map<String, String> map7( &pairAlloc, &intAlloc, 3000, func );
-
-    Map<String, String> copyMap( map7 );
-    Map<String, String> moveMap( std::move( map7 ) );
+    Map<String, String, AllocatorGuard> map4( &pairAlloc, &intAlloc );
+    Map<String, String, AllocatorGuard> map5( &pairAlloc, &intAlloc, 3000 );
+    Map<String, String, AllocatorGuard> map6( &pairAlloc, &intAlloc, func );
+    Map<String, String, AllocatorGuard> map7( &pairAlloc, &intAlloc, 3000,
+                                              func );
+
+    Map<String, String, AllocatorGuard> copyMap( map7 );
+    Map<String, String, AllocatorGuard> moveMap( std::move( map7 ) );
 }
 
 TEST( Map, CopyAndMove )
@@ -70,8 +72,8 @@ TEST( Map, CopyAndMove )
     CountingAllocator<Map<String, String>::Pair> pairAlloc;
     CountingAllocator<uint32> binAlloc;
 
-    Map<String, String> map( &pairAlloc, &binAlloc );
-    DynamicArray<String> keys = getKeys( &alloc );
+    Map<String, String, AllocatorGuard> map( &pairAlloc, &binAlloc );
+    DynamicArray<String, AllocatorGuard> keys = getKeys( &alloc );
 
     uint32 i;
     for ( i = 0; i < keys.size(); ++i )
@@ -79,13 +81,13 @@ TEST( Map, CopyAndMove )
         map[keys[i]] = keys[i];
     }
 
-    Map<String, String> copy( map );
+    Map<String, String, AllocatorGuard> copy( map );
     for ( i = 0; i < keys.size(); ++i )
     {
         ASSERT_STREQ( keys[i].c_str(), copy[keys[i]].c_str() );
     }
 
-    Map<String, String> moved( std::move( copy ) );
+    Map<String, String, AllocatorGuard> moved( std::move( copy ) );
     for ( i = 0; i < keys.size(); ++i )
     {
         ASSERT_STREQ( keys[i].c_str(), moved[keys[i]].c_str() );
@@ -107,8 +109,8 @@ TEST( Map, InsertionAndRemoval )
     CountingAllocator<Map<String, String>::Pair> pairAlloc;
     CountingAllocator<uint32> binAlloc;
 
-    Map<String, String> map( &pairAlloc, &binAlloc );
-    DynamicArray<String> keys = getKeys( &alloc );
+    Map<String, String, AllocatorGuard> map( &pairAlloc, &binAlloc );
+    DynamicArray<String, AllocatorGuard> keys = getKeys( &alloc );
 
     uint32 i;
     for ( i = 0; i < keys.size(); ++i )
@@ -178,6 +180,52 @@ TEST( Map, InsertionAndRemoval )
     ASSERT_TRUE( map.isEmpty() );
 }
 
+TEST( Map, Find )
+{
+    using namespace nge::cntr;
+    using namespace nge;
+
+    Map<uint32, uint32> map;
+    const Map<uint32, uint32>& constMap = map;
+
+    uint32 i;
+    for ( i = 0; i < 100; ++i )
+    {
+        map.put( i, i * 2 );
+    }
+
+    for ( i = 0; i < 100; ++i )
+    {
+        ASSERT_NE( nullptr, constMap.find( i ) );
+        ASSERT_EQ( i * 2, *constMap.find( i ) );
+    }
+
+    *map.find( 5 ) = 1;
+    EXPECT_EQ( 1, map[5] );
+
+    // finding a missing key does not add it
+    EXPECT_EQ( nullptr, map.find( 100 ) );
+    EXPECT_EQ( nullptr, constMap.find( 100 ) );
+    EXPECT_EQ( 100, map.size() );
+
+    map.remove( 7 );
+    EXPECT_EQ( nullptr, map.find( 7 ) );
+
+    // removing through the output only touches present keys
+    uint32 value = 0;
+    EXPECT_FALSE( map.remove( 7, &value ) );
+    EXPECT_EQ( 0, value );
+    EXPECT_TRUE( map.remove( 9, &value ) );
+    EXPECT_EQ( 18, value );
+    EXPECT_TRUE( map.remove( 11, nullptr ) );
+    EXPECT_EQ( nullptr, map.find( 11 ) );
+    EXPECT_EQ( 97, map.size() );
+
+    map.enableFilter();
+    EXPECT_EQ( nullptr, map.find( 7 ) );
+    EXPECT_EQ( 8, *map.find( 4 ) );
+}
+
 TEST( Map, Iterator )
 {
     using namespace nge::cntr;
@@ -188,8 +236,8 @@ TEST( Map, Iterator )
     CountingAllocator<Map<String, String>::Pair> pairAlloc;
     CountingAllocator<uint32> binAlloc;
 
-    Map<String, String> map( &pairAlloc, &binAlloc );
-    DynamicArray<String> keys = getKeys( &alloc );
+    Map<String, String, AllocatorGuard> map( &pairAlloc, &binAlloc );
+    DynamicArray<String, AllocatorGuard> keys = getKeys( &alloc );
 
     uint32 i;
     for ( i = 0; i < keys.size(); ++i )
@@ -208,4 +256,127 @@ TEST( Map, Iterator )
         ASSERT_STREQ( keys[i].c_str(), iter->key.c_str() );
         ASSERT_STREQ( keys[i].c_str(), iter->value.c_str() );
     }
-}
\ No newline at end of file
+}
+
+TEST( Map, RemovalWithCollisions )
+{
+    using namespace nge::cntr;
+    using namespace nge;
+
+    Map<uint32, uint32> map( []( const uint32& /* key */ ) { return 0u; } );
+
+    uint32 i;
+    for ( i = 0; i < 16; ++i )
+    {
+        map[i] = i;
+    }
+
+    map.remove( 3 );
+
+    for ( i = 0; i < 16; ++i )
+    {
+        ASSERT_EQ( i != 3, map.has( i ) );
+    }
+
+    for ( i = 0; i < 16; ++i )
+    {
+        if ( i != 3 )
+        {
+            ASSERT_EQ( i, map.remove( i ) );
+        }
+    }
+
+    EXPECT_TRUE( map.isEmpty() );
+}
+
+TEST( Map, RemovalChurn )
+{
+    using namespace nge::cntr;
+    using namespace nge::mem;
+    using namespace nge;
+
+    TrackingAllocator<Map<uint32, uint32>::Pair> pairAlloc( "map.churn" );
+    TrackingAllocator<uint32> intAlloc( "map.churn.bins" );
+    Map<uint32, uint32, AllocatorGuard> map( &pairAlloc, &intAlloc );
+    uint64 allocations;
+    uint32 i;
+
+    for ( i = 0; i < 1000; ++i )
+    {
+        map.put( i, i );
+    }
+
+    // removing and adding keeps the size the same, so the bins are only
+    // rehashed in place and never reallocated
+    allocations = intAlloc.tracker()->stats().allocations;
+    for ( i = 1000; i < 100000; ++i )
+    {
+        ASSERT_EQ( i - 1000, map.remove( i - 1000 ) );
+        map.put( i, i );
+    }
+
+    EXPECT_EQ( allocations, intAlloc.tracker()->stats().allocations );
+    EXPECT_EQ( 1000, map.size() );
+    for ( i = 0; i < 100000; ++i )
+    {
+        ASSERT_EQ( i >= 99000, map.has( i ) );
+    }
+}
+
+TEST( Map, Filter )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 1024;
+
+    uint32 i;
+
+    Map<uint32, uint32> map;
+    for ( i = 0; i < SIZE / 2; ++i )
+    {
+        map[i] = i;
+    }
+
+    EXPECT_FALSE( map.isFiltered() );
+    map.enableFilter();
+    EXPECT_TRUE( map.isFiltered() );
+
+    for ( i = SIZE / 2; i < SIZE; ++i )
+    {
+        map.put( i, i );
+    }
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_TRUE( map.has( i ) );
+        ASSERT_FALSE( map.has( i + SIZE ) );
+    }
+
+    for ( i = 0; i < SIZE; i += 2 )
+    {
+        ASSERT_EQ( i, map.remove( i ) );
+    }
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i % 2 == 1, map.has( i ) );
+    }
+
+    Map<uint32, uint32> copy( map );
+    EXPECT_TRUE( copy.isFiltered() );
+    EXPECT_TRUE( copy.has( 1 ) );
+    EXPECT_FALSE( copy.has( 0 ) );
+
+    Map<uint32, uint32> move( std::move( map ) );
+    EXPECT_TRUE( move.isFiltered() );
+    EXPECT_TRUE( move.has( 1 ) );
+    EXPECT_FALSE( map.isFiltered() );
+
+    // assigning an unfiltered map drops the filter
+    Map<uint32, uint32> plain;
+    copy = plain;
+    EXPECT_FALSE( copy.isFiltered() );
+    move = std::move( plain );
+    EXPECT_FALSE( move.isFiltered() );
+}
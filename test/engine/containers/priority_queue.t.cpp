@@ -0,0 +1,237 @@
+// priority_queue.t.cpp
+#include <engine/containers/priority_queue.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Task
+{
+    nge::uint32 id;
+    nge::uint32 cost;
+
+    bool operator==( const Task& task ) const
+    {
+        return id == task.id;
+    }
+
+    bool operator<( const Task& task ) const
+    {
+        return cost < task.cost;
+    }
+};
+
+nge::uint32 hashTask( const Task& task )
+{
+    return nge::util::Hasher<nge::uint32>::hash( task.id );
+}
+
+Task makeTask( nge::uint32 id, nge::uint32 cost )
+{
+    Task task;
+    task.id = id;
+    task.cost = cost;
+    return task;
+}
+
+} // End nspc anonymous
+
+TEST( PriorityQueue, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<uint32> alloc;
+
+    PriorityQueue<uint32> def;
+    PriorityQueue<uint32> capacity( 128 );
+    PriorityQueue<uint32, std::greater<uint32>> compare(
+        ( std::greater<uint32>() ) );
+    PriorityQueue<uint32> withAlloc( &alloc );
+    PriorityQueue<uint32> full( &alloc, 128, std::less<uint32>() );
+
+    full.push( 3 );
+    full.push( 1 );
+
+    PriorityQueue<uint32> copy( full );
+    EXPECT_EQ( 2, copy.size() );
+    EXPECT_EQ( 1, copy.top() );
+
+    PriorityQueue<uint32> move( std::move( copy ) );
+    EXPECT_EQ( 2, move.size() );
+    EXPECT_EQ( 0, copy.size() );
+
+    def = move;
+    EXPECT_EQ( 1, def.top() );
+    def = std::move( move );
+    EXPECT_EQ( 2, def.size() );
+}
+
+TEST( PriorityQueue, PushAndPop )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 1024;
+
+    uint32 i;
+    uint32 prev;
+
+    PriorityQueue<uint32> queue;
+    PriorityQueue<uint32, std::greater<uint32>> maxQueue;
+    PriorityQueue<uint32, std::less<uint32>, 4> quadQueue;
+
+    EXPECT_TRUE( queue.isEmpty() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        queue.push( ( i * 7919 ) % SIZE );
+        maxQueue.push( ( i * 7919 ) % SIZE );
+        quadQueue.push( ( i * 7919 ) % SIZE );
+    }
+
+    EXPECT_EQ( SIZE, queue.size() );
+    EXPECT_EQ( 0, queue.top() );
+    EXPECT_EQ( SIZE - 1, maxQueue.top() );
+    EXPECT_EQ( 0, quadQueue.top() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i, queue.pop() );
+        ASSERT_EQ( i, quadQueue.pop() );
+    }
+
+    for ( prev = maxQueue.pop(); !maxQueue.isEmpty(); )
+    {
+        ASSERT_GE( prev, maxQueue.top() );
+        prev = maxQueue.pop();
+    }
+
+    EXPECT_TRUE( queue.isEmpty() );
+    EXPECT_TRUE( quadQueue.isEmpty() );
+}
+
+TEST( PriorityQueue, Heapify )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 513;
+
+    uint32 values[SIZE];
+    uint32 i;
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        values[i] = SIZE - i - 1;
+    }
+
+    PriorityQueue<uint32, std::less<uint32>, 4> queue;
+    queue.push( 10000 );
+    queue.heapify( values, SIZE );
+
+    EXPECT_EQ( SIZE, queue.size() );
+    EXPECT_FALSE( queue.has( 10000 ) );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i, queue.pop() );
+    }
+}
+
+TEST( PriorityQueue, Tracking )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 256;
+
+    uint32 i;
+
+    PriorityQueue<Task> queue;
+    for ( i = 0; i < SIZE; ++i )
+    {
+        queue.push( makeTask( i, i + SIZE ) );
+    }
+
+    EXPECT_FALSE( queue.isTracking() );
+    queue.enableTracking( &hashTask );
+    EXPECT_TRUE( queue.isTracking() );
+
+    EXPECT_TRUE( queue.has( makeTask( 5, 0 ) ) );
+    EXPECT_FALSE( queue.has( makeTask( SIZE, 0 ) ) );
+
+    // decrease key
+    EXPECT_TRUE( queue.update( makeTask( 200, 0 ), makeTask( 200, 1 ) ) );
+    EXPECT_EQ( 200, queue.top().id );
+    EXPECT_FALSE( queue.update( makeTask( SIZE, 0 ), makeTask( SIZE, 1 ) ) );
+
+    // increase key
+    EXPECT_TRUE( queue.update( makeTask( 200, 0 ), makeTask( 200, 10000 ) ) );
+    EXPECT_EQ( 0, queue.top().id );
+
+    // remove
+    EXPECT_TRUE( queue.remove( makeTask( 0, 0 ) ) );
+    EXPECT_TRUE( queue.remove( makeTask( 100, 0 ) ) );
+    EXPECT_FALSE( queue.remove( makeTask( 100, 0 ) ) );
+    EXPECT_FALSE( queue.has( makeTask( 100, 0 ) ) );
+    EXPECT_EQ( SIZE - 2, queue.size() );
+
+    for ( i = 1; i < SIZE; ++i )
+    {
+        if ( i == 100 || i == 200 )
+        {
+            continue;
+        }
+
+        ASSERT_EQ( i, queue.pop().id );
+        ASSERT_FALSE( queue.has( makeTask( i, 0 ) ) );
+    }
+
+    EXPECT_EQ( 200, queue.pop().id );
+    EXPECT_TRUE( queue.isEmpty() );
+}
+
+TEST( PriorityQueue, TrackingAllocators )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    typedef PriorityQueue<Task>::Pair Pair;
+
+    CountingAllocator<Pair> pairAlloc;
+    CountingAllocator<uint32> binAlloc;
+    uint32 i;
+
+    {
+        PriorityQueue<Task> queue;
+        for ( i = 0; i < 64; ++i )
+        {
+            queue.push( makeTask( i, 64 - i ) );
+        }
+
+        EXPECT_FALSE( queue.isTracking() );
+
+        // the positions map is allocated with the given allocators
+        queue.enableTracking( &hashTask, &pairAlloc, &binAlloc );
+        EXPECT_TRUE( queue.isTracking() );
+        EXPECT_LT( 0, pairAlloc.getAllocationCount() );
+        EXPECT_LT( 0, binAlloc.getAllocationCount() );
+
+        PriorityQueue<Task> copy( queue );
+        EXPECT_TRUE( copy.isTracking() );
+        EXPECT_TRUE( copy.remove( makeTask( 10, 0 ) ) );
+        EXPECT_TRUE( queue.has( makeTask( 10, 0 ) ) );
+
+        PriorityQueue<Task> move( std::move( queue ) );
+        EXPECT_TRUE( move.isTracking() );
+        EXPECT_FALSE( queue.isTracking() );
+        EXPECT_EQ( 63, move.pop().id );
+    }
+
+    EXPECT_EQ( 0, pairAlloc.getAllocationCount() );
+    EXPECT_EQ( 0, binAlloc.getAllocationCount() );
+}
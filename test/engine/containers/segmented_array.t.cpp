@@ -0,0 +1,143 @@
+// segmented_array.t.cpp
+#include <engine/containers/segmented_array.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( SegmentedArray, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    DefaultAllocator<uint32> alloc;
+
+    SegmentedArray<uint32> array( &alloc );
+    SegmentedArray<uint32> blockSize( static_cast<uint32>( 100 ) );
+    SegmentedArray<uint32> full( &alloc, 16 );
+    SegmentedArray<uint32> def;
+
+    EXPECT_EQ( 128, blockSize.blockSize() );
+    EXPECT_EQ( 16, full.blockSize() );
+
+    full.push( 1 );
+    full.push( 2 );
+
+    SegmentedArray<uint32> copy( full );
+    EXPECT_EQ( 2, copy.size() );
+    EXPECT_EQ( 2, copy[1] );
+
+    SegmentedArray<uint32> move( std::move( copy ) );
+    EXPECT_EQ( 2, move.size() );
+    EXPECT_EQ( 0, copy.size() );
+
+    def = move;
+    EXPECT_EQ( 1, def[0] );
+    def = std::move( move );
+    EXPECT_EQ( 2, def.size() );
+}
+
+TEST( SegmentedArray, PushAndPop )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 1024;
+
+    uint32 i;
+
+    SegmentedArray<uint32> array( 16 );
+    EXPECT_TRUE( array.isEmpty() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        array.push( i + 12 );
+        ASSERT_EQ( i + 12, array[array.size() - 1] );
+    }
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        array.pushFront( i + 69 );
+        ASSERT_EQ( i + 69, array[0] );
+    }
+
+    EXPECT_EQ( SIZE * 2, array.size() );
+    EXPECT_EQ( SIZE * 2 / 16, array.blockCount() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i + 69, array[SIZE - i - 1] );
+        ASSERT_EQ( i + 12, array.at( SIZE + i ) );
+    }
+
+    EXPECT_THROW( array.at( SIZE * 2 ), std::runtime_error );
+
+    for ( i = SIZE; i > 0; --i )
+    {
+        ASSERT_EQ( i - 1 + 12, array.pop() );
+        ASSERT_EQ( i - 1 + 69, array.popFront() );
+    }
+
+    EXPECT_TRUE( array.isEmpty() );
+    EXPECT_EQ( 0, array.blockCount() );
+
+    // alternate across a block boundary
+    for ( i = 0; i < SIZE; ++i )
+    {
+        array.pushFront( i );
+        ASSERT_EQ( i, array.popFront() );
+        array.push( i );
+        ASSERT_EQ( i, array.pop() );
+    }
+
+    EXPECT_TRUE( array.isEmpty() );
+}
+
+TEST( SegmentedArray, PointerStability )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    constexpr uint32 SIZE = 1000;
+
+    uint32 i;
+    const uint32* pointers[SIZE];
+
+    CountingAllocator<uint32> alloc;
+    SegmentedArray<uint32> array( &alloc, 32 );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        if ( i % 2 == 0 )
+        {
+            array.push( i );
+            pointers[i] = &array[array.size() - 1];
+        }
+        else
+        {
+            array.pushFront( i );
+            pointers[i] = &array[0];
+        }
+    }
+
+    // one block is allocated at a time
+    EXPECT_EQ( array.blockCount() * 32, alloc.getAllocationCount() );
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( i, *pointers[i] );
+    }
+
+    uint32 count = 0;
+    for ( auto iter = array.cbegin(); iter != array.cend(); ++iter )
+    {
+        ASSERT_EQ( array[count], *iter );
+        ++count;
+    }
+
+    EXPECT_EQ( SIZE, count );
+
+    array.clear();
+    EXPECT_TRUE( array.isEmpty() );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
@@ -32,11 +32,14 @@ TEST( Set, Construction )
 
     DefaultAllocator<std::string> valAlloc;
     DefaultAllocator<uint32> binAlloc;
-    Set<std::string> withAlloc( &valAlloc, &binAlloc );
-    Set<std::string> withAllocAndCap( &valAlloc, &binAlloc, 100 );
-    Set<std::string> withAllocAndHashFunc( &valAlloc, &binAlloc,
-                                           &HashUtils::fnv1a );
-    Set<std::string> withAll( &valAlloc, &binAlloc, 100, &HashUtils::fnv1a );
+    Set<std::string, AllocatorGuard> withAlloc( &valAlloc, &binAlloc );
+    Set<std::string, AllocatorGuard> withAllocAndCap( &valAlloc, &binAlloc,
+                                                      100 );
+    Set<std::string, AllocatorGuard> withAllocAndHashFunc( &valAlloc,
+                                                           &binAlloc,
+                                                           &HashUtils::fnv1a );
+    Set<std::string, AllocatorGuard> withAll( &valAlloc, &binAlloc, 100,
+                                              &HashUtils::fnv1a );
 }
 
 TEST( Set, MemberFunctions )
@@ -109,4 +112,90 @@ TEST( Set, Iterator )
     {
         ASSERT_EQ( iter, iter2 );
     }
-}
\ No newline at end of file
+}
+
+TEST( Set, RemovalWithCollisions )
+{
+    using namespace nge::cntr;
+    using namespace nge;
+
+    Set<uint32> set( []( const uint32& /* value */ ) { return 0u; } );
+
+    uint32 i;
+    for ( i = 0; i < 16; ++i )
+    {
+        set.add( i );
+    }
+
+    set.remove( 3 );
+    EXPECT_EQ( 15, set.size() );
+
+    for ( i = 0; i < 16; ++i )
+    {
+        ASSERT_EQ( i != 3, set.has( i ) );
+    }
+
+    for ( i = 0; i < 16; ++i )
+    {
+        set.remove( i );
+        ASSERT_FALSE( set.has( i ) );
+    }
+
+    EXPECT_TRUE( set.isEmpty() );
+
+    // removing and adding reclaims the removed bins
+    for ( i = 0; i < 10000; ++i )
+    {
+        set.add( i );
+        if ( i >= 8 )
+        {
+            set.remove( i - 8 );
+        }
+    }
+
+    EXPECT_EQ( 8, set.size() );
+    for ( i = 0; i < 10000; ++i )
+    {
+        ASSERT_EQ( i >= 9992, set.has( i ) );
+    }
+}
+
+TEST( Set, Filter )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 SIZE = 1024;
+
+    uint32 i;
+
+    Set<uint32> set;
+    for ( i = 0; i < SIZE / 2; ++i )
+    {
+        set.add( i );
+    }
+
+    EXPECT_FALSE( set.isFiltered() );
+    set.enableFilter();
+    EXPECT_TRUE( set.isFiltered() );
+
+    // values added before and after enabling the filter and after a resize
+    for ( i = SIZE / 2; i < SIZE; ++i )
+    {
+        set.add( i );
+    }
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        ASSERT_TRUE( set.has( i ) );
+        ASSERT_FALSE( set.has( i + SIZE ) );
+    }
+
+    Set<uint32> copy( set );
+    EXPECT_TRUE( copy.isFiltered() );
+    EXPECT_TRUE( copy.has( 0 ) );
+
+    set.clear();
+    EXPECT_TRUE( set.isFiltered() );
+    EXPECT_FALSE( set.has( 0 ) );
+}
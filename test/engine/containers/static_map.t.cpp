@@ -0,0 +1,95 @@
+// static_map.t.cpp
+#include <engine/containers/static_map.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr nge::cntr::StaticMap<nge::uint32, 5>::Entry ATTRIBUTES[] = {
+    { "position", 0 },
+    { "normal",   1 },
+    { "tangent",  2 },
+    { "uv",       3 },
+    { "color",    4 }
+};
+
+constexpr nge::cntr::StaticMap<nge::uint32, 5> ATTRIBUTE_MAP( ATTRIBUTES );
+
+constexpr nge::cntr::StaticMap<const char*, 1>::Entry SINGLE[] = {
+    { "only", "value" }
+};
+
+constexpr nge::cntr::StaticMap<const char*, 1> SINGLE_MAP( SINGLE );
+
+// 200 keys of the form "key000" through "key199"
+#define KEY( a, b, c ) { "key" #a #b #c, a * 100 + b * 10 + c }
+#define KEYS_10( a, b ) \
+    KEY( a, b, 0 ), KEY( a, b, 1 ), KEY( a, b, 2 ), KEY( a, b, 3 ), \
+    KEY( a, b, 4 ), KEY( a, b, 5 ), KEY( a, b, 6 ), KEY( a, b, 7 ), \
+    KEY( a, b, 8 ), KEY( a, b, 9 )
+#define KEYS_100( a ) \
+    KEYS_10( a, 0 ), KEYS_10( a, 1 ), KEYS_10( a, 2 ), KEYS_10( a, 3 ), \
+    KEYS_10( a, 4 ), KEYS_10( a, 5 ), KEYS_10( a, 6 ), KEYS_10( a, 7 ), \
+    KEYS_10( a, 8 ), KEYS_10( a, 9 )
+
+constexpr nge::cntr::StaticMap<nge::uint32, 200>::Entry MANY[] = {
+    KEYS_100( 0 ), KEYS_100( 1 )
+};
+
+#undef KEYS_100
+#undef KEYS_10
+#undef KEY
+
+constexpr nge::cntr::StaticMap<nge::uint32, 200> MANY_MAP( MANY );
+
+} // End nspc anonymous
+
+TEST( StaticMap, Lookup )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    static_assert( ATTRIBUTE_MAP.size() == 5, "size is a constant" );
+
+    ASSERT_EQ( 32, ATTRIBUTE_MAP.slotCount() );
+
+    for ( uint32 i = 0; i < ATTRIBUTE_MAP.size(); ++i )
+    {
+        const StaticMap<uint32, 5>::Entry& entry =
+            ATTRIBUTE_MAP.entries()[i];
+
+        ASSERT_NE( nullptr, ATTRIBUTE_MAP.find( entry.key ) );
+        ASSERT_EQ( entry.value, *ATTRIBUTE_MAP.find( entry.key ) );
+        ASSERT_TRUE( ATTRIBUTE_MAP.has( entry.key ) );
+    }
+
+    ASSERT_EQ( 3, ATTRIBUTE_MAP.at( "uv" ) );
+    ASSERT_EQ( 1, *ATTRIBUTE_MAP.find( chash( "normal" ), "normal" ) );
+
+    ASSERT_FALSE( ATTRIBUTE_MAP.has( "" ) );
+    ASSERT_FALSE( ATTRIBUTE_MAP.has( "positio" ) );
+    ASSERT_FALSE( ATTRIBUTE_MAP.has( "positions" ) );
+    ASSERT_EQ( nullptr, ATTRIBUTE_MAP.find( "binormal" ) );
+    ASSERT_THROW( ATTRIBUTE_MAP.at( "binormal" ), std::runtime_error );
+
+    ASSERT_STREQ( "value", *SINGLE_MAP.find( "only" ) );
+    ASSERT_FALSE( SINGLE_MAP.has( "other" ) );
+}
+
+TEST( StaticMap, ManyKeys )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    char key[8];
+
+    for ( uint32 i = 0; i < MANY_MAP.size(); ++i )
+    {
+        snprintf( key, sizeof( key ), "key%03u", i );
+        ASSERT_NE( nullptr, MANY_MAP.find( key ) ) << key;
+        ASSERT_EQ( i, *MANY_MAP.find( key ) );
+    }
+
+    ASSERT_FALSE( MANY_MAP.has( "key200" ) );
+    ASSERT_FALSE( MANY_MAP.has( "key" ) );
+}
@@ -0,0 +1,354 @@
+// batch.t.cpp
+#include <engine/math/batch.h>
+#include <engine/math/vec_math.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+using namespace nge;
+using namespace nge::math;
+
+// the count is not a multiple of a register so that every kernel has a
+// remainder to finish
+const uint32 COUNT = 37;
+
+/**
+ * Makes the vector for the index, which is never zero.
+ */
+Vec3 vector( uint32 index )
+{
+    return Vec3( 0.25f * index - 3.0f, 1.5f - 0.125f * index,
+                 0.5f + ( index % 7 ) );
+}
+
+/**
+ * Runs the test for each instruction set that is supported.
+ */
+template <typename F>
+void forEachInstructions( F test )
+{
+    Batch::Instructions original = Batch::instructions();
+    uint32 i;
+
+    for ( i = Batch::SCALAR; i <= Batch::supported(); ++i )
+    {
+        Batch::setInstructions( static_cast<Batch::Instructions>( i ) );
+        SCOPED_TRACE( i );
+        test();
+    }
+
+    Batch::setInstructions( original );
+}
+
+} // End nspc anonymous
+
+TEST( Batch, TransformPoints )
+{
+    Mat4 m( 0.5f, 3.0f, -1.0f, 4.0f,
+            1.0f, -0.25f, 2.0f, -5.0f,
+            -2.0f, 1.5f, 0.75f, 6.0f,
+            0.0f, 0.0f, 0.0f, 1.0f );
+
+    forEachInstructions( [&]() {
+        std::vector<Vec3> in( COUNT );
+        std::vector<Vec3> out( COUNT );
+        std::vector<float> x( COUNT );
+        std::vector<float> y( COUNT );
+        std::vector<float> z( COUNT );
+        Vec4 expected;
+        uint32 i;
+
+        for ( i = 0; i < COUNT; ++i )
+        {
+            in[i] = vector( i );
+            x[i] = in[i].x;
+            y[i] = in[i].y;
+            z[i] = in[i].z;
+        }
+
+        Batch::transformPoints( m, ArrayIn<Vec3>( &in[0], COUNT ),
+                                ArrayOut<Vec3>( &out[0], COUNT ) );
+        Batch::transformPoints( m, ArrayIn<float>( &x[0], COUNT ),
+                                ArrayIn<float>( &y[0], COUNT ),
+                                ArrayIn<float>( &z[0], COUNT ),
+                                ArrayOut<float>( &x[0], COUNT ),
+                                ArrayOut<float>( &y[0], COUNT ),
+                                ArrayOut<float>( &z[0], COUNT ) );
+
+        for ( i = 0; i < COUNT; ++i )
+        {
+            expected = m * Vec4( in[i], 1.0f );
+            EXPECT_FLOAT_EQ( expected.x, out[i].x );
+            EXPECT_FLOAT_EQ( expected.y, out[i].y );
+            EXPECT_FLOAT_EQ( expected.z, out[i].z );
+            EXPECT_FLOAT_EQ( expected.x, x[i] );
+            EXPECT_FLOAT_EQ( expected.y, y[i] );
+            EXPECT_FLOAT_EQ( expected.z, z[i] );
+        }
+    } );
+}
+
+TEST( Batch, Transform2D )
+{
+    Mat3 m( 0.5f, 2.0f, -3.0f,
+            -1.0f, 0.25f, 4.0f,
+            0.0f, 0.0f, 1.0f );
+
+    forEachInstructions( [&]() {
+        std::vector<Vec2> in( COUNT );
+        std::vector<Vec2> out( COUNT );
+        std::vector<float> x( COUNT );
+        std::vector<float> y( COUNT );
+        std::vector<float> outX( COUNT );
+        std::vector<float> outY( COUNT );
+        Vec3 expected;
+        uint32 i;
+
+        for ( i = 0; i < COUNT; ++i )
+        {
+            in[i] = Vec2( vector( i ).x, vector( i ).y );
+            x[i] = in[i].x;
+            y[i] = in[i].y;
+        }
+
+        Batch::transform2D( m, ArrayIn<Vec2>( &in[0], COUNT ),
+                            ArrayOut<Vec2>( &out[0], COUNT ) );
+        Batch::transform2D( m, ArrayIn<float>( &x[0], COUNT ),
+                            ArrayIn<float>( &y[0], COUNT ),
+                            ArrayOut<float>( &outX[0], COUNT ),
+                            ArrayOut<float>( &outY[0], COUNT ) );
+
+        for ( i = 0; i < COUNT; ++i )
+        {
+            expected = m * Vec3( in[i], 1.0f );
+            EXPECT_FLOAT_EQ( expected.x, out[i].x );
+            EXPECT_FLOAT_EQ( expected.y, out[i].y );
+            EXPECT_FLOAT_EQ( expected.x, outX[i] );
+            EXPECT_FLOAT_EQ( expected.y, outY[i] );
+        }
+    } );
+}
+
+TEST( Batch, VectorFunctions )
+{
+    forEachInstructions( [&]() {
+        std::vector<Vec3> a( COUNT );
+        std::vector<Vec3> b( COUNT );
+        std::vector<Vec3> out( COUNT );
+        std::vector<float> ax( COUNT );
+        std::vector<float> ay( COUNT );
+        std::vector<float> az( COUNT );
+        std::vector<float> bx( COUNT );
+        std::vector<float> by( COUNT );
+        std::vector<float> bz( COUNT );
+        std::vector<float> dots( COUNT );
+        std::vector<float> soaDots( COUNT );
+        Vec3 expected;
+        uint32 i;
+
+        for ( i = 0; i < COUNT; ++i )
+        {
+            a[i] = vector( i );
+            b[i] = vector( COUNT - i );
+            ax[i] = a[i].x;
+            ay[i] = a[i].y;
+            az[i] = a[i].z;
+            bx[i] = b[i].x;
+            by[i] = b[i].y;
+            bz[i] = b[i].z;
+        }
+
+        Batch::dotMany( ArrayIn<Vec3>( &a[0], COUNT ),
+                        ArrayIn<Vec3>( &b[0], COUNT ),
+                        ArrayOut<float>( &dots[0], COUNT ) );
+        Batch::dotMany( ArrayIn<float>( &ax[0], COUNT ),
+                        ArrayIn<float>( &ay[0], COUNT ),
+                        ArrayIn<float>( &az[0], COUNT ),
+                        ArrayIn<float>( &bx[0], COUNT ),
+                        ArrayIn<float>( &by[0], COUNT ),
+                        ArrayIn<float>( &bz[0], COUNT ),
+                        ArrayOut<float>( &soaDots[0], COUNT ) );
+        for ( i = 0; i < COUNT; ++i )
+        {
+            EXPECT_FLOAT_EQ( Vec::dot( a[i], b[i] ), dots[i] );
+            EXPECT_FLOAT_EQ( Vec::dot( a[i], b[i] ), soaDots[i] );
+        }
+
+        Batch::lerpMany( ArrayIn<Vec3>( &a[0], COUNT ),
+                         ArrayIn<Vec3>( &b[0], COUNT ), 0.25f,
+                         ArrayOut<Vec3>( &out[0], COUNT ) );
+        Batch::lerpMany( ArrayIn<float>( &ax[0], COUNT ),
+                         ArrayIn<float>( &bx[0], COUNT ), 0.25f,
+                         ArrayOut<float>( &ax[0], COUNT ) );
+        for ( i = 0; i < COUNT; ++i )
+        {
+            expected = a[i] + ( b[i] - a[i] ) * 0.25f;
+            EXPECT_FLOAT_EQ( expected.x, out[i].x );
+            EXPECT_FLOAT_EQ( expected.y, out[i].y );
+            EXPECT_FLOAT_EQ( expected.z, out[i].z );
+            EXPECT_FLOAT_EQ( expected.x, ax[i] );
+        }
+
+        Batch::normalizeAll( ArrayIn<Vec3>( &a[0], COUNT ),
+                             ArrayOut<Vec3>( &out[0], COUNT ) );
+        Batch::normalizeAll( ArrayIn<float>( &bx[0], COUNT ),
+                             ArrayIn<float>( &by[0], COUNT ),
+                             ArrayIn<float>( &bz[0], COUNT ),
+                             ArrayOut<float>( &bx[0], COUNT ),
+                             ArrayOut<float>( &by[0], COUNT ),
+                             ArrayOut<float>( &bz[0], COUNT ) );
+        for ( i = 0; i < COUNT; ++i )
+        {
+            expected = Vec::normalize( a[i] );
+            EXPECT_FLOAT_EQ( expected.x, out[i].x );
+            EXPECT_FLOAT_EQ( expected.y, out[i].y );
+            EXPECT_FLOAT_EQ( expected.z, out[i].z );
+
+            expected = Vec::normalize( b[i] );
+            EXPECT_FLOAT_EQ( expected.x, bx[i] );
+            EXPECT_FLOAT_EQ( expected.y, by[i] );
+            EXPECT_FLOAT_EQ( expected.z, bz[i] );
+        }
+    } );
+}
+
+TEST( Batch, Containers )
+{
+    Mat4 m( 2.0f, 0.0f, 0.0f, 1.0f,
+            0.0f, 3.0f, 0.0f, -1.0f,
+            0.0f, 0.0f, 4.0f, 0.5f,
+            0.0f, 0.0f, 0.0f, 1.0f );
+
+    forEachInstructions( [&]() {
+        cntr::DynamicArray<Vec3> points;
+        cntr::FixedArray<Vec3> world( 200 );
+        cntr::FixedArray<float> dots( 200 );
+        Vec3 expected;
+        uint32 i;
+
+        // move the front forward so that the points wrap around and are in
+        // two runs
+        for ( i = 0; i < 10; ++i )
+        {
+            points.push( vector( i ) );
+        }
+        for ( i = 0; i < 8; ++i )
+        {
+            points.popFront();
+        }
+        for ( i = 10; i < 35; ++i )
+        {
+            points.push( vector( i ) );
+        }
+        ASSERT_LT( points.contiguousSize( 0 ), points.size() );
+
+        for ( i = 0; i < points.size(); ++i )
+        {
+            world.push( Vec3() );
+            dots.push( 0.0f );
+        }
+
+        Batch::transformPoints( m, points, world );
+        Batch::dotMany( points, world, dots );
+        for ( i = 0; i < points.size(); ++i )
+        {
+            expected = Vec3( m * Vec4( points[i], 1.0f ) );
+            EXPECT_FLOAT_EQ( expected.x, world[i].x );
+            EXPECT_FLOAT_EQ( expected.y, world[i].y );
+            EXPECT_FLOAT_EQ( expected.z, world[i].z );
+            EXPECT_FLOAT_EQ( Vec::dot( points[i], world[i] ), dots[i] );
+        }
+
+        // transform in place, across the wrap of the array
+        Batch::transformPoints( m, points, points );
+        for ( i = 0; i < points.size(); ++i )
+        {
+            EXPECT_FLOAT_EQ( world[i].x, points[i].x );
+            EXPECT_FLOAT_EQ( world[i].y, points[i].y );
+            EXPECT_FLOAT_EQ( world[i].z, points[i].z );
+        }
+    } );
+}
+
+TEST( Batch, DISABLED_Benchmark )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const char* names[] = { "scalar", "sse", "avx2" };
+    const uint32 SIZE = 4096;
+    const uint32 ROUNDS = 2000;
+
+    Batch::Instructions original = Batch::instructions();
+    Mat4 m( 0.5f, 3.0f, -1.0f, 4.0f,
+            1.0f, -0.25f, 2.0f, -5.0f,
+            -2.0f, 1.5f, 0.75f, 6.0f,
+            0.0f, 0.0f, 0.0f, 1.0f );
+    std::vector<Vec3> points( SIZE );
+    std::vector<Vec3> out( SIZE );
+    std::vector<float> x( SIZE );
+    std::vector<float> y( SIZE );
+    std::vector<float> z( SIZE );
+    Clock::time_point start;
+    double seconds;
+    uint32 i;
+    uint32 r;
+
+    for ( i = 0; i < SIZE; ++i )
+    {
+        points[i] = vector( i );
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+
+    // the loop that the kernels replace
+    start = Clock::now();
+    for ( r = 0; r < ROUNDS; ++r )
+    {
+        for ( i = 0; i < SIZE; ++i )
+        {
+            out[i] = Vec3( m * Vec4( points[i], 1.0f ) );
+        }
+    }
+    seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+    std::cout << "per vector: " << SIZE * ROUNDS / seconds / 1e6
+              << " Mpoints/s\n";
+
+    for ( i = Batch::SCALAR; i <= Batch::supported(); ++i )
+    {
+        Batch::setInstructions( static_cast<Batch::Instructions>( i ) );
+
+        start = Clock::now();
+        for ( r = 0; r < ROUNDS; ++r )
+        {
+            Batch::transformPoints( m, ArrayIn<Vec3>( &points[0], SIZE ),
+                                    ArrayOut<Vec3>( &out[0], SIZE ) );
+        }
+        seconds =
+            std::chrono::duration<double>( Clock::now() - start ).count();
+        std::cout << names[i] << " aos: " << SIZE * ROUNDS / seconds / 1e6
+                  << " Mpoints/s\n";
+
+        start = Clock::now();
+        for ( r = 0; r < ROUNDS; ++r )
+        {
+            Batch::transformPoints( m, ArrayIn<float>( &x[0], SIZE ),
+                                    ArrayIn<float>( &y[0], SIZE ),
+                                    ArrayIn<float>( &z[0], SIZE ),
+                                    ArrayOut<float>( &x[0], SIZE ),
+                                    ArrayOut<float>( &y[0], SIZE ),
+                                    ArrayOut<float>( &z[0], SIZE ) );
+        }
+        seconds =
+            std::chrono::duration<double>( Clock::now() - start ).count();
+        std::cout << names[i] << " soa: " << SIZE * ROUNDS / seconds / 1e6
+                  << " Mpoints/s\n";
+    }
+
+    Batch::setInstructions( original );
+}
@@ -3,6 +3,12 @@
 #include <engine/math/mat.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
 TEST( TMat4x4, Construction )
 {
     using namespace nge::math;
@@ -277,6 +283,169 @@ TEST( TMat4x4, ArithmeticMatrixBinaryOperators )
     EXPECT_EQ( ie, x %= y );
 }
 
+TEST( TMat4x4, FloatProducts )
+{
+    using namespace nge::math;
+
+    Mat4 m( 1, 2, 3, 4, 4, 1, 2, 3, 3, 4, 1, 2, 2, 3, 4, 1 );
+    Mat4 n( 2, 3, 4, 1, 3, 4, 1, 2, 4, 1, 2, 3, 1, 2, 3, 4 );
+    Mat4 e;
+    DMat4 dm( m );
+    DMat4 dn( n );
+    Mat4::Column col;
+    Mat4::Row row;
+
+    // the float products have their own implementations so check them
+    // against the generic ones
+    e = Mat4( 24, 22, 24, 30, 22, 24, 30, 24, 24, 30, 24, 22, 30, 24, 22, 24 );
+    EXPECT_EQ( e, m * n );
+    EXPECT_EQ( Mat4( dn * dm ), n * m );
+    EXPECT_EQ( Mat4( dm * dn * dm ), m * n * m );
+
+    m *= n;
+    EXPECT_EQ( e, m );
+    m = Mat4( dm );
+
+    row = Mat4::Row( 1, 2, 3, 4 );
+    col = Mat4::Column( 30, 24, 22, 24 );
+    EXPECT_EQ( col, m * row );
+    EXPECT_EQ( Vec4( dn * DVec4( row ) ), n * row );
+
+    col = Mat4::Column( 1, 2, 3, 4 );
+    row = Mat4::Row( 26, 28, 26, 20 );
+    EXPECT_EQ( row, col * m );
+    EXPECT_EQ( Vec4( DVec4( col ) * dn ), col * n );
+
+    EXPECT_EQ( m, Mat4::IDENTITY * m );
+    EXPECT_EQ( m, m * Mat4::IDENTITY );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( &m ) % 16 );
+}
+
+TEST( TMat4x4, Inverses )
+{
+    using namespace nge;
+    using namespace nge::math;
+
+    Mat4 n( 2, 3, 4, 1, 3, 4, 1, 2, 4, 1, 2, 3, 1, 2, 3, 4 );
+    Mat4 rigid = Mat::translate( 3.0f, -2.0f, 5.0f ) *
+                 Mat::rotateX( 0.5f ) * Mat::rotateY( -1.25f );
+    Mat4 affine = rigid * Mat4( 2.0f, 0.5f, 0.0f, 0.0f,
+                                0.0f, 1.5f, 0.0f, 0.0f,
+                                0.25f, 0.0f, 3.0f, 0.0f,
+                                0.0f, 0.0f, 0.0f, 1.0f );
+    Mat4 general( 4, -1, 2, 0.5f, 1, 3, -2, 1, 0.5f, 2, 5, -1, 1, 0, 2, 3 );
+    DMat4 expected;
+    uint32 i;
+    uint32 j;
+
+    EXPECT_EQ( -160, Mat::determinant( n ) );
+    EXPECT_EQ( -44, Mat::determinant( Mat3( 2, 3, 4, 3, 4, 1, 4, 1, 2 ) ) );
+    EXPECT_EQ( -1, Mat::determinant( Mat2( 2, 3, 3, 4 ) ) );
+
+    // every path is checked against the generic inverse in double precision
+    expected = Mat::invert( DMat4( general ) );
+    for ( i = 0; i < 16; ++i )
+    {
+        EXPECT_NEAR( expected[i / 4][i % 4],
+                     Mat::invert( general )[i / 4][i % 4], 1e-6 );
+    }
+
+    expected = Mat::invert( DMat4( affine ) );
+    for ( i = 0; i < 16; ++i )
+    {
+        EXPECT_NEAR( expected[i / 4][i % 4],
+                     Mat::invert( affine )[i / 4][i % 4], 1e-5 );
+        EXPECT_NEAR( expected[i / 4][i % 4],
+                     Mat::invertAffine( affine )[i / 4][i % 4], 1e-5 );
+    }
+
+    expected = Mat::invert( DMat4( rigid ) );
+    for ( i = 0; i < 16; ++i )
+    {
+        EXPECT_NEAR( expected[i / 4][i % 4],
+                     Mat::invert( rigid )[i / 4][i % 4], 1e-5 );
+        EXPECT_NEAR( expected[i / 4][i % 4],
+                     Mat::invertAffine( rigid )[i / 4][i % 4], 1e-5 );
+        EXPECT_NEAR( expected[i / 4][i % 4],
+                     Mat::invertOrthonormal( rigid )[i / 4][i % 4], 1e-5 );
+    }
+
+    // a transform and its inverse undo each other
+    for ( i = 0; i < 4; ++i )
+    {
+        for ( j = 0; j < 4; ++j )
+        {
+            EXPECT_NEAR( i == j ? 1 : 0,
+                         ( Mat::invertOrthonormal( rigid ) * rigid )[i][j],
+                         1e-5 );
+            EXPECT_NEAR( i == j ? 1 : 0,
+                         ( Mat::invertAffine( affine ) * affine )[i][j], 1e-5 );
+        }
+    }
+}
+
+TEST( TMat4x4, DISABLED_InverseBenchmark )
+{
+    using namespace nge;
+    using namespace nge::math;
+
+    typedef std::chrono::steady_clock Clock;
+
+    // build with NGE_MATH_SCALAR to time the generic inverse instead of the
+    // SSE one
+    const uint32 COUNT = 1024;
+    const uint32 ROUNDS = 2000;
+
+    std::vector<Mat4> transforms( COUNT );
+    std::vector<Mat4> inverses( COUNT );
+    Mat4 ( *paths[] )( const Mat4& ) = { &Mat::invert<float>,
+                                         &Mat::invertAffine<float>,
+                                         &Mat::invertOrthonormal<float> };
+    const char* names[] = { "invert", "invertAffine", "invertOrthonormal" };
+    Clock::time_point start;
+    DMat4 expected;
+    double seconds;
+    double error;
+    uint32 i;
+    uint32 p;
+    uint32 r;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        transforms[i] = Mat::translate( 0.5f * i, -2.0f, 0.25f * ( i % 9 ) ) *
+                        Mat::rotateX( 0.01f * i ) * Mat::rotateZ( 0.5f );
+    }
+
+    for ( p = 0; p < sizeof( paths ) / sizeof( paths[0] ); ++p )
+    {
+        start = Clock::now();
+        for ( r = 0; r < ROUNDS; ++r )
+        {
+            for ( i = 0; i < COUNT; ++i )
+            {
+                inverses[i] = paths[p]( transforms[i] );
+            }
+        }
+        seconds =
+            std::chrono::duration<double>( Clock::now() - start ).count();
+
+        error = 0;
+        for ( i = 0; i < COUNT; ++i )
+        {
+            expected = Mat::invert( DMat4( transforms[i] ) );
+            for ( r = 0; r < 16; ++r )
+            {
+                error = std::max(
+                    error, std::abs( expected[r / 4][r % 4] -
+                                     inverses[i][r / 4][r % 4] ) );
+            }
+        }
+
+        std::cout << names[p] << ": " << COUNT * ROUNDS / seconds / 1e6
+                  << " M/s, max error " << error << "\n";
+    }
+}
+
 TEST( TMat4x4, BitwiseBinaryOperators )
 {
     using namespace nge::math;
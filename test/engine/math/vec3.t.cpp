@@ -164,6 +164,22 @@ TEST( TVec3, ArithmeticBinaryOperators )
     ASSERT_TRUE( v.x == 1 && v.y == 2 && v.z == 3 );
 }
 
+TEST( TVec3, VectorFunctions )
+{
+    using namespace nge::math;
+
+    Vec3 x( 1, 0, 0 );
+    Vec3 y( 0, 1, 0 );
+    Vec3 u( 1, 2, 3 );
+    Vec3 v( 4, 5, 6 );
+
+    EXPECT_EQ( Vec3( 0, 0, 1 ), Vec::cross( x, y ) );
+    EXPECT_EQ( Vec3( 0, 0, -1 ), Vec::cross( y, x ) );
+    EXPECT_EQ( Vec3( -3, 6, -3 ), Vec::cross( u, v ) );
+    EXPECT_EQ( 0, Vec::dot( u, Vec::cross( u, v ) ) );
+    EXPECT_EQ( 32, Vec::dot( u, v ) );
+}
+
 TEST( TVec3, BitwiseBinaryOperators )
 {
     using namespace nge::math;
@@ -164,6 +164,27 @@ TEST( TVec4, ArithmeticBinaryOperators )
     ASSERT_TRUE( v.x == 1 && v.y == 2 && v.z == 3 && v.w == 4 );
 }
 
+TEST( TVec4, VectorFunctions )
+{
+    using namespace nge::math;
+
+    Vec4 u( 1, 2, 3, 4 );
+    Vec4 v( 4, -3, 2, -1 );
+    Vec4 n;
+
+    EXPECT_EQ( 0, Vec::dot( u, v ) );
+    EXPECT_EQ( 30, Vec::dot( u, u ) );
+    EXPECT_FLOAT_EQ( Math::sqrt( 30.0f ), Vec::length( u ) );
+
+    n = Vec::normalize( u );
+    EXPECT_FLOAT_EQ( 1, Vec::length( n ) );
+    EXPECT_EQ( Vec4( 1 / Math::sqrt( 30.0f ), 2 / Math::sqrt( 30.0f ),
+                     3 / Math::sqrt( 30.0f ), 4 / Math::sqrt( 30.0f ) ), n );
+
+    EXPECT_EQ( Vec4( -1, -2, -3, -4 ), -u );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( &n ) % 16 );
+}
+
 TEST( TVec4, BitwiseBinaryOperators )
 {
     using namespace nge::math;
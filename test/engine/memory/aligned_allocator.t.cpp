@@ -0,0 +1,86 @@
+// aligned_allocator.t.cpp
+#include <engine/memory/aligned_allocator.h>
+#include <engine/memory/allocator_guard.h>
+#include <engine/memory/default_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/fixed_array.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Counted
+{
+    static nge::uint32 g_live;
+
+    Counted()
+    {
+        ++g_live;
+    }
+
+    ~Counted()
+    {
+        --g_live;
+    }
+};
+
+nge::uint32 Counted::g_live = 0;
+
+} // End nspc anonymous
+
+TEST( AlignedAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AlignedAllocator<float, 32> alloc;
+    AlignedAllocator<Counted, 64> counted;
+
+    float* values = alloc.get( 7 );
+    EXPECT_TRUE( MemoryUtils::isAligned( values, 32 ) );
+    EXPECT_EQ( 32, alloc.alignment() );
+    alloc.release( values, 7 );
+
+    Counted* instances = counted.get( 3 );
+    EXPECT_TRUE( MemoryUtils::isAligned( instances, 64 ) );
+    EXPECT_EQ( 3, Counted::g_live );
+
+    counted.release( instances, 3 );
+    EXPECT_EQ( 0, Counted::g_live );
+}
+
+TEST( AlignedAllocator, Interface )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DefaultAllocator<uint64> def;
+    AlignedAllocator<uint64, 64> aligned;
+    AllocatorGuard<uint64> guard( &aligned );
+
+    EXPECT_EQ( alignof( uint64 ), def.alignment() );
+    EXPECT_EQ( 64, guard.alignment() );
+}
+
+TEST( AlignedAllocator, Containers )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    uint32 i;
+
+    FixedArray<float, AlignedPolicy<32>::Allocator> fixed( 64 );
+    DynamicArray<float, AlignedPolicy<16>::Allocator> dynamic;
+
+    EXPECT_TRUE( MemoryUtils::isAligned( fixed.data(), 32 ) );
+
+    for ( i = 0; i < 100; ++i )
+    {
+        dynamic.push( i * 0.5f );
+    }
+
+    FixedArray<float, AlignedPolicy<32>::Allocator> copy( fixed );
+    EXPECT_TRUE( MemoryUtils::isAligned( copy.data(), 32 ) );
+    EXPECT_EQ( 49.5f, dynamic[99] );
+}
@@ -0,0 +1,323 @@
+// allocation_profiler.t.cpp
+#include <engine/memory/allocation_profiler.h>
+#include <engine/strdef.h>
+#include <engine/utility/log.h>
+#include <engine/utility/logger.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class TestLog : public nge::util::Log
+{
+  public:
+    nge::String warnings;
+
+    virtual void setLevel( Level /* level */ )
+    {
+    }
+
+    virtual void write( Level level, const nge::String& /* tag */,
+                        const nge::String& msg,
+                        std::exception /* exc */ )
+    {
+        if ( level == WARN )
+        {
+            warnings += msg;
+        }
+    }
+};
+
+} // End nspc anonymous
+
+static void recordFromFirstSite( nge::mem::AllocationProfiler* profiler,
+                                 const void* pointer, nge::uint64 bytes )
+{
+    profiler->recordGet( pointer, bytes );
+}
+
+static void recordFromSecondSite( nge::mem::AllocationProfiler* profiler,
+                                  const void* pointer, nge::uint64 bytes )
+{
+    profiler->recordGet( pointer, bytes );
+}
+
+TEST( AllocationProfiler, Recording )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationProfiler profiler( 64 );
+    uint64 values[4];
+
+    recordFromFirstSite( &profiler, values, 8 );
+    recordFromFirstSite( &profiler, values + 1, 8 );
+    recordFromSecondSite( &profiler, values + 2, 16 );
+    EXPECT_EQ( 3, profiler.liveCount() );
+    EXPECT_EQ( 32, profiler.liveBytes() );
+
+    profiler.recordRelease( values );
+    profiler.recordRelease( values + 2 );
+    EXPECT_EQ( 1, profiler.liveCount() );
+    EXPECT_EQ( 8, profiler.liveBytes() );
+
+    // unknown allocations are ignored
+    profiler.recordRelease( values + 3 );
+    EXPECT_EQ( 1, profiler.liveCount() );
+
+    profiler.recordRelease( values + 1 );
+    EXPECT_EQ( 0, profiler.liveCount() );
+    EXPECT_EQ( 0, profiler.dropped() );
+}
+
+TEST( AllocationProfiler, TopSites )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationProfiler profiler( 64 );
+    AllocationProfiler::Site sites[4];
+    uint64 values[4];
+    uint64 total;
+    uint32 size;
+    uint32 i;
+
+    // optimized builds may unroll the loop into several sites
+    for ( i = 0; i < 3; ++i )
+    {
+        recordFromFirstSite( &profiler, values + i, 8 );
+    }
+    recordFromSecondSite( &profiler, values + 3, 100 );
+
+    size = profiler.topSites( sites, 4, AllocationProfiler::FRAME_COUNT );
+    ASSERT_LE( 2, size );
+    total = 0;
+    for ( i = 0; i < size; ++i )
+    {
+        EXPECT_TRUE( i == 0 || sites[i - 1].frameCount >= sites[i].frameCount );
+        total += sites[i].frameCount;
+    }
+    EXPECT_EQ( 4, total );
+
+    ASSERT_EQ( 1, profiler.topSites( sites, 1,
+                                     AllocationProfiler::FRAME_BYTES ) );
+    EXPECT_EQ( 100, sites[0].frameBytes );
+    EXPECT_EQ( 1, sites[0].frameCount );
+
+    profiler.endFrame();
+    EXPECT_EQ( 1, profiler.frame() );
+    EXPECT_EQ( 0, profiler.topSites( sites, 4,
+                                     AllocationProfiler::FRAME_COUNT ) );
+
+    ASSERT_EQ( size, profiler.topSites( sites, 4,
+                                        AllocationProfiler::LIVE_BYTES ) );
+    EXPECT_EQ( 100, sites[0].liveBytes );
+
+    for ( i = 0; i < 4; ++i )
+    {
+        profiler.recordRelease( values + i );
+    }
+    EXPECT_EQ( 0, profiler.topSites( sites, 4,
+                                     AllocationProfiler::LIVE_COUNT ) );
+}
+
+TEST( AllocationProfiler, Dropped )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationProfiler profiler( 2 );
+    uint64 values[3];
+
+    profiler.recordGet( values, 8 );
+    profiler.recordGet( values + 1, 8 );
+    profiler.recordGet( values + 2, 8 );
+    EXPECT_EQ( 2, profiler.liveCount() );
+    EXPECT_EQ( 1, profiler.dropped() );
+
+    profiler.recordRelease( values );
+    profiler.recordRelease( values + 1 );
+    profiler.recordRelease( values + 2 );
+    EXPECT_EQ( 0, profiler.liveCount() );
+}
+
+TEST( AllocationProfiler, Purge )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationProfiler profiler( 16 );
+    uint64 values[64];
+    uint32 i;
+
+    // keep a few allocations live while the others churn through the
+    // table so that it is rebuilt around them
+    for ( i = 0; i < 4; ++i )
+    {
+        profiler.recordGet( values + i, 8 );
+    }
+
+    for ( i = 4; i < 64; ++i )
+    {
+        profiler.recordGet( values + i, 8 );
+        profiler.recordGrow( values + i, 8 );
+        profiler.recordRelease( values + i );
+    }
+
+    EXPECT_EQ( 4, profiler.liveCount() );
+    EXPECT_EQ( 32, profiler.liveBytes() );
+    EXPECT_EQ( 0, profiler.dropped() );
+
+    for ( i = 0; i < 4; ++i )
+    {
+        profiler.recordGrow( values + i, 8 );
+        profiler.recordRelease( values + i );
+    }
+
+    EXPECT_EQ( 0, profiler.liveCount() );
+    EXPECT_EQ( 0, profiler.liveBytes() );
+}
+
+TEST( AllocationProfiler, Reports )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationProfiler profiler( 64 );
+    std::ostringstream text;
+    std::ostringstream json;
+    std::ostringstream leaks;
+    uint64 value;
+
+    profiler.recordGet( &value, 8 );
+
+    profiler.writeText( text, 5 );
+    EXPECT_NE( String::npos, text.str().find( "top sites by count" ) );
+    EXPECT_NE( String::npos, text.str().find( "1 allocations, 8 bytes" ) );
+
+    profiler.writeJson( json, 5 );
+    EXPECT_EQ( '{', json.str().front() );
+    EXPECT_EQ( '}', json.str().back() );
+    EXPECT_NE( String::npos, json.str().find( "\"liveBytes\":8" ) );
+    EXPECT_NE( String::npos, json.str().find( "\"byBytes\":[{" ) );
+
+    profiler.writeLeaks( leaks );
+    EXPECT_NE( String::npos, leaks.str().find( "8 bytes leaked" ) );
+
+    profiler.recordRelease( &value );
+}
+
+TEST( AllocationProfiler, LeakReport )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    util::Logger logger;
+    TestLog log;
+    uint64 value;
+
+    logger.attach( &log );
+
+    {
+        AllocationProfiler profiler( 64 );
+        profiler.setLogger( &logger );
+        profiler.recordGet( &value, 8 );
+    }
+
+    EXPECT_NE( String::npos, log.warnings.find( "8 bytes leaked" ) );
+
+    // profilers without leaks do not report
+    log.warnings.clear();
+    {
+        AllocationProfiler profiler( 64 );
+        profiler.setLogger( &logger );
+        profiler.recordGet( &value, 8 );
+        profiler.recordRelease( &value );
+    }
+
+    EXPECT_TRUE( log.warnings.empty() );
+    logger.detach( &log );
+}
+
+TEST( AllocationProfiler, Threads )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 THREADS = 4;
+    const uint32 ALLOCATIONS = 256;
+    AllocationProfiler profiler( 4096 );
+    std::vector<uint64> values( THREADS * ALLOCATIONS );
+    std::vector<std::thread> threads;
+    uint32 i;
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads.push_back( std::thread( [&profiler, &values, i]() {
+            uint32 j;
+
+            for ( j = 0; j < ALLOCATIONS; ++j )
+            {
+                profiler.recordGet( &values[i * ALLOCATIONS + j], 8 );
+            }
+            for ( j = 0; j < ALLOCATIONS; j += 2 )
+            {
+                profiler.recordRelease( &values[i * ALLOCATIONS + j] );
+            }
+        } ) );
+    }
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads[i].join();
+    }
+
+    EXPECT_EQ( THREADS * ALLOCATIONS / 2, profiler.liveCount() );
+    EXPECT_EQ( 8 * THREADS * ALLOCATIONS / 2, profiler.liveBytes() );
+
+    for ( i = 1; i < THREADS * ALLOCATIONS; i += 2 )
+    {
+        profiler.recordRelease( &values[i] );
+    }
+    EXPECT_EQ( 0, profiler.liveCount() );
+}
+
+TEST( AllocationProfiler, ThreadsPurge )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 THREADS = 4;
+    const uint32 ALLOCATIONS = 256;
+    AllocationProfiler profiler( 64 );
+    std::vector<uint64> values( THREADS * ALLOCATIONS );
+    std::vector<std::thread> threads;
+    uint32 i;
+
+    // every thread churns through more allocations than the table holds
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads.push_back( std::thread( [&profiler, &values, i]() {
+            uint32 j;
+
+            for ( j = 0; j < ALLOCATIONS; ++j )
+            {
+                profiler.recordGet( &values[i * ALLOCATIONS + j], 8 );
+                profiler.recordRelease( &values[i * ALLOCATIONS + j] );
+            }
+        } ) );
+    }
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads[i].join();
+    }
+
+    EXPECT_EQ( 0, profiler.liveCount() );
+    EXPECT_EQ( 0, profiler.liveBytes() );
+    EXPECT_EQ( 0, profiler.dropped() );
+}
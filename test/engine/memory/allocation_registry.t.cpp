@@ -0,0 +1,53 @@
+// allocation_registry.t.cpp
+#include <engine/memory/allocation_registry.h>
+#include <gtest/gtest.h>
+
+TEST( AllocationRegistry, Trackers )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint32 size = AllocationRegistry::size();
+    AllocationTracker* physics;
+
+    EXPECT_EQ( nullptr, AllocationRegistry::find( "registry.physics" ) );
+
+    physics = AllocationRegistry::tracker( "registry.physics" );
+    ASSERT_NE( nullptr, physics );
+    EXPECT_EQ( "registry.physics", physics->tag() );
+    EXPECT_EQ( size + 1, AllocationRegistry::size() );
+
+    EXPECT_EQ( physics, AllocationRegistry::tracker( "registry.physics" ) );
+    EXPECT_EQ( physics, AllocationRegistry::find( "registry.physics" ) );
+    EXPECT_EQ( size + 1, AllocationRegistry::size() );
+
+    EXPECT_NE( physics, AllocationRegistry::tracker( "registry.audio" ) );
+    EXPECT_EQ( size + 2, AllocationRegistry::size() );
+}
+
+TEST( AllocationRegistry, Total )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationTracker::Stats before = AllocationRegistry::total();
+    AllocationTracker::Stats after;
+    uint32 visited = 0;
+
+    AllocationRegistry::tracker( "registry.first" )->recordGet( 10 );
+    AllocationRegistry::tracker( "registry.second" )->recordGet( 20 );
+
+    after = AllocationRegistry::total();
+    EXPECT_EQ( before.liveBytes + 30, after.liveBytes );
+    EXPECT_EQ( before.allocations + 2, after.allocations );
+    EXPECT_EQ( before.histogram[0] + 1, after.histogram[0] );
+    EXPECT_EQ( before.histogram[1] + 1, after.histogram[1] );
+
+    AllocationRegistry::forEach( [&visited]( const AllocationTracker& ) {
+        ++visited;
+    } );
+    EXPECT_EQ( AllocationRegistry::size(), visited );
+
+    AllocationRegistry::tracker( "registry.first" )->recordRelease( 10 );
+    AllocationRegistry::tracker( "registry.second" )->recordRelease( 20 );
+}
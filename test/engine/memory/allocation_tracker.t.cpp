@@ -0,0 +1,99 @@
+// allocation_tracker.t.cpp
+#include <engine/memory/allocation_tracker.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST( AllocationTracker, SizeClass )
+{
+    using namespace nge::mem;
+
+    EXPECT_EQ( 0, AllocationTracker::sizeClass( 1 ) );
+    EXPECT_EQ( 0, AllocationTracker::sizeClass( 16 ) );
+    EXPECT_EQ( 1, AllocationTracker::sizeClass( 17 ) );
+    EXPECT_EQ( 1, AllocationTracker::sizeClass( 32 ) );
+    EXPECT_EQ( 6, AllocationTracker::sizeClass( 1024 ) );
+    EXPECT_EQ( AllocationTracker::SIZE_CLASSES - 1,
+               AllocationTracker::sizeClass( 1ull << 40 ) );
+}
+
+TEST( AllocationTracker, Recording )
+{
+    using namespace nge::mem;
+
+    AllocationTracker tracker( "tracker" );
+    AllocationTracker::Stats stats;
+
+    EXPECT_EQ( "tracker", tracker.tag() );
+
+    tracker.recordGet( 8 );
+    tracker.recordGet( 100 );
+    EXPECT_EQ( 108, tracker.liveBytes() );
+    EXPECT_EQ( 108, tracker.peakBytes() );
+
+    tracker.recordRelease( 100 );
+    tracker.recordGet( 40 );
+    EXPECT_EQ( 48, tracker.liveBytes() );
+    EXPECT_EQ( 108, tracker.peakBytes() );
+
+    stats = tracker.stats();
+    EXPECT_EQ( 48, stats.liveBytes );
+    EXPECT_EQ( 108, stats.peakBytes );
+    EXPECT_EQ( 3, stats.allocations );
+    EXPECT_EQ( 1, stats.releases );
+    EXPECT_EQ( 1, stats.histogram[0] );
+    EXPECT_EQ( 1, stats.histogram[2] );
+    EXPECT_EQ( 1, stats.histogram[3] );
+
+    tracker.reset();
+    stats = tracker.stats();
+    EXPECT_EQ( 48, stats.liveBytes );
+    EXPECT_EQ( 48, stats.peakBytes );
+    EXPECT_EQ( 0, stats.allocations );
+    EXPECT_EQ( 0, stats.histogram[2] );
+
+    EXPECT_DEATH( tracker.recordRelease( 49 ), ".*" );
+}
+
+TEST( AllocationTracker, Threads )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 THREADS = 8;
+    const uint32 ALLOCATIONS = 1000;
+    AllocationTracker tracker( "threads" );
+    std::vector<std::thread> threads;
+    AllocationTracker::Stats stats;
+    uint32 i;
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads.push_back( std::thread( [&tracker, ALLOCATIONS]() {
+            uint32 j;
+
+            for ( j = 0; j < ALLOCATIONS; ++j )
+            {
+                tracker.recordGet( 64 );
+            }
+            for ( j = 0; j < ALLOCATIONS / 2; ++j )
+            {
+                tracker.recordRelease( 64 );
+            }
+        } ) );
+    }
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads[i].join();
+    }
+
+    stats = tracker.stats();
+    EXPECT_EQ( THREADS * ALLOCATIONS, stats.allocations );
+    EXPECT_EQ( THREADS * ALLOCATIONS / 2, stats.releases );
+    EXPECT_EQ( THREADS * ALLOCATIONS, stats.histogram[2] );
+    EXPECT_EQ( 64ull * THREADS * ALLOCATIONS / 2, stats.liveBytes );
+    EXPECT_GE( 64ull * THREADS * ALLOCATIONS, stats.peakBytes );
+    EXPECT_LE( stats.liveBytes, stats.peakBytes );
+}
@@ -0,0 +1,134 @@
+// arena_allocator.t.cpp
+#include <engine/memory/arena_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Counted
+{
+    static nge::uint32 g_live;
+
+    Counted()
+    {
+        ++g_live;
+    }
+
+    ~Counted()
+    {
+        --g_live;
+    }
+};
+
+nge::uint32 Counted::g_live = 0;
+
+} // End nspc anonymous
+
+TEST( ArenaAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ArenaAllocator<uint32> def;
+    ArenaAllocator<uint32> sized( 16 );
+
+    EXPECT_EQ( 0, def.size() );
+    EXPECT_EQ( def.blockCapacity(), def.capacity() );
+    EXPECT_EQ( 16, sized.blockCapacity() );
+    EXPECT_EQ( 16, sized.capacity() );
+}
+
+TEST( ArenaAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ArenaAllocator<uint32> arena( 16 );
+
+    uint32* first = arena.get( 4 );
+    uint32* second = arena.get( 4 );
+
+    EXPECT_EQ( first + 4, second );
+    EXPECT_EQ( 8, arena.size() );
+
+    // release does not give the memory back
+    arena.release( second, 4 );
+    EXPECT_EQ( 8, arena.size() );
+    EXPECT_EQ( second + 4, arena.get( 8 ) );
+
+    // a request that does not fit is placed in a new block
+    uint32* large = arena.get( 20 );
+    EXPECT_NE( nullptr, large );
+    EXPECT_EQ( 36, arena.size() );
+    EXPECT_EQ( 36, arena.capacity() );
+
+    large[19] = 1;
+
+    arena.reset();
+    EXPECT_EQ( 0, arena.size() );
+    EXPECT_EQ( 16, arena.capacity() );
+    EXPECT_EQ( first, arena.get( 4 ) );
+
+    // the block made by the overflow is reused
+    arena.get( 12 );
+    EXPECT_EQ( large, arena.get( 20 ) );
+}
+
+TEST( ArenaAllocator, MarkerAndRollback )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ArenaAllocator<Counted> arena( 8 );
+
+    arena.get( 2 );
+    EXPECT_EQ( 2, Counted::g_live );
+
+    ArenaAllocator<Counted>::Marker marker = arena.mark();
+    Counted* scratch = arena.get( 4 );
+    arena.get( 8 );
+    EXPECT_EQ( 14, Counted::g_live );
+
+    arena.rollback( marker );
+    EXPECT_EQ( 2, arena.size() );
+    EXPECT_EQ( 2, Counted::g_live );
+    EXPECT_EQ( scratch, arena.get( 4 ) );
+
+    arena.reset();
+    EXPECT_EQ( 0, Counted::g_live );
+
+    {
+        ArenaAllocator<Counted> temp( 4 );
+        temp.get( 3 );
+        EXPECT_EQ( 3, Counted::g_live );
+    }
+
+    EXPECT_EQ( 0, Counted::g_live );
+}
+
+TEST( ArenaAllocator, Containers )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    ArenaAllocator<uint32> arena( 256 );
+    uint32 frame;
+    uint32 i;
+
+    for ( frame = 0; frame < 4; ++frame )
+    {
+        DynamicArray<uint32, AllocatorGuard> scratch( &arena );
+
+        for ( i = 0; i < 100; ++i )
+        {
+            scratch.push( i );
+        }
+
+        EXPECT_EQ( 99, scratch[99] );
+        EXPECT_TRUE( arena.size() >= 100 );
+
+        arena.reset();
+    }
+}
@@ -0,0 +1,67 @@
+// arena_resource.t.cpp
+#include <engine/memory/arena_resource.h>
+#include <gtest/gtest.h>
+
+TEST( ArenaResource, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ArenaResource def;
+    ArenaResource sized( 256 );
+
+    EXPECT_EQ( 0, def.size() );
+    EXPECT_EQ( def.blockSize(), def.capacity() );
+    EXPECT_EQ( 256, sized.blockSize() );
+    EXPECT_EQ( 256, sized.capacity() );
+}
+
+TEST( ArenaResource, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ArenaResource arena( 256 );
+
+    uint8* first = static_cast<uint8*>( arena.allocate( 3, 1 ) );
+    uint8* second = static_cast<uint8*>( arena.allocate( 8, 8 ) );
+
+    // the second allocation is padded up to its alignment
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( second ) % 8 );
+    EXPECT_LE( first + 3, second );
+    EXPECT_GT( first + 3 + 8, second );
+
+    // deallocate does not give the memory back
+    arena.deallocate( second, 8, 8 );
+    EXPECT_EQ( second + 8, arena.allocate( 8, 8 ) );
+
+    // a request that does not fit is placed in a new block
+    arena.allocate( 512, 64 );
+    EXPECT_EQ( 256 + 512 + 63, arena.capacity() );
+}
+
+TEST( ArenaResource, MarkerAndRollback )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ArenaResource arena( 64 );
+
+    arena.allocate( 16, 4 );
+    ArenaResource::Marker marker = arena.mark();
+    uint32 size = arena.size();
+
+    void* first = arena.allocate( 32, 4 );
+    arena.allocate( 128, 4 );
+    EXPECT_LT( 64, arena.capacity() );
+
+    arena.rollback( marker );
+    EXPECT_EQ( size, arena.size() );
+    EXPECT_EQ( 64, arena.capacity() );
+
+    // the memory is handed out again
+    EXPECT_EQ( first, arena.allocate( 32, 4 ) );
+
+    arena.reset();
+    EXPECT_EQ( 0, arena.size() );
+}
@@ -0,0 +1,157 @@
+// buddy_allocator.t.cpp
+#include <engine/memory/buddy_allocator.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST( BuddyAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyAllocator pow2( 1024, 16 );
+    BuddyAllocator odd( 1000, 16 );
+
+    EXPECT_EQ( 1024, pow2.capacity() );
+    EXPECT_EQ( 16, pow2.minBlockSize() );
+    EXPECT_EQ( 1024, pow2.available() );
+    EXPECT_EQ( 1024, pow2.largestFreeBlock() );
+    EXPECT_EQ( 1, pow2.freeBlockCount( 6 ) );
+    EXPECT_EQ( 0.0f, pow2.fragmentation() );
+
+    // 62 smallest blocks are covered by blocks of 32, 16, 8, 4 and 2
+    EXPECT_EQ( 992, odd.capacity() );
+    EXPECT_EQ( 512, odd.largestFreeBlock() );
+    EXPECT_EQ( 1, odd.freeBlockCount( 5 ) );
+    EXPECT_EQ( 1, odd.freeBlockCount( 1 ) );
+    EXPECT_EQ( 0, odd.freeBlockCount( 0 ) );
+}
+
+TEST( BuddyAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyAllocator buddies( 1024, 16 );
+    uint64 first;
+    uint64 second;
+    uint64 third;
+
+    first = buddies.allocate( 10, 1 );
+    second = buddies.allocate( 100, 1 );
+    third = buddies.allocate( 16, 64 );
+
+    EXPECT_EQ( 0, first );
+    EXPECT_EQ( 0, second % 128 );
+    EXPECT_EQ( 0, third % 64 );
+    EXPECT_NE( first, third );
+
+    EXPECT_EQ( 3, buddies.allocationCount() );
+    EXPECT_EQ( 16 + 128 + 64, buddies.used() );
+    EXPECT_EQ( 10 + 100 + 16, buddies.requested() );
+    EXPECT_FLOAT_EQ( 1.0f - 126.0f / 208.0f, buddies.waste() );
+
+    EXPECT_EQ( BuddyAllocator::INVALID_OFFSET, buddies.allocate( 1024, 1 ) );
+    EXPECT_EQ( BuddyAllocator::INVALID_OFFSET,
+               buddies.allocate( 1ull << 40, 1 ) );
+
+    buddies.release( first, 10 );
+    buddies.release( second, 100 );
+    buddies.release( third, 16 );
+
+    // every block merged back into one
+    EXPECT_EQ( 0, buddies.used() );
+    EXPECT_EQ( 1, buddies.freeBlockCount( 6 ) );
+    EXPECT_EQ( 0, buddies.allocate( 1024, 1 ) );
+}
+
+TEST( BuddyAllocator, Fragmentation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyAllocator buddies( 1024, 16 );
+    uint64 offsets[64];
+    uint32 i;
+
+    for ( i = 0; i < 64; ++i )
+    {
+        offsets[i] = buddies.allocate( 16, 1 );
+        ASSERT_NE( BuddyAllocator::INVALID_OFFSET, offsets[i] );
+    }
+    EXPECT_EQ( 0, buddies.available() );
+    EXPECT_EQ( 0.0f, buddies.fragmentation() );
+
+    // free every other block so no two free blocks are buddies
+    for ( i = 0; i < 64; i += 2 )
+    {
+        buddies.release( offsets[i], 16 );
+    }
+    EXPECT_EQ( 512, buddies.available() );
+    EXPECT_EQ( 16, buddies.largestFreeBlock() );
+    EXPECT_FLOAT_EQ( 1.0f - 16.0f / 512.0f, buddies.fragmentation() );
+    EXPECT_EQ( BuddyAllocator::INVALID_OFFSET, buddies.allocate( 32, 1 ) );
+
+    for ( i = 1; i < 64; i += 2 )
+    {
+        buddies.release( offsets[i], 16 );
+    }
+    EXPECT_EQ( 1024, buddies.largestFreeBlock() );
+    EXPECT_EQ( 0.0f, buddies.fragmentation() );
+
+    buddies.allocate( 16, 1 );
+    buddies.reset();
+    EXPECT_EQ( 0, buddies.allocationCount() );
+    EXPECT_EQ( 1024, buddies.largestFreeBlock() );
+}
+
+TEST( BuddyAllocator, Random )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyAllocator buddies( 1 << 20, 64 );
+    std::vector<std::pair<uint64, uint64>> live;
+    std::mt19937 random( 7 );
+    uint64 offset;
+    uint64 size;
+    uint32 index;
+    uint32 i;
+
+    for ( i = 0; i < 10000; ++i )
+    {
+        if ( live.empty() || random() % 3 != 0 )
+        {
+            size = 1 + random() % 4096;
+            offset = buddies.allocate( size, 1 );
+            if ( offset != BuddyAllocator::INVALID_OFFSET )
+            {
+                live.push_back( std::make_pair( offset, size ) );
+            }
+        }
+        else
+        {
+            index = random() % live.size();
+            buddies.release( live[index].first, live[index].second );
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    // no two live allocations overlap
+    std::sort( live.begin(), live.end() );
+    for ( i = 1; i < live.size(); ++i )
+    {
+        ASSERT_LE( live[i - 1].first + live[i - 1].second, live[i].first );
+    }
+
+    for ( i = 0; i < live.size(); ++i )
+    {
+        buddies.release( live[i].first, live[i].second );
+    }
+    EXPECT_EQ( 0, buddies.used() );
+    EXPECT_EQ( 0, buddies.requested() );
+    EXPECT_EQ( 1u << 20, buddies.largestFreeBlock() );
+}
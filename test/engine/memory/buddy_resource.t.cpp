@@ -0,0 +1,55 @@
+// buddy_resource.t.cpp
+#include <engine/memory/buddy_resource.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/resource_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( BuddyResource, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyResource buddies( 4096, 32 );
+    uint8* first;
+    uint8* second;
+
+    first = static_cast<uint8*>( buddies.allocate( 100, 16 ) );
+    second = static_cast<uint8*>( buddies.allocate( 32, 256 ) );
+
+    ASSERT_NE( nullptr, first );
+    ASSERT_NE( nullptr, second );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( first ) % 16 );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( second ) % 256 );
+    EXPECT_EQ( 128 + 256, buddies.buddies().used() );
+
+    EXPECT_EQ( nullptr, buddies.allocate( 4096, 1 ) );
+
+    buddies.deallocate( first, 100, 16 );
+    buddies.deallocate( second, 32, 256 );
+    EXPECT_EQ( 4096, buddies.buddies().largestFreeBlock() );
+    EXPECT_NE( nullptr, buddies.allocate( 4096, 1 ) );
+}
+
+TEST( BuddyResource, Containers )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyResource buddies( 64 * 1024, 64 );
+    ResourceAllocator<uint32> alloc( &buddies );
+    uint32 i;
+
+    {
+        cntr::DynamicArray<uint32, AllocatorGuard> array( &alloc );
+
+        for ( i = 0; i < 1000; ++i )
+        {
+            array.push( i );
+        }
+
+        EXPECT_EQ( 1, buddies.buddies().allocationCount() );
+        EXPECT_EQ( 999, array[999] );
+    }
+
+    EXPECT_EQ( 0, buddies.buddies().used() );
+}
@@ -0,0 +1,108 @@
+// budget_allocator.t.cpp
+#include <engine/memory/budget_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/default_allocator.h>
+#include <engine/memory/virtual_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( BudgetAllocator, Construction )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget_alloc.construction", 1024 );
+    DefaultAllocator<uint32> def;
+    BudgetAllocator<uint32> alloc( &budget );
+    BudgetAllocator<uint32> wrapped( &budget, &def );
+    BudgetAllocator<uint32> copy( alloc );
+
+    EXPECT_EQ( &budget, alloc.budget() );
+    EXPECT_EQ( &budget, wrapped.budget() );
+    EXPECT_EQ( &budget, copy.budget() );
+    EXPECT_EQ( def.alignment(), wrapped.alignment() );
+}
+
+TEST( BudgetAllocator, Allocation )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget_alloc.allocation", 100 );
+    BudgetAllocator<uint32> alloc( &budget );
+    uint32 calls = 0;
+    uint32* small;
+    uint32* large;
+
+    budget.setCallback( [&]( const MemoryBudget& /* over */,
+                              uint64 /* live */ ) {
+        ++calls;
+    } );
+
+    small = alloc.get( 10 );
+    EXPECT_EQ( 40, budget.liveBytes() );
+    EXPECT_FALSE( budget.exceeded() );
+
+    large = alloc.get( 20 );
+    EXPECT_EQ( 120, budget.liveBytes() );
+    EXPECT_TRUE( budget.exceeded() );
+    EXPECT_EQ( 1, calls );
+
+    alloc.release( large, 20 );
+    EXPECT_FALSE( budget.exceeded() );
+
+    alloc.release( small, 10 );
+    EXPECT_EQ( 0, budget.liveBytes() );
+    EXPECT_EQ( 1, calls );
+}
+
+TEST( BudgetAllocator, Grow )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget_alloc.grow", 400 );
+    VirtualAllocator<uint64> virt( 64 * 1024, VirtualMemory::SMALL_PAGES );
+    BudgetAllocator<uint64> alloc( &budget, &virt );
+    uint32 max = virt.maxCount();
+    uint64* values;
+
+    values = alloc.get( 10 );
+    EXPECT_FALSE( budget.exceeded() );
+
+    ASSERT_TRUE( alloc.grow( values, 10, 100 ) );
+    EXPECT_EQ( 800, budget.liveBytes() );
+    EXPECT_TRUE( budget.exceeded() );
+
+    EXPECT_FALSE( alloc.grow( values, 100, max + 1 ) );
+    EXPECT_EQ( 800, budget.liveBytes() );
+
+    alloc.release( values, 100 );
+    EXPECT_EQ( 0, budget.liveBytes() );
+    EXPECT_FALSE( budget.exceeded() );
+}
+
+TEST( BudgetAllocator, Containers )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget_alloc.containers", 1024 );
+    BudgetAllocator<uint32> alloc( &budget );
+    uint32 i;
+
+    {
+        cntr::DynamicArray<uint32, AllocatorGuard> array( &alloc );
+
+        for ( i = 0; i < 1000; ++i )
+        {
+            array.push( i );
+        }
+
+        EXPECT_TRUE( budget.exceeded() );
+        EXPECT_LE( 4000, budget.framePeakBytes() );
+    }
+
+    EXPECT_EQ( 0, budget.liveBytes() );
+    EXPECT_FALSE( budget.exceeded() );
+    EXPECT_LE( 1, budget.overruns() );
+}
@@ -0,0 +1,66 @@
+// budget_table.t.cpp
+#include <engine/memory/budget_table.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+TEST( BudgetTable, Construction )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    BudgetTable budgets;
+    MemoryBudget* render;
+    MemoryBudget* audio;
+
+    EXPECT_EQ( 0, budgets.size() );
+    EXPECT_EQ( nullptr, budgets.find( "table.render" ) );
+
+    render = budgets.add( "table.render", 1024 );
+    audio = budgets.add( "table.audio", 512 );
+
+    EXPECT_EQ( 2, budgets.size() );
+    EXPECT_EQ( render, budgets.find( "table.render" ) );
+    EXPECT_EQ( audio, budgets.find( "table.audio" ) );
+    EXPECT_EQ( 512, audio->limit() );
+
+    EXPECT_DEATH( budgets.add( "table.render", 1 ), ".*" );
+}
+
+TEST( BudgetTable, Frames )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    BudgetTable budgets;
+    MemoryBudget* world = budgets.add( "table.world", 100 );
+    MemoryBudget* sound = budgets.add( "table.sound", 1000 );
+    std::vector<String> over;
+    std::ostringstream report;
+
+    budgets.setCallback( [&]( const MemoryBudget& budget,
+                               uint64 /* live */ ) {
+        over.push_back( budget.tag() );
+    } );
+
+    world->tracker()->recordGet( 150 );
+    sound->tracker()->recordGet( 250 );
+    EXPECT_FALSE( budgets.exceeded() );
+
+    budgets.endFrame();
+    EXPECT_TRUE( budgets.exceeded() );
+    ASSERT_EQ( 1, over.size() );
+    EXPECT_EQ( "table.world", over[0] );
+
+    budgets.writeReport( report );
+    EXPECT_NE( String::npos,
+               report.str().find( "table.world: 150 / 100 bytes (150%)" ) );
+    EXPECT_NE( String::npos,
+               report.str().find( "table.sound: 250 / 1000 bytes (25%)" ) );
+    EXPECT_NE( String::npos, report.str().find( "OVER BUDGET" ) );
+
+    world->tracker()->recordRelease( 150 );
+    sound->tracker()->recordRelease( 250 );
+    budgets.endFrame();
+    EXPECT_FALSE( budgets.exceeded() );
+}
@@ -0,0 +1,195 @@
+// compacting_heap.t.cpp
+#include <engine/memory/compacting_heap.h>
+#include <engine/memory/allocation_registry.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+TEST( CompactingHeap, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1024 );
+
+    EXPECT_EQ( 1024, heap.capacity() );
+    EXPECT_EQ( 0, heap.used() );
+    EXPECT_EQ( 1024, heap.available() );
+    EXPECT_EQ( 1024, heap.availableAtTop() );
+    EXPECT_EQ( 0.0f, heap.fragmentation() );
+    EXPECT_TRUE( heap.isCompacted() );
+}
+
+TEST( CompactingHeap, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1024 );
+    Handle<uint32> ints;
+    Handle<uint64> longs;
+    Handle<uint8> tooLarge;
+    Handle<uint32> null;
+
+    ints = heap.allocate<uint32>( 10 );
+    longs = heap.allocate<uint64>( 10 );
+
+    ASSERT_TRUE( static_cast<bool>( ints ) );
+    ASSERT_TRUE( static_cast<bool>( longs ) );
+    EXPECT_TRUE( heap.valid( ints ) );
+    EXPECT_EQ( 2, heap.allocationCount() );
+    EXPECT_EQ( 120, heap.used() );
+    EXPECT_TRUE( MemoryUtils::isAligned( heap.resolve( longs ), 8 ) );
+
+    heap.resolve( ints )[9] = 99;
+    EXPECT_EQ( 99, heap.resolve( ints )[9] );
+
+    tooLarge = heap.allocate<uint8>( 1000 );
+    EXPECT_FALSE( tooLarge );
+    EXPECT_EQ( nullptr, heap.resolve( null ) );
+
+    // a stale handle resolves to null even when its entry is reused
+    heap.release( ints );
+    EXPECT_FALSE( heap.valid( ints ) );
+    EXPECT_EQ( nullptr, heap.resolve( ints ) );
+    EXPECT_NE( ints, heap.allocate<uint32>( 10 ) );
+    EXPECT_EQ( nullptr, heap.resolve( ints ) );
+
+    EXPECT_DEATH( heap.release( ints ), ".*" );
+}
+
+TEST( CompactingHeap, Compaction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1024 );
+    Handle<uint32> blocks[8];
+    Handle<uint32> large;
+    uint32 i;
+    uint32 j;
+
+    for ( i = 0; i < 8; ++i )
+    {
+        blocks[i] = heap.allocate<uint32>( 32 );
+        for ( j = 0; j < 32; ++j )
+        {
+            heap.resolve( blocks[i] )[j] = i * 100 + j;
+        }
+    }
+    EXPECT_EQ( 0, heap.availableAtTop() );
+
+    for ( i = 0; i < 8; i += 2 )
+    {
+        heap.release( blocks[i] );
+    }
+    EXPECT_EQ( 512, heap.available() );
+    EXPECT_EQ( 0, heap.availableAtTop() );
+    EXPECT_EQ( 1.0f, heap.fragmentation() );
+    EXPECT_FALSE( heap.isCompacted() );
+
+    EXPECT_EQ( 512, heap.compact() );
+    EXPECT_TRUE( heap.isCompacted() );
+    EXPECT_EQ( 512, heap.availableAtTop() );
+    EXPECT_EQ( 0.0f, heap.fragmentation() );
+
+    // moved blocks keep their contents
+    for ( i = 1; i < 8; i += 2 )
+    {
+        for ( j = 0; j < 32; ++j )
+        {
+            ASSERT_EQ( i * 100 + j, heap.resolve( blocks[i] )[j] );
+        }
+    }
+
+    // an allocation that only fits after compaction compacts first
+    heap.release( blocks[1] );
+    large = heap.allocate<uint32>( 160 );
+    ASSERT_TRUE( static_cast<bool>( large ) );
+    EXPECT_EQ( 0, heap.availableAtTop() );
+    EXPECT_EQ( 331, heap.resolve( blocks[3] )[31] );
+}
+
+TEST( CompactingHeap, Pinning )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1024 );
+    Handle<uint8> first = heap.allocate<uint8>( 100 );
+    Handle<uint8> pinned = heap.allocate<uint8>( 100 );
+    Handle<uint8> last = heap.allocate<uint8>( 100 );
+    uint8* address;
+
+    heap.release( first );
+    heap.pin( pinned );
+    address = heap.resolve( pinned );
+
+    heap.compact();
+    EXPECT_EQ( address, heap.resolve( pinned ) );
+    EXPECT_TRUE( heap.isCompacted() );
+    EXPECT_DEATH( heap.release( pinned ), ".*" );
+
+    // unpinning lets compaction close the hole below the block
+    heap.unpin( pinned );
+    EXPECT_FALSE( heap.isCompacted() );
+    EXPECT_EQ( 200, heap.compact() );
+    EXPECT_EQ( 824, heap.availableAtTop() );
+    EXPECT_DEATH( heap.unpin( last ), ".*" );
+}
+
+TEST( CompactingHeap, Incremental )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1 << 20, "compacting_heap.incremental" );
+    AllocationTracker* tracker =
+        AllocationRegistry::find( "compacting_heap.incremental" );
+    std::vector<Handle<uint8>> live;
+    std::vector<uint8> values;
+    std::mt19937 random( 11 );
+    Handle<uint8> handle;
+    uint32 size;
+    uint32 index;
+    uint32 i;
+
+    for ( i = 0; i < 5000; ++i )
+    {
+        if ( live.empty() || random() % 3 != 0 )
+        {
+            size = 1 + random() % 1024;
+            handle = heap.allocate<uint8>( size );
+            if ( handle )
+            {
+                live.push_back( handle );
+                values.push_back( static_cast<uint8>( i ) );
+                memset( heap.resolve( handle ), values.back(), size );
+            }
+        }
+        else
+        {
+            index = random() % live.size();
+            heap.release( live[index] );
+            live[index] = live.back();
+            values[index] = values.back();
+            live.pop_back();
+            values.pop_back();
+        }
+
+        // one step per iteration keeps compaction running alongside
+        heap.compact( 0.0f );
+    }
+
+    EXPECT_EQ( heap.used(), tracker->liveBytes() );
+    EXPECT_LT( 0, heap.movedBytes() );
+
+    for ( i = 0; i < live.size(); ++i )
+    {
+        ASSERT_EQ( values[i], heap.resolve( live[i] )[0] );
+    }
+
+    heap.compact();
+    EXPECT_EQ( heap.available(), heap.availableAtTop() );
+}
@@ -0,0 +1,177 @@
+// double_stack_resource.t.cpp
+#include <engine/memory/double_stack_resource.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/resource_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( DoubleStackResource, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 256 );
+
+    EXPECT_EQ( 256, stack.capacity() );
+    EXPECT_EQ( 256, stack.available() );
+    EXPECT_EQ( 0, stack.size( DoubleStackResource::BOTTOM ) );
+    EXPECT_EQ( 0, stack.size( DoubleStackResource::TOP ) );
+}
+
+TEST( DoubleStackResource, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 256 );
+
+    uint8* first = static_cast<uint8*>( stack.allocate( 3, 1 ) );
+    uint8* second = static_cast<uint8*>( stack.allocate( 8, 8 ) );
+    uint8* top = static_cast<uint8*>(
+        stack.allocate( DoubleStackResource::TOP, 16, 16 ) );
+    uint8* lower = static_cast<uint8*>(
+        stack.allocate( DoubleStackResource::TOP, 5, 1 ) );
+
+    // the bottom grows up and the top grows down
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( second ) % 8 );
+    EXPECT_LE( first + 3, second );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( top ) % 16 );
+    EXPECT_EQ( top - 5, lower );
+    EXPECT_LT( second + 8, lower );
+
+    EXPECT_EQ( 256, stack.size( DoubleStackResource::BOTTOM ) +
+                    stack.size( DoubleStackResource::TOP ) +
+                    stack.available() );
+
+    // deallocate does not give the memory back
+    stack.deallocate( second, 8, 8 );
+    EXPECT_EQ( second + 8, stack.allocate( 8, 8 ) );
+}
+
+TEST( DoubleStackResource, Full )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 64 );
+
+    stack.allocate( 32, 1 );
+    stack.allocate( DoubleStackResource::TOP, 24, 1 );
+
+    EXPECT_TRUE( stack.fits( DoubleStackResource::BOTTOM, 8, 1 ) );
+    EXPECT_TRUE( stack.fits( DoubleStackResource::TOP, 8, 1 ) );
+    EXPECT_FALSE( stack.fits( DoubleStackResource::BOTTOM, 9, 1 ) );
+    EXPECT_FALSE( stack.fits( DoubleStackResource::TOP, 9, 1 ) );
+
+    EXPECT_EQ( nullptr, stack.allocate( DoubleStackResource::TOP, 9, 1 ) );
+    EXPECT_EQ( nullptr, stack.allocate( 9, 1 ) );
+    EXPECT_EQ( 8, stack.available() );
+    EXPECT_DEATH( stack.allocate( 0, 1 ), ".*" );
+    EXPECT_DEATH( stack.allocate( 1, 3 ), ".*" );
+
+    stack.allocate( DoubleStackResource::TOP, 8, 1 );
+    EXPECT_EQ( 0, stack.available() );
+    EXPECT_EQ( nullptr, stack.allocate( 1, 1 ) );
+}
+
+TEST( DoubleStackResource, FillKeepsAllocations )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 256 );
+    uint64* blocks[32];
+    uint64* block;
+    uint32 count = 0;
+    uint32 i;
+
+    // allocate from alternating ends until neither has room
+    while ( true )
+    {
+        block = static_cast<uint64*>( stack.allocate(
+            count % 2 == 0 ? DoubleStackResource::BOTTOM
+                           : DoubleStackResource::TOP, 24, 8 ) );
+        if ( block == nullptr )
+        {
+            break;
+        }
+
+        ASSERT_LT( count, 32 );
+        block[0] = block[1] = block[2] = count;
+        blocks[count++] = block;
+    }
+
+    EXPECT_EQ( 10, count );
+    EXPECT_EQ( nullptr, stack.allocate( DoubleStackResource::TOP, 24, 8 ) );
+    EXPECT_EQ( nullptr, stack.allocate( 24, 8 ) );
+    EXPECT_EQ( 16, stack.available() );
+
+    // the failed allocations handed out nothing that was still in use
+    for ( i = 0; i < count; ++i )
+    {
+        EXPECT_EQ( i, blocks[i][0] );
+        EXPECT_EQ( i, blocks[i][1] );
+        EXPECT_EQ( i, blocks[i][2] );
+    }
+}
+
+TEST( DoubleStackResource, MarkerAndRollback )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 256 );
+    DoubleStackResource::Marker bottom;
+    DoubleStackResource::Marker top;
+    void* first;
+
+    stack.allocate( 16, 4 );
+    stack.allocate( DoubleStackResource::TOP, 16, 4 );
+    bottom = stack.mark( DoubleStackResource::BOTTOM );
+    top = stack.mark( DoubleStackResource::TOP );
+
+    first = stack.allocate( 32, 4 );
+    stack.allocate( DoubleStackResource::TOP, 64, 4 );
+
+    // rolling back one end leaves the other alone
+    stack.rollback( bottom );
+    EXPECT_EQ( 16, stack.size( DoubleStackResource::BOTTOM ) );
+    EXPECT_EQ( 80, stack.size( DoubleStackResource::TOP ) );
+    EXPECT_EQ( first, stack.allocate( 32, 4 ) );
+
+    stack.rollback( top );
+    EXPECT_EQ( 16, stack.size( DoubleStackResource::TOP ) );
+
+    stack.reset( DoubleStackResource::TOP );
+    EXPECT_EQ( 0, stack.size( DoubleStackResource::TOP ) );
+    EXPECT_EQ( 48, stack.size( DoubleStackResource::BOTTOM ) );
+
+    stack.reset();
+    EXPECT_EQ( 256, stack.available() );
+}
+
+TEST( DoubleStackResource, Resources )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 1024 );
+    ResourceAllocator<uint32> bottomAlloc( &stack );
+    ResourceAllocator<uint64> topAlloc(
+        stack.resource( DoubleStackResource::TOP ) );
+    cntr::DynamicArray<uint32, AllocatorGuard> persistent( &bottomAlloc );
+    cntr::DynamicArray<uint64, AllocatorGuard> scratch( &topAlloc );
+    uint32 i;
+
+    for ( i = 0; i < 16; ++i )
+    {
+        persistent.push( i );
+        scratch.push( i * 2 );
+    }
+
+    EXPECT_LT( 0, stack.size( DoubleStackResource::BOTTOM ) );
+    EXPECT_LT( 0, stack.size( DoubleStackResource::TOP ) );
+    EXPECT_LT( static_cast<void*>( &persistent[15] ),
+               static_cast<void*>( &scratch[0] ) );
+    EXPECT_EQ( 15, persistent[15] );
+    EXPECT_EQ( 30, scratch[15] );
+}
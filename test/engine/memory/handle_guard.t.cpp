@@ -0,0 +1,65 @@
+// handle_guard.t.cpp
+#include <engine/memory/handle_guard.h>
+#include <gtest/gtest.h>
+
+#include <utility>
+
+TEST( HandleGuard, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1024 );
+    Handle<uint32> handle = heap.allocate<uint32>( 4 );
+    HandleGuard<uint32> empty;
+
+    EXPECT_FALSE( empty );
+    EXPECT_EQ( nullptr, empty.get() );
+
+    {
+        HandleGuard<uint32> guard( &heap, handle );
+        HandleGuard<uint32> moved( std::move( guard ) );
+
+        EXPECT_FALSE( guard );
+        EXPECT_TRUE( moved );
+        EXPECT_EQ( heap.resolve( handle ), moved.get() );
+        EXPECT_EQ( handle, moved.handle() );
+
+        *moved = 7;
+        EXPECT_EQ( 7, heap.resolve( handle )[0] );
+
+        // the allocation is pinned while the guard lives
+        EXPECT_DEATH( heap.release( handle ), ".*" );
+    }
+
+    heap.release( handle );
+    EXPECT_FALSE( heap.valid( handle ) );
+}
+
+TEST( HandleGuard, Compaction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CompactingHeap heap( 1024 );
+    Handle<uint32> first = heap.allocate<uint32>( 16 );
+    Handle<uint32> second = heap.allocate<uint32>( 16 );
+    uint32* address;
+
+    heap.resolve( second )[0] = 42;
+    heap.release( first );
+
+    {
+        HandleGuard<uint32> guard( &heap, second );
+
+        address = guard.get();
+        heap.compact();
+
+        EXPECT_EQ( address, heap.resolve( second ) );
+        EXPECT_EQ( 42, *guard );
+    }
+
+    heap.compact();
+    EXPECT_NE( address, heap.resolve( second ) );
+    EXPECT_EQ( 42, heap.resolve( second )[0] );
+}
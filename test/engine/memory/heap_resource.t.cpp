@@ -0,0 +1,41 @@
+// heap_resource.t.cpp
+#include <engine/memory/heap_resource.h>
+#include <gtest/gtest.h>
+
+TEST( HeapResource, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    HeapResource heap;
+
+    uint8* bytes = static_cast<uint8*>( heap.allocate( 32, 8 ) );
+
+    ASSERT_NE( nullptr, bytes );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( bytes ) % 8 );
+
+    bytes[0] = 1;
+    bytes[31] = 2;
+    heap.deallocate( bytes, 32, 8 );
+}
+
+TEST( HeapResource, OverAligned )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    HeapResource heap;
+    void* pointers[8];
+    uint32 i;
+
+    for ( i = 0; i < 8; ++i )
+    {
+        pointers[i] = heap.allocate( 24 + i, 64 );
+        EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( pointers[i] ) % 64 );
+    }
+
+    for ( i = 0; i < 8; ++i )
+    {
+        heap.deallocate( pointers[i], 24 + i, 64 );
+    }
+}
@@ -0,0 +1,136 @@
+// memory_budget.t.cpp
+#include <engine/memory/memory_budget.h>
+#include <engine/memory/allocation_registry.h>
+#include <engine/utility/log.h>
+#include <engine/utility/logger.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+class TestLog : public nge::util::Log
+{
+  public:
+    nge::uint32 warnings;
+
+    TestLog() : warnings( 0 )
+    {
+    }
+
+    virtual void setLevel( Level /* level */ )
+    {
+    }
+
+    virtual void write( Level level, const nge::String& /* tag */,
+                        const nge::String& /* msg */,
+                        std::exception /* exc */ )
+    {
+        if ( level == WARN )
+        {
+            ++warnings;
+        }
+    }
+};
+
+} // End nspc anonymous
+
+TEST( MemoryBudget, Construction )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget.construction", 1024 );
+
+    EXPECT_EQ( "budget.construction", budget.tag() );
+    EXPECT_EQ( 1024, budget.limit() );
+    EXPECT_EQ( 0, budget.liveBytes() );
+    EXPECT_EQ( 0, budget.overruns() );
+    EXPECT_FALSE( budget.exceeded() );
+    EXPECT_EQ( AllocationRegistry::find( "budget.construction" ),
+               budget.tracker() );
+
+    budget.setLimit( 2048 );
+    EXPECT_EQ( 2048, budget.limit() );
+}
+
+TEST( MemoryBudget, Check )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget.check", 100 );
+    AllocationTracker* tracker = budget.tracker();
+    util::Logger logger;
+    TestLog log;
+    uint64 reported = 0;
+    uint32 calls = 0;
+
+    logger.attach( &log );
+    budget.setLogger( &logger );
+    budget.setCallback( [&]( const MemoryBudget& over, uint64 live ) {
+        EXPECT_EQ( &budget, &over );
+        reported = live;
+        ++calls;
+    } );
+
+    tracker->recordGet( 100 );
+    budget.check();
+    EXPECT_FALSE( budget.exceeded() );
+    EXPECT_EQ( 0, calls );
+
+    tracker->recordGet( 50 );
+    budget.check();
+    EXPECT_TRUE( budget.exceeded() );
+    EXPECT_EQ( 1, calls );
+    EXPECT_EQ( 150, reported );
+    EXPECT_EQ( 1, log.warnings );
+
+    // staying over the limit does not report again
+    tracker->recordGet( 50 );
+    budget.check();
+    EXPECT_EQ( 1, calls );
+    EXPECT_EQ( 1, budget.overruns() );
+
+    tracker->recordRelease( 150 );
+    budget.check();
+    EXPECT_FALSE( budget.exceeded() );
+
+    tracker->recordGet( 150 );
+    budget.check();
+    EXPECT_EQ( 2, calls );
+    EXPECT_EQ( 2, log.warnings );
+    EXPECT_EQ( 2, budget.overruns() );
+
+    tracker->recordRelease( 200 );
+}
+
+TEST( MemoryBudget, Frames )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    MemoryBudget budget( "budget.frames", 100 );
+    AllocationTracker* tracker = budget.tracker();
+
+    tracker->recordGet( 200 );
+    budget.check();
+    tracker->recordRelease( 150 );
+    budget.check();
+
+    EXPECT_EQ( 200, budget.framePeakBytes() );
+    EXPECT_EQ( 1, budget.frameOverruns() );
+
+    budget.endFrame();
+    EXPECT_EQ( 50, budget.framePeakBytes() );
+    EXPECT_EQ( 0, budget.frameOverruns() );
+    EXPECT_EQ( 1, budget.overruns() );
+
+    // allocations made without a check are caught at the end of the frame
+    tracker->recordGet( 100 );
+    budget.endFrame();
+    EXPECT_TRUE( budget.exceeded() );
+    EXPECT_EQ( 150, budget.framePeakBytes() );
+    EXPECT_EQ( 1, budget.frameOverruns() );
+
+    tracker->recordRelease( 150 );
+}
@@ -2,6 +2,14 @@
 #include <engine/memory/memory_utils.h>
 #include <gtest/gtest.h>
 
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
 TEST( MemoryUtils, All )
 {
     using namespace nge::mem;
@@ -15,4 +23,248 @@ TEST( MemoryUtils, All )
     MemoryUtils::move( &dst[0], ( char* )"name", 5 );
 
     EXPECT_STREQ( "name", dst );
-}
\ No newline at end of file
+}
+
+TEST( MemoryUtils, AlignedAllocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint32 align;
+    void* pointer;
+
+    for ( align = 1; align <= 256; align <<= 1 )
+    {
+        pointer = MemoryUtils::allocateAligned( 24, align );
+
+        EXPECT_TRUE( MemoryUtils::isAligned( pointer, align ) );
+        MemoryUtils::deallocateAligned( pointer );
+    }
+}
+
+TEST( MemoryUtils, Copy )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 sizes[] = { 0, 1, 15, 16, 17, 63, 64, 65, 1000,
+                             MemoryUtils::NON_TEMPORAL_THRESHOLD + 33 };
+    std::vector<uint8> src( MemoryUtils::NON_TEMPORAL_THRESHOLD + 64 );
+    std::vector<uint8> dst( src.size() );
+    uint32 offset;
+    uint32 i;
+    uint32 j;
+
+    for ( i = 0; i < src.size(); ++i )
+    {
+        src[i] = static_cast<uint8>( i * 7 + 3 );
+    }
+
+    // offsets move the destination off of the vector alignment
+    for ( i = 0; i < sizeof( sizes ) / sizeof( sizes[0] ); ++i )
+    {
+        for ( offset = 0; offset < 4; ++offset )
+        {
+            std::fill( dst.begin(), dst.end(), 0 );
+            MemoryUtils::copy( &dst[offset], &src[0], sizes[i] );
+
+            for ( j = 0; j < sizes[i]; ++j )
+            {
+                ASSERT_EQ( src[j], dst[offset + j] );
+            }
+            EXPECT_EQ( 0, dst[offset + sizes[i]] );
+        }
+    }
+}
+
+TEST( MemoryUtils, Set )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    struct Triple
+    {
+        uint8 values[3];
+    };
+
+    const uint32 count = MemoryUtils::NON_TEMPORAL_THRESHOLD / 4 + 7;
+    std::vector<uint8> bytes( 1000 );
+    std::vector<uint16> shorts( 1000 );
+    std::vector<uint32> ints( count + 1 );
+    std::vector<uint64> longs( 1000 );
+    Triple triples[5];
+    uint32 i;
+
+    MemoryUtils::set( &bytes[3], static_cast<uint8>( 0xAB ), 990 );
+    MemoryUtils::set( &shorts[1], static_cast<uint16>( 0x1234 ), 997 );
+    MemoryUtils::set( &ints[1], 0xDEADBEEFu, count );
+    MemoryUtils::set( &longs[0], static_cast<uint64>( 0x0123456789ABCDEF ),
+                      999 );
+    MemoryUtils::set( triples, Triple{ { 1, 2, 3 } }, 5 );
+
+    EXPECT_EQ( 0, bytes[2] );
+    EXPECT_EQ( 0, bytes[993] );
+    for ( i = 3; i < 993; ++i )
+    {
+        ASSERT_EQ( 0xAB, bytes[i] );
+    }
+
+    EXPECT_EQ( 0, shorts[0] );
+    EXPECT_EQ( 0, shorts[998] );
+    for ( i = 1; i < 998; ++i )
+    {
+        ASSERT_EQ( 0x1234, shorts[i] );
+    }
+
+    EXPECT_EQ( 0, ints[0] );
+    for ( i = 1; i <= count; ++i )
+    {
+        ASSERT_EQ( 0xDEADBEEFu, ints[i] );
+    }
+
+    MemoryUtils::set( &ints[1], 0xFFFFFFFFu, 99 );
+    EXPECT_EQ( 0, ints[0] );
+    EXPECT_EQ( 0xFFFFFFFFu, ints[99] );
+    EXPECT_EQ( 0xDEADBEEFu, ints[100] );
+
+    EXPECT_EQ( 0, longs[999] );
+    for ( i = 0; i < 999; ++i )
+    {
+        ASSERT_EQ( 0x0123456789ABCDEFull, longs[i] );
+    }
+
+    for ( i = 0; i < 5; ++i )
+    {
+        EXPECT_EQ( 1, triples[i].values[0] );
+        EXPECT_EQ( 3, triples[i].values[2] );
+    }
+}
+
+TEST( MemoryUtils, Equals )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    std::vector<uint32> lhs( 1000 );
+    std::vector<uint32> rhs( 1000 );
+    float positive = 0.0f;
+    float negative = -0.0f;
+    uint32 i;
+
+    for ( i = 0; i < 1000; ++i )
+    {
+        lhs[i] = rhs[i] = i * 31;
+    }
+
+    EXPECT_TRUE( MemoryUtils::equals( &lhs[0], &rhs[0], 1000 ) );
+    EXPECT_TRUE( MemoryUtils::equals( &lhs[0], &rhs[0], 0 ) );
+
+    for ( i = 0; i < 1000; i += 37 )
+    {
+        rhs[i] ^= 0x100;
+        EXPECT_FALSE( MemoryUtils::equals( &lhs[0], &rhs[0], 1000 ) );
+        EXPECT_TRUE( MemoryUtils::equals( &lhs[0], &rhs[0], i ) );
+        rhs[i] ^= 0x100;
+    }
+
+    // floats are compared by value, not by bytes
+    EXPECT_TRUE( MemoryUtils::equals( &positive, &negative, 1 ) );
+}
+
+TEST( MemoryUtils, DISABLED_Benchmark )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    typedef std::chrono::steady_clock Clock;
+
+    const uint32 sizes[] = { 256, 4096, 64 * 1024, 1024 * 1024,
+                             16 * 1024 * 1024 };
+    const uint32 total = 256 * 1024 * 1024;
+    std::vector<uint32> src( sizes[4] / 4, 7 );
+    std::vector<uint32> dst( sizes[4] / 4 );
+    volatile bool same;
+    uint32 count;
+    uint32 rounds;
+    uint32 i;
+    uint32 j;
+    uint32 k;
+
+    // time each kernel over the same number of bytes for every size
+    auto time = [&]( const std::function<void()>& func ) {
+        Clock::time_point start = Clock::now();
+
+        for ( j = 0; j < rounds; ++j )
+        {
+            func();
+        }
+
+        return std::chrono::duration<double>( Clock::now() - start ).count();
+    };
+    auto report = [&]( const char* name, double seconds ) {
+        std::cout << "  " << name << ": "
+                  << total / seconds / ( 1024 * 1024 * 1024 ) << " GiB/s\n";
+    };
+
+    for ( i = 0; i < sizeof( sizes ) / sizeof( sizes[0] ); ++i )
+    {
+        count = sizes[i] / 4;
+        rounds = total / sizes[i];
+        MemoryUtils::copy( &dst[0], &src[0], count );
+        std::cout << sizes[i] << " bytes:\n";
+
+        report( "set loop", time( [&]() {
+            for ( k = 0; k < count; ++k )
+            {
+                dst[k] = 0;
+            }
+        } ) );
+        report( "set", time( [&]() {
+            MemoryUtils::set( &dst[0], 0u, count );
+        } ) );
+        report( "memset", time( [&]() {
+            memset( &dst[0], 0, sizes[i] );
+        } ) );
+
+        // a zero fill is one repeated byte and goes to memset, so time a
+        // multi-byte pattern to measure the vector fill
+        report( "fill loop", time( [&]() {
+            for ( k = 0; k < count; ++k )
+            {
+                dst[k] = 0x01020304u;
+            }
+        } ) );
+        report( "fill", time( [&]() {
+            MemoryUtils::set( &dst[0], 0x01020304u, count );
+        } ) );
+        report( "std::fill", time( [&]() {
+            std::fill( dst.begin(), dst.begin() + count, 0x01020304u );
+        } ) );
+
+        report( "copy loop", time( [&]() {
+            for ( k = 0; k < count; ++k )
+            {
+                dst[k] = src[k];
+            }
+        } ) );
+        report( "copy", time( [&]() {
+            MemoryUtils::copy( &dst[0], &src[0], count );
+        } ) );
+        report( "memcpy", time( [&]() {
+            memcpy( &dst[0], &src[0], sizes[i] );
+        } ) );
+
+        report( "equals loop", time( [&]() {
+            for ( k = 0; k < count && dst[k] == src[k]; ++k )
+            {
+            }
+            same = k == count;
+        } ) );
+        report( "equals", time( [&]() {
+            same = MemoryUtils::equals( &dst[0], &src[0], count );
+        } ) );
+        report( "memcmp", time( [&]() {
+            same = memcmp( &dst[0], &src[0], sizes[i] ) == 0;
+        } ) );
+    }
+}
@@ -0,0 +1,289 @@
+// object_pool.t.cpp
+#include <engine/memory/object_pool.h>
+#include <engine/world/itickable.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+class Particle : public nge::world::ITickable
+{
+  public:
+    static nge::uint32 constructed;
+    static nge::uint32 destructed;
+
+    float position;
+    float speed;
+    std::vector<float> trail;
+
+    explicit Particle( float speed = 1.0f ) : position( 0.0f ), speed( speed )
+    {
+        ++constructed;
+    }
+
+    virtual ~Particle()
+    {
+        ++destructed;
+    }
+
+    virtual void pretick()
+    {
+    }
+
+    virtual void tick( float dtS )
+    {
+        position += speed * dtS;
+        trail.push_back( position );
+    }
+
+    virtual void postick()
+    {
+    }
+};
+
+nge::uint32 Particle::constructed = 0;
+nge::uint32 Particle::destructed = 0;
+
+struct Fragile
+{
+    explicit Fragile( bool fail )
+    {
+        if ( fail )
+        {
+            throw std::runtime_error( "construction failed" );
+        }
+    }
+};
+
+} // End nspc anonymous
+
+TEST( ObjectPool, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ObjectPool<Particle> def;
+    ObjectPool<Particle> pool( 16 );
+
+    EXPECT_EQ( ObjectPool<Particle>::DEFAULT_CHUNK_SIZE, def.chunkSize() );
+    EXPECT_EQ( 16, pool.chunkSize() );
+    EXPECT_EQ( 0, pool.size() );
+    EXPECT_EQ( 0, pool.capacity() );
+
+    pool.reserve( 20 );
+    EXPECT_EQ( 2, pool.chunkCount() );
+    EXPECT_EQ( 32, pool.capacity() );
+}
+
+TEST( ObjectPool, CreateAndDestroy )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Particle::constructed = 0;
+    Particle::destructed = 0;
+
+    {
+        ObjectPool<Particle> pool( 4 );
+        Particle* particles[6];
+        Particle* reused;
+        uint32 i;
+
+        for ( i = 0; i < 6; ++i )
+        {
+            particles[i] = pool.create( static_cast<float>( i ) );
+        }
+
+        EXPECT_EQ( 6, pool.size() );
+        EXPECT_EQ( 2, pool.chunkCount() );
+        EXPECT_EQ( 6, Particle::constructed );
+
+        // slots of a chunk are handed out in address order
+        EXPECT_LT( particles[0], particles[1] );
+        EXPECT_LT( particles[1], particles[2] );
+        EXPECT_EQ( 3.0f, particles[3]->speed );
+
+        pool.destroy( particles[2] );
+        EXPECT_EQ( 1, Particle::destructed );
+        EXPECT_EQ( 5, pool.size() );
+
+        reused = pool.create( 9.0f );
+        EXPECT_EQ( particles[2], reused );
+        EXPECT_EQ( 2, pool.chunkCount() );
+
+        pool.destroy( particles[5] );
+        EXPECT_DEATH( pool.destroy( particles[5] ), ".*" );
+    }
+
+    // the pool destructs the objects still in it
+    EXPECT_EQ( Particle::constructed, Particle::destructed );
+}
+
+TEST( ObjectPool, ThrowingConstructor )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ObjectPool<Fragile> pool( 2 );
+    Fragile* first;
+    Fragile* second;
+
+    first = pool.create( false );
+    EXPECT_THROW( pool.create( true ), std::runtime_error );
+    EXPECT_EQ( 1, pool.size() );
+
+    // the slot of the failed object is handed out again rather than lost
+    second = pool.create( false );
+    EXPECT_NE( first, second );
+    EXPECT_EQ( 2, pool.size() );
+    EXPECT_EQ( 1, pool.chunkCount() );
+
+    pool.destroy( first );
+    pool.destroy( second );
+}
+
+TEST( ObjectPool, Recycling )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Particle::constructed = 0;
+    Particle::destructed = 0;
+
+    {
+        ObjectPool<Particle> pool( 4 );
+        Particle* first;
+        Particle* second;
+        uint32 resets = 0;
+
+        pool.setResetter( [&]( Particle& particle ) {
+            particle.position = 0.0f;
+            particle.trail.clear();
+            ++resets;
+        } );
+
+        first = pool.acquire();
+        first->tick( 1.0f );
+        pool.recycle( first );
+
+        EXPECT_EQ( 0, pool.size() );
+        EXPECT_EQ( 1, pool.idleCount() );
+        EXPECT_EQ( 1, resets );
+        EXPECT_EQ( 0, Particle::destructed );
+
+        // the recycled object is handed out again without constructing
+        second = pool.acquire();
+        EXPECT_EQ( first, second );
+        EXPECT_EQ( 0.0f, second->position );
+        EXPECT_TRUE( second->trail.empty() );
+        EXPECT_EQ( 1, Particle::constructed );
+
+        pool.recycle( second );
+        pool.trim();
+        EXPECT_EQ( 0, pool.idleCount() );
+        EXPECT_EQ( 1, Particle::destructed );
+
+        pool.recycle( pool.acquire() );
+        pool.create();
+        pool.create();
+        pool.create();
+
+        // a full pool destroys recycled objects before it grows
+        pool.create();
+        EXPECT_EQ( 1, pool.chunkCount() );
+        EXPECT_EQ( 0, pool.idleCount() );
+
+        pool.clear();
+        EXPECT_EQ( 0, pool.size() );
+        EXPECT_EQ( Particle::constructed, Particle::destructed );
+    }
+}
+
+TEST( ObjectPool, Trim )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Particle::constructed = 0;
+    Particle::destructed = 0;
+
+    {
+        ObjectPool<Particle> pool( 4 );
+        Particle* particles[12];
+        Particle* reused;
+        uint32 i;
+
+        for ( i = 0; i < 12; ++i )
+        {
+            particles[i] = pool.create();
+        }
+        EXPECT_EQ( 3, pool.chunkCount() );
+
+        // empty the first chunk with destroys and recycles and leave one
+        // object in the second
+        pool.destroy( particles[0] );
+        pool.destroy( particles[1] );
+        pool.recycle( particles[2] );
+        pool.recycle( particles[3] );
+        for ( i = 4; i < 7; ++i )
+        {
+            pool.destroy( particles[i] );
+        }
+
+        pool.trim();
+        EXPECT_EQ( 2, pool.chunkCount() );
+        EXPECT_EQ( 8, pool.capacity() );
+        EXPECT_EQ( 5, pool.size() );
+        EXPECT_EQ( 0, pool.idleCount() );
+        EXPECT_EQ( 7, Particle::destructed );
+
+        // the free slots of the kept chunk are handed out again
+        reused = pool.create();
+        EXPECT_EQ( particles[4], reused );
+        EXPECT_EQ( 2, pool.chunkCount() );
+
+        pool.clear();
+        pool.trim();
+        EXPECT_EQ( 0, pool.chunkCount() );
+        EXPECT_EQ( 0, pool.capacity() );
+    }
+
+    EXPECT_EQ( Particle::constructed, Particle::destructed );
+}
+
+TEST( ObjectPool, Tickables )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ObjectPool<Particle> pool( 8 );
+    std::vector<Particle*> particles;
+    float total = 0.0f;
+    uint32 count = 0;
+    uint32 i;
+
+    for ( i = 0; i < 20; ++i )
+    {
+        particles.push_back( pool.create( 1.0f ) );
+    }
+    for ( i = 0; i < 20; i += 2 )
+    {
+        pool.destroy( particles[i] );
+    }
+
+    pool.forEach( [&]( world::ITickable& tickable ) {
+        tickable.pretick();
+        tickable.tick( 0.5f );
+        tickable.postick();
+    } );
+    pool.forEach( [&]( Particle& particle ) {
+        total += particle.position;
+        ++count;
+    } );
+
+    EXPECT_EQ( 10, count );
+    EXPECT_FLOAT_EQ( 5.0f, total );
+}
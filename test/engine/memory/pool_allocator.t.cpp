@@ -0,0 +1,259 @@
+// pool_allocator.t.cpp
+#include <engine/memory/pool_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST( PoolAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    PoolAllocator<uint64> def;
+    PoolAllocator<uint64> slab( 16 );
+    PoolAllocator<uint8> chunk( 16, 4 );
+
+    EXPECT_EQ( 1, def.chunkSize() );
+    EXPECT_EQ( 16, slab.slabSize() );
+    EXPECT_EQ( 4, chunk.chunkSize() );
+    EXPECT_EQ( 0, def.capacity() );
+    EXPECT_EQ( 0, def.size() );
+    EXPECT_EQ( 0.0f, def.occupancy() );
+    EXPECT_FALSE( def.isThreadCached() );
+}
+
+TEST( PoolAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    PoolAllocator<uint64> pool( 4 );
+    uint64* values[8];
+    uint32 i;
+
+    for ( i = 0; i < 8; ++i )
+    {
+        values[i] = pool.get( 1 );
+        *values[i] = i;
+    }
+
+    EXPECT_EQ( 2, pool.slabCount() );
+    EXPECT_EQ( 8, pool.size() );
+    EXPECT_EQ( 8, pool.capacity() );
+    EXPECT_EQ( 1.0f, pool.occupancy() );
+    EXPECT_EQ( values[0] + 1, values[1] );
+
+    // released chunks are reused first
+    pool.release( values[5], 1 );
+    EXPECT_EQ( 7, pool.size() );
+    EXPECT_EQ( values[5], pool.get( 1 ) );
+    *values[5] = 5;
+
+    // large requests go to the heap
+    uint64* large = pool.get( 10 );
+    large[9] = 1;
+    EXPECT_EQ( 1, pool.oversizedCount() );
+    EXPECT_EQ( 8, pool.size() );
+    pool.release( large, 10 );
+
+    for ( i = 0; i < 8; ++i )
+    {
+        EXPECT_EQ( i, *values[i] );
+        pool.release( values[i], 1 );
+    }
+
+    EXPECT_EQ( 0, pool.size() );
+    EXPECT_EQ( 2, pool.slabCount() );
+}
+
+TEST( PoolAllocator, Fragmentation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    PoolAllocator<uint32> pool( 4 );
+    uint32* values[8];
+    uint32 i;
+
+    EXPECT_EQ( 0.0f, pool.fragmentation() );
+
+    for ( i = 0; i < 8; ++i )
+    {
+        values[i] = pool.get( 1 );
+    }
+
+    EXPECT_EQ( 0.0f, pool.fragmentation() );
+
+    // freeing every other chunk strands all of the free chunks
+    for ( i = 0; i < 8; i += 2 )
+    {
+        pool.release( values[i], 1 );
+    }
+
+    EXPECT_EQ( 1.0f, pool.fragmentation() );
+
+    // emptying the first slab makes its chunks reclaimable
+    pool.release( values[1], 1 );
+    pool.release( values[3], 1 );
+    EXPECT_FLOAT_EQ( 2.0f / 6.0f, pool.fragmentation() );
+
+    pool.release( values[5], 1 );
+    pool.release( values[7], 1 );
+    EXPECT_EQ( 0.0f, pool.fragmentation() );
+}
+
+TEST( PoolAllocator, ManySlabs )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    // more slabs than fragmentation sorts at a time
+    PoolAllocator<uint32> pool( 2 );
+    uint32* values[300];
+    uint32 i;
+
+    for ( i = 0; i < 300; ++i )
+    {
+        values[i] = pool.get( 1 );
+    }
+
+    EXPECT_EQ( 150u, pool.slabCount() );
+
+    for ( i = 0; i < 300; i += 2 )
+    {
+        pool.release( values[i], 1 );
+    }
+
+    EXPECT_EQ( 1.0f, pool.fragmentation() );
+
+    for ( i = 1; i < 300; i += 2 )
+    {
+        pool.release( values[i], 1 );
+    }
+
+    EXPECT_EQ( 0.0f, pool.fragmentation() );
+}
+
+TEST( PoolAllocator, OverAligned )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    struct alignas( 64 ) Line
+    {
+        uint8 bytes[64];
+    };
+
+    PoolAllocator<Line> pool( 8 );
+    Line* values[16];
+    uint32 i;
+
+    for ( i = 0; i < 16; ++i )
+    {
+        values[i] = pool.get( 1 );
+        EXPECT_TRUE( MemoryUtils::isAligned( values[i], 64 ) );
+    }
+
+    for ( i = 0; i < 16; ++i )
+    {
+        pool.release( values[i], 1 );
+    }
+
+    // oversized requests bypass the slabs but keep the alignment
+    values[0] = pool.get( pool.chunkSize() + 1 );
+    EXPECT_TRUE( MemoryUtils::isAligned( values[0], 64 ) );
+    EXPECT_EQ( 1u, pool.oversizedCount() );
+    pool.release( values[0], pool.chunkSize() + 1 );
+}
+
+TEST( PoolAllocator, Containers )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    PoolAllocator<uint32> pool( 8, 32 );
+    DynamicArray<uint32, AllocatorGuard> array( &pool );
+    uint32 i;
+
+    for ( i = 0; i < 16; ++i )
+    {
+        array.push( i );
+    }
+
+    EXPECT_EQ( 1, pool.size() );
+    EXPECT_EQ( 0, pool.oversizedCount() );
+    EXPECT_EQ( 15, array[15] );
+}
+
+TEST( PoolAllocator, ThreadCache )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 THREADS = 4;
+    const uint32 VALUES = 1000;
+
+    PoolAllocator<uint64> pool( 64 );
+    std::vector<std::thread> threads;
+    uint32 i;
+
+    pool.enableThreadCache();
+    EXPECT_TRUE( pool.isThreadCached() );
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads.push_back( std::thread( [&pool, i, VALUES]() {
+            std::vector<uint64*> values;
+            uint32 j;
+
+            for ( j = 0; j < VALUES; ++j )
+            {
+                values.push_back( pool.get( 1 ) );
+                *values.back() = i * VALUES + j;
+            }
+
+            for ( j = 0; j < VALUES; ++j )
+            {
+                ASSERT_EQ( i * VALUES + j, *values[j] );
+                pool.release( values[j], 1 );
+            }
+        } ) );
+    }
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads[i].join();
+    }
+
+    EXPECT_EQ( 0, pool.size() );
+    EXPECT_TRUE( pool.capacity() >= VALUES );
+}
+
+TEST( PoolAllocator, ThreadExit )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 THREADS = 100;
+
+    PoolAllocator<uint64> pool( 64 );
+    uint32 i;
+
+    pool.enableThreadCache();
+
+    // each thread leaves chunks in its cache, which must go back to the
+    // shared free list when it exits for the pool to stay at one slab
+    for ( i = 0; i < THREADS; ++i )
+    {
+        std::thread thread( [&pool]() {
+            pool.release( pool.get( 1 ), 1 );
+        } );
+        thread.join();
+    }
+
+    EXPECT_EQ( 0, pool.size() );
+    EXPECT_EQ( 1, pool.slabCount() );
+}
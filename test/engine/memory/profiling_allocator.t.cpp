@@ -0,0 +1,116 @@
+// profiling_allocator.t.cpp
+#include <engine/memory/profiling_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/default_allocator.h>
+#include <engine/memory/virtual_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( ProfilingAllocator, Construction )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    AllocationProfiler profiler( 64 );
+    DefaultAllocator<uint32> def;
+    ProfilingAllocator<uint32> alloc( &profiler );
+    ProfilingAllocator<uint32> wrapped( &profiler, &def );
+    ProfilingAllocator<uint32> copy( alloc );
+
+    EXPECT_EQ( &profiler, alloc.profiler() );
+    EXPECT_EQ( &profiler, copy.profiler() );
+    EXPECT_EQ( def.alignment(), wrapped.alignment() );
+    EXPECT_DEATH( ProfilingAllocator<uint32> invalid( nullptr ), ".*" );
+}
+
+TEST( ProfilingAllocator, Allocation )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    AllocationProfiler profiler( 64 );
+    ProfilingAllocator<uint64> alloc( &profiler );
+    AllocationProfiler::Site site;
+    uint64* values;
+
+    values = alloc.get( 4 );
+    EXPECT_EQ( 1, profiler.liveCount() );
+    EXPECT_EQ( 32, profiler.liveBytes() );
+
+    ASSERT_EQ( 1, profiler.topSites( &site, 1,
+                                     AllocationProfiler::LIVE_BYTES ) );
+    EXPECT_EQ( 32, site.liveBytes );
+
+    alloc.release( values, 4 );
+    EXPECT_EQ( 0, profiler.liveCount() );
+
+    EXPECT_DEATH( alloc.get( 0 ), ".*" );
+    EXPECT_DEATH( alloc.release( nullptr, 1 ), ".*" );
+}
+
+TEST( ProfilingAllocator, Failure )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    AllocationProfiler profiler( 64 );
+    VirtualAllocator<uint64> virt( 1ull << 62, VirtualMemory::SMALL_PAGES );
+    ProfilingAllocator<uint64> alloc( &profiler, &virt );
+
+    // failed allocations are not recorded
+    EXPECT_EQ( nullptr, alloc.get( 4 ) );
+    EXPECT_EQ( 0, profiler.liveCount() );
+    EXPECT_EQ( 0, profiler.dropped() );
+}
+
+TEST( ProfilingAllocator, Grow )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    AllocationProfiler profiler( 64 );
+    VirtualAllocator<uint64> virt( 64 * 1024, VirtualMemory::SMALL_PAGES );
+    ProfilingAllocator<uint64> alloc( &profiler, &virt );
+    AllocationProfiler::Site site;
+    uint32 max = virt.maxCount();
+    uint64* values;
+
+    values = alloc.get( 10 );
+    ASSERT_TRUE( alloc.grow( values, 10, 100 ) );
+    EXPECT_EQ( 1, profiler.liveCount() );
+    EXPECT_EQ( 800, profiler.liveBytes() );
+
+    ASSERT_EQ( 1, profiler.topSites( &site, 1,
+                                     AllocationProfiler::LIVE_BYTES ) );
+    EXPECT_EQ( 1, site.count );
+    EXPECT_EQ( 800, site.liveBytes );
+
+    EXPECT_FALSE( alloc.grow( values, 100, max + 1 ) );
+    EXPECT_EQ( 800, profiler.liveBytes() );
+
+    alloc.release( values, 100 );
+    EXPECT_EQ( 0, profiler.liveBytes() );
+}
+
+TEST( ProfilingAllocator, Containers )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    AllocationProfiler profiler( 64 );
+    ProfilingAllocator<uint32> alloc( &profiler );
+    uint32 i;
+
+    {
+        cntr::DynamicArray<uint32, AllocatorGuard> array( &alloc );
+
+        for ( i = 0; i < 100; ++i )
+        {
+            array.push( i );
+        }
+
+        EXPECT_EQ( 1, profiler.liveCount() );
+        EXPECT_LE( 400, profiler.liveBytes() );
+    }
+
+    EXPECT_EQ( 0, profiler.liveCount() );
+}
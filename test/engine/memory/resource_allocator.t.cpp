@@ -0,0 +1,123 @@
+// resource_allocator.t.cpp
+#include <engine/memory/resource_allocator.h>
+#include <engine/memory/arena_resource.h>
+#include <engine/memory/buddy_resource.h>
+#include <engine/memory/heap_resource.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/list.h>
+#include <engine/containers/map.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Counted
+{
+    static nge::uint32 g_live;
+
+    Counted()
+    {
+        ++g_live;
+    }
+
+    ~Counted()
+    {
+        --g_live;
+    }
+};
+
+nge::uint32 Counted::g_live = 0;
+
+} // End nspc anonymous
+
+TEST( ResourceAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    HeapResource heap;
+    ResourceAllocator<Counted> alloc( &heap );
+
+    Counted* values = alloc.get( 4 );
+    EXPECT_EQ( 4, Counted::g_live );
+
+    alloc.release( values, 4 );
+    EXPECT_EQ( 0, Counted::g_live );
+
+    // allocators of other types share the resource
+    ResourceAllocator<uint64> other( alloc );
+    EXPECT_EQ( &heap, other.resource() );
+}
+
+TEST( ResourceAllocator, Exhausted )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    BuddyResource buddies( 1024, 64 );
+    ResourceAllocator<Counted> alloc( &buddies );
+    Counted* values[16];
+    uint32 count;
+    uint32 i;
+
+    // allocate until the resource is out of space
+    for ( count = 0; count < 16; ++count )
+    {
+        values[count] = alloc.get( 128 );
+        if ( values[count] == nullptr )
+        {
+            break;
+        }
+    }
+
+    ASSERT_EQ( 8, count );
+    EXPECT_EQ( count * 128, Counted::g_live );
+    EXPECT_EQ( nullptr, alloc.get( 128 ) );
+    EXPECT_EQ( count * 128, Counted::g_live );
+
+    for ( i = 0; i < count; ++i )
+    {
+        alloc.release( values[i], 128 );
+    }
+    EXPECT_EQ( 0, Counted::g_live );
+}
+
+TEST( ResourceAllocator, SharedArena )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    ArenaResource arena;
+    ArenaResource::Marker marker = arena.mark();
+    uint32 i;
+
+    {
+        ResourceAllocator<uint32> intAlloc( &arena );
+        ResourceAllocator<Map<uint32, float>::Pair> pairAlloc( &arena );
+        ResourceAllocator<List<uint64>::Node> nodeAlloc( &arena );
+
+        DynamicArray<uint32, AllocatorGuard> array( &intAlloc );
+        Map<uint32, float, AllocatorGuard> map( &pairAlloc, &intAlloc );
+        List<uint64, AllocatorGuard> list( &nodeAlloc );
+
+        for ( i = 0; i < 100; ++i )
+        {
+            array.push( i );
+            map.put( i, i * 0.5f );
+            list.push( i );
+        }
+
+        EXPECT_EQ( 100, array.size() );
+        EXPECT_EQ( 100, map.size() );
+        EXPECT_EQ( 100, list.size() );
+        EXPECT_EQ( 49.5f, map[99] );
+        EXPECT_EQ( 99, list[99] );
+    }
+
+    // every container used the one arena
+    EXPECT_LT( 0, arena.size() );
+
+    arena.rollback( marker );
+    EXPECT_EQ( 0, arena.size() );
+}
@@ -0,0 +1,91 @@
+// stack_marker.t.cpp
+#include <engine/memory/stack_marker.h>
+#include <gtest/gtest.h>
+
+#include <utility>
+
+TEST( StackMarker, Full )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 256 );
+    StackMarker null;
+
+    ASSERT_TRUE( !null );
+    ASSERT_FALSE( null );
+
+    stack.allocate( 16, 1 );
+    {
+        StackMarker bottom( &stack, DoubleStackResource::BOTTOM );
+        StackMarker top( &stack, DoubleStackResource::TOP );
+
+        ASSERT_TRUE( bottom );
+        ASSERT_FALSE( !top );
+        EXPECT_EQ( 16, bottom.marker().offset );
+        EXPECT_EQ( DoubleStackResource::TOP, top.marker().side );
+
+        stack.allocate( 32, 1 );
+        stack.allocate( DoubleStackResource::TOP, 32, 1 );
+        {
+            StackMarker nested( &stack, DoubleStackResource::TOP );
+
+            stack.allocate( DoubleStackResource::TOP, 64, 1 );
+            EXPECT_EQ( 96, stack.size( DoubleStackResource::TOP ) );
+        }
+        EXPECT_EQ( 32, stack.size( DoubleStackResource::TOP ) );
+
+        top.rollback();
+        EXPECT_EQ( 0, stack.size( DoubleStackResource::TOP ) );
+        EXPECT_EQ( 48, stack.size( DoubleStackResource::BOTTOM ) );
+    }
+    EXPECT_EQ( 16, stack.size( DoubleStackResource::BOTTOM ) );
+    EXPECT_EQ( 0, stack.size( DoubleStackResource::TOP ) );
+}
+
+TEST( StackMarker, Move )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleStackResource stack( 256 );
+    StackMarker outer;
+
+    {
+        StackMarker inner( &stack, DoubleStackResource::BOTTOM );
+
+        stack.allocate( 64, 1 );
+        outer = std::move( inner );
+
+        ASSERT_FALSE( inner );
+        ASSERT_TRUE( outer );
+    }
+    EXPECT_EQ( 64, stack.size( DoubleStackResource::BOTTOM ) );
+
+    {
+        StackMarker moved( std::move( outer ) );
+
+        ASSERT_FALSE( outer );
+    }
+    EXPECT_EQ( 0, stack.size( DoubleStackResource::BOTTOM ) );
+
+    {
+        StackMarker first( &stack, DoubleStackResource::TOP );
+
+        stack.allocate( DoubleStackResource::TOP, 32, 1 );
+
+        StackMarker second( &stack, DoubleStackResource::BOTTOM );
+
+        stack.allocate( DoubleStackResource::BOTTOM, 16, 1 );
+
+        // assigning over an active marker rolls its stack back
+        first = std::move( second );
+        EXPECT_EQ( 0, stack.size( DoubleStackResource::TOP ) );
+        EXPECT_EQ( 16, stack.size( DoubleStackResource::BOTTOM ) );
+        ASSERT_FALSE( second );
+        ASSERT_TRUE( first );
+    }
+    EXPECT_EQ( 0, stack.size( DoubleStackResource::BOTTOM ) );
+
+    EXPECT_DEATH( StackMarker().rollback(), ".*" );
+}
@@ -0,0 +1,64 @@
+// static_allocator.t.cpp
+#include <engine/memory/static_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/list.h>
+#include <engine/containers/map.h>
+#include <gtest/gtest.h>
+#include <type_traits>
+
+TEST( StaticAllocator, Allocation )
+{
+    using namespace nge::mem;
+
+    std::string* value = nullptr;
+
+    StaticAllocator<std::string> alloc;
+
+    EXPECT_NO_FATAL_FAILURE( value = alloc.get( 1 ) );
+    EXPECT_NE( nullptr, value );
+    EXPECT_NO_FATAL_FAILURE( alloc.release( value, 1 ) );
+
+    EXPECT_DEATH( alloc.release( nullptr, 1 ), ".*" );
+
+    EXPECT_NO_FATAL_FAILURE( value = alloc.get( 100 ) );
+    EXPECT_NE( nullptr, value );
+    EXPECT_NO_FATAL_FAILURE( alloc.release( value, 100 ) );
+}
+
+TEST( StaticAllocator, ContainerOverhead )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    // the array only holds its values pointer and three indices
+    struct Layout
+    {
+        uint32* values;
+        uint32 first;
+        uint32 size;
+        uint32 capacity;
+    };
+
+    EXPECT_TRUE( std::is_empty<StaticAllocator<uint32>>::value );
+    EXPECT_EQ( sizeof( Layout ), sizeof( DynamicArray<uint32> ) );
+    EXPECT_LT( sizeof( DynamicArray<uint32> ),
+               sizeof( DynamicArray<uint32, AllocatorGuard> ) );
+    EXPECT_LT( sizeof( List<uint32> ), sizeof( List<uint32, AllocatorGuard> ) );
+    EXPECT_LT( sizeof( Map<uint32, uint32> ),
+               sizeof( Map<uint32, uint32, AllocatorGuard> ) );
+}
+
+TEST( StaticAllocator, SharedNodeTypes )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    // nodes and pairs are the same for every policy
+    EXPECT_TRUE( ( std::is_same<List<uint32>::Node,
+                                List<uint32, AllocatorGuard>::Node>::value ) );
+    EXPECT_TRUE( ( std::is_same<Map<uint32, float>::Pair,
+                                Map<uint32, float,
+                                    AllocatorGuard>::Pair>::value ) );
+}
@@ -0,0 +1,341 @@
+// thread_cache_resource.t.cpp
+#include <engine/memory/thread_cache_resource.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/heap_resource.h>
+#include <engine/memory/resource_allocator.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST( ThreadCacheResource, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ThreadCacheResource threadCache;
+    uint8* first;
+    uint8* second;
+    uint8* third;
+
+    first = static_cast<uint8*>( threadCache.allocate( 24, 8 ) );
+    second = static_cast<uint8*>( threadCache.allocate( 24, 8 ) );
+    third = static_cast<uint8*>( threadCache.allocate( 16, 1024 ) );
+
+    ASSERT_NE( nullptr, first );
+    ASSERT_NE( nullptr, second );
+    ASSERT_NE( nullptr, third );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( first ) % 32 );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( third ) % 1024 );
+
+    // blocks of a batch come from one slab in address order
+    EXPECT_EQ( first + 32, second );
+    EXPECT_EQ( 1, threadCache.slabCount( 1 ) );
+    EXPECT_EQ( 1, threadCache.slabCount( 6 ) );
+    EXPECT_EQ( 0, threadCache.slabCount( 0 ) );
+
+    threadCache.deallocate( first, 24, 8 );
+    threadCache.deallocate( second, 24, 8 );
+    threadCache.deallocate( third, 16, 1024 );
+}
+
+TEST( ThreadCacheResource, Batches )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ThreadCacheResource threadCache;
+    std::vector<void*> blocks;
+    uint32 perSlab = ThreadCacheResource::SLAB_SIZE / 64;
+    uint32 i;
+
+    EXPECT_EQ( 64, ThreadCacheResource::classSize( 2 ) );
+
+    blocks.push_back( threadCache.allocate( 64, 8 ) );
+    EXPECT_EQ( 31, threadCache.cachedCount( 2 ) );
+    EXPECT_EQ( perSlab - 32, threadCache.pooledCount( 2 ) );
+
+    for ( i = 1; i < 200; ++i )
+    {
+        blocks.push_back( threadCache.allocate( 64, 8 ) );
+    }
+    EXPECT_EQ( 24, threadCache.cachedCount( 2 ) );
+    EXPECT_EQ( perSlab - 224, threadCache.pooledCount( 2 ) );
+
+    // the cache keeps at most two batches and returns the rest
+    for ( i = 0; i < 200; ++i )
+    {
+        threadCache.deallocate( blocks[i], 64, 8 );
+        EXPECT_LE( threadCache.cachedCount( 2 ), 64 );
+    }
+    EXPECT_EQ( perSlab, threadCache.cachedCount( 2 ) +
+                            threadCache.pooledCount( 2 ) );
+
+    threadCache.flush();
+    EXPECT_EQ( 0, threadCache.cachedCount( 2 ) );
+    EXPECT_EQ( perSlab, threadCache.pooledCount( 2 ) );
+    EXPECT_EQ( 1, threadCache.slabCount( 2 ) );
+}
+
+TEST( ThreadCacheResource, Reuse )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ThreadCacheResource threadCache;
+    void* block;
+
+    block = threadCache.allocate( 100, 4 );
+    threadCache.deallocate( block, 100, 4 );
+    EXPECT_EQ( block, threadCache.allocate( 128, 16 ) );
+    threadCache.deallocate( block, 128, 16 );
+}
+
+TEST( ThreadCacheResource, Large )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ThreadCacheResource threadCache;
+    uint8* bytes;
+    uint32 i;
+
+    bytes = static_cast<uint8*>(
+        threadCache.allocate( ThreadCacheResource::MAX_CACHED_SIZE + 1, 8 ) );
+    ASSERT_NE( nullptr, bytes );
+    for ( i = 0; i <= ThreadCacheResource::MAX_CACHED_SIZE; ++i )
+    {
+        bytes[i] = static_cast<uint8>( i );
+    }
+    threadCache.deallocate( bytes, ThreadCacheResource::MAX_CACHED_SIZE + 1,
+                            8 );
+
+    bytes = static_cast<uint8*>( threadCache.allocate( 64, 8192 ) );
+    ASSERT_NE( nullptr, bytes );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( bytes ) % 8192 );
+    threadCache.deallocate( bytes, 64, 8192 );
+
+    for ( i = 0; i < ThreadCacheResource::SIZE_CLASSES; ++i )
+    {
+        EXPECT_EQ( 0, threadCache.slabCount( i ) );
+    }
+}
+
+TEST( ThreadCacheResource, CrossThread )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 PAIRS = 4;
+    const uint32 VALUES = 10000;
+
+    ThreadCacheResource threadCache;
+    std::vector<std::thread> threads;
+    std::vector<uint64*> queues[PAIRS];
+    std::mutex mutexes[PAIRS];
+    bool done[PAIRS];
+    uint32 pooled = 0;
+    uint32 slabs = 0;
+    uint32 i;
+
+    // producers allocate and consumers on other threads deallocate
+    for ( i = 0; i < PAIRS; ++i )
+    {
+        done[i] = false;
+
+        threads.push_back( std::thread( [&, i]() {
+            uint64* value;
+            uint32 j;
+
+            for ( j = 0; j < VALUES; ++j )
+            {
+                value = static_cast<uint64*>(
+                    threadCache.allocate( sizeof( uint64 ), 8 ) );
+                *value = i * VALUES + j;
+
+                std::lock_guard<std::mutex> lock( mutexes[i] );
+                queues[i].push_back( value );
+            }
+
+            std::lock_guard<std::mutex> lock( mutexes[i] );
+            done[i] = true;
+        } ) );
+
+        threads.push_back( std::thread( [&, i]() {
+            std::vector<uint64*> values;
+            uint32 next = 0;
+            uint32 j;
+            bool finished = false;
+
+            while ( !finished || !values.empty() )
+            {
+                for ( j = 0; j < values.size(); ++j )
+                {
+                    ASSERT_EQ( i * VALUES + next, *values[j] );
+                    threadCache.deallocate( values[j], sizeof( uint64 ), 8 );
+                    ++next;
+                }
+                values.clear();
+
+                std::lock_guard<std::mutex> lock( mutexes[i] );
+                values.swap( queues[i] );
+                finished = done[i];
+            }
+
+            EXPECT_EQ( VALUES, next );
+            threadCache.flush();
+        } ) );
+    }
+
+    for ( i = 0; i < threads.size(); ++i )
+    {
+        threads[i].join();
+    }
+
+    // every block is back in the pool except those cached by producers,
+    // which keep at most two batches
+    for ( i = 0; i < ThreadCacheResource::SIZE_CLASSES; ++i )
+    {
+        pooled += threadCache.pooledCount( i );
+        slabs += threadCache.slabCount( i );
+    }
+    EXPECT_LE( 1, slabs );
+    EXPECT_LE( slabs * ThreadCacheResource::SLAB_SIZE / 16 - PAIRS * 64,
+               pooled );
+}
+
+TEST( ThreadCacheResource, Containers )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ThreadCacheResource threadCache;
+    ResourceAllocator<uint32> alloc( &threadCache );
+    uint32 i;
+
+    {
+        cntr::DynamicArray<uint32, AllocatorGuard> array( &alloc );
+
+        for ( i = 0; i < 10000; ++i )
+        {
+            array.push( i );
+        }
+
+        EXPECT_EQ( 9999, array[9999] );
+    }
+
+    threadCache.flush();
+    for ( i = 0; i < ThreadCacheResource::SIZE_CLASSES; ++i )
+    {
+        EXPECT_EQ( threadCache.slabCount( i ) *
+                       ThreadCacheResource::SLAB_SIZE /
+                       ThreadCacheResource::classSize( i ),
+                   threadCache.pooledCount( i ) );
+    }
+}
+
+TEST( ThreadCacheResource, DISABLED_Benchmark )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    typedef std::chrono::steady_clock Clock;
+
+    const uint32 counts[] = { 1, 2, 4, 8, 16 };
+    const uint32 ROUNDS = 200;
+    const uint32 LIVE = 1000;
+
+    HeapResource heap;
+    ThreadCacheResource threadCache;
+    uint32 i;
+
+    // gets the size of the block at the index of a list of handed off
+    // blocks, which holds every odd index of each working set in order
+    auto oddSize = [&]( uint32 index ) {
+        return 16u << ( ( 2 * ( index % ( LIVE / 2 ) ) + 1 ) % 6 );
+    };
+
+    // each thread allocates a working set of mixed sizes and frees half of
+    // it on the next thread over, so blocks cross threads every round
+    auto run = [&]( IMemoryResource* resource, uint32 count ) {
+        std::vector<std::thread> threads;
+        std::vector<std::vector<void*>> handoffs( count );
+        std::vector<std::mutex> mutexes( count );
+        Clock::time_point start = Clock::now();
+        uint32 t;
+        uint32 j;
+
+        for ( t = 0; t < count; ++t )
+        {
+            threads.push_back( std::thread( [&, t]() {
+                std::vector<void*> blocks( LIVE );
+                std::vector<void*> received;
+                uint32 next = ( t + 1 ) % count;
+                uint32 r;
+                uint32 j;
+
+                for ( r = 0; r < ROUNDS; ++r )
+                {
+                    for ( j = 0; j < LIVE; ++j )
+                    {
+                        blocks[j] =
+                            resource->allocate( 16 << ( j % 6 ), 8 );
+                    }
+
+                    for ( j = 0; j < LIVE; j += 2 )
+                    {
+                        resource->deallocate( blocks[j], 16 << ( j % 6 ),
+                                              8 );
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock( mutexes[next] );
+                        for ( j = 1; j < LIVE; j += 2 )
+                        {
+                            handoffs[next].push_back( blocks[j] );
+                        }
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock( mutexes[t] );
+                        received.swap( handoffs[t] );
+                    }
+
+                    for ( j = 0; j < received.size(); ++j )
+                    {
+                        resource->deallocate( received[j], oddSize( j ), 8 );
+                    }
+                    received.clear();
+                }
+            } ) );
+        }
+
+        for ( t = 0; t < count; ++t )
+        {
+            threads[t].join();
+        }
+
+        for ( t = 0; t < count; ++t )
+        {
+            for ( j = 0; j < handoffs[t].size(); ++j )
+            {
+                resource->deallocate( handoffs[t][j], oddSize( j ), 8 );
+            }
+        }
+
+        return count * ROUNDS * LIVE * 2 /
+               std::chrono::duration<double>( Clock::now() - start ).count();
+    };
+
+    for ( i = 0; i < sizeof( counts ) / sizeof( counts[0] ); ++i )
+    {
+        std::cout << counts[i] << " threads:\n";
+        std::cout << "  heap: " << run( &heap, counts[i] ) / 1e6
+                  << " Mops/s\n";
+        std::cout << "  thread cache: " << run( &threadCache, counts[i] ) / 1e6
+                  << " Mops/s\n";
+    }
+}
@@ -0,0 +1,74 @@
+// thread_index.t.cpp
+#include <engine/memory/thread_index.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class RecordingCache : public nge::mem::IThreadCache
+{
+  public:
+    std::vector<nge::uint32> released;
+
+    virtual void releaseThread( nge::uint32 index )
+    {
+        released.push_back( index );
+    }
+};
+
+} // End nspc anonymous
+
+TEST( ThreadIndex, Current )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint32 index = ThreadIndex::current();
+    uint32 other = ThreadIndex::MAX_THREADS;
+
+    EXPECT_LT( index, ThreadIndex::MAX_THREADS );
+    EXPECT_EQ( index, ThreadIndex::current() );
+
+    std::thread thread( [&other]() { other = ThreadIndex::current(); } );
+    thread.join();
+
+    EXPECT_LT( other, ThreadIndex::MAX_THREADS );
+    EXPECT_NE( index, other );
+}
+
+TEST( ThreadIndex, Reuse )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    const uint32 THREADS = ThreadIndex::MAX_THREADS * 2;
+
+    RecordingCache cache;
+    uint32 index;
+    uint32 i;
+
+    ThreadIndex::addCache( &cache );
+
+    // threads that run one after another never run out of indices and each
+    // releases its index to the cache when it exits
+    for ( i = 0; i < THREADS; ++i )
+    {
+        index = ThreadIndex::MAX_THREADS;
+        std::thread thread( [&index]() { index = ThreadIndex::current(); } );
+        thread.join();
+
+        ASSERT_LT( index, ThreadIndex::MAX_THREADS );
+        ASSERT_EQ( i + 1, cache.released.size() );
+        ASSERT_EQ( index, cache.released.back() );
+    }
+
+    // threads that never ask for an index do not release one
+    std::thread thread( []() {} );
+    thread.join();
+    EXPECT_EQ( THREADS, cache.released.size() );
+
+    ThreadIndex::removeCache( &cache );
+}
@@ -0,0 +1,101 @@
+// tracking_allocator.t.cpp
+#include <engine/memory/tracking_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/default_allocator.h>
+#include <engine/memory/virtual_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( TrackingAllocator, Construction )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    DefaultAllocator<uint32> def;
+    TrackingAllocator<uint32> alloc( "tracking.construction" );
+    TrackingAllocator<uint32> wrapped( "tracking.construction", &def );
+    TrackingAllocator<uint32> copy( alloc );
+
+    EXPECT_EQ( alloc.tracker(), wrapped.tracker() );
+    EXPECT_EQ( alloc.tracker(), copy.tracker() );
+    EXPECT_EQ( alloc.tracker(),
+               AllocationRegistry::find( "tracking.construction" ) );
+    EXPECT_EQ( def.alignment(), wrapped.alignment() );
+}
+
+TEST( TrackingAllocator, Allocation )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    TrackingAllocator<uint32> ints( "tracking.allocation" );
+    TrackingAllocator<uint64> longs( "tracking.allocation" );
+    AllocationTracker* tracker = ints.tracker();
+    uint32* intValues;
+    uint64* longValues;
+
+    intValues = ints.get( 10 );
+    EXPECT_EQ( 40, tracker->liveBytes() );
+
+    longValues = longs.get( 10 );
+    EXPECT_EQ( 120, tracker->liveBytes() );
+
+    ints.release( intValues, 10 );
+    EXPECT_EQ( 80, tracker->liveBytes() );
+    EXPECT_EQ( 120, tracker->peakBytes() );
+
+    longs.release( longValues, 10 );
+    EXPECT_EQ( 0, tracker->liveBytes() );
+    EXPECT_EQ( 2, tracker->stats().allocations );
+    EXPECT_EQ( 2, tracker->stats().releases );
+
+    EXPECT_DEATH( ints.get( 0 ), ".*" );
+    EXPECT_DEATH( ints.release( nullptr, 1 ), ".*" );
+}
+
+TEST( TrackingAllocator, Grow )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    VirtualAllocator<uint64> virt( 64 * 1024, VirtualMemory::SMALL_PAGES );
+    TrackingAllocator<uint64> alloc( "tracking.grow", &virt );
+    AllocationTracker* tracker = alloc.tracker();
+    uint32 max = virt.maxCount();
+    uint64* values;
+
+    values = alloc.get( 10 );
+    ASSERT_TRUE( alloc.grow( values, 10, 100 ) );
+    EXPECT_EQ( 800, tracker->liveBytes() );
+    EXPECT_EQ( 800, tracker->peakBytes() );
+    EXPECT_EQ( 1, tracker->stats().allocations );
+
+    EXPECT_FALSE( alloc.grow( values, 100, max + 1 ) );
+    EXPECT_EQ( 800, tracker->liveBytes() );
+
+    alloc.release( values, 100 );
+    EXPECT_EQ( 0, tracker->liveBytes() );
+}
+
+TEST( TrackingAllocator, Containers )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    TrackingAllocator<uint32> alloc( "tracking.containers" );
+    AllocationTracker* tracker = alloc.tracker();
+    uint32 i;
+
+    {
+        cntr::DynamicArray<uint32, AllocatorGuard> array( &alloc );
+
+        for ( i = 0; i < 100; ++i )
+        {
+            array.push( i );
+        }
+
+        EXPECT_LE( 400, tracker->liveBytes() );
+        EXPECT_LT( 1, tracker->stats().allocations );
+    }
+
+    EXPECT_EQ( 0, tracker->liveBytes() );
+}
@@ -0,0 +1,117 @@
+// virtual_allocator.t.cpp
+#include <engine/memory/virtual_allocator.h>
+#include <engine/containers/dynamic_array.h>
+#include <gtest/gtest.h>
+
+TEST( VirtualAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    VirtualAllocator<uint32> def;
+    VirtualAllocator<uint32> small( 1000, VirtualMemory::SMALL_PAGES );
+    VirtualAllocator<uint32> copy( small );
+
+    EXPECT_EQ( 1ull << 30, def.reserveSize() );
+    EXPECT_EQ( VirtualMemory::TRANSPARENT_HUGE_PAGES, def.mode() );
+    EXPECT_EQ( VirtualMemory::pageSize(), small.reserveSize() );
+    EXPECT_EQ( small.reserveSize() / 4, small.maxCount() );
+    EXPECT_EQ( VirtualMemory::SMALL_PAGES, copy.mode() );
+    EXPECT_EQ( VirtualMemory::pageSize(), small.alignment() );
+}
+
+TEST( VirtualAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    VirtualAllocator<uint64> alloc( 1024 * 1024,
+                                    VirtualMemory::SMALL_PAGES );
+    uint64* values;
+    uint32 i;
+
+    values = alloc.get( 100 );
+    ASSERT_NE( nullptr, values );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( values ) %
+                  VirtualMemory::pageSize() );
+
+    for ( i = 0; i < 100; ++i )
+    {
+        EXPECT_EQ( 0, values[i] );
+        values[i] = i;
+    }
+
+    EXPECT_DEATH( alloc.get( alloc.maxCount() + 1 ), ".*" );
+    EXPECT_DEATH( alloc.get( 0 ), ".*" );
+
+    alloc.release( values, 100 );
+}
+
+TEST( VirtualAllocator, ReserveFailure )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    // larger than any address space
+    VirtualAllocator<uint64> alloc( 1ull << 62, VirtualMemory::SMALL_PAGES );
+
+    EXPECT_EQ( nullptr, alloc.get( 100 ) );
+}
+
+TEST( VirtualAllocator, Grow )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    VirtualAllocator<uint64> alloc( 1024 * 1024,
+                                    VirtualMemory::SMALL_PAGES );
+    uint32 max = alloc.maxCount();
+    uint64* values = alloc.get( 10 );
+    uint32 i;
+
+    values[9] = 9;
+
+    ASSERT_TRUE( alloc.grow( values, 10, max / 2 ) );
+    EXPECT_EQ( 9, values[9] );
+    EXPECT_EQ( 0, values[max / 2 - 1] );
+    values[max / 2 - 1] = 1;
+
+    ASSERT_TRUE( alloc.grow( values, max / 2, max ) );
+    EXPECT_FALSE( alloc.grow( values, max, max + 1 ) );
+
+    for ( i = 0; i < max; i += 512 )
+    {
+        values[i] = i;
+    }
+
+    alloc.release( values, max );
+}
+
+TEST( VirtualAllocator, Containers )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    VirtualAllocator<uint32> alloc( 16 * 1024 * 1024,
+                                    VirtualMemory::TRANSPARENT_HUGE_PAGES );
+    cntr::DynamicArray<uint32, AllocatorGuard> array( &alloc );
+    const uint32* front;
+    uint32 i;
+
+    // wrap the items around the front before the array grows
+    array.push( 1 );
+    array.pushFront( 0 );
+    front = &array[0];
+
+    for ( i = 2; i < 100000; ++i )
+    {
+        array.push( i );
+    }
+
+    // the array grew in place so the wrapped items were the only ones moved
+    EXPECT_EQ( front, &array[0] );
+    for ( i = 0; i < 100000; ++i )
+    {
+        ASSERT_EQ( i, array[i] );
+    }
+}
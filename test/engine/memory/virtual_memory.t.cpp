@@ -0,0 +1,85 @@
+// virtual_memory.t.cpp
+#include <engine/memory/virtual_memory.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+TEST( VirtualMemory, Sizes )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint64 page = VirtualMemory::pageSize();
+
+    EXPECT_LT( 0, page );
+    EXPECT_EQ( 0, page & ( page - 1 ) );
+    EXPECT_EQ( page, VirtualMemory::granularity( VirtualMemory::SMALL_PAGES ) );
+    EXPECT_EQ( VirtualMemory::HUGE_PAGE_SIZE,
+               VirtualMemory::granularity( VirtualMemory::HUGE_PAGES ) );
+
+    EXPECT_EQ( page, VirtualMemory::roundUp( 1, VirtualMemory::SMALL_PAGES ) );
+    EXPECT_EQ( page,
+               VirtualMemory::roundUp( page, VirtualMemory::SMALL_PAGES ) );
+    EXPECT_EQ( 2 * VirtualMemory::HUGE_PAGE_SIZE,
+               VirtualMemory::roundUp(
+                   VirtualMemory::HUGE_PAGE_SIZE + 1,
+                   VirtualMemory::TRANSPARENT_HUGE_PAGES ) );
+}
+
+TEST( VirtualMemory, ReserveAndCommit )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint64 page = VirtualMemory::pageSize();
+    uint64 size = 64 * page;
+    uint8* bytes;
+
+    bytes = static_cast<uint8*>(
+        VirtualMemory::reserve( size, VirtualMemory::SMALL_PAGES ) );
+    ASSERT_NE( nullptr, bytes );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( bytes ) % page );
+
+    // commit the front and then a page in the middle of the range
+    ASSERT_TRUE( VirtualMemory::commit( bytes, 2 * page ) );
+    std::memset( bytes, 0xAB, 2 * page );
+    ASSERT_TRUE( VirtualMemory::commit( bytes + 32 * page, page ) );
+    bytes[32 * page] = 1;
+
+    // committing again keeps the contents
+    ASSERT_TRUE( VirtualMemory::commit( bytes, 4 * page ) );
+    EXPECT_EQ( 0xAB, bytes[2 * page - 1] );
+    EXPECT_EQ( 0, bytes[3 * page] );
+
+    VirtualMemory::decommit( bytes, 2 * page );
+    ASSERT_TRUE( VirtualMemory::commit( bytes, 2 * page ) );
+    EXPECT_EQ( 0, bytes[0] );
+
+    VirtualMemory::release( bytes, size );
+}
+
+TEST( VirtualMemory, HugePages )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint64 size = 2 * VirtualMemory::HUGE_PAGE_SIZE;
+    uint8* bytes;
+
+    bytes = static_cast<uint8*>( VirtualMemory::reserve(
+        size, VirtualMemory::TRANSPARENT_HUGE_PAGES ) );
+    ASSERT_NE( nullptr, bytes );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( bytes ) %
+                  VirtualMemory::HUGE_PAGE_SIZE );
+    ASSERT_TRUE( VirtualMemory::commit( bytes, size ) );
+    bytes[size - 1] = 1;
+    VirtualMemory::release( bytes, size );
+
+    // explicit huge pages fall back when the system has none to give
+    bytes = static_cast<uint8*>(
+        VirtualMemory::reserve( size, VirtualMemory::HUGE_PAGES ) );
+    ASSERT_NE( nullptr, bytes );
+    ASSERT_TRUE( VirtualMemory::commit( bytes, size ) );
+    bytes[0] = 1;
+    VirtualMemory::release( bytes, size );
+}
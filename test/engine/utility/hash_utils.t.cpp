@@ -14,4 +14,29 @@ TEST( HashUtils, CompileTimeHash )
     using namespace nge::util;
     ASSERT_EQ( HashUtils::fnv1a( "hisNameIsRobertPaulson" ),
                chash( "hisNameIsRobertPaulson" ) );
-}
\ No newline at end of file
+}
+
+TEST( HashUtils, Mix )
+{
+    using namespace nge;
+    using namespace nge::util;
+
+    ASSERT_EQ( 0, HashUtils::mix( 0 ) );
+    ASSERT_NE( HashUtils::mix( 1 ), HashUtils::mix( 2 ) );
+
+    // neighbouring inputs differ in their high bits
+    ASSERT_NE( HashUtils::mix( 1 ) >> 24, HashUtils::mix( 2 ) >> 24 );
+}
+
+TEST( HashUtils, StringHash )
+{
+    using namespace nge::util;
+
+    constexpr nge::uint32 hashCode = HashUtils::stringHash( "compileTime" );
+
+    ASSERT_EQ( chash( "compileTime" ), hashCode );
+    ASSERT_EQ( HashUtils::fnv1a( nge::String( "compileTime" ) ), hashCode );
+    ASSERT_EQ( chash( "" ), HashUtils::stringHash( "" ) );
+    ASSERT_EQ( HashUtils::fnv1a64( nge::String( "compileTime" ) ),
+               HashUtils::stringHash64( "compileTime" ) );
+}
@@ -0,0 +1,125 @@
+// string_id.t.cpp
+#include <engine/utility/string_id.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST( StringId, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::util;
+
+    constexpr StringId literal = NGE_SID( "literal" );
+    constexpr StringId empty;
+
+    static_assert( literal.value() == chash( "literal" ),
+                   "literal ids are computed at compile time" );
+    static_assert( empty.isEmpty(), "the default id is empty" );
+
+    StringId copy( literal );
+    StringId assigned;
+
+    assigned = copy;
+    ASSERT_EQ( literal, assigned );
+    ASSERT_NE( empty, assigned );
+    ASSERT_FALSE( assigned.isEmpty() );
+
+    ASSERT_EQ( HashUtils::stringHash64( "literal" ),
+               StringId64::hash( "literal" ) );
+
+    // literal ids are not in the table until they are interned
+    ASSERT_FALSE( NGE_SID( "literal.only" ).isInterned() );
+    ASSERT_EQ( '#', NGE_SID( "literal.only" ).toString()[0] );
+}
+
+TEST( StringId, Intern )
+{
+    using namespace nge;
+    using namespace nge::util;
+
+    StringId id = StringId::intern( String( "shaders/basic.vert" ) );
+
+    ASSERT_EQ( StringId( chash( "shaders/basic.vert" ) ), id );
+    ASSERT_EQ( id, StringId::intern( "shaders/basic.vert" ) );
+    ASSERT_NE( id, StringId::intern( "shaders/basic.frag" ) );
+    ASSERT_TRUE( id.isInterned() );
+    ASSERT_EQ( "shaders/basic.vert", id.toString() );
+
+    StringId64 id64 = StringId64::intern( "shaders/basic.vert" );
+    ASSERT_EQ( StringId64::hash( "shaders/basic.vert" ), id64.value() );
+    ASSERT_EQ( "shaders/basic.vert", id64.toString() );
+
+    // ids that were never interned print their value
+    ASSERT_FALSE( StringId( 0xabc ).isInterned() );
+    ASSERT_EQ( "#00000abc", StringId( 0xabc ).toString() );
+
+    ASSERT_EQ( chash( "logger" ) < chash( "renderer" ),
+               NGE_SID( "logger" ) < NGE_SID( "renderer" ) );
+}
+
+TEST( StringId, EmbeddedNull )
+{
+    using namespace nge;
+    using namespace nge::util;
+
+    const String value( "tex\0ture", 8 );
+
+    // the hash covers the characters after the null
+    ASSERT_NE( StringId::hash( "tex" ), StringId::hash( value ) );
+    ASSERT_NE( StringId::intern( "tex" ), StringId::intern( value ) );
+    ASSERT_EQ( value, StringId::intern( value ).toString() );
+    ASSERT_NE( StringId64::intern( "tex" ), StringId64::intern( value ) );
+}
+
+TEST( StringId, MapKeys )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::util;
+
+    Map<StringId, uint32> map;
+
+    map.put( NGE_SID( "first" ), 1 );
+    map.put( StringId::intern( "second" ), 2 );
+
+    ASSERT_EQ( 1, map[StringId::intern( "first" )] );
+    ASSERT_EQ( 2, map[NGE_SID( "second" )] );
+    ASSERT_FALSE( map.has( NGE_SID( "third" ) ) );
+}
+
+TEST( StringId, ConcurrentIntern )
+{
+    using namespace nge;
+    using namespace nge::util;
+
+    const uint32 THREADS = 4;
+    const uint32 STRINGS = 256;
+
+    std::vector<std::thread> threads;
+    uint32 i;
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads.push_back( std::thread( [STRINGS]() {
+            uint32 j;
+
+            for ( j = 0; j < STRINGS; ++j )
+            {
+                StringId::intern( "concurrent" + std::to_string( j ) );
+            }
+        } ) );
+    }
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads[i].join();
+    }
+
+    for ( i = 0; i < STRINGS; ++i )
+    {
+        const String value = "concurrent" + std::to_string( i );
+        ASSERT_EQ( value,
+                   StringId( StringId::hash( value.c_str() ) ).toString() );
+    }
+}